@@ -21,6 +21,10 @@
 
 #include "raylib.h"
 
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -30,6 +34,23 @@ typedef enum GameScreen { LOGO, TITLE, GAMEPLAY, ENDING } GameScreen;
 
 // TODO: Define required structs
 
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void UpdateDrawFrame(void);  // Update and draw one frame
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const int screenWidth = 800;
+static const int screenHeight = 450;
+
+// Game required variables
+static GameScreen screen = LOGO;       // Current game screen state
+static int framesCounter = 0;          // General pourpose frames counter
+static int gameResult = -1;            // Game result: 0 - Loose, 1 - Win, -1 - Not defined
+static bool gamePaused = false;        // Game paused state toggle
+
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
@@ -37,135 +58,143 @@ int main()
 {
     // Initialization
     //--------------------------------------------------------------------------------------
-    const int screenWidth = 800;
-    const int screenHeight = 450;
-
     // LESSON 01: Window initialization and screens management
     InitWindow(screenWidth, screenHeight, "PROJECT: BLOCKS GAME");
     
     // NOTE: Load resources (textures, fonts, audio) after Window initialization
 
     // Game required variables
-    GameScreen screen = LOGO;       // Current game screen state
     
-    int framesCounter = 0;          // General pourpose frames counter
-    int gameResult = -1;            // Game result: 0 - Loose, 1 - Win, -1 - Not defined
-    bool gamePaused = false;        // Game paused state toggle
     
     // TODO: Define and Initialize game variables
         
+#if defined(PLATFORM_WEB)
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
+#else
     SetTargetFPS(60);               // Set desired framerate (frames per second)
     //--------------------------------------------------------------------------------------
     
     // Main game loop
     while (!WindowShouldClose())    // Detect window close button or ESC key
     {
-        // Update
-        //----------------------------------------------------------------------------------
+        UpdateDrawFrame();
+    }
+#endif
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    
+    // NOTE: Unload any loaded resources (texture, fonts, audio)
+
+    CloseWindow();              // Close window and OpenGL context
+    //--------------------------------------------------------------------------------------
+    
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Update and draw one frame
+// NOTE: Called once per frame by main game loop or, on web, by emscripten_set_main_loop()
+static void UpdateDrawFrame(void)
+{
+    // Update
+    //----------------------------------------------------------------------------------
+    switch(screen) 
+    {
+        case LOGO: 
+        {
+            // Update LOGO screen data here!
+            
+            framesCounter++;
+            
+            if (framesCounter > 180) 
+            {
+                screen = TITLE;    // Change to TITLE screen after 3 seconds
+                framesCounter = 0;
+            }
+            
+        } break;
+        case TITLE: 
+        {
+            // Update TITLE screen data here!
+            
+            framesCounter++;
+            
+            // LESSON 03: Inputs management (keyboard, mouse)
+            if (IsKeyPressed(KEY_ENTER)) screen = GAMEPLAY;
+            
+        } break;
+        case GAMEPLAY:
+        { 
+            // Update GAMEPLAY screen data here!
+
+            if (!gamePaused)
+            {
+                // TODO: Gameplay logic
+            }
+            
+            if (IsKeyPressed(KEY_ENTER)) screen = ENDING;
+
+        } break;
+        case ENDING: 
+        {
+            // Update END screen data here!
+            
+            framesCounter++;
+            
+            // LESSON 03: Inputs management (keyboard, mouse)
+            if (IsKeyPressed(KEY_ENTER)) screen = TITLE;
+
+        } break;
+        default: break;
+    }
+    //----------------------------------------------------------------------------------
+    
+    // Draw
+    //----------------------------------------------------------------------------------
+    BeginDrawing();
+    
+        ClearBackground(RAYWHITE);
+        
         switch(screen) 
         {
-            case LOGO: 
+            case LOGO:
             {
-                // Update LOGO screen data here!
-                
-                framesCounter++;
-                
-                if (framesCounter > 180) 
-                {
-                    screen = TITLE;    // Change to TITLE screen after 3 seconds
-                    framesCounter = 0;
-                }
-                
+                // TODO: Draw LOGO screen here!
+                DrawText("LOGO SCREEN", 20, 20, 40, LIGHTGRAY);
+                DrawText("WAIT for 3 SECONDS...", 290, 220, 20, GRAY);
+
             } break;
-            case TITLE: 
+            case TITLE:
             {
-                // Update TITLE screen data here!
-                
-                framesCounter++;
-                
-                // LESSON 03: Inputs management (keyboard, mouse)
-                if (IsKeyPressed(KEY_ENTER)) screen = GAMEPLAY;
-                
+                // TODO: Draw TITLE screen here!
+                DrawRectangle(0, 0, screenWidth, screenHeight, GREEN);
+                DrawText("TITLE SCREEN", 20, 20, 40, DARKGREEN);
+                DrawText("PRESS ENTER or TAP to JUMP to GAMEPLAY SCREEN", 120, 220, 20, DARKGREEN);
+
             } break;
             case GAMEPLAY:
-            { 
-                // Update GAMEPLAY screen data here!
-
-                if (!gamePaused)
-                {
-                    // TODO: Gameplay logic
-                }
-                
-                if (IsKeyPressed(KEY_ENTER)) screen = ENDING;
+            {
+                // TODO: Draw GAMEPLAY screen here!
+                DrawRectangle(0, 0, screenWidth, screenHeight, PURPLE);
+                DrawText("GAMEPLAY SCREEN", 20, 20, 40, MAROON);
+                DrawText("PRESS ENTER or TAP to JUMP to ENDING SCREEN", 130, 220, 20, MAROON);
 
             } break;
-            case ENDING: 
+            case ENDING:
             {
-                // Update END screen data here!
-                
-                framesCounter++;
-                
-                // LESSON 03: Inputs management (keyboard, mouse)
-                if (IsKeyPressed(KEY_ENTER)) screen = TITLE;
+                // TODO: Draw ENDING screen here!
+                DrawRectangle(0, 0, screenWidth, screenHeight, BLUE);
+                DrawText("ENDING SCREEN", 20, 20, 40, DARKBLUE);
+                DrawText("PRESS ENTER or TAP to RETURN to TITLE SCREEN", 120, 220, 20, DARKBLUE);
 
             } break;
             default: break;
         }
-        //----------------------------------------------------------------------------------
-        
-        // Draw
-        //----------------------------------------------------------------------------------
-        BeginDrawing();
-        
-            ClearBackground(RAYWHITE);
-            
-            switch(screen) 
-            {
-                case LOGO:
-                {
-                    // TODO: Draw LOGO screen here!
-                    DrawText("LOGO SCREEN", 20, 20, 40, LIGHTGRAY);
-                    DrawText("WAIT for 3 SECONDS...", 290, 220, 20, GRAY);
-
-                } break;
-                case TITLE:
-                {
-                    // TODO: Draw TITLE screen here!
-                    DrawRectangle(0, 0, screenWidth, screenHeight, GREEN);
-                    DrawText("TITLE SCREEN", 20, 20, 40, DARKGREEN);
-                    DrawText("PRESS ENTER or TAP to JUMP to GAMEPLAY SCREEN", 120, 220, 20, DARKGREEN);
-
-                } break;
-                case GAMEPLAY:
-                {
-                    // TODO: Draw GAMEPLAY screen here!
-                    DrawRectangle(0, 0, screenWidth, screenHeight, PURPLE);
-                    DrawText("GAMEPLAY SCREEN", 20, 20, 40, MAROON);
-                    DrawText("PRESS ENTER or TAP to JUMP to ENDING SCREEN", 130, 220, 20, MAROON);
-
-                } break;
-                case ENDING:
-                {
-                    // TODO: Draw ENDING screen here!
-                    DrawRectangle(0, 0, screenWidth, screenHeight, BLUE);
-                    DrawText("ENDING SCREEN", 20, 20, 40, DARKBLUE);
-                    DrawText("PRESS ENTER or TAP to RETURN to TITLE SCREEN", 120, 220, 20, DARKBLUE);
-
-                } break;
-                default: break;
-            }
-        
-        EndDrawing();
-        //----------------------------------------------------------------------------------
-    }
-
-    // De-Initialization
-    //--------------------------------------------------------------------------------------
-    
-    // NOTE: Unload any loaded resources (texture, fonts, audio)
-
-    CloseWindow();              // Close window and OpenGL context
-    //--------------------------------------------------------------------------------------
     
-    return 0;
-}
\ No newline at end of file
+    EndDrawing();
+    //----------------------------------------------------------------------------------
+}
@@ -5,10 +5,10 @@
 *   DESCRIPTION:    Sounds and music loading and playing
 *
 *   COMPILATION (Windows - MinGW):
-*       gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lopengl32 -lgdi32 -lwinmm -Wall -std=c99
+*       gcc -o $(NAME_PART).exe $(FILE_NAME) -I../src -Lbuild/PLATFORM_DESKTOP -lgamecore -lraylib -lopengl32 -lgdi32 -lwinmm -Wall -std=c99
 *
 *   COMPILATION (Linux - GCC):
-*       gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*       gcc -o $(NAME_PART).exe $(FILE_NAME) -I../src -Lbuild/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
 *
 *   Example originally created with raylib 2.0, last time updated with raylib 4.2
 
@@ -21,390 +21,1085 @@
 
 #include "raylib.h"
 
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#endif
+#include "rlgl.h"                   // Required for: rlBegin(), rlEnd(), rlSetTexture()...
+#include <stddef.h>                 // Required for: NULL
+#include <math.h>                   // Required for: sinf(), cosf()
+
+// Shared game core library (libgamecore)
+#include "blocks_sim.h"             // Game simulation: Player, Ball, Brick, UpdateBlocksGame()...
+#include "screens.h"                // Screens management: GameScreen, ChangeScreen()
+#include "game_audio.h"             // Sounds and music: LoadGameSound(), PlayGameSound()...
+#include "pacing.h"                 // Frame pacing controller: InitFramePacer(), BeginFramePacing()...
+#include "assets.h"                 // Streaming assets loading: LoadAssetAsync(), IsAssetReady()...
+#include "softrender.h"             // CPU software rasterizer: SoftDrawTexture(), SoftDrawRectangle()...
+#include "clip_recorder.h"          // Clips recording: StartClipRecording(), CaptureClipScreen()...
+#include "screenshots.h"            // Non-blocking screenshots: TakeScreenshotAsync(), UpdateScreenshots()...
+#include "frame_counters.h"         // Frame counters: BeginFrameCounters(), DrawFrameCounters()...
+#include "trace_events.h"           // Timeline tracing: BeginTraceSpan(), EndTraceSpan(), SaveTraceEvents()...
+#include "redraw.h"                 // Idle-aware redraw: SetIdleRedraw(), ShouldRedraw(), RedrawBlink()...
+#include "resolution_scaler.h"      // Dynamic resolution: BeginScaledMode(), DrawScaledTarget()...
+#include "sim_thread.h"             // Simulation thread: StartSimThread(), SetSimInput(), AcquireSimState()...
+#include "game_events.h"            // Gameplay events queue: PushGameEvent(), PollGameEvent()...
+#include "spectator_shm.h"          // Spectators fan-out: CreateSpectatorHost(), PublishSpectatorFrame()...
+#include "replay.h"                 // Session replays: StartReplayRecording(), RecordReplayStep()...
+#include "camera_view.h"            // Camera over board: PanCameraView(), ZoomCameraView(), GetCameraViewRec()...
+#include "brick_mesh.h"             // Bricks greedy mesher: UpdateBrickMesh(), GenImageBrickAtlas()...
+#include "screen_draw.h"            // Screens drawing shared with tools: DrawBlocksScreen(), DrawBlocksGameplay()...
+
 //----------------------------------------------------------------------------------
-// Useful values definitions 
+// Defines and Macros
 //----------------------------------------------------------------------------------
-#define PLAYER_LIFES             5
-#define BRICKS_LINES             5
-#define BRICKS_PER_LINE         20
-
-#define BRICKS_POSITION_Y       50
+#define MAX_PARTICLES       64      // Particles spawned by gameplay events (destroyed bricks, paddle hits)
+#define BRICKS_MESH_BANDS   (((BRICKS_LINES + BRICK_MESH_MAX_ROWS - 1)/BRICK_MESH_MAX_ROWS)*((BRICKS_PER_LINE + BRICK_MESH_MAX_COLUMNS - 1)/BRICK_MESH_MAX_COLUMNS))   // Batched backend bricks meshes
+#define BOARD_MESH_BANDS    (((BRICK_BOARD_MAX_ROWS + BRICK_MESH_MAX_ROWS - 1)/BRICK_MESH_MAX_ROWS)*((BRICK_BOARD_MAX_COLUMNS + BRICK_MESH_MAX_COLUMNS - 1)/BRICK_MESH_MAX_COLUMNS))   // Batched backend board meshes
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
+// NOTE: Player, Ball and Brick structs are defined by game core (blocks_sim.h)
 
-// LESSON 01: Window initialization and screens management
-typedef enum GameScreen { LOGO, TITLE, GAMEPLAY, ENDING } GameScreen;
+// Simulation buttons, inputs are sampled on main thread and handed to simulation thread as bitmasks
+typedef enum {
+    BUTTON_LEFT     = 0x01,
+    BUTTON_RIGHT    = 0x02,
+    BUTTON_LAUNCH   = 0x04
+} GameButton;
 
-// Player structure
-typedef struct Player {
+// Particle structure, spawned by gameplay events
+typedef struct Particle {
     Vector2 position;
     Vector2 speed;
-    Vector2 size;
-    Rectangle bounds;
-    int lifes;
-} Player;
+    float life;                     // Remaining life (frames), 0 - not active
+    Color color;
+} Particle;
 
-// Ball structure
-typedef struct Ball {
-    Vector2 position;
-    Vector2 speed;
-    float radius;
-    bool active;
-} Ball;
+// Textures required to draw GAMEPLAY screen elements
+typedef struct GameplayTextures {
+    Texture2D paddle;
+    Texture2D ball;
+    Texture2D brick;
+    Texture2D brickAtlas;           // Tinted bricks grid, merged bricks quads source (check brick_mesh.h)
+} GameplayTextures;
 
-// Bricks structure
-typedef struct Brick {
-    Vector2 position;
-    Vector2 size;
-    Rectangle bounds;
-    int resistance;
-    bool active;
-} Brick;
+// Render backends available to draw GAMEPLAY screen
+typedef enum RenderBackendType {
+    RENDER_SHAPES = 0,              // LESSON 02: Basic shapes (rectangles, circles)
+    RENDER_TEXTURES,                // LESSON 05: One DrawTextureEx() call per element
+    RENDER_BATCHED,                 // Merged bricks quads submitted as a single batch
+    RENDER_NULL,                    // Nothing drawn, useful for headless runs
+    RENDER_SOFTWARE,                // Drawn on CPU (softrender) and uploaded as a single texture
+    RENDER_BACKEND_COUNT
+} RenderBackendType;
+
+// Render backend structure
+typedef struct RenderBackend {
+    const char *name;               // Backend name, also used as command-line value
+    void (*DrawGameplay)(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+} RenderBackend;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void UpdateDrawFrame(void);  // Update and draw one frame
+static unsigned int StepBlocksGame(void *state, SimInput input, void *userData);   // Simulation step (simulation thread)
+static void SpawnParticles(Vector2 position, Color color, int count);   // Spawn particles burst
+static void UpdateParticles(void);  // Move particles, fade them out
+static void DrawParticles(void);    // Draw active particles
+static void DrawGameplayScaled(const BlocksGame *blocks);   // Draw GAMEPLAY world with current render backend, at current resolution scale
+static void DrawGameplayShapes(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+static void DrawGameplayTextures(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+static void DrawGameplayBatched(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+static void DrawGameplayNull(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+static void DrawGameplaySoftware(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures);
+static void DrawBrickFieldRows(const BrickField *field, GameplayTextures textures);  // Draw endless mode resident rows in camera visible area
+static void DrawBrickBoardCells(const BrickBoard *board, GameplayTextures textures); // Draw board mode cells in camera visible area
+static void DrawBrickGridMeshes(BrickMesh *meshes, const unsigned char *cells, int rows, int columns, Vector2 position, Vector2 brickSize, GridRange visible, Texture2D atlas);  // Mesh grid bands and draw visible ones
+static void DrawBrickMesh(const BrickMesh *mesh, Vector2 position, Vector2 brickSize, int baseRow, int rowStep, GridRange visible, Texture2D atlas);  // Draw merged bricks quads from atlas
+static int GetGridCellsCount(const BlocksGame *blocks);     // Get bricks grid cells in current mode (visited cells reference)
+static void OnScreenshotSaved(const char *fileName, bool success, void *userData);  // Screenshot written callback
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const RenderBackend renderBackends[RENDER_BACKEND_COUNT] = {
+    { "shapes", DrawGameplayShapes },
+    { "textures", DrawGameplayTextures },
+    { "batched", DrawGameplayBatched },
+    { "null", DrawGameplayNull },
+    { "software", DrawGameplaySoftware },
+};
+
+static const int screenWidth = 800;
+static const int screenHeight = 450;
+
+// Render backend selection, it can be changed at runtime with keys [F1]..[F5]
+static RenderBackendType renderBackend = RENDER_TEXTURES;
+
+// LESSON 05: Textures loading and drawing
+static Texture2D texLogo = { 0 };
+static Texture2D texBall = { 0 };
+static Texture2D texPaddle = { 0 };
+static Texture2D texBrick = { 0 };
+static Texture2D texBrickAtlas = { 0 };
+
+// Bricks tints per state (normal, requiring more hits), even and odd checkerboard cells
+static const Color brickTints[4] = { GRAY, DARKGRAY, MAROON, { 120, 30, 40, 255 } };
+
+// LESSON 06: Fonts loading and text drawing
+static Font font = { 0 };
+
+// Screens drawing resources, shared screens drawing code (check screen_draw.h)
+static BlocksScreenAssets screenAssets = { 0 };
+
+// Software render backend: CPU framebuffer, its GPU copy and CPU textures
+static SoftFramebuffer softTarget = { 0 };
+static Texture2D texSoftTarget = { 0 };
+static SoftTexture softBall = { 0 };
+static SoftTexture softPaddle = { 0 };
+static SoftTexture softBrick = { 0 };
+
+// Dynamic resolution: gameplay render target, scale adapted to frame time
+static ResolutionScaler scaler = { 0 };
+
+// LESSON 07: Sounds and music loading and playing
+static int fxStart = -1;            // Sounds ids (check game_audio.h)
+static int fxBounce = -1;
+static int fxExplode = -1;
+
+// Game required variables
+static ScreenState screen = { SCREEN_LOGO, 0 };    // Current game screen state and frames counter
+static int gameResult = -1;            // Game result: 0 - Loose, 1 - Win, -1 - Not defined
+static bool gamePaused = false;        // Game paused state toggle
+static int clipFramesCounter = 0;      // Frames drawn while recording clip, one out of two captured
+static int screenshotsCounter = 0;     // Screenshots taken, used for file names
+static bool showCounters = false;      // Frame counters overlay toggle
+static bool endlessMode = false;       // Endless mode: bricks rows scroll down from field (procedural or level file)
+static const char *levelFileName = NULL;   // Endless mode level file, procedural rows if not provided
+static const char *boardFileName = NULL;   // Board mode level file, large board of several screens
+
+// NOTE: Player, ball and bricks are updated by game core simulation, on its own thread,
+// game state is only accessed by simulation, main thread draws latest published snapshot
+static BlocksGame game = { 0 };
+static SimThread sim = { 0 };
+static const BlocksGame *view = NULL;  // Latest simulation snapshot, drawn by main thread
+static unsigned int viewCollisionTests = 0; // Snapshot collision tests count, frame counters get differences
+
+// Spectators: latest snapshot published every frame into shared memory ("raylib_blocks"),
+// tools/spectator renders it in other windows, host cost does not depend on viewers count
+static SpectatorHost spectators = { 0 };
+
+// Session replay: gameplay steps inputs and keyframes (blocks_session.rpl), written by simulation
+// thread, tools/replay_player plays it back with seeking and fast-forward
+static ReplayRecorder replay = { 0 };
+
+// Particles, spawned by gameplay events on main thread
+static Particle particles[MAX_PARTICLES] = { 0 };
+
+// Gameplay camera: mouse wheel zoom, right button drag pan, [HOME] reset
+// NOTE: Render backends only draw bricks grid cells inside camera visible area
+static CameraView camera = { 0 };
+static GridRange visibleBricks = { 0 };
+static bool cameraFollow = true;       // Board mode: camera follows ball, stopped by panning, [HOME] restarts it
+static unsigned int cellsVisited = 0;  // Bricks grid cells visited by drawing, added to frame counters (culling check)
+
+// Batched backend merged bricks meshes: classic bricks lines bands, endless field chunks (ring slots) and board bands
+// NOTE: Bands are re-meshed only when their bricks change, quads/bricks counted every frame
+static BrickMesh bricksMeshes[BRICKS_MESH_BANDS] = { 0 };
+static BrickMesh fieldMeshes[BRICK_FIELD_CHUNKS] = { 0 };
+static BrickMesh boardMeshes[BOARD_MESH_BANDS] = { 0 };
+static int meshBricksCount = 0;        // Bricks drawn by merged quads, one quad each without merging
+static int meshQuadsCount = 0;         // Merged quads drawn
+static unsigned char bricksCells[BRICKS_LINES*BRICKS_PER_LINE] = { 0 };    // Classic bricks as mesh cells, rebuilt when bricks are destroyed
+static bool bricksCellsDirty = true;   // Classic bricks changed since cells were built
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main()
+int main(int argc, char *argv[])
 {
     // Initialization
     //--------------------------------------------------------------------------------------
-    const int screenWidth = 800;
-    const int screenHeight = 450;
+    // Timeline tracing: startup loading and frame phases, saved on exit and with key [F8]
+    InitTraceEvents("blocks_trace.json");
+    
+    // Render backend selection, it can be changed at runtime with keys [F1]..[F5]
+    // NOTE: Command-line usage: --render [shapes|textures|batched|null|software] [--endless] [--level <file>] [--board <file>]
+    for (int i = 1; i < argc; i++)
+    {
+        if (TextIsEqual(argv[i], "--render") && (i + 1 < argc))
+        {
+            for (int b = 0; b < RENDER_BACKEND_COUNT; b++)
+            {
+                if (TextIsEqual(argv[i + 1], renderBackends[b].name)) renderBackend = b;
+            }
+        }
+        else if (TextIsEqual(argv[i], "--endless")) endlessMode = true;
+        else if (TextIsEqual(argv[i], "--level") && (i + 1 < argc))
+        {
+            levelFileName = argv[i + 1];
+            endlessMode = true;
+        }
+        else if (TextIsEqual(argv[i], "--board") && (i + 1 < argc)) boardFileName = argv[i + 1];
+    }
+    
+    // NOTE: Null backend is intended for headless runs, no need to show the window
+    if (renderBackend == RENDER_NULL) SetConfigFlags(FLAG_WINDOW_HIDDEN);
 
     // LESSON 01: Window initialization and screens management
+    BeginTraceSpan("InitWindow", NULL);
     InitWindow(screenWidth, screenHeight, "PROJECT: BLOCKS GAME");
+    EndTraceSpan();
     
     // NOTE: Load resources (textures, fonts, audio) after Window initialization
     
     // LESSON 05: Textures loading and drawing
-    Texture2D texLogo = LoadTexture("resources/raylib_logo.png");
-    Texture2D texBall = LoadTexture("resources/ball.png");
-    Texture2D texPaddle = LoadTexture("resources/paddle.png");
-    Texture2D texBrick = LoadTexture("resources/brick.png");
+    BeginTraceSpan("LoadTexture", "resources/raylib_logo.png");
+    texLogo = LoadTexture("resources/raylib_logo.png");
+    EndTraceSpan();
+    BeginTraceSpan("LoadTexture", "resources/ball.png");
+    texBall = LoadTexture("resources/ball.png");
+    EndTraceSpan();
+    BeginTraceSpan("LoadTexture", "resources/paddle.png");
+    texPaddle = LoadTexture("resources/paddle.png");
+    EndTraceSpan();
+    BeginTraceSpan("LoadTexture", "resources/brick.png");
+    texBrick = LoadTexture("resources/brick.png");
+    EndTraceSpan();
+    BeginTraceSpan("GenImageBrickAtlas", "resources/brick.png");
+    Image imBrick = LoadImage("resources/brick.png");
+    Image imBrickAtlas = GenImageBrickAtlas(imBrick, brickTints, 2);
+    texBrickAtlas = LoadTextureFromImage(imBrickAtlas);
+    UnloadImage(imBrickAtlas);
+    UnloadImage(imBrick);
+    EndTraceSpan();
     
     // LESSON 06: Fonts loading and text drawing
-    Font font = LoadFont("resources/setback.png");
+    BeginTraceSpan("LoadFont", "resources/setback.png");
+    font = LoadFont("resources/setback.png");
+    EndTraceSpan();
+    
+    screenAssets.logo = (ScreenTexture){ &texLogo, texLogo.width, texLogo.height };
+    screenAssets.paddle = (ScreenTexture){ &texPaddle, texPaddle.width, texPaddle.height };
+    screenAssets.ball = (ScreenTexture){ &texBall, texBall.width, texBall.height };
+    screenAssets.brick = (ScreenTexture){ &texBrick, texBrick.width, texBrick.height };
+    screenAssets.font = (ScreenFont){ &font, font.baseSize };
+    
+    // Software render backend: gameplay is rasterized on CPU and uploaded once per frame
+    BeginTraceSpan("LoadSoftRender", NULL);
+    softTarget = LoadSoftFramebuffer(screenWidth, screenHeight);
+    texSoftTarget = LoadTextureFromImage((Image){ softTarget.pixels, screenWidth, screenHeight, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 });
+    softBall = LoadSoftTexture("resources/ball.png");
+    softPaddle = LoadSoftTexture("resources/paddle.png");
+    softBrick = LoadSoftTexture("resources/brick.png");
+    EndTraceSpan();
+    
+    // Dynamic resolution: gameplay is drawn at a lower resolution when frames get too heavy
+    scaler = LoadResolutionScaler(screenWidth, screenHeight, GetResolutionScalerConfigDefault());
     
     // LESSON 07: Sounds and music loading and playing
-    InitAudioDevice();              // Initialize audio system
+    InitGameAudio();                // Initialize audio system
+    
+    fxStart = LoadGameSound("resources/start.wav");
+    fxBounce = LoadGameSound("resources/bounce.wav");
+    fxExplode = LoadGameSound("resources/explosion.wav");
+    
+    // NOTE: Music is not required by LOGO/TITLE screens, on web it's fetched in background,
+    // it starts streaming on UpdateGameAudio() once available
+    InitAssets("");
+    PlayGameMusic(LoadAssetAsync("resources/blockshock.mod", ASSET_MUSIC));
+
+    // Initialize player, ball and bricks
+    // NOTE: Endless mode level file is loaded once here, field rows are generated from it while playing,
+    // board mode playfield grows to board size (classic mode if board can not be loaded)
+    if (boardFileName != NULL) InitBlocksGameBoard(&game, screenWidth, screenHeight, boardFileName);
+    else if (endlessMode) InitBlocksGameEndless(&game, screenWidth, screenHeight, (unsigned int)GetRandomValue(1, 0x7fffffff), levelFileName);
+    else InitBlocksGame(&game, screenWidth, screenHeight);
+    
+    camera = InitCameraView((Vector2){ screenWidth, screenHeight }, (Rectangle){ 0, 0, game.screenWidth, game.screenHeight });
+    ResetCameraView(&camera);
     
-    Sound fxStart = LoadSound("resources/start.wav");
-    Sound fxBounce = LoadSound("resources/bounce.wav");
-    Sound fxExplode = LoadSound("resources/explosion.wav");
+    // Gameplay events are raised by simulation and screen changes, game reacts to them once per frame
+    InitGameEvents();
     
-    Music music = LoadMusicStream("resources/blockshock.mod");
+    // Session replay, recording starts before simulation steps run
+    SimThreadConfig simConfig = GetSimThreadConfigDefault();
+#if !defined(PLATFORM_WEB)
+    replay = StartReplayRecording("blocks_session.rpl", REPLAY_GAME_BLOCKS, sizeof(BlocksGame), simConfig.stepRate);
+#endif
     
-    PlayMusicStream(music);         // Start music streaming
+    // Simulation runs at fixed rate on its own thread while playing, overlapping with drawing
+    StartSimThread(&sim, &game, sizeof(BlocksGame), StepBlocksGame, NULL, simConfig);
+    view = (const BlocksGame *)AcquireSimState(&sim, NULL);
+    
+    // Local spectators: shared memory region, viewer processes attach read-only
+    spectators = CreateSpectatorHost("raylib_blocks", SPECTATOR_GAME_BLOCKS, sizeof(BlocksGame));
+    
+    // Screenshots are encoded in background, [F10] takes one
+    InitScreenshots(screenWidth, screenHeight);
+    
+    // Frame counters: [F6] shows overlay, [F7] starts/stops CSV export
+    InitFrameCounters();
+        
+#if defined(PLATFORM_WEB)
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
+#else
+    // NOTE: Frame pacer replaces SetTargetFPS(60), check pacing.h for available options
+    FramePacer pacer = InitFramePacer(GetFramePacerConfigDefault());
+    //--------------------------------------------------------------------------------------
+    
+    // Main game loop
+    while (!WindowShouldClose())    // Detect window close button or ESC key
+    {
+        BeginFramePacing(&pacer);   // Wait for next frame slot and sample inputs
+        
+        UpdateDrawFrame();
+        
+        // NOTE: Idle frames are not drawn, nothing to present
+        if (IsRedrawSkipped()) SkipFramePacing(&pacer);
+        else EndFramePacing(&pacer);    // Present frame and measure timings
+    }
+#endif
 
-    // Game required variables
-    GameScreen screen = LOGO;       // Current game screen state
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    
+    // NOTE: Unload any loaded resources (texture, fonts, audio)
     
-    int framesCounter = 0;          // General purpose frames counter
-    int gameResult = -1;            // Game result: 0 - Loose, 1 - Win, -1 - Not defined
-    bool gamePaused = false;        // Game paused state toggle
+    // LESSON 05: Textures loading and drawing
+    UnloadTexture(texBall);
+    UnloadTexture(texPaddle);
+    UnloadTexture(texBrick);
+    UnloadTexture(texBrickAtlas);
+    
+    // LESSON 06: Fonts loading and text drawing
+    UnloadFont(font);
     
-    // NOTE: Check defined structs on top
-    Player player = { 0 };
-    Ball ball = { 0 };
-    Brick bricks[BRICKS_LINES][BRICKS_PER_LINE] = { 0 };
+    UnloadTexture(texSoftTarget);
+    UnloadSoftFramebuffer(softTarget);
+    UnloadSoftTexture(softBall);
+    UnloadSoftTexture(softPaddle);
+    UnloadSoftTexture(softBrick);
     
-    // Initialize player
-    player.position = (Vector2){ screenWidth/2, screenHeight*7/8 };
-    player.speed = (Vector2){ 8.0f, 0.0f };
-    player.size = (Vector2){ 100, 24 };
-    player.lifes = PLAYER_LIFES;
+    UnloadResolutionScaler(scaler);
     
-    // Initialize ball
-    ball.radius = 10.0f;
-    ball.active = false;
-    ball.position = (Vector2){ player.position.x + player.size.x/2, player.position.y - ball.radius*2 };
-    ball.speed = (Vector2){ 4.0f, 4.0f };
+    // LESSON 07: Sounds and music loading and playing
+    UnloadAssets();             // Unload music streaming buffers
+    
+    CloseGameAudio();           // Unload sounds and close audio device connection
+    
+    StopSimThread(&sim);        // Stop simulation thread, unload snapshots
+    CloseSpectatorHost(&spectators);    // Viewers see region closed
+    StopReplayRecording(&replay);       // Write replay index footer
+    
+    StopClipRecording();        // Finish clip encoding if still recording
+    CloseScreenshots();         // Finish pending screenshots encoding
+    CloseFrameCounters();       // Close CSV file and unload counting render batch
+    CloseRedraw();              // Stop idle redraw timer
+    
+    CloseWindow();              // Close window and OpenGL context
+    
+    CloseTraceEvents();         // Save trace file (worker threads already finished)
+    //--------------------------------------------------------------------------------------
+    
+    return 0;
+}
 
-    // Initialize bricks
-    for (int j = 0; j < BRICKS_LINES; j++)
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Update and draw one frame
+// NOTE: Called once per frame by main game loop or, on web, by emscripten_set_main_loop()
+static void UpdateDrawFrame(void)
+{
+    // Update
+    //----------------------------------------------------------------------------------
+    BeginTraceSpan("Update", GetScreenName(screen.current));
+    BeginFrameCounters();
+    BeginScalerFrame(&scaler);
+    
+    // Render backend selection: [F1] shapes, [F2] textures, [F3] batched, [F4] null, [F5] software
+    for (int b = 0; b < RENDER_BACKEND_COUNT; b++)
     {
-        for (int i = 0; i < BRICKS_PER_LINE; i++)
+        if (IsKeyPressed(KEY_F1 + b) && (renderBackend != b))
         {
-            bricks[j][i].size = (Vector2){ screenWidth/BRICKS_PER_LINE, 20 };
-            bricks[j][i].position = (Vector2){ i*bricks[j][i].size.x, j*bricks[j][i].size.y + BRICKS_POSITION_Y };
-            bricks[j][i].bounds = (Rectangle){ bricks[j][i].position.x, bricks[j][i].position.y, bricks[j][i].size.x, bricks[j][i].size.y };
-            bricks[j][i].active = true;
+            renderBackend = b;
+            TraceLog(LOG_INFO, "GAME: Render backend selected: %s", renderBackends[renderBackend].name);
         }
     }
+    
+    // Clip recording: [F9] start/stop, GIF is encoded in background
+    if (IsKeyPressed(KEY_F9))
+    {
+        if (IsClipRecording()) StopClipRecording();
+        else StartClipRecording("blocks_clip.gif", screenWidth, screenHeight, 30, CLIP_FORMAT_GIF);
         
-    SetTargetFPS(60);               // Set desired framerate (frames per second)
-    //--------------------------------------------------------------------------------------
+        clipFramesCounter = 0;
+    }
     
-    // Main game loop
-    while (!WindowShouldClose())    // Detect window close button or ESC key
+    UpdateClipRecorder();
+    UpdateScreenshots();            // Notify screenshots written in background
+    
+    // Frame counters: [F6] overlay, [F7] CSV export (one row per frame)
+    if (IsKeyPressed(KEY_F6)) showCounters = !showCounters;
+    if (IsKeyPressed(KEY_F7))
+    {
+        if (IsFrameCountersCSVActive()) StopFrameCountersCSV();
+        else StartFrameCountersCSV("blocks_frames.csv");
+    }
+    
+    // Timeline tracing: [F8] saves latest events, recording continues
+    if (IsKeyPressed(KEY_F8)) SaveTraceEvents();
+    
+    screen.framesCounter++;
+    
+    switch(screen.current) 
     {
-        // Update
-        //----------------------------------------------------------------------------------
-        switch(screen) 
+        case SCREEN_LOGO: 
         {
-            case LOGO: 
+            // Update LOGO screen data here!
+            
+            if (screen.framesCounter > 180) ChangeScreen(&screen, SCREEN_TITLE);  // Change to TITLE screen after 3 seconds
+            
+        } break;
+        case SCREEN_TITLE: 
+        {
+            // Update TITLE screen data here!
+            
+            // LESSON 03: Inputs management (keyboard, mouse)
+            if (IsKeyPressed(KEY_ENTER))
             {
-                // Update LOGO screen data here!
-                
-                framesCounter++;
-                
-                if (framesCounter > 180) 
-                {
-                    screen = TITLE;    // Change to TITLE screen after 3 seconds
-                    framesCounter = 0;
-                }
-                
-            } break;
-            case TITLE: 
+                ChangeScreen(&screen, SCREEN_GAMEPLAY);
+                PlayGameSound(fxStart);
+            }
+            
+        } break;
+        case SCREEN_GAMEPLAY:
+        { 
+            // Update GAMEPLAY screen data here!
+            
+            // LESSON 03: Inputs management (keyboard, mouse)
+            if (IsKeyPressed('P')) gamePaused = !gamePaused;    // Pause button logic
+            
+            // Camera controls, also available while paused
+            ZoomCameraView(&camera, 1.0f + 0.1f*GetMouseWheelMove(), GetMousePosition());
+            if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT))
+            {
+                PanCameraView(&camera, GetMouseDelta());
+                cameraFollow = false;
+            }
+            if (IsKeyPressed(KEY_HOME))
+            {
+                ResetCameraView(&camera);
+                cameraFollow = true;
+            }
+
+            if (!gamePaused)
             {
-                // Update TITLE screen data here!
-                
-                framesCounter++;
-                
                 // LESSON 03: Inputs management (keyboard, mouse)
-                if (IsKeyPressed(KEY_ENTER))
-                {
-                    screen = GAMEPLAY;
-                    PlaySound(fxStart);
-                }
+                // NOTE: Inputs are applied by simulation thread on its next steps
+                unsigned int down = 0;
+                if (IsKeyDown(KEY_LEFT)) down |= BUTTON_LEFT;
+                if (IsKeyDown(KEY_RIGHT)) down |= BUTTON_RIGHT;
                 
-            } break;
-            case GAMEPLAY:
-            { 
-                // Update GAMEPLAY screen data here!
-                
-                // LESSON 03: Inputs management (keyboard, mouse)
-                if (IsKeyPressed('P')) gamePaused = !gamePaused;    // Pause button logic
-
-                if (!gamePaused)
-                {
-                    // LESSON 03: Inputs management (keyboard, mouse)
-                    
-                    // Player movement logic
-                    if (IsKeyDown(KEY_LEFT)) player.position.x -= player.speed.x;
-                    if (IsKeyDown(KEY_RIGHT)) player.position.x += player.speed.x;
-                    
-                    if ((player.position.x) <= 0) player.position.x = 0;
-                    if ((player.position.x + player.size.x) >= screenWidth) player.position.x = screenWidth - player.size.x;
-                    
-                    player.bounds = (Rectangle){ player.position.x, player.position.y, player.size.x, player.size.y };
-
-                    if (ball.active)
-                    {
-                        // Ball movement logic
-                        ball.position.x += ball.speed.x;
-                        ball.position.y += ball.speed.y;
-                        
-                        // Collision logic: ball vs screen-limits
-                        if (((ball.position.x + ball.radius) >= screenWidth) || ((ball.position.x - ball.radius) <= 0)) ball.speed.x *= -1;
-                        if ((ball.position.y - ball.radius) <= 0) ball.speed.y *= -1;
-                        
-                        // LESSON 04: Collision detection and resolution
-                        
-                        // NOTE: For collisions we consider elements bounds parameters, 
-                        // that's independent of elements drawing but they should match texture parameters
-                        
-                        // Collision logic: ball vs player
-                        if (CheckCollisionCircleRec(ball.position, ball.radius, player.bounds))
-                        {
-                            ball.speed.y *= -1;
-                            ball.speed.x = (ball.position.x - (player.position.x + player.size.x/2))/player.size.x*5.0f;
-                            PlaySound(fxBounce);
-                        }
-                        
-                        // Collision logic: ball vs bricks
-                        for (int j = 0; j < BRICKS_LINES; j++)
-                        {
-                            for (int i = 0; i < BRICKS_PER_LINE; i++)
-                            {
-                                if (bricks[j][i].active && (CheckCollisionCircleRec(ball.position, ball.radius, bricks[j][i].bounds)))
-                                {
-                                    bricks[j][i].active = false;
-                                    ball.speed.y *= -1;
-                                    PlaySound(fxExplode);
-                                    
-                                    break;
-                                }
-                            }
-                        }
-
-                        // Game ending logic
-                        if ((ball.position.y + ball.radius) >= screenHeight)
-                        {
-                            ball.position.x = player.position.x + player.size.x/2;
-                            ball.position.y = player.position.y - ball.radius - 1.0f;
-                            ball.speed = (Vector2){ 0, 0 };
-                            ball.active = false;
-
-                            player.lifes--;
-                        }
-                        
-                        if (player.lifes < 0)
-                        {
-                            screen = ENDING;
-                            player.lifes = 5;
-                            framesCounter = 0;
-                        }
-                    }
-                    else
-                    {
-                        // Reset ball position
-                        ball.position.x = player.position.x + player.size.x/2;
-                        
-                        // LESSON 03: Inputs management (keyboard, mouse)
-                        if (IsKeyPressed(KEY_SPACE))
-                        {
-                            // Activate ball logic
-                            ball.active = true;
-                            ball.speed = (Vector2){ 0, -5.0f };
-                        }
-                    }
-                }
+                SetSimInput(&sim, down, IsKeyPressed(KEY_SPACE)? BUTTON_LAUNCH : 0);
+            }
 
+        } break;
+        case SCREEN_ENDING: 
+        {
+            // Update END screen data here!
+            
+            // LESSON 03: Inputs management (keyboard, mouse)
+            if (IsKeyPressed(KEY_ENTER))
+            {
+                // Replay / Exit game logic
+                ChangeScreen(&screen, SCREEN_TITLE);
+            }
+            
+        } break;
+        default: break;
+    }
+    
+    // LESSON 04: Collision detection and resolution
+    // NOTE: Player, ball and bricks movement and collisions are resolved by game core simulation,
+    // it runs on its own thread while playing, reports what happened and game reacts to it
+    SetSimActive(&sim, (screen.current == SCREEN_GAMEPLAY) && !gamePaused);
+    
+    unsigned int simEvents = 0;
+    view = (const BlocksGame *)AcquireSimState(&sim, &simEvents);
+    
+    // NOTE: Snapshot events include skipped snapshots ones, no destroyed brick is missed
+    if (simEvents & BLOCKS_EVENT_BRICK_HIT) bricksCellsDirty = true;
+    
+    // NOTE: Collision tests counted by simulation in game state, steps published since last frame
+    AddFrameCounter(COUNTER_COLLISION_TESTS, (view->collisionTests >= viewCollisionTests)? view->collisionTests - viewCollisionTests : view->collisionTests);
+    viewCollisionTests = view->collisionTests;
+    
+    PublishSpectatorFrame(&spectators, view, simEvents);     // Changed state chunks only
+    
+    // Endless mode board extends above screen, camera bounds follow field rows
+    if (view->mode == BLOCKS_MODE_ENDLESS)
+    {
+        Rectangle fieldBounds = GetBrickFieldBounds(&view->field);
+        float top = (fieldBounds.y < 0)? fieldBounds.y : 0;
+        
+        SetCameraViewBounds(&camera, (Rectangle){ 0, top, screenWidth, screenHeight - top });
+    }
+    
+    // Board mode playfield is several screens in both axes, camera keeps ball on screen
+    if ((view->mode == BLOCKS_MODE_BOARD) && cameraFollow) CenterCameraView(&camera, view->ball.position);
+    
+    // Gameplay events dispatch: audio, particles and telemetry react outside simulation step
+    GameEvent event = { 0 };
+    while (PollGameEvent(&event))
+    {
+        TraceInstantEvent(GetGameEventName(event.type), NULL);
+        
+        switch (event.type)
+        {
+            // LESSON 07: Sounds and music loading and playing
+            case GAME_EVENT_BALL_HIT_PADDLE:
+            {
+                PlayGameSound(fxBounce);
+                SpawnParticles(event.position, MAROON, 4);
             } break;
-            case ENDING: 
+            case GAME_EVENT_BRICK_DESTROYED:
             {
-                // Update END screen data here!
-                
-                framesCounter++;
-                
-                // LESSON 03: Inputs management (keyboard, mouse)
-                if (IsKeyPressed(KEY_ENTER))
-                {
-                    // Replay / Exit game logic
-                    screen = TITLE;
-                }
-                
+                PlayGameSound(fxExplode);
+                SpawnParticles(event.position, ((event.value/BRICKS_PER_LINE + event.value%BRICKS_PER_LINE)%2 == 0)? GRAY : DARKGRAY, 8);
+            } break;
+            case GAME_EVENT_GAME_OVER:
+            {
+                // Game ending logic
+                if (screen.current == SCREEN_GAMEPLAY) ChangeScreen(&screen, SCREEN_ENDING);
+            } break;
+            case GAME_EVENT_SCREEN_CHANGED:
+            {
+                for (int i = 0; i < MAX_PARTICLES; i++) particles[i].life = 0.0f;
+
+                // New game: ENDING stats only count its events, reset in queue order (previous game ones already polled)
+                if (event.value == SCREEN_GAMEPLAY) ResetGameEventsCounts();
             } break;
             default: break;
         }
+    }
+    
+    if ((screen.current == SCREEN_GAMEPLAY) && !gamePaused) UpdateParticles();
+    
+    // LESSON 07: Sounds and music loading and playing
+    UpdateAssets();
+    UpdateGameAudio();              // Start music once available and refill its buffers
+    
+    EndTraceSpan();
+    
+    // Idle redraw: TITLE, ENDING and paused GAMEPLAY screens are drawn only on input or blink,
+    // main thread sleeps in between (music keeps being refilled)
+    // NOTE: Clips need every frame, idle mode is disabled while recording
+    SetIdleRedraw(((screen.current == SCREEN_TITLE) || (screen.current == SCREEN_ENDING) ||
+        ((screen.current == SCREEN_GAMEPLAY) && gamePaused)) && !IsClipRecording());
+    
+    if (!ShouldRedraw())
+    {
+        WaitRedrawEvents();
+        return;
+    }
+    //----------------------------------------------------------------------------------
+    
+    // Draw
+    //----------------------------------------------------------------------------------
+    BeginTraceSpan("Draw", GetScreenName(screen.current));
+    
+    BeginDrawing();
+    
+        // Screens are drawn by code shared with golden frames tool, GAMEPLAY world by game render backends
+        BlocksScreenView screenView = { 0 };
+        screenView.game = view;
+        screenView.screenWidth = screenWidth;
+        screenView.screenHeight = screenHeight;
+        screenView.blink = ((screen.current == SCREEN_TITLE) || (screen.current == SCREEN_ENDING))? RedrawBlink(0.5) : false;    // NOTE: Blink schedules idle redraws, only sampled by blinking screens
+        screenView.paused = gamePaused;
+        screenView.bricksDestroyed = GetGameEventsCount(GAME_EVENT_BRICK_DESTROYED);
+        screenView.paddleHits = GetGameEventsCount(GAME_EVENT_BALL_HIT_PADDLE);
+        screenView.lifesLost = GetGameEventsCount(GAME_EVENT_LIFE_LOST);
+        screenView.DrawGameplay = DrawGameplayScaled;
+        
+        DrawBlocksScreen(GetScreenDrawBackend(SCREEN_DRAW_RAYLIB), screen.current, &screenAssets, screenView);
         
-        // LESSON 07: Sounds and music loading and playing
-        // NOTE: Music buffers must be refilled if consumed
-        UpdateMusicStream(music);
-        //----------------------------------------------------------------------------------
+        // NOTE: Screen captures flush render batch, its contents must be counted before
+        SampleFrameCounters();
         
-        // Draw
-        //----------------------------------------------------------------------------------
-        BeginDrawing();
+        // Screenshot: frame is copied and queued, encoded in background
+        if (IsKeyPressed(KEY_F10)) TakeScreenshotAsync(TextFormat("blocks_screenshot_%03i.png", screenshotsCounter++), OnScreenshotSaved, NULL);
         
-            ClearBackground(RAYWHITE);
+        // Clip recording: one out of two frames is captured, clip plays at 30 fps
+        // NOTE: Recording indicator is drawn after capture, it does not appear in the clip
+        if (IsClipRecording())
+        {
+            if ((clipFramesCounter++)%2 == 0) CaptureClipScreen();
             
-            switch(screen) 
+            DrawCircle(screenWidth - 20, 20, 8, RED);
+        }
+        
+        // Frame counters: CSV rows are tagged with screen and render backend
+        // NOTE: Counting ends before overlay drawing, overlay is not counted
+        SetFrameCountersTag(TextFormat("%s %s", GetScreenName(screen.current), renderBackends[renderBackend].name));
+        EndFrameCounters();
+        
+        if (showCounters)
+        {
+            DrawFrameCounters(screenWidth - 220, 40);
+            DrawText(TextFormat("render_scale: %.2f", scaler.scale), screenWidth - 210, 194, 10, DARKGRAY);
+            DrawText(TextFormat("cells visited: %u of %i", GetFrameCounter(COUNTER_CELLS_VISITED), GetGridCellsCount(view)), screenWidth - 210, 209, 10, DARKGRAY);
+            if (renderBackend == RENDER_BATCHED) DrawText(TextFormat("bricks vertices: %i -> %i merged", 4*meshBricksCount, 4*meshQuadsCount), screenWidth - 210, 224, 10, DARKGRAY);
+        }
+    
+        EndTraceSpan();
+        
+        // NOTE: Batch flush, buffers swap and inputs polling
+        BeginTraceSpan("EndDrawing", NULL);
+    
+    EndDrawing();
+    
+    EndTraceSpan();
+    
+    // Dynamic resolution: scale adapted to measured frame work, only while playing
+    if ((screen.current == SCREEN_GAMEPLAY) && !gamePaused) EndScalerFrame(&scaler);
+    //----------------------------------------------------------------------------------
+}
+
+// Simulation step, called by simulation thread at fixed rate while playing
+// NOTE: Only game state is touched here, main thread reacts to returned events
+static unsigned int StepBlocksGame(void *state, SimInput input, void *userData)
+{
+    (void)userData;
+    
+    RecordReplayStep(&replay, state, input);    // NOTE: State before step, replays run this same step
+    
+    BlocksGame *blocks = (BlocksGame *)state;
+    
+    BlocksInput blocksInput = { 0 };
+    blocksInput.left = (input.down & BUTTON_LEFT) != 0;
+    blocksInput.right = (input.down & BUTTON_RIGHT) != 0;
+    blocksInput.launch = (input.pressed & BUTTON_LAUNCH) != 0;
+    
+    unsigned int events = UpdateBlocksGame(blocks, blocksInput);
+    
+    // Step outcomes queued as gameplay events, main thread plays sounds and spawns particles
+    if (events & BLOCKS_EVENT_PADDLE_HIT) PushGameEvent(GAME_EVENT_BALL_HIT_PADDLE, blocks->ball.position, 0);
+    
+    for (int i = 0; i < blocks->hitBricksCount; i++)
+    {
+        // NOTE: Endless mode destroyed bricks are field cells, board mode ones board cells, classic mode ones bricks lines entries
+        Rectangle bounds = { 0 };
+        if (blocks->mode == BLOCKS_MODE_ENDLESS) bounds = GetBrickFieldCellRec(&blocks->field, blocks->hitBricks[i]);
+        else if (blocks->mode == BLOCKS_MODE_BOARD) bounds = GetBrickBoardCellRec(&blocks->board, blocks->hitBricks[i]);
+        else bounds = blocks->bricks[blocks->hitBricks[i]/BRICKS_PER_LINE][blocks->hitBricks[i]%BRICKS_PER_LINE].bounds;
+        
+        PushGameEvent(GAME_EVENT_BRICK_DESTROYED, (Vector2){ bounds.x + bounds.width/2, bounds.y + bounds.height/2 }, blocks->hitBricks[i]);
+    }
+    
+    if (events & BLOCKS_EVENT_ROW_LANDED) PushGameEvent(GAME_EVENT_LIFE_LOST, blocks->player.position, (events & BLOCKS_EVENT_GAME_OVER)? 0 : blocks->player.lifes);
+    if (events & BLOCKS_EVENT_BALL_LOST) PushGameEvent(GAME_EVENT_LIFE_LOST, blocks->ball.position, (events & BLOCKS_EVENT_GAME_OVER)? 0 : blocks->player.lifes);
+    if (events & BLOCKS_EVENT_GAME_OVER) PushGameEvent(GAME_EVENT_GAME_OVER, blocks->ball.position, 0);
+    
+    return events;
+}
+
+// Spawn particles burst
+// NOTE: Particles are spread evenly around position, inactive ones are reused
+static void SpawnParticles(Vector2 position, Color color, int count)
+{
+    for (int i = 0, spawned = 0; (i < MAX_PARTICLES) && (spawned < count); i++)
+    {
+        if (particles[i].life > 0.0f) continue;
+        
+        float angle = (float)spawned/count*2.0f*PI;
+        
+        particles[i].position = position;
+        particles[i].speed = (Vector2){ cosf(angle)*3.0f, sinf(angle)*3.0f };
+        particles[i].life = 30.0f;
+        particles[i].color = color;
+        spawned++;
+    }
+}
+
+// Move particles, fade them out
+static void UpdateParticles(void)
+{
+    for (int i = 0; i < MAX_PARTICLES; i++)
+    {
+        if (particles[i].life <= 0.0f) continue;
+        
+        particles[i].position.x += particles[i].speed.x;
+        particles[i].position.y += particles[i].speed.y;
+        particles[i].speed.y += 0.2f;       // Gravity
+        particles[i].life -= 1.0f;
+    }
+}
+
+// Draw active particles
+static void DrawParticles(void)
+{
+    for (int i = 0; i < MAX_PARTICLES; i++)
+    {
+        if (particles[i].life > 0.0f) DrawRectangleV(particles[i].position, (Vector2){ 4, 4 }, Fade(particles[i].color, particles[i].life/30.0f));
+    }
+}
+
+// Draw GAMEPLAY world with current render backend, at current resolution scale
+// NOTE: Render target drawing flushes render batch, frame counters must be sampled before
+static void DrawGameplayScaled(const BlocksGame *blocks)
+{
+    BeginScaledMode(&scaler);
+    
+        BeginMode2D(camera.camera);
+        
+            // Bricks grid cells on screen, only those are visited by render backends
+            // NOTE: Classic bricks lines are only used by classic mode, other modes draw their own grid
+            if (blocks->mode == BLOCKS_MODE_CLASSIC) visibleBricks = GetGridRangeRec(GetCameraViewRec(camera), (Vector2){ 0, BRICKS_POSITION_Y }, blocks->bricks[0][0].size, BRICKS_PER_LINE, BRICKS_LINES);
+            else visibleBricks = (GridRange){ 0, -1, 0, -1 };
+            
+            BeginTraceSpan("DrawGameplay", renderBackends[renderBackend].name);
+            meshBricksCount = 0;
+            meshQuadsCount = 0;
+            cellsVisited = 0;
+            
+            renderBackends[renderBackend].DrawGameplay(blocks->player, blocks->ball, blocks->bricks, (GameplayTextures){ texPaddle, texBall, texBrick, texBrickAtlas });
+            if ((blocks->mode == BLOCKS_MODE_ENDLESS) && (renderBackend != RENDER_NULL)) DrawBrickFieldRows(&blocks->field, (GameplayTextures){ texPaddle, texBall, texBrick, texBrickAtlas });
+            if ((blocks->mode == BLOCKS_MODE_BOARD) && (renderBackend != RENDER_NULL)) DrawBrickBoardCells(&blocks->board, (GameplayTextures){ texPaddle, texBall, texBrick, texBrickAtlas });
+            EndTraceSpan();
+            
+            AddFrameCounter(COUNTER_CELLS_VISITED, cellsVisited);
+            
+            if (renderBackend != RENDER_NULL) DrawParticles();
+        
+        EndMode2D();
+        
+        SampleFrameCounters();
+    
+    EndScaledMode();
+    
+    DrawScaledTarget(scaler);   // Upscaled to native resolution
+}
+
+// LESSON 02: Draw basic shapes (circle, rectangle)
+static void DrawGameplayShapes(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures)
+{
+    (void)textures;
+    
+    DrawRectangle(player.position.x, player.position.y, player.size.x, player.size.y, BLACK);   // Draw player bar
+    DrawCircleV(ball.position, ball.radius, MAROON);    // Draw ball
+    
+    // Draw bricks
+    for (int j = visibleBricks.firstRow; j <= visibleBricks.lastRow; j++)
+    {
+        for (int i = visibleBricks.firstColumn; i <= visibleBricks.lastColumn; i++)
+        {
+            cellsVisited++;
+            
+            if (bricks[j][i].active)
             {
-                case LOGO: 
-                {
-                    // Draw LOGO screen here!
-                    
-                    // LESSON 05: Textures loading and drawing
-                    DrawTexture(texLogo, screenWidth/2 - texLogo.width/2, screenHeight/2 - texLogo.height/2, WHITE);
-                    
-                } break;
-                case TITLE: 
-                {
-                    // Draw TITLE screen here!
-                    
-                    // LESSON 06: Fonts loading and text drawing
-                    DrawTextEx(font, "BLOCKS", (Vector2){ 100, 80 }, 160, 10, MAROON);   // Draw Title
-
-                    if ((framesCounter/30)%2 == 0) DrawText("PRESS [ENTER] to START", GetScreenWidth()/2 - MeasureText("PRESS [ENTER] to START", 20)/2, GetScreenHeight()/2 + 60, 20, DARKGRAY);
-                    
-                } break;
-                case GAMEPLAY:
-                { 
-                    // Draw GAMEPLAY screen here!
-                    
-                    #define LESSON05_TEXTURES         // Alternative: LESSON02_SHAPES
-                    #if defined(LESSON02_SHAPES)
-                        // LESSON 02: Draw basic shapes (circle, rectangle)
-                        DrawRectangle(player.position.x, player.position.y, player.size.x, player.size.y, BLACK);   // Draw player bar
-                        DrawCircleV(ball.position, ball.radius, MAROON);    // Draw ball
-                        
-                        // Draw bricks
-                        for (int j = 0; j < BRICKS_LINES; j++)
-                        {
-                            for (int i = 0; i < BRICKS_PER_LINE; i++)
-                            {
-                                if (bricks[j][i].active)
-                                {
-                                    if ((i + j)%2 == 0) DrawRectangle(bricks[j][i].position.x, bricks[j][i].position.y, bricks[j][i].size.x, bricks[j][i].size.y, GRAY);
-                                    else DrawRectangle(bricks[j][i].position.x, bricks[j][i].position.y, bricks[j][i].size.x, bricks[j][i].size.y, DARKGRAY);
-                                }
-                            }
-                        }
-                    #elif defined(LESSON05_TEXTURES)
-                        // LESSON 05: Textures loading and drawing
-                        DrawTextureEx(texPaddle, player.position, 0.0f, 1.0f, WHITE);   // Draw player
-                        
-                        DrawTexture(texBall, ball.position.x - ball.radius/2, ball.position.y - ball.radius/2, MAROON);    // Draw ball
-                    
-                        // Draw bricks
-                        for (int j = 0; j < BRICKS_LINES; j++)
-                        {
-                            for (int i = 0; i < BRICKS_PER_LINE; i++)
-                            {
-                                if (bricks[j][i].active)
-                                {
-                                    // NOTE: Texture is not scaled, just using original size
-                                    
-                                    if ((i + j)%2 == 0) DrawTextureEx(texBrick, bricks[j][i].position, 0.0f, 1.0f, GRAY);
-                                    else DrawTextureEx(texBrick, bricks[j][i].position, 0.0f, 1.0f, DARKGRAY);
-                                }
-                            }
-                        }
-                    #endif
-                    
-                    // Draw GUI: player lives
-                    for (int i = 0; i < player.lifes; i++) DrawRectangle(20 + 40*i, screenHeight - 30, 35, 10, LIGHTGRAY);
-
-                    // Draw pause message when required
-                    if (gamePaused) DrawText("GAME PAUSED", screenWidth/2 - MeasureText("GAME PAUSED", 40)/2, screenHeight/2 + 60, 40, GRAY);
-                    
-                } break;
-                case ENDING: 
+                if ((i + j)%2 == 0) DrawRectangle(bricks[j][i].position.x, bricks[j][i].position.y, bricks[j][i].size.x, bricks[j][i].size.y, GRAY);
+                else DrawRectangle(bricks[j][i].position.x, bricks[j][i].position.y, bricks[j][i].size.x, bricks[j][i].size.y, DARKGRAY);
+            }
+        }
+    }
+}
+
+// LESSON 05: Textures loading and drawing
+// NOTE: Drawn by screens drawing code shared with golden frames tool, textures from screens resources
+static void DrawGameplayTextures(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures)
+{
+    (void)textures;
+    
+    cellsVisited += DrawBlocksGameplay(GetScreenDrawBackend(SCREEN_DRAW_RAYLIB), &screenAssets, player, ball, bricks, visibleBricks);
+}
+
+// Same output as textures backend but bricks quads are pushed directly to the
+// render batch with a single texture bind, skipping per-brick DrawTextureEx() overhead
+static void DrawGameplayBatched(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures)
+{
+    DrawTextureEx(textures.paddle, player.position, 0.0f, 1.0f, WHITE);   // Draw player
+    
+    DrawTexture(textures.ball, ball.position.x - ball.radius/2, ball.position.y - ball.radius/2, MAROON);    // Draw ball
+
+    // Bricks lines meshed in bands, cells rebuilt and bands re-meshed only when a brick is destroyed
+    if (bricksCellsDirty)
+    {
+        for (int j = 0; j < BRICKS_LINES; j++)
+        {
+            for (int i = 0; i < BRICKS_PER_LINE; i++) bricksCells[j*BRICKS_PER_LINE + i] = bricks[j][i].active? 1 : 0;
+        }
+        
+        bricksCellsDirty = false;
+    }
+    
+    DrawBrickGridMeshes(bricksMeshes, bricksCells, BRICKS_LINES, BRICKS_PER_LINE, bricks[0][0].position, bricks[0][0].size, visibleBricks, textures.brickAtlas);
+}
+
+// Nothing is drawn, only frame clearing and GUI cost remains
+static void DrawGameplayNull(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures)
+{
+    // Nothing to draw
+    (void)player;
+    (void)ball;
+    (void)bricks;
+    (void)textures;
+}
+
+// Same output as textures backend but rasterized on CPU into a framebuffer,
+// uploaded and drawn as a single screen texture (check softrender.h)
+// NOTE: Camera and resolution scale are applied on CPU, positions transformed to scaled screen
+// and textures scaled by zoom, only scaled size pixels are rasterized and uploaded
+static void DrawGameplaySoftware(Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GameplayTextures textures)
+{
+    (void)textures;             // NOTE: CPU textures used instead (softBall, softPaddle, softBrick)
+    
+    // Framebuffer rows packed at current render size, native size buffer is reused
+    Vector2 size = GetScaledSize(scaler);
+    SoftFramebuffer target = { (int)size.x, (int)size.y, softTarget.pixels };
+    
+    // Camera scaled to render size: world to scaled screen in one transform
+    Camera2D softCamera = camera.camera;
+    float scale = size.x/screenWidth;
+    softCamera.offset = (Vector2){ softCamera.offset.x*scale, softCamera.offset.y*scale };
+    softCamera.zoom *= scale;
+    
+    BeginSoftDrawing(&target);
+    
+        SoftClearBackground(RAYWHITE);
+        
+        SoftDrawTextureEx(softPaddle, GetWorldToScreen2D(player.position, softCamera), 0.0f, softCamera.zoom, WHITE);   // Draw player
+        
+        SoftDrawTextureEx(softBall, GetWorldToScreen2D((Vector2){ ball.position.x - ball.radius/2, ball.position.y - ball.radius/2 }, softCamera), 0.0f, softCamera.zoom, MAROON);    // Draw ball
+
+        // Draw bricks
+        for (int j = visibleBricks.firstRow; j <= visibleBricks.lastRow; j++)
+        {
+            for (int i = visibleBricks.firstColumn; i <= visibleBricks.lastColumn; i++)
+            {
+                cellsVisited++;
+                
+                if (bricks[j][i].active)
                 {
-                    // Draw END screen here!
-                    
-                    // LESSON 06: Fonts loading and text drawing
-                    // Draw ending message
-                    DrawTextEx(font, "GAME FINISHED", (Vector2){ 80, 100 }, 80, 6, MAROON);
-
-                    if ((framesCounter/30)%2 == 0) DrawText("PRESS [ENTER] TO PLAY AGAIN", GetScreenWidth()/2 - MeasureText("PRESS [ENTER] TO PLAY AGAIN", 20)/2, GetScreenHeight()/2 + 80, 20, GRAY);
-                    
-                } break;
-                default: break;
+                    if ((i + j)%2 == 0) SoftDrawTextureEx(softBrick, GetWorldToScreen2D(bricks[j][i].position, softCamera), 0.0f, softCamera.zoom, GRAY);
+                    else SoftDrawTextureEx(softBrick, GetWorldToScreen2D(bricks[j][i].position, softCamera), 0.0f, softCamera.zoom, DARKGRAY);
+                }
             }
+        }
+    
+    EndSoftDrawing();
+    
+    UpdateTextureRec(texSoftTarget, (Rectangle){ 0, 0, target.width, target.height }, target.pixels);
+    
+    // NOTE: Framebuffer covers the whole screen, it is drawn over camera visible area (current 2D mode),
+    // scaled mode maps it 1:1 to render target pixels
+    DrawTexturePro(texSoftTarget, (Rectangle){ 0, 0, target.width, target.height }, GetCameraViewRec(camera), (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+// Draw endless mode resident rows on screen
+// NOTE: Drawn over current backend output, shapes backend keeps shapes, other backends brick texture,
+// only rows and columns inside camera visible area are visited
+static void DrawBrickFieldRows(const BrickField *field, GameplayTextures textures)
+{
+    GridRange range = GetBrickFieldRangeRec(field, GetCameraViewRec(camera));
+    
+    // Batched backend: every resident chunk is a mesh band, only chunks with visible rows are drawn
+    if (renderBackend == RENDER_BATCHED)
+    {
+        for (int c = 0; c < field->resident; c++)
+        {
+            int slot = (field->head + c)%BRICK_FIELD_CHUNKS;
+            const BrickChunk *chunk = &field->chunks[slot];
+            
+            if ((chunk->firstRow > range.lastRow) || ((chunk->firstRow + BRICK_FIELD_CHUNK_ROWS - 1) < range.firstRow)) continue;
+            
+            // NOTE: Band rows go upwards (chunk rows order), cells state 2 for bricks requiring more hits
+            unsigned char cells[BRICK_FIELD_CHUNK_ROWS*BRICK_FIELD_COLUMNS] = { 0 };
+            for (int j = 0; j < BRICK_FIELD_CHUNK_ROWS; j++)
+            {
+                for (int i = 0; i < BRICK_FIELD_COLUMNS; i++) cells[j*BRICK_FIELD_COLUMNS + i] = (chunk->rows[j].cells[i] > 1)? 2 : chunk->rows[j].cells[i];
+            }
+            
+            UpdateBrickMesh(&fieldMeshes[slot], cells, BRICK_FIELD_CHUNK_ROWS, BRICK_FIELD_COLUMNS, 0, 0);
+            cellsVisited += BRICK_FIELD_CHUNK_ROWS*BRICK_FIELD_COLUMNS;
+            
+            GridRange visible = range;
+            visible.firstRow -= chunk->firstRow;
+            visible.lastRow -= chunk->firstRow;
+            
+            DrawBrickMesh(&fieldMeshes[slot], (Vector2){ 0, GetBrickFieldRowY(field, chunk->firstRow) }, field->cellSize, chunk->firstRow, -1, visible, textures.brickAtlas);
+        }
         
-        EndDrawing();
-        //----------------------------------------------------------------------------------
+        return;
     }
+    
+    for (int j = range.firstRow; j <= range.lastRow; j++)
+    {
+        const BrickRow *row = GetBrickFieldRow(field, j);
+        float y = GetBrickFieldRowY(field, j);
+        
+        for (int i = range.firstColumn; i <= range.lastColumn; i++)
+        {
+            cellsVisited++;
+            
+            if (row->cells[i] == 0) continue;
+            
+            Color color = brickTints[((row->cells[i] > 1)? 2 : 0) + (i + row->index)%2];     // Bricks requiring more hits tinted red
+            
+            if (renderBackend == RENDER_SHAPES) DrawRectangle(i*field->cellSize.x, y, field->cellSize.x, field->cellSize.y, color);
+            else DrawTextureEx(textures.brick, (Vector2){ i*field->cellSize.x, y }, 0.0f, 1.0f, color);
+        }
+    }
+}
 
-    // De-Initialization
-    //--------------------------------------------------------------------------------------
+// Draw board mode cells on screen
+// NOTE: Drawn over current backend output like endless mode rows, only cells inside camera visible area
+// are visited, batched backend only converts and meshes bands touching it
+static void DrawBrickBoardCells(const BrickBoard *board, GameplayTextures textures)
+{
+    GridRange range = GetBrickBoardRangeRec(board, GetCameraViewRec(camera));
     
-    // NOTE: Unload any loaded resources (texture, fonts, audio)
+    if ((range.firstRow > range.lastRow) || (range.firstColumn > range.lastColumn)) return;
     
-    // LESSON 05: Textures loading and drawing
-    UnloadTexture(texBall);
-    UnloadTexture(texPaddle);
-    UnloadTexture(texBrick);
+    if (renderBackend == RENDER_BATCHED)
+    {
+        // NOTE: Cells state 2 for bricks requiring more hits, visible bands cells converted only
+        static unsigned char cells[BRICK_BOARD_MAX_ROWS*BRICK_BOARD_MAX_COLUMNS] = { 0 };
+        int firstRow = (range.firstRow/BRICK_MESH_MAX_ROWS)*BRICK_MESH_MAX_ROWS;
+        int lastRow = (range.lastRow/BRICK_MESH_MAX_ROWS + 1)*BRICK_MESH_MAX_ROWS - 1;
+        int firstColumn = (range.firstColumn/BRICK_MESH_MAX_COLUMNS)*BRICK_MESH_MAX_COLUMNS;
+        int lastColumn = (range.lastColumn/BRICK_MESH_MAX_COLUMNS + 1)*BRICK_MESH_MAX_COLUMNS - 1;
+        if (lastRow >= board->rows) lastRow = board->rows - 1;
+        if (lastColumn >= board->columns) lastColumn = board->columns - 1;
+        
+        for (int j = firstRow; j <= lastRow; j++)
+        {
+            for (int i = firstColumn; i <= lastColumn; i++)
+            {
+                int cell = j*board->columns + i;
+                cells[cell] = (board->cells[cell] > 1)? 2 : board->cells[cell];
+            }
+        }
+        
+        DrawBrickGridMeshes(boardMeshes, cells, board->rows, board->columns, board->origin, board->cellSize, range, textures.brickAtlas);
+        
+        return;
+    }
     
-    // LESSON 06: Fonts loading and text drawing
-    UnloadFont(font);
+    for (int j = range.firstRow; j <= range.lastRow; j++)
+    {
+        for (int i = range.firstColumn; i <= range.lastColumn; i++)
+        {
+            int cell = j*board->columns + i;
+            cellsVisited++;
+            
+            if (board->cells[cell] == 0) continue;
+            
+            Rectangle bounds = GetBrickBoardCellRec(board, cell);
+            Color color = brickTints[((board->cells[cell] > 1)? 2 : 0) + (i + j)%2];     // Bricks requiring more hits tinted red
+            
+            if (renderBackend == RENDER_SHAPES) DrawRectangleRec(bounds, color);
+            else DrawTextureEx(textures.brick, (Vector2){ bounds.x, bounds.y }, 0.0f, 1.0f, color);
+        }
+    }
+}
+
+// Mesh grid bands and draw visible ones
+// NOTE: Grid rows go down from position, meshes array must hold one mesh per band (BRICK_MESH_MAX_ROWS x
+// BRICK_MESH_MAX_COLUMNS cells), bands outside visible range are neither meshed nor drawn
+static void DrawBrickGridMeshes(BrickMesh *meshes, const unsigned char *cells, int rows, int columns, Vector2 position, Vector2 brickSize, GridRange visible, Texture2D atlas)
+{
+    int bandColumns = (columns + BRICK_MESH_MAX_COLUMNS - 1)/BRICK_MESH_MAX_COLUMNS;
     
-    // LESSON 07: Sounds and music loading and playing
-    UnloadSound(fxStart);
-    UnloadSound(fxBounce);
-    UnloadSound(fxExplode);
+    for (int j = 0; j < rows; j += BRICK_MESH_MAX_ROWS)
+    {
+        if (((j + BRICK_MESH_MAX_ROWS - 1) < visible.firstRow) || (j > visible.lastRow)) continue;
+        
+        for (int i = 0; i < columns; i += BRICK_MESH_MAX_COLUMNS)
+        {
+            if (((i + BRICK_MESH_MAX_COLUMNS - 1) < visible.firstColumn) || (i > visible.lastColumn)) continue;
+            
+            BrickMesh *mesh = &meshes[(j/BRICK_MESH_MAX_ROWS)*bandColumns + i/BRICK_MESH_MAX_COLUMNS];
+            
+            UpdateBrickMesh(mesh, cells, rows, columns, j, i);
+            cellsVisited += mesh->rows*mesh->columns;
+            
+            DrawBrickMesh(mesh, position, brickSize, 0, 1, visible, atlas);
+        }
+    }
+}
+
+// Draw merged bricks quads from atlas
+// NOTE: position is grid first cell top-left, rowStep is screen direction of grid rows (1: down, -1: up),
+// baseRow is added to grid rows for atlas tints parity, quads outside visible grid rows and columns
+// are skipped, all quads are pushed to render batch with a single texture bind
+static void DrawBrickMesh(const BrickMesh *mesh, Vector2 position, Vector2 brickSize, int baseRow, int rowStep, GridRange visible, Texture2D atlas)
+{
+    if ((visible.firstRow > visible.lastRow) || (visible.firstColumn > visible.lastColumn)) return;
     
-    UnloadMusicStream(music);   // Unload music streaming buffers
+    // Atlas cells keep brick texture size, quads are drawn with bricks size
+    Vector2 atlasBrickSize = { (float)texBrick.width, (float)texBrick.height };
     
-    CloseAudioDevice();         // Close audio device connection
+    // NOTE: Make sure all quads fit in current batch, avoiding a flush in the middle
+    rlCheckRenderBatchLimit(4*mesh->quadsCount);
     
-    CloseWindow();              // Close window and OpenGL context
-    //--------------------------------------------------------------------------------------
+    rlSetTexture(atlas.id);
+    rlBegin(RL_QUADS);
     
-    return 0;
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlColor4ub(255, 255, 255, 255);
+        
+        for (int q = 0; q < mesh->quadsCount; q++)
+        {
+            BrickQuad quad = mesh->quads[q];
+            int row = mesh->firstRow + quad.row;
+            int column = mesh->firstColumn + quad.column;
+            
+            if ((column > visible.lastColumn) || ((column + quad.width - 1) < visible.firstColumn) ||
+                (row > visible.lastRow) || ((row + quad.height - 1) < visible.firstRow)) continue;
+            
+            // Grid row drawn at quad top: first one going down, last one going up
+            int top = (rowStep > 0)? row : row + quad.height - 1;
+            Rectangle source = GetBrickAtlasSourceRec(quad, baseRow + top, column, atlasBrickSize);
+            
+            float x = position.x + column*brickSize.x;
+            float y = position.y + rowStep*top*brickSize.y;
+            float width = quad.width*brickSize.x;
+            float height = quad.height*brickSize.y;
+            float u0 = source.x/atlas.width, u1 = (source.x + source.width)/atlas.width;
+            float v0 = source.y/atlas.height, v1 = (source.y + source.height)/atlas.height;
+            
+            rlTexCoord2f(u0, v0); rlVertex2f(x, y);
+            rlTexCoord2f(u0, v1); rlVertex2f(x, y + height);
+            rlTexCoord2f(u1, v1); rlVertex2f(x + width, y + height);
+            rlTexCoord2f(u1, v0); rlVertex2f(x + width, y);
+            
+            meshBricksCount += quad.width*quad.height;
+            meshQuadsCount++;
+        }
+        
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// Get bricks grid cells in current mode (visited cells reference)
+// NOTE: Culled drawing visits about the same cells on any board size, only the visible ones
+static int GetGridCellsCount(const BlocksGame *blocks)
+{
+    if (blocks->mode == BLOCKS_MODE_BOARD) return blocks->board.rows*blocks->board.columns;
+    else if (blocks->mode == BLOCKS_MODE_ENDLESS) return blocks->field.resident*BRICK_FIELD_CHUNK_ROWS*BRICK_FIELD_COLUMNS;
+    
+    return BRICKS_LINES*BRICKS_PER_LINE;
+}
+
+// Screenshot written callback, called by UpdateScreenshots()
+static void OnScreenshotSaved(const char *fileName, bool success, void *userData)
+{
+    if (success) TraceLog(LOG_INFO, "GAME: Screenshot saved: %s", fileName);
+    else TraceLog(LOG_WARNING, "GAME: Screenshot could not be saved: %s", fileName);
 }
@@ -3,10 +3,26 @@
 *   raylib pong
 *
 *   COMPILATION (Windows - MinGW):
-*       gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lopengl32 -lgdi32 -lwinmm -Wall -std=c99
+*       gcc -o $(NAME_PART).exe $(FILE_NAME) -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lopengl32 -lgdi32 -lwinmm -Wall -std=c99
 *
 *   COMPILATION (Linux - GCC):
-*       gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*       gcc -o $(NAME_PART).exe $(FILE_NAME) -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   COMPILATION (Web - emscripten):
+*     emcc -o pong.html pong.c -s USE_GLFW=3 -s TOTAL_MEMORY=67108864
+*          --preload-file resources/logo_raylib.png --preload-file resources/pixantiqua.ttf
+*          --preload-file resources/start.wav --preload-file resources/pong.wav
+*          -I../src -L../lessons/build/PLATFORM_WEB -lgamecore -I../../raylib/src -L../../raylib/src -lraylib -DPLATFORM_WEB
+*
+*   NOTE: Game core library (libgamecore) is built by lessons/Makefile (make core)
+*   NOTE: On web only LOGO/TITLE screens resources are preloaded, music is fetched in background
+*   from resources/ directory next to pong.html (check src/assets.h)
+*   NOTE: Enemy is controlled by MLP policy if resources/enemy_policy.mlp is available (check
+*   src/enemy_policy.h), [E] switches between MLP policy and scripted chase
+*   NOTE: Game state is published every frame for local spectators (shared memory region
+*   "raylib_pong", check src/spectator_shm.h), tools/spectator renders it in other windows
+*   NOTE: Gameplay session is recorded into pong_session.rpl (desktop only, check src/replay.h),
+*   tools/replay_player plays it back with seeking and fast-forward
 *
 *   Example licensed under an unmodified zlib/libpng license, which is an OSI-certified,
 *   BSD-like license that allows static linking with closed source software
@@ -17,7 +33,84 @@
 
 #include "raylib.h"
 
-typedef enum { SCREEN_LOGO = 0, SCREEN_TITLE, SCREEN_GAMEPLAY, SCREEN_ENDING } GameScreen;
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#endif
+#include <stddef.h>         // Required for: NULL
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"       // Game simulation: PongGame, UpdatePongGame()...
+#include "screens.h"        // Screens management: GameScreen, ChangeScreen()
+#include "game_audio.h"     // Sounds and music: LoadGameSound(), PlayGameSound()...
+#include "pacing.h"         // Frame pacing controller: InitFramePacer(), BeginFramePacing()...
+#include "assets.h"         // Streaming assets loading: LoadAssetAsync(), IsAssetReady()...
+#include "clip_recorder.h"  // Clips recording: StartClipRecording(), CaptureClipScreen()...
+#include "screenshots.h"    // Non-blocking screenshots: TakeScreenshotAsync(), UpdateScreenshots()...
+#include "frame_counters.h" // Frame counters: BeginFrameCounters(), DrawFrameCounters()...
+#include "trace_events.h"   // Timeline tracing: BeginTraceSpan(), EndTraceSpan(), SaveTraceEvents()...
+#include "redraw.h"         // Idle-aware redraw: SetIdleRedraw(), ShouldRedraw(), RedrawBlink()...
+#include "resolution_scaler.h"  // Dynamic resolution: BeginScaledMode(), DrawScaledTarget()...
+#include "sim_thread.h"     // Simulation thread: StartSimThread(), SetSimInput(), AcquireSimState()...
+#include "game_events.h"    // Gameplay events queue: PushGameEvent(), PollGameEvent()...
+#include "enemy_policy.h"   // Enemy policies: LoadEnemyPolicy(), ApplyEnemyPolicy()...
+#include "spectator_shm.h"  // Spectators fan-out: CreateSpectatorHost(), PublishSpectatorFrame()...
+#include "replay.h"         // Session replays: StartReplayRecording(), RecordReplayStep()...
+#include "screen_draw.h"    // Screens drawing shared with tools: DrawPongScreen(), DrawPongGameplay()...
+
+// Simulation buttons, inputs are sampled on main thread and handed to simulation thread as bitmasks
+typedef enum {
+    BUTTON_UP               = 0x01,
+    BUTTON_DOWN             = 0x02,
+    BUTTON_VISION_INCREASE  = 0x04,
+    BUTTON_VISION_DECREASE  = 0x08,
+    BUTTON_ENEMY_POLICY     = 0x10      // Held while enemy is controlled by MLP policy
+} GameButton;
+
+static void UpdateDrawFrame(void);
+static void DrawGameplayScaled(const PongGame *pong);
+static unsigned int StepPongGame(void *state, SimInput input, void *userData);
+static void OnScreenshotSaved(const char *fileName, bool success, void *userData);
+
+// Global variables
+static const int screenWidth = 800;
+static const int screenHeight = 600;
+
+static bool pause = false;
+static bool finishGame = false;
+static ScreenState screen = { SCREEN_LOGO, 0 };    // Current screen and frames counter
+static int clipFramesCounter = 0;                   // Frames drawn while recording clip
+static int screenshotsCounter = 0;                  // Screenshots taken, used for file names
+static bool showCounters = false;                   // Frame counters overlay toggle
+
+// Ball, player and enemy
+// NOTE: Game state is updated by simulation thread, main thread draws latest published snapshot
+static PongGame game = { 0 };
+static SimThread sim = { 0 };
+static const PongGame *view = NULL;
+static unsigned int viewCollisionTests = 0;         // Snapshot collision tests count, frame counters get differences
+
+// Spectators: latest snapshot published every frame, viewers count does not change host cost
+static SpectatorHost spectators = { 0 };
+
+// Session replay: simulation inputs and keyframes, written by simulation thread steps
+static ReplayRecorder replay = { 0 };
+
+// Enemy controller: MLP policy (read-only once loaded, evaluated by simulation thread) or scripted chase
+static EnemyPolicy enemyPolicy = { 0 };
+static bool useEnemyPolicy = false;
+
+static float alphaLogo = 0.0f;
+static int logoState = 0;          // 0-FadeIn, 1-Wait, 2-FadeOut
+
+// Resources
+static Texture2D texLogo = { 0 };
+static Font fntTitle = { 0 };
+static PongScreenAssets screenAssets = { 0 };      // Screens drawing resources (check screen_draw.h)
+static int fxStart = -1;
+static int fxPong = -1;
+
+// Dynamic resolution: gameplay render target, scale adapted to frame time
+static ResolutionScaler scaler = { 0 };
 
 //------------------------------------------------------------------------------------
 // Program main entry point
@@ -26,254 +119,373 @@ int main(void)
 {
     // Initialization
     //--------------------------------------------------------------------------------------
-    const int screenWidth = 800;
-    const int screenHeight = 600;
+    // Timeline tracing: startup loading and frame phases, saved on exit and with key [F8]
+    InitTraceEvents("pong_trace.json");
 
     //SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_UNDECORATED);
+    BeginTraceSpan("InitWindow", NULL);
     InitWindow(screenWidth, screenHeight, "raylib [core] example - basic window");
-    
-    InitAudioDevice();
-    
-    // Ball
-    Vector2 ballPosition = { screenWidth/2, screenHeight/2 };
-    float ballRadius = 20.0f;
-    int ballSpeedX = 6;
-    int ballSpeedY = -4;
-    
-    // Player
-    Rectangle player = { 10, screenHeight/2 - 50, 25, 100 };
-    float playerSpeed = 8.0f;
-    int playerScore = 0;
-
-    // Enemy
-    Rectangle enemy = { screenWidth - 10 - 25, screenHeight/2 - 50, 25, 100 };
-    float enemySpeed = 3.0f;
-    int enemyVisionRange = screenWidth/2;
-    int enemyScore = 0;
-    
+    EndTraceSpan();
+
+    InitGameAudio();
+
+    InitPongGame(&game, screenWidth, screenHeight);
+
+    // Gameplay events are raised by simulation and screen changes, game reacts to them once per frame
+    InitGameEvents();
+
+    // Enemy MLP policy, scripted chase if weights are not available
+    enemyPolicy = LoadEnemyPolicy("resources/enemy_policy.mlp");
+    useEnemyPolicy = (enemyPolicy.type == ENEMY_POLICY_MLP);
+
+    // Session replay, recording starts before simulation steps run
+    SimThreadConfig simConfig = GetSimThreadConfigDefault();
+#if !defined(PLATFORM_WEB)
+    replay = StartReplayRecording("pong_session.rpl", REPLAY_GAME_PONG, sizeof(PongGame), simConfig.stepRate);
+#endif
+
+    // Simulation runs at fixed rate on its own thread while playing, overlapping with drawing
+    StartSimThread(&sim, &game, sizeof(PongGame), StepPongGame, &enemyPolicy, simConfig);
+    view = (const PongGame *)AcquireSimState(&sim, NULL);
+
+    // Local spectators: shared memory region, viewer processes attach read-only
+    spectators = CreateSpectatorHost("raylib_pong", SPECTATOR_GAME_PONG, sizeof(PongGame));
+
+    // Screenshots are encoded in background, [F10] takes one
+    InitScreenshots(screenWidth, screenHeight);
+
+    // Frame counters: [F6] shows overlay, [F7] starts/stops CSV export
+    InitFrameCounters();
+
+    // Dynamic resolution: gameplay is drawn at a lower resolution when frames get too heavy
+    // NOTE: Point filtering keeps shapes edges sharp when upscaled
+    ResolutionScalerConfig scalerConfig = GetResolutionScalerConfigDefault();
+    scalerConfig.filter = TEXTURE_FILTER_POINT;
+    scaler = LoadResolutionScaler(screenWidth, screenHeight, scalerConfig);
+
     // Resources loading
-    Texture2D texLogo = LoadTexture("resources/logo_raylib.png");
-    float alphaLogo = 0.0f;
-    int logoState = 0;          // 0-FadeIn, 1-Wait, 2-FadeOut 
-    
+    BeginTraceSpan("LoadTexture", "resources/logo_raylib.png");
+    texLogo = LoadTexture("resources/logo_raylib.png");
+    EndTraceSpan();
+
     //Image imLogo = LoadImage("resources/logo_raylib.png");
     //Texture2D texLogo = LoadTextureFromImage(imLogo);
     //UnloadImage(imLogo);
-    
+
     //Font fntTitle = LoadFont("resources/pixantiqua.ttf");     // Font size: 32px default
-    Font fntTitle = LoadFontEx("resources/pixantiqua.ttf", 12, 0, 0); // Font size: pixel-perfect
+    BeginTraceSpan("LoadFont", "resources/pixantiqua.ttf");
+    fntTitle = LoadFontEx("resources/pixantiqua.ttf", 12, 0, 0); // Font size: pixel-perfect
+    EndTraceSpan();
     SetTextureFilter(fntTitle.texture, TEXTURE_FILTER_POINT);
-    
-    Sound fxStart = LoadSound("resources/start.wav");
-    Sound fxPong = LoadSound("resources/pong.wav");
-    
-    Music ambient = LoadMusicStream("resources/qt-plimp.xm");
-    PlayMusicStream(ambient);
-    
-    // General variables
-    bool pause = false;
-    bool finishGame = false;
-    int framesCounter = 0;
-    GameScreen currentScreen = SCREEN_LOGO; // 0-LOGO, 1-TITLE, 2-GAMEPLAY, 3-ENDING
-
-    SetTargetFPS(60);           // Set our game to run at 60 frames-per-second
+
+    screenAssets.logo = (ScreenTexture){ &texLogo, texLogo.width, texLogo.height };
+    screenAssets.titleFont = (ScreenFont){ &fntTitle, fntTitle.baseSize };
+
+    fxStart = LoadGameSound("resources/start.wav");
+    fxPong = LoadGameSound("resources/pong.wav");
+
+    // NOTE: On web, music is fetched in background, game runs silent until ready
+    InitAssets("");
+    PlayGameMusic(LoadAssetAsync("resources/qt-plimp.xm", ASSET_MUSIC));
+
+#if defined(PLATFORM_WEB)
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
+#else
+    // Set our game to run at 60 frames-per-second, check pacing.h for available options
+    FramePacer pacer = InitFramePacer(GetFramePacerConfigDefault());
     //--------------------------------------------------------------------------------------
 
     // Main game loop
     while (!WindowShouldClose() && !finishGame)    // Detect window close button or ESC key
     {
-        // Update
-        //----------------------------------------------------------------------------------
-        UpdateMusicStream(ambient);
-        
-        switch (currentScreen)
+        BeginFramePacing(&pacer);   // Wait for next frame slot and sample inputs
+
+        UpdateDrawFrame();
+
+        // NOTE: Idle frames are not drawn, nothing to present
+        if (IsRedrawSkipped()) SkipFramePacing(&pacer);
+        else EndFramePacing(&pacer);    // Present frame and measure timings
+    }
+#endif
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    UnloadTexture(texLogo);
+    UnloadFont(fntTitle);
+    UnloadResolutionScaler(scaler);
+
+    UnloadAssets();         // Unload music stream
+
+    CloseGameAudio();       // Unload sounds and close audio device
+
+    StopSimThread(&sim);    // Stop simulation thread, unload snapshots
+    CloseSpectatorHost(&spectators);    // Viewers see region closed
+    StopReplayRecording(&replay);       // Write replay index footer
+
+    StopClipRecording();    // Finish clip encoding if still recording
+    CloseScreenshots();     // Finish pending screenshots encoding
+    CloseFrameCounters();   // Close CSV file and unload counting render batch
+    CloseRedraw();          // Stop idle redraw timer
+
+    CloseWindow();        // Close window and OpenGL context
+
+    CloseTraceEvents();     // Save trace file (worker threads already finished)
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+// Update and draw one frame
+// NOTE: Called once per frame by main game loop or, on web, by emscripten_set_main_loop()
+static void UpdateDrawFrame(void)
+{
+    // Update
+    //----------------------------------------------------------------------------------
+    BeginTraceSpan("Update", GetScreenName(screen.current));
+    BeginFrameCounters();
+    BeginScalerFrame(&scaler);
+
+    UpdateAssets();
+    UpdateGameAudio();      // Start music once available and refill its buffers
+
+    // Clip recording: [F9] start/stop, GIF is encoded in background
+    if (IsKeyPressed(KEY_F9))
+    {
+        if (IsClipRecording()) StopClipRecording();
+        else StartClipRecording("pong_clip.gif", screenWidth, screenHeight, 30, CLIP_FORMAT_GIF);
+
+        clipFramesCounter = 0;
+    }
+
+    UpdateClipRecorder();
+    UpdateScreenshots();    // Notify screenshots written in background
+
+    // Frame counters: [F6] overlay, [F7] CSV export (one row per frame)
+    if (IsKeyPressed(KEY_F6)) showCounters = !showCounters;
+    if (IsKeyPressed(KEY_F7))
+    {
+        if (IsFrameCountersCSVActive()) StopFrameCountersCSV();
+        else StartFrameCountersCSV("pong_frames.csv");
+    }
+
+    // Timeline tracing: [F8] saves latest events, recording continues
+    if (IsKeyPressed(KEY_F8)) SaveTraceEvents();
+
+    switch (screen.current)
+    {
+        case SCREEN_LOGO:
         {
-            case SCREEN_LOGO:
+            if (logoState == 0)
             {
-                if (logoState == 0)
-                {
-                    alphaLogo +=  (1.0f/180);
-                    if (alphaLogo > 1.0f)
-                    {
-                        alphaLogo = 1.0f;
-                        logoState = 1;
-                    }
-                }
-                else if (logoState == 1)
-                {
-                    framesCounter++;
-                    if (framesCounter >= 200)
-                    {
-                        framesCounter = 0;
-                        logoState = 2;
-                    }
-                }
-                else if (logoState == 2)
+                alphaLogo +=  (1.0f/180);
+                if (alphaLogo > 1.0f)
                 {
-                    alphaLogo -=  (1.0f/180);
-                    if (alphaLogo < 0.0f)
-                    {
-                        alphaLogo = 0.0f;
-                        currentScreen = 1;
-                    }
+                    alphaLogo = 1.0f;
+                    logoState = 1;
                 }
-
-            } break;
-            case SCREEN_TITLE:
+            }
+            else if (logoState == 1)
             {
-                framesCounter++;
-                
-                // Update TITLE screen
-                if (IsKeyPressed(KEY_ENTER)) 
+                screen.framesCounter++;
+                if (screen.framesCounter >= 200)
                 {
-                    PlaySound(fxStart);
-                    currentScreen = 2;
+                    screen.framesCounter = 0;
+                    logoState = 2;
                 }
-            } break;
-            case SCREEN_GAMEPLAY:
+            }
+            else if (logoState == 2)
             {
-                // Update GAMEPLAY screen
-                if (!pause)
+                alphaLogo -=  (1.0f/180);
+                if (alphaLogo < 0.0f)
                 {
-                    // Ball movement logic
-                    ballPosition.x += ballSpeedX;
-                    ballPosition.y += ballSpeedY;
-                    
-                    if (((ballPosition.x + ballRadius) > screenWidth) || ((ballPosition.x - ballRadius) < 0)) 
-                    {
-                        PlaySound(fxPong);
-                        ballSpeedX *= -1;
-                    }
-                    
-                    if (((ballPosition.y + ballRadius) > screenHeight) || ((ballPosition.y - ballRadius) < 0)) 
-                    {
-                        PlaySound(fxPong);
-                        ballSpeedY *= -1;
-                    }
-                    
-                    if ((ballPosition.x - ballRadius) <= 0) enemyScore += 1000;
-                    else if ((ballPosition.x + ballRadius) > GetScreenWidth()) playerScore += 1000;
-                    
-                    // Player movement logic
-                    if (IsKeyDown(KEY_UP)) player.y -= playerSpeed;
-                    else if (IsKeyDown(KEY_DOWN)) player.y += playerSpeed;
-                    
-                    if (player.y <= 0) player.y = 0;
-                    else if ((player.y + player.height) >= screenHeight) player.y = screenHeight - player.height;
-                    
-                    if (CheckCollisionCircleRec(ballPosition, ballRadius, player)) 
-                    {
-                        PlaySound(fxPong);
-                        ballSpeedX *= -1;
-                    }
-                    
-                    // Enemy movement logic
-                    if (ballPosition.x > enemyVisionRange)
-                    {
-                        if (ballPosition.y > (enemy.y + enemy.height/2)) enemy.y += enemySpeed;
-                        else if (ballPosition.y < (enemy.y + enemy.height/2)) enemy.y -= enemySpeed;
-                    }
-                    
-                    if (CheckCollisionCircleRec(ballPosition, ballRadius, enemy)) 
-                    {
-                        PlaySound(fxPong);
-                        ballSpeedX *= -1;
-                    }
-                    
-                    if (IsKeyDown(KEY_RIGHT)) enemyVisionRange++;
-                    else if (IsKeyDown(KEY_LEFT)) enemyVisionRange--;
+                    alphaLogo = 0.0f;
+                    ChangeScreen(&screen, SCREEN_TITLE);
                 }
-                
-                if (IsKeyPressed(KEY_P)) pause = !pause;
-                
-                if (IsKeyPressed(KEY_ENTER)) currentScreen = 3;
-            } break;
-            case SCREEN_ENDING:
+            }
+
+        } break;
+        case SCREEN_TITLE:
+        {
+            screen.framesCounter++;
+
+            // Update TITLE screen
+            if (IsKeyPressed(KEY_ENTER))
             {
-                // Update ENDING screen
-                if (IsKeyPressed(KEY_ENTER)) 
-                {
-                    //currentScreen = 1;
-                    finishGame = true;
-                }
-            } break;
-            default: break;
-        }
-        //----------------------------------------------------------------------------------
+                PlayGameSound(fxStart);
+                ChangeScreen(&screen, SCREEN_GAMEPLAY);
+            }
+        } break;
+        case SCREEN_GAMEPLAY:
+        {
+            // Update GAMEPLAY screen
+            if (!pause)
+            {
+                // NOTE: Inputs are applied by simulation thread on its next steps
+                unsigned int down = 0;
+                if (IsKeyDown(KEY_UP)) down |= BUTTON_UP;
+                if (IsKeyDown(KEY_DOWN)) down |= BUTTON_DOWN;
+                if (IsKeyDown(KEY_RIGHT)) down |= BUTTON_VISION_INCREASE;
+                if (IsKeyDown(KEY_LEFT)) down |= BUTTON_VISION_DECREASE;
+                if (useEnemyPolicy) down |= BUTTON_ENEMY_POLICY;
+
+                SetSimInput(&sim, down, 0);
+            }
 
-        // Draw
-        //----------------------------------------------------------------------------------
-        BeginDrawing();
+            if (IsKeyPressed(KEY_P)) pause = !pause;
 
-            ClearBackground(RAYWHITE);
-            
-            switch (currentScreen)
+            if (IsKeyPressed(KEY_E) && (enemyPolicy.type == ENEMY_POLICY_MLP)) useEnemyPolicy = !useEnemyPolicy;
+
+            if (IsKeyPressed(KEY_ENTER)) ChangeScreen(&screen, SCREEN_ENDING);
+        } break;
+        case SCREEN_ENDING:
+        {
+            // Update ENDING screen
+            if (IsKeyPressed(KEY_ENTER))
             {
-                case SCREEN_LOGO:
-                {
-                    // Draw LOGO screen
-                    //DrawRectangle(0, 0, screenWidth, screenHeight, BLUE);
-                    //DrawText("SCREEN LOGO", 10, 10, 30, DARKBLUE);
-                    
-                    DrawTexture(texLogo, GetScreenWidth()/2 - texLogo.width/2, GetScreenHeight()/2 - texLogo.height/2 - 40, Fade(WHITE, alphaLogo));
-                } break;
-                case SCREEN_TITLE:
-                {
-                    // Draw TITLE screen
-                    //DrawRectangle(0, 0, screenWidth, screenHeight, GREEN);
-                    //DrawText("SCREEN TITLE", 10, 10, 30, DARKGREEN);
-                    
-                    DrawTextEx(fntTitle, "SUPER PONG", (Vector2){ 200, 100 }, fntTitle.baseSize*6, 4, LIME);
-                    
-                    if ((framesCounter/30)%2) DrawText("PRESS ENTER to START", 200, 300, 30, BLACK);
-                    
-                } break;
-                case SCREEN_GAMEPLAY:
-                {
-                    DrawCircleV(ballPosition, ballRadius, RED);
-
-                    DrawRectangleRec(player, BLUE);
-                    
-                    DrawRectangleRec(enemy, DARKGREEN);
-                    
-                    DrawLine(enemyVisionRange, 0, enemyVisionRange, screenHeight, GRAY);
-                    
-                    // Draw hud
-                    DrawText(TextFormat("%04i", playerScore), 100, 10, 30, BLUE);
-                    DrawText(TextFormat("%04i", enemyScore), screenWidth - 200, 10, 30, DARKGREEN);
-                    
-                    if (pause)
-                    {
-                        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(WHITE, 0.8f));
-                        DrawText("GAME PAUSED", 320, 200, 30, RED);
-                    }
-                } break;
-                case SCREEN_ENDING:
-                {
-                    // Draw ENDING screen
-                    DrawRectangle(0, 0, screenWidth, screenHeight, RED);
-                    DrawText("SCREEN ENDING", 10, 10, 30, MAROON);
-                } break;
-                default: break;
+                //ChangeScreen(&screen, SCREEN_TITLE);
+                finishGame = true;
             }
+        } break;
+        default: break;
+    }
+
+    // Ball, player and enemy movement and collisions logic, on simulation thread while playing
+    SetSimActive(&sim, (screen.current == SCREEN_GAMEPLAY) && !pause);
+
+    unsigned int simEvents = 0;
+    view = (const PongGame *)AcquireSimState(&sim, &simEvents);
+
+    // NOTE: Collision tests counted by simulation in game state, steps published since last frame
+    AddFrameCounter(COUNTER_COLLISION_TESTS, (view->collisionTests >= viewCollisionTests)? view->collisionTests - viewCollisionTests : view->collisionTests);
+    viewCollisionTests = view->collisionTests;
+
+    PublishSpectatorFrame(&spectators, view, simEvents);     // Changed state chunks only
 
-        EndDrawing();
-        //----------------------------------------------------------------------------------
+    // Gameplay events dispatch: audio and telemetry react outside simulation step
+    GameEvent event = { 0 };
+    while (PollGameEvent(&event))
+    {
+        TraceInstantEvent(GetGameEventName(event.type), NULL);
+
+        if ((event.type == GAME_EVENT_BALL_HIT_PADDLE) || (event.type == GAME_EVENT_BALL_BOUNCE)) PlayGameSound(fxPong);
     }
 
-    // De-Initialization
-    //--------------------------------------------------------------------------------------
-    UnloadTexture(texLogo);
-    UnloadFont(fntTitle);
-    
-    UnloadSound(fxStart);
-    UnloadSound(fxPong);
-    UnloadMusicStream(ambient);
-    
-    CloseAudioDevice();
+    EndTraceSpan();
 
-    CloseWindow();        // Close window and OpenGL context
-    //--------------------------------------------------------------------------------------
+    // Idle redraw: TITLE, ENDING and paused GAMEPLAY screens are drawn only on input or blink
+    // NOTE: Clips need every frame, idle mode is disabled while recording
+    SetIdleRedraw(((screen.current == SCREEN_TITLE) || (screen.current == SCREEN_ENDING) ||
+        ((screen.current == SCREEN_GAMEPLAY) && pause)) && !IsClipRecording());
 
-    return 0;
-}
\ No newline at end of file
+    if (!ShouldRedraw())
+    {
+        WaitRedrawEvents();     // Sleep until input, blink toggle or music refill
+        return;
+    }
+    //----------------------------------------------------------------------------------
+
+    // Draw
+    //----------------------------------------------------------------------------------
+    BeginTraceSpan("Draw", GetScreenName(screen.current));
+
+    BeginDrawing();
+
+        // Screens are drawn by code shared with golden frames tool, GAMEPLAY world at current resolution scale
+        PongScreenView screenView = { 0 };
+        screenView.game = view;
+        screenView.blink = (screen.current == SCREEN_TITLE)? RedrawBlink(0.5) : false;   // NOTE: Blink schedules idle redraws, only sampled by blinking screen
+        screenView.paused = pause;
+        screenView.logoAlpha = alphaLogo;
+        screenView.enemyPolicy = (enemyPolicy.type == ENEMY_POLICY_MLP)? (useEnemyPolicy? "mlp" : "chase") : NULL;
+        screenView.DrawGameplay = DrawGameplayScaled;
+
+        DrawPongScreen(GetScreenDrawBackend(SCREEN_DRAW_RAYLIB), screen.current, &screenAssets, screenView);
+
+        // NOTE: Screen captures flush render batch, its contents must be counted before
+        SampleFrameCounters();
+
+        // Screenshot: frame is copied and queued, encoded in background
+        if (IsKeyPressed(KEY_F10)) TakeScreenshotAsync(TextFormat("pong_screenshot_%03i.png", screenshotsCounter++), OnScreenshotSaved, NULL);
+
+        // Clip recording: one out of two frames is captured, clip plays at 30 fps
+        // NOTE: Recording indicator is drawn after capture, it does not appear in the clip
+        if (IsClipRecording())
+        {
+            if ((clipFramesCounter++)%2 == 0) CaptureClipScreen();
+
+            DrawCircle(screenWidth - 20, 20, 8, RED);
+        }
+
+        // Frame counters: overlay is drawn after counting, it is not counted
+        SetFrameCountersTag(GetScreenName(screen.current));
+        EndFrameCounters();
+
+        if (showCounters)
+        {
+            DrawFrameCounters(screenWidth - 220, 40);
+            DrawText(TextFormat("render_scale: %.2f", scaler.scale), screenWidth - 210, 194, 10, DARKGRAY);
+        }
+
+        EndTraceSpan();
+
+        // NOTE: Batch flush, buffers swap and inputs polling
+        BeginTraceSpan("EndDrawing", NULL);
+
+    EndDrawing();
+
+    EndTraceSpan();
+
+    // Dynamic resolution: scale adapted to measured frame work, only while playing
+    if ((screen.current == SCREEN_GAMEPLAY) && !pause) EndScalerFrame(&scaler);
+    //----------------------------------------------------------------------------------
+}
+
+// Draw ball and paddles at current resolution scale
+// NOTE: Render target drawing flushes render batch, frame counters must be sampled before
+static void DrawGameplayScaled(const PongGame *pong)
+{
+    BeginScaledMode(&scaler);
+
+        DrawPongGameplay(GetScreenDrawBackend(SCREEN_DRAW_RAYLIB), pong);
+
+        SampleFrameCounters();
+
+    EndScaledMode();
+
+    DrawScaledTarget(scaler);   // Upscaled to native resolution
+}
+
+// Simulation step, called by simulation thread at fixed rate while playing
+static unsigned int StepPongGame(void *state, SimInput input, void *userData)
+{
+    const EnemyPolicy *policy = (const EnemyPolicy *)userData;
+
+    RecordReplayStep(&replay, state, input);    // NOTE: State before step, replays run this same step
+
+    PongInput pongInput = { 0 };
+    pongInput.up = (input.down & BUTTON_UP) != 0;
+    pongInput.down = (input.down & BUTTON_DOWN) != 0;
+    pongInput.visionIncrease = (input.down & BUTTON_VISION_INCREASE) != 0;
+    pongInput.visionDecrease = (input.down & BUTTON_VISION_DECREASE) != 0;
+
+    PongGame *pong = (PongGame *)state;
+    if (input.down & BUTTON_ENEMY_POLICY) ApplyEnemyPolicy(policy, pong, &pongInput);
+
+    unsigned int events = UpdatePongGame(pong, pongInput);
+
+    // Step outcomes queued as gameplay events, main thread plays sounds
+    if (events & PONG_EVENT_PLAYER_HIT) PushGameEvent(GAME_EVENT_BALL_HIT_PADDLE, pong->ballPosition, 0);
+    if (events & PONG_EVENT_ENEMY_HIT) PushGameEvent(GAME_EVENT_BALL_HIT_PADDLE, pong->ballPosition, 1);
+    if ((events & PONG_EVENT_BOUNCE) && !(events & (PONG_EVENT_PLAYER_HIT | PONG_EVENT_ENEMY_HIT))) PushGameEvent(GAME_EVENT_BALL_BOUNCE, pong->ballPosition, 0);
+    if (events & PONG_EVENT_PLAYER_SCORE) PushGameEvent(GAME_EVENT_SCORE, pong->ballPosition, 0);
+    if (events & PONG_EVENT_ENEMY_SCORE) PushGameEvent(GAME_EVENT_SCORE, pong->ballPosition, 1);
+
+    return events;
+}
+
+// Screenshot written callback, called by UpdateScreenshots()
+static void OnScreenshotSaved(const char *fileName, bool success, void *userData)
+{
+    if (success) TraceLog(LOG_INFO, "GAME: Screenshot saved: %s", fileName);
+    else TraceLog(LOG_WARNING, "GAME: Screenshot could not be saved: %s", fileName);
+}
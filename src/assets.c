@@ -0,0 +1,330 @@
+/**********************************************************************************************
+*
+*   assets - Streaming assets loading for web and desktop
+*
+*   NOTE: Check assets.h for backends and usage details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "assets.h"
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan()
+
+#include <stdlib.h>             // Required for: getenv(), atof()
+#include <string.h>             // Required for: strncpy(), strstr()
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+    #include <sys/stat.h>       // Required for: mkdir()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAX_ASSET_PATH_LENGTH      256      // Maximum asset file name/url length
+#define FETCH_ID_BITS                8      // Asset id bits in fetch callback argument, generation above (MAX_ASSETS must fit)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Managed asset
+typedef struct Asset {
+    char fileName[MAX_ASSET_PATH_LENGTH];
+    AssetType type;
+    AssetState state;
+    double arrivalTime;         // Time file is available (desktop stub only)
+    bool stubFailing;           // File fetch fails on arrival (desktop stub only)
+
+    Texture2D texture;
+    Font font;
+    Sound sound;
+    Music music;
+} Asset;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static Asset assets[MAX_ASSETS] = { 0 };
+static int assetCount = 0;
+static unsigned int assetsGeneration = 0;   // Incremented by UnloadAssets(), asset ids are reused after it
+
+static char assetsBaseUrl[MAX_ASSET_PATH_LENGTH] = { 0 };
+#if !defined(PLATFORM_WEB)
+static double stubLatency = 0.0;        // Desktop file-serving stub: seconds before transfer starts
+static double stubBandwidth = 0.0;      // Desktop file-serving stub: bytes per second (0 - unlimited)
+static const char *stubFail = NULL;     // Desktop file-serving stub: failing files name part (NULL - none)
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void LoadAssetData(Asset *asset);    // Load fetched file into GPU/audio resource
+#if defined(PLATFORM_WEB)
+static int GetFetchAssetId(void *arg);      // Get asset id from fetch callback argument, -1 if fetch is from a previous generation
+static void OnAssetFetched(unsigned int handle, void *arg, const char *fileName);
+static void OnAssetFetchError(unsigned int handle, void *arg, int status);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize assets system
+void InitAssets(const char *baseUrl)
+{
+    assetCount = 0;
+    if (baseUrl != NULL) strncpy(assetsBaseUrl, baseUrl, MAX_ASSET_PATH_LENGTH - 1);
+
+#if !defined(PLATFORM_WEB)
+    const char *latency = getenv("ASSETS_STUB_LATENCY");
+    const char *bandwidth = getenv("ASSETS_STUB_BANDWIDTH");
+
+    if (latency != NULL) stubLatency = atof(latency);
+    if (bandwidth != NULL) stubBandwidth = atof(bandwidth);
+    stubFail = getenv("ASSETS_STUB_FAIL");
+    if ((stubFail != NULL) && (stubFail[0] == '\0')) stubFail = NULL;
+
+    if ((stubLatency > 0.0) || (stubBandwidth > 0.0) || (stubFail != NULL))
+    {
+        TraceLog(LOG_INFO, "ASSETS: File-serving stub enabled (latency: %.2f s, bandwidth: %.0f bytes/s, failing: %s)", stubLatency, stubBandwidth, (stubFail != NULL)? stubFail : "none");
+    }
+#endif
+}
+
+// Unload all loaded assets
+void UnloadAssets(void)
+{
+    for (int i = 0; i < assetCount; i++)
+    {
+        if (assets[i].state != ASSET_READY) continue;
+
+        switch (assets[i].type)
+        {
+            case ASSET_TEXTURE: UnloadTexture(assets[i].texture); break;
+            case ASSET_FONT: UnloadFont(assets[i].font); break;
+            case ASSET_SOUND: UnloadSound(assets[i].sound); break;
+            case ASSET_MUSIC: UnloadMusicStream(assets[i].music); break;
+            default: break;
+        }
+    }
+
+    // NOTE: Fetches still in flight on web carry previous generation and are ignored,
+    // even if their asset id has been reused by a new request
+    for (int i = 0; i < assetCount; i++) assets[i] = (Asset){ 0 };
+    assetCount = 0;
+    assetsGeneration++;
+}
+
+// Update fetching state and load one fetched asset
+void UpdateAssets(void)
+{
+#if !defined(PLATFORM_WEB)
+    double time = GetTime();
+
+    for (int i = 0; i < assetCount; i++)
+    {
+        if ((assets[i].state == ASSET_FETCHING) && (time >= assets[i].arrivalTime))
+        {
+            if (assets[i].stubFailing)
+            {
+                // Same path as web fetch error (OnAssetFetchError())
+                assets[i].state = ASSET_FAILED;
+                TraceLog(LOG_WARNING, "ASSETS: [%s] Fetch failed (status: 404, stub)", assets[i].fileName);
+            }
+            else assets[i].state = ASSET_FETCHED;
+        }
+    }
+#endif
+
+    // NOTE: Only one asset is loaded per frame, loading (decoding, GPU upload) can be expensive
+    for (int i = 0; i < assetCount; i++)
+    {
+        if (assets[i].state == ASSET_FETCHED)
+        {
+            LoadAssetData(&assets[i]);
+            break;
+        }
+    }
+}
+
+// Request asset, loaded immediately if file is already available
+int LoadAssetAsync(const char *fileName, AssetType type)
+{
+    if (assetCount >= MAX_ASSETS)
+    {
+        TraceLog(LOG_WARNING, "ASSETS: [%s] Maximum number of assets reached (%i)", fileName, MAX_ASSETS);
+        return -1;
+    }
+
+    int id = assetCount;
+    Asset *asset = &assets[id];
+    assetCount++;
+
+    strncpy(asset->fileName, fileName, MAX_ASSET_PATH_LENGTH - 1);
+    asset->type = type;
+
+#if defined(PLATFORM_WEB)
+    if (FileExists(fileName))
+    {
+        // File was preloaded in the web package
+        asset->state = ASSET_FETCHED;
+        LoadAssetData(asset);
+    }
+    else
+    {
+        // Make sure destination directory exists in virtual filesystem
+        mkdir(GetDirectoryPath(fileName), 0777);
+
+        asset->state = ASSET_FETCHING;
+        unsigned long fetchId = ((unsigned long)assetsGeneration << FETCH_ID_BITS) | (unsigned long)id;
+
+        emscripten_async_wget2(TextFormat("%s%s", assetsBaseUrl, fileName), fileName, "GET", "",
+            (void *)fetchId, OnAssetFetched, OnAssetFetchError, NULL);
+
+        TraceLog(LOG_INFO, "ASSETS: [%s] Fetching in background", fileName);
+    }
+#else
+    if (!FileExists(fileName))
+    {
+        TraceLog(LOG_WARNING, "ASSETS: [%s] File not found", fileName);
+        asset->state = ASSET_FAILED;
+    }
+    else if ((stubLatency > 0.0) || (stubBandwidth > 0.0) || (stubFail != NULL))
+    {
+        // Simulate network transfer time, failing files error after latency (like a 404 response)
+        asset->state = ASSET_FETCHING;
+        asset->stubFailing = (stubFail != NULL) && (strstr(fileName, stubFail) != NULL);
+        asset->arrivalTime = GetTime() + stubLatency;
+        if ((stubBandwidth > 0.0) && !asset->stubFailing) asset->arrivalTime += (double)GetFileLength(fileName)/stubBandwidth;
+    }
+    else
+    {
+        asset->state = ASSET_FETCHED;
+        LoadAssetData(asset);
+    }
+#endif
+
+    return id;
+}
+
+// Get asset current state
+AssetState GetAssetState(int id)
+{
+    if ((id < 0) || (id >= assetCount)) return ASSET_EMPTY;
+
+    return assets[id].state;
+}
+
+// Check if asset is ready to be used
+bool IsAssetReady(int id)
+{
+    return (GetAssetState(id) == ASSET_READY);
+}
+
+// Get texture asset
+Texture2D GetAssetTexture(int id)
+{
+    return IsAssetReady(id)? assets[id].texture : (Texture2D){ 0 };
+}
+
+// Get font asset
+Font GetAssetFont(int id)
+{
+    return IsAssetReady(id)? assets[id].font : GetFontDefault();
+}
+
+// Get sound asset
+Sound GetAssetSound(int id)
+{
+    return IsAssetReady(id)? assets[id].sound : (Sound){ 0 };
+}
+
+// Get music asset
+Music GetAssetMusic(int id)
+{
+    return IsAssetReady(id)? assets[id].music : (Music){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Load fetched file into GPU/audio resource
+static void LoadAssetData(Asset *asset)
+{
+    bool loaded = false;
+
+    switch (asset->type)
+    {
+        case ASSET_TEXTURE:
+        {
+            BeginTraceSpan("LoadTexture", asset->fileName);
+            asset->texture = LoadTexture(asset->fileName);
+            loaded = (asset->texture.id > 0);
+        } break;
+        case ASSET_FONT:
+        {
+            BeginTraceSpan("LoadFont", asset->fileName);
+            asset->font = LoadFont(asset->fileName);
+            loaded = (asset->font.texture.id > 0);
+        } break;
+        case ASSET_SOUND:
+        {
+            BeginTraceSpan("LoadSound", asset->fileName);
+            asset->sound = LoadSound(asset->fileName);
+            loaded = (asset->sound.stream.buffer != NULL);
+        } break;
+        case ASSET_MUSIC:
+        {
+            BeginTraceSpan("LoadMusicStream", asset->fileName);
+            asset->music = LoadMusicStream(asset->fileName);
+            loaded = (asset->music.stream.buffer != NULL);
+        } break;
+        default: BeginTraceSpan("LoadAsset", asset->fileName); break;
+    }
+
+    EndTraceSpan();
+
+    asset->state = loaded? ASSET_READY : ASSET_FAILED;
+
+    if (loaded) TraceLog(LOG_INFO, "ASSETS: [%s] Asset ready", asset->fileName);
+    else TraceLog(LOG_WARNING, "ASSETS: [%s] Asset could not be loaded", asset->fileName);
+}
+
+#if defined(PLATFORM_WEB)
+// Get asset id from fetch callback argument
+// NOTE: Argument packs generation and asset id, fetches requested before UnloadAssets() are stale
+static int GetFetchAssetId(void *arg)
+{
+    unsigned long fetchId = (unsigned long)arg;
+    unsigned long generation = (unsigned long)assetsGeneration & (~0UL >> FETCH_ID_BITS);
+
+    if ((fetchId >> FETCH_ID_BITS) != generation) return -1;
+
+    return (int)(fetchId & ((1UL << FETCH_ID_BITS) - 1));
+}
+
+// File fetched into virtual filesystem
+static void OnAssetFetched(unsigned int handle, void *arg, const char *fileName)
+{
+    int id = GetFetchAssetId(arg);
+
+    if ((id != -1) && (assets[id].state == ASSET_FETCHING)) assets[id].state = ASSET_FETCHED;
+}
+
+// File fetch failed
+static void OnAssetFetchError(unsigned int handle, void *arg, int status)
+{
+    int id = GetFetchAssetId(arg);
+
+    if ((id != -1) && (assets[id].state == ASSET_FETCHING))
+    {
+        assets[id].state = ASSET_FAILED;
+        TraceLog(LOG_WARNING, "ASSETS: [%s] Fetch failed (status: %i)", assets[id].fileName, status);
+    }
+}
+#endif
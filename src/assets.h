@@ -0,0 +1,95 @@
+/**********************************************************************************************
+*
+*   assets - Streaming assets loading for web and desktop
+*
+*   Assets required at startup (LOGO/TITLE screens) are preloaded in the web package, the rest
+*   (i.e. music) are requested with LoadAssetAsync() and arrive in background while the game runs.
+*   Game must check IsAssetReady() before using an asset and degrade gracefully until then.
+*
+*   Fetch backends:
+*     - PLATFORM_WEB: Files not present in the virtual filesystem are downloaded with
+*       emscripten_async_wget2() from baseUrl + fileName, no main loop blocking, no ASYNCIFY
+*     - Desktop: Files are read from disk; a file-serving stub can simulate network latency and
+*       bandwidth to test the web behaviour locally, configured with environment variables:
+*         ASSETS_STUB_LATENCY     Seconds before any requested file starts arriving
+*         ASSETS_STUB_BANDWIDTH   Bytes per second for the file transfer
+*         ASSETS_STUB_FAIL        Requested files containing this text fail after latency (i.e. ".xm")
+*
+*   TESTING WEB BUILD LOCALLY:
+*       Web build is served by a throttled static server (tools/serve_web.py): latency per request,
+*       limited bandwidth per file and failing files (error status, fetch onerror path):
+*
+*           make web
+*           make serve_web SERVE_WEB_PATH=../pong SERVE_WEB_LATENCY=0.3 SERVE_WEB_BANDWIDTH=65536
+*           make serve_web SERVE_WEB_PATH=../pong SERVE_WEB_FAIL="*.xm"    // Music fetch fails
+*
+*       Open http://localhost:8080/pong.html: TITLE screen must show once preloaded .data
+*       arrives (music still downloading, check server log), with a failing file the browser
+*       console shows "ASSETS: [resources/qt-plimp.xm] Fetch failed (status: 404)" and game
+*       keeps running without music. Same check on desktop: ASSETS_STUB_FAIL=.xm ./pong
+*
+*   NOTE: Fetched files are turned into GPU/audio resources by UpdateAssets(), on main thread,
+*   one asset per call to avoid frame hitches
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAX_ASSETS                  32      // Maximum number of managed assets
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Asset type
+typedef enum AssetType {
+    ASSET_TEXTURE = 0,
+    ASSET_FONT,
+    ASSET_SOUND,
+    ASSET_MUSIC
+} AssetType;
+
+// Asset state
+typedef enum AssetState {
+    ASSET_EMPTY = 0,                // Asset slot not used
+    ASSET_FETCHING,                 // File requested, not available yet
+    ASSET_FETCHED,                  // File available, waiting to be loaded by UpdateAssets()
+    ASSET_READY,                    // Asset loaded and ready to be used
+    ASSET_FAILED                    // File could not be fetched or loaded
+} AssetState;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitAssets(const char *baseUrl);                       // Initialize assets system, baseUrl used for web fetching (can be "")
+void UnloadAssets(void);                                    // Unload all loaded assets
+void UpdateAssets(void);                                    // Update fetching state and load one fetched asset (call once per frame)
+
+int LoadAssetAsync(const char *fileName, AssetType type);   // Request asset, loaded immediately if file is already available, returns asset id (-1 on error)
+AssetState GetAssetState(int id);                           // Get asset current state
+bool IsAssetReady(int id);                                  // Check if asset is ready to be used
+
+Texture2D GetAssetTexture(int id);                          // Get texture asset (empty texture if not ready)
+Font GetAssetFont(int id);                                  // Get font asset (default font if not ready)
+Sound GetAssetSound(int id);                                // Get sound asset (empty sound if not ready)
+Music GetAssetMusic(int id);                                // Get music asset (empty music if not ready)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ASSETS_H
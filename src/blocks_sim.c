@@ -0,0 +1,328 @@
+/**********************************************************************************************
+*
+*   blocks_sim - BLOCKS GAME simulation (player, ball and bricks update)
+*
+*   NOTE: Check blocks_sim.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "blocks_sim.h"
+
+#include "collision.h"          // Required for: CheckCollisionBallRec()
+
+#include <stddef.h>             // Required for: NULL
+#include <math.h>               // Required for: fabsf()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int UpdateBricksCollision(BlocksGame *game);        // Ball vs bricks lines (classic mode)
+static unsigned int UpdateFieldCollision(BlocksGame *game);         // Ball vs resident field rows (endless mode)
+static unsigned int UpdateBoardCollision(BlocksGame *game);         // Ball vs board cells (board mode)
+static bool CheckCollisionGameBall(BlocksGame *game, Rectangle rec);    // Check collision between ball and rectangle, test counted by game
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize player, ball and bricks
+void InitBlocksGame(BlocksGame *game, int screenWidth, int screenHeight)
+{
+    game->screenWidth = screenWidth;
+    game->screenHeight = screenHeight;
+    game->mode = BLOCKS_MODE_CLASSIC;
+
+    // Initialize player
+    game->player.position = (Vector2){ screenWidth/2, screenHeight*7/8 };
+    game->player.speed = (Vector2){ 8.0f, 0.0f };
+    game->player.size = (Vector2){ 100, 24 };
+    game->player.bounds = (Rectangle){ game->player.position.x, game->player.position.y, game->player.size.x, game->player.size.y };
+    game->player.lifes = PLAYER_LIFES;
+
+    // Initialize ball
+    game->ball.radius = 10.0f;
+    game->ball.active = false;
+    game->ball.position = (Vector2){ game->player.position.x + game->player.size.x/2, game->player.position.y - game->ball.radius*2 };
+    game->ball.speed = (Vector2){ 4.0f, 4.0f };
+
+    // Initialize bricks
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++)
+        {
+            Brick *brick = &game->bricks[j][i];
+
+            brick->size = (Vector2){ screenWidth/BRICKS_PER_LINE, 20 };
+            brick->position = (Vector2){ i*brick->size.x, j*brick->size.y + BRICKS_POSITION_Y };
+            brick->bounds = (Rectangle){ brick->position.x, brick->position.y, brick->size.x, brick->size.y };
+            brick->resistance = 0;
+            brick->active = true;
+        }
+    }
+}
+
+// Initialize endless mode, level file optional
+// NOTE: Bricks rows start where classic bricks lines are, lowest row first
+void InitBlocksGameEndless(BlocksGame *game, int screenWidth, int screenHeight, unsigned int seed, const char *levelFileName)
+{
+    InitBlocksGame(game, screenWidth, screenHeight);
+
+    game->mode = BLOCKS_MODE_ENDLESS;
+
+    // NOTE: Classic bricks lines not used, bricks come from field rows
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++) game->bricks[j][i].active = false;
+    }
+
+    InitBrickField(&game->field, screenWidth, BRICKS_POSITION_Y + (BRICKS_LINES - 1)*20, 20, seed);
+    if (levelFileName != NULL) LoadBrickFieldLevel(&game->field, levelFileName);
+}
+
+// Initialize board mode, returns false (classic mode) if level can not be loaded
+// NOTE: Playfield grows to board size (board cells and a play area below them, at least
+// one screen), player starts at playfield bottom, centered
+bool InitBlocksGameBoard(BlocksGame *game, int screenWidth, int screenHeight, const char *levelFileName)
+{
+    InitBlocksGame(game, screenWidth, screenHeight);
+
+    if (!LoadBrickBoard(&game->board, levelFileName, (Vector2){ 0, BRICKS_POSITION_Y }, (Vector2){ screenWidth/BRICKS_PER_LINE, 20 })) return false;
+
+    Rectangle bounds = GetBrickBoardBounds(&game->board);
+    int width = (int)bounds.width;
+    int height = (int)(bounds.y + bounds.height) + screenHeight*3/4;
+
+    InitBlocksGame(game, (width > screenWidth)? width : screenWidth, (height > screenHeight)? height : screenHeight);
+
+    game->mode = BLOCKS_MODE_BOARD;
+
+    // Player placed on playfield bottom, same distance as classic mode
+    game->player.position = (Vector2){ game->screenWidth/2 - game->player.size.x/2, game->screenHeight - screenHeight/8 };
+    game->player.bounds = (Rectangle){ game->player.position.x, game->player.position.y, game->player.size.x, game->player.size.y };
+    game->ball.position = (Vector2){ game->player.position.x + game->player.size.x/2, game->player.position.y - game->ball.radius*2 };
+
+    // NOTE: Classic bricks lines not used, bricks come from board cells
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++) game->bricks[j][i].active = false;
+    }
+
+    return true;
+}
+
+// Update one simulation step
+// NOTE: Game logic from lesson 07, ball vs bricks only resolves one brick per line and step
+unsigned int UpdateBlocksGame(BlocksGame *game, BlocksInput input)
+{
+    unsigned int events = 0;
+
+    Player *player = &game->player;
+    Ball *ball = &game->ball;
+
+    game->hitBricksCount = 0;
+
+    // Player movement logic
+    if (input.left) player->position.x -= player->speed.x;
+    if (input.right) player->position.x += player->speed.x;
+
+    if ((player->position.x) <= 0) player->position.x = 0;
+    if ((player->position.x + player->size.x) >= game->screenWidth) player->position.x = game->screenWidth - player->size.x;
+
+    player->bounds = (Rectangle){ player->position.x, player->position.y, player->size.x, player->size.y };
+
+    if (ball->active)
+    {
+        // Ball movement logic
+        ball->position.x += ball->speed.x;
+        ball->position.y += ball->speed.y;
+
+        // Collision logic: ball vs screen-limits
+        if (((ball->position.x + ball->radius) >= game->screenWidth) || ((ball->position.x - ball->radius) <= 0)) ball->speed.x *= -1;
+        if ((ball->position.y - ball->radius) <= 0) ball->speed.y *= -1;
+
+        // Collision logic: ball vs player
+        if (CheckCollisionGameBall(game, player->bounds))
+        {
+            ball->speed.y *= -1;
+            ball->speed.x = (ball->position.x - (player->position.x + player->size.x/2))/player->size.x*5.0f;
+            events |= BLOCKS_EVENT_PADDLE_HIT;
+        }
+
+        // Collision logic: ball vs bricks
+        if (game->mode == BLOCKS_MODE_ENDLESS) events |= UpdateFieldCollision(game);
+        else if (game->mode == BLOCKS_MODE_BOARD) events |= UpdateBoardCollision(game);
+        else events |= UpdateBricksCollision(game);
+
+        // Endless mode: bricks rows scroll while ball is in play, every row reaching player costs one life
+        if (game->mode == BLOCKS_MODE_ENDLESS)
+        {
+            int landed = UpdateBrickField(&game->field, player->position.y);
+
+            if (landed > 0)
+            {
+                player->lifes -= landed;
+                events |= BLOCKS_EVENT_ROW_LANDED;
+            }
+        }
+
+        // Game ending logic
+        if ((ball->position.y + ball->radius) >= game->screenHeight)
+        {
+            ball->position.x = player->position.x + player->size.x/2;
+            ball->position.y = player->position.y - ball->radius - 1.0f;
+            ball->speed = (Vector2){ 0, 0 };
+            ball->active = false;
+
+            player->lifes--;
+            events |= BLOCKS_EVENT_BALL_LOST;
+        }
+
+        if (player->lifes < 0)
+        {
+            player->lifes = PLAYER_LIFES;
+            events |= BLOCKS_EVENT_GAME_OVER;
+        }
+    }
+    else
+    {
+        // Reset ball position
+        ball->position.x = player->position.x + player->size.x/2;
+
+        if (input.launch)
+        {
+            // Activate ball logic
+            ball->active = true;
+            ball->speed = (Vector2){ 0, -5.0f };
+            events |= BLOCKS_EVENT_LAUNCH;
+        }
+    }
+
+    return events;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Ball vs bricks lines (classic mode)
+// NOTE: Only one brick resolved per line and step, only bricks touching ball bounds are checked
+// (same bricks grid cells order, same results as checking all bricks)
+static unsigned int UpdateBricksCollision(BlocksGame *game)
+{
+    unsigned int events = 0;
+    Ball *ball = &game->ball;
+
+    Rectangle ballBounds = { ball->position.x - ball->radius, ball->position.y - ball->radius, ball->radius*2, ball->radius*2 };
+    GridRange range = GetGridRangeRec(ballBounds, (Vector2){ 0, BRICKS_POSITION_Y }, game->bricks[0][0].size, BRICKS_PER_LINE, BRICKS_LINES);
+
+    for (int j = range.firstRow; j <= range.lastRow; j++)
+    {
+        for (int i = range.firstColumn; i <= range.lastColumn; i++)
+        {
+            if (game->bricks[j][i].active && CheckCollisionGameBall(game, game->bricks[j][i].bounds))
+            {
+                game->bricks[j][i].active = false;
+                game->hitBricks[game->hitBricksCount++] = j*BRICKS_PER_LINE + i;
+                ball->speed.y *= -1;
+                events |= BLOCKS_EVENT_BRICK_HIT;
+
+                break;
+            }
+        }
+    }
+
+    return events;
+}
+
+// Ball vs resident field rows (endless mode)
+// NOTE: Only rows and columns touching ball are checked, one brick resolved per row and step,
+// bricks with hits left lose one hit and stay, destroyed ones are recorded as field cells.
+// Ball bounces away from brick, rows reach screen top and a top limit bounce on same step
+// must not be reverted (ball would leave the screen through the field)
+static unsigned int UpdateFieldCollision(BlocksGame *game)
+{
+    unsigned int events = 0;
+    Ball *ball = &game->ball;
+    BrickField *field = &game->field;
+
+    // NOTE: Ball bounds expanded by one pixel, rows positions are not integers and
+    // CheckCollisionBallRec() truncates rectangles centers
+    Rectangle ballBounds = { ball->position.x - ball->radius - 1.0f, ball->position.y - ball->radius - 1.0f, ball->radius*2 + 2.0f, ball->radius*2 + 2.0f };
+    GridRange range = GetBrickFieldRangeRec(field, ballBounds);
+
+    for (int j = range.firstRow; j <= range.lastRow; j++)
+    {
+        BrickRow *row = GetBrickFieldRow(field, j);
+
+        for (int i = range.firstColumn; i <= range.lastColumn; i++)
+        {
+            int cell = j*BRICK_FIELD_COLUMNS + i;
+            Rectangle bounds = GetBrickFieldCellRec(field, cell);
+
+            if ((row->cells[i] > 0) && CheckCollisionGameBall(game, bounds))
+            {
+                row->cells[i]--;
+                if ((row->cells[i] == 0) && (game->hitBricksCount < BRICKS_LINES)) game->hitBricks[game->hitBricksCount++] = cell;
+                ball->speed.y = (ball->position.y > (bounds.y + bounds.height/2))? fabsf(ball->speed.y) : -fabsf(ball->speed.y);
+                events |= BLOCKS_EVENT_BRICK_HIT;
+
+                break;
+            }
+        }
+    }
+
+    return events;
+}
+
+// Ball vs board cells (board mode)
+// NOTE: Only cells touching ball bounds are checked (a few cells on any board size), one brick
+// resolved per row and step, bricks with hits left lose one hit and stay
+static unsigned int UpdateBoardCollision(BlocksGame *game)
+{
+    unsigned int events = 0;
+    Ball *ball = &game->ball;
+    BrickBoard *board = &game->board;
+
+    Rectangle ballBounds = { ball->position.x - ball->radius, ball->position.y - ball->radius, ball->radius*2, ball->radius*2 };
+    GridRange range = GetBrickBoardRangeRec(board, ballBounds);
+
+    for (int j = range.firstRow; j <= range.lastRow; j++)
+    {
+        for (int i = range.firstColumn; i <= range.lastColumn; i++)
+        {
+            int cell = j*board->columns + i;
+            Rectangle bounds = GetBrickBoardCellRec(board, cell);
+
+            if ((board->cells[cell] > 0) && CheckCollisionGameBall(game, bounds))
+            {
+                board->cells[cell]--;
+
+                if (board->cells[cell] == 0)
+                {
+                    board->bricksCount--;
+                    if (game->hitBricksCount < BRICKS_LINES) game->hitBricks[game->hitBricksCount++] = cell;
+                }
+
+                ball->speed.y = (ball->position.y > (bounds.y + bounds.height/2))? fabsf(ball->speed.y) : -fabsf(ball->speed.y);
+                events |= BLOCKS_EVENT_BRICK_HIT;
+
+                break;
+            }
+        }
+    }
+
+    return events;
+}
+
+// Check collision between ball and rectangle, test counted by game
+// NOTE: Tests are counted in game state, every game (threads, server matches) only writes its own counter
+static bool CheckCollisionGameBall(BlocksGame *game, Rectangle rec)
+{
+    game->collisionTests++;
+
+    return CheckCollisionBallRec(game->ball.position, game->ball.radius, rec);
+}
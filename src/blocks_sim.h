@@ -0,0 +1,138 @@
+/**********************************************************************************************
+*
+*   blocks_sim - BLOCKS GAME simulation (player, ball and bricks update)
+*
+*   Gameplay logic from lessons, decoupled from window, inputs, drawing and audio:
+*     - Inputs are provided by the game on every step (BlocksInput)
+*     - Audible/visible gameplay outcomes are returned as events flags, game decides
+*       how to react (sounds, screen changes...), bricks destroyed on last step are
+*       recorded in game state (hitBricks)
+*     - Endless mode: bricks rows scroll down from a streamed field (check brick_field.h),
+*       rows reaching player cost one life each, session never runs out of bricks
+*     - Board mode: large bricks board loaded from a level file (check brick_board.h),
+*       playfield grows to the board size (several screens in both axes), game shows
+*       part of it with a camera
+*
+*   USAGE:
+*       BlocksGame game = { 0 };
+*       InitBlocksGame(&game, screenWidth, screenHeight);
+*
+*       // Every GAMEPLAY frame (not paused)
+*       unsigned int events = UpdateBlocksGame(&game, input);
+*       if (events & BLOCKS_EVENT_BRICK_HIT) PlayGameSound(fxExplode);
+*
+*       // Endless mode: procedural rows (seed) or level rows (text file)
+*       InitBlocksGameEndless(&game, screenWidth, screenHeight, 1234, NULL);
+*
+*       // Board mode: playfield is board size (game->screenWidth, game->screenHeight)
+*       InitBlocksGameBoard(&game, screenWidth, screenHeight, "resources/blocks_board.txt");
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef BLOCKS_SIM_H
+#define BLOCKS_SIM_H
+
+#include "raylib.h"
+
+#include "brick_field.h"        // Required for: BrickField
+#include "brick_board.h"        // Required for: BrickBoard
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PLAYER_LIFES             5
+#define BRICKS_LINES             5
+#define BRICKS_PER_LINE         20
+
+#define BRICKS_POSITION_Y       50
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Player structure
+typedef struct Player {
+    Vector2 position;
+    Vector2 speed;
+    Vector2 size;
+    Rectangle bounds;
+    int lifes;
+} Player;
+
+// Ball structure
+typedef struct Ball {
+    Vector2 position;
+    Vector2 speed;
+    float radius;
+    bool active;
+} Ball;
+
+// Bricks structure
+typedef struct Brick {
+    Vector2 position;
+    Vector2 size;
+    Rectangle bounds;
+    int resistance;
+    bool active;
+} Brick;
+
+// Blocks game modes
+typedef enum {
+    BLOCKS_MODE_CLASSIC = 0,    // Fixed bricks lines (bricks)
+    BLOCKS_MODE_ENDLESS,        // Scrolling bricks rows (field)
+    BLOCKS_MODE_BOARD           // Large bricks board (board)
+} BlocksMode;
+
+// Blocks game state
+typedef struct BlocksGame {
+    int screenWidth;            // Playfield width
+    int screenHeight;           // Playfield height
+    int mode;                   // Game mode (BlocksMode)
+    Player player;
+    Ball ball;
+    Brick bricks[BRICKS_LINES][BRICKS_PER_LINE];    // Classic mode bricks
+    BrickField field;           // Endless mode bricks rows
+    BrickBoard board;           // Board mode bricks
+    int hitBricks[BRICKS_LINES];    // Bricks destroyed on last step (line*BRICKS_PER_LINE + index), endless mode: field cell, board mode: board cell
+    int hitBricksCount;         // Bricks destroyed on last step
+    unsigned int collisionTests;    // Collision tests done, not reset (wraps around, use differences)
+} BlocksGame;
+
+// Blocks game inputs for one simulation step
+typedef struct BlocksInput {
+    bool left;                  // Move player left
+    bool right;                 // Move player right
+    bool launch;                // Launch ball (when not active)
+} BlocksInput;
+
+// Blocks game events, returned as flags by UpdateBlocksGame()
+typedef enum {
+    BLOCKS_EVENT_PADDLE_HIT = 0x01, // Ball bounced on player
+    BLOCKS_EVENT_BRICK_HIT  = 0x02, // Ball destroyed one or more bricks
+    BLOCKS_EVENT_BALL_LOST  = 0x04, // Ball reached bottom limit, one life lost
+    BLOCKS_EVENT_GAME_OVER  = 0x08, // No lifes remaining (player lifes are reset)
+    BLOCKS_EVENT_LAUNCH     = 0x10, // Ball launched
+    BLOCKS_EVENT_ROW_LANDED = 0x20  // Endless mode: bricks row reached player, one life lost per row
+} BlocksEvent;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitBlocksGame(BlocksGame *game, int screenWidth, int screenHeight);  // Initialize player, ball and bricks
+void InitBlocksGameEndless(BlocksGame *game, int screenWidth, int screenHeight, unsigned int seed, const char *levelFileName);   // Initialize endless mode, level file optional
+bool InitBlocksGameBoard(BlocksGame *game, int screenWidth, int screenHeight, const char *levelFileName);   // Initialize board mode, returns false (classic mode) if level can not be loaded
+unsigned int UpdateBlocksGame(BlocksGame *game, BlocksInput input);       // Update one simulation step, returns BlocksEvent flags
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // BLOCKS_SIM_H
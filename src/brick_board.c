@@ -0,0 +1,105 @@
+/**********************************************************************************************
+*
+*   brick_board - Large bricks board, fixed grid of several screens loaded from a level file
+*
+*   NOTE: Check brick_board.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "brick_board.h"
+
+#include <stddef.h>             // Required for: NULL
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Load board cells from level text file
+// NOTE: Board is cleared first, it is left empty (no rows) if file can not be read
+bool LoadBrickBoard(BrickBoard *board, const char *fileName, Vector2 origin, Vector2 cellSize)
+{
+    board->columns = 0;
+    board->rows = 0;
+    board->origin = origin;
+    board->cellSize = cellSize;
+    board->bricksCount = 0;
+
+    char *text = LoadFileText(fileName);
+    if (text == NULL) return false;
+
+    // Read lines, board columns given by longest one
+    static unsigned char lines[BRICK_BOARD_MAX_ROWS][BRICK_BOARD_MAX_COLUMNS] = { 0 };
+    int linesCount = 0;
+    int columns = 0;
+
+    for (char *line = text; (*line != '\0') && (linesCount < BRICK_BOARD_MAX_ROWS); )
+    {
+        char *next = line;
+        while ((*next != '\0') && (*next != '\n')) next++;
+
+        if ((*line != '#') && (*line != '\n') && (*line != '\r') && (*line != '\0'))
+        {
+            int length = 0;
+
+            for (int i = 0; (i < BRICK_BOARD_MAX_COLUMNS) && (line + i < next) && (line[i] != '\r'); i++)
+            {
+                lines[linesCount][i] = ((line[i] >= '1') && (line[i] <= '9'))? (unsigned char)(line[i] - '0') : 0;
+                length = i + 1;
+            }
+
+            for (int i = length; i < BRICK_BOARD_MAX_COLUMNS; i++) lines[linesCount][i] = 0;
+
+            if (length > columns) columns = length;
+            linesCount++;
+        }
+
+        line = (*next == '\n')? next + 1 : next;
+    }
+
+    UnloadFileText(text);
+
+    if ((linesCount == 0) || (columns == 0))
+    {
+        TraceLog(LOG_WARNING, "BOARD: [%s] No board rows found", fileName);
+        return false;
+    }
+
+    board->columns = columns;
+    board->rows = linesCount;
+
+    for (int j = 0; j < linesCount; j++)
+    {
+        for (int i = 0; i < columns; i++)
+        {
+            board->cells[j*columns + i] = lines[j][i];
+            if (lines[j][i] > 0) board->bricksCount++;
+        }
+    }
+
+    TraceLog(LOG_INFO, "BOARD: [%s] Board loaded successfully (%i x %i cells, %i bricks)", fileName, columns, linesCount, board->bricksCount);
+
+    return true;
+}
+
+// Get brick rectangle, cell: row*columns + column
+Rectangle GetBrickBoardCellRec(const BrickBoard *board, int cell)
+{
+    return (Rectangle){ board->origin.x + (cell%board->columns)*board->cellSize.x, board->origin.y + (cell/board->columns)*board->cellSize.y, board->cellSize.x, board->cellSize.y };
+}
+
+// Get board cells touching rectangle (edges included)
+// NOTE: Range is empty (first > last) when rectangle is outside board
+GridRange GetBrickBoardRangeRec(const BrickBoard *board, Rectangle rec)
+{
+    return GetGridRangeRec(rec, board->origin, board->cellSize, board->columns, board->rows);
+}
+
+// Get board cells area
+Rectangle GetBrickBoardBounds(const BrickBoard *board)
+{
+    return (Rectangle){ board->origin.x, board->origin.y, board->columns*board->cellSize.x, board->rows*board->cellSize.y };
+}
@@ -0,0 +1,82 @@
+/**********************************************************************************************
+*
+*   brick_board - Large bricks board, fixed grid of several screens loaded from a level file
+*
+*   Board mode playfield is larger than the screen in both axes: bricks grid is loaded
+*   from a text level file (up to BRICK_BOARD_MAX_COLUMNS x BRICK_BOARD_MAX_ROWS cells),
+*   player and ball move in the whole board area and a camera shows part of it.
+*
+*   Only cells touching a rectangle are collided or drawn (GetBrickBoardRangeRec()): ball
+*   collision touches a few cells, drawing only visits cells in visible area, a zoomed in
+*   view visits the same cells count on any board size.
+*
+*   Board is a plain structure (no pointers), it can be copied as raw bytes with the game
+*   state (simulation snapshots, replays, spectators).
+*
+*   LEVEL FILE FORMAT (text, one row per line, first line is the top one):
+*       '.' or ' '      No brick
+*       '1'..'9'        Brick, hits required to destroy it
+*       '#'             Comment line (first character)
+*
+*   Board columns are given by the longest row, up to BRICK_BOARD_MAX_COLUMNS characters
+*   per row are used, rows past BRICK_BOARD_MAX_ROWS are ignored.
+*
+*   USAGE:
+*       LoadBrickBoard(&board, "resources/blocks_board.txt", (Vector2){ 0, 50 }, (Vector2){ 40, 20 });
+*
+*       // Collision or drawing: cells touching rectangle
+*       GridRange range = GetBrickBoardRangeRec(&board, rec);
+*       for (int j = range.firstRow; j <= range.lastRow; j++)
+*           for (int i = range.firstColumn; i <= range.lastColumn; i++) board.cells[j*board.columns + i];
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef BRICK_BOARD_H
+#define BRICK_BOARD_H
+
+#include "raylib.h"
+
+#include "collision.h"          // Required for: GridRange
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BRICK_BOARD_MAX_COLUMNS     128     // Board maximum columns (40 px bricks: 6.4 screens of 800 px)
+#define BRICK_BOARD_MAX_ROWS         64     // Board maximum rows (20 px bricks: 2.8 screens of 450 px)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Bricks board
+// NOTE: Cells are stored row after row, columns cells per row (cell: row*columns + column)
+typedef struct BrickBoard {
+    int columns;                // Board columns
+    int rows;                   // Board rows
+    Vector2 origin;             // First cell top-left position
+    Vector2 cellSize;           // Brick size
+    int bricksCount;            // Bricks left
+    unsigned char cells[BRICK_BOARD_MAX_ROWS*BRICK_BOARD_MAX_COLUMNS];  // Hits left per cell (0: no brick)
+} BrickBoard;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool LoadBrickBoard(BrickBoard *board, const char *fileName, Vector2 origin, Vector2 cellSize);    // Load board cells from level text file
+Rectangle GetBrickBoardCellRec(const BrickBoard *board, int cell);         // Get brick rectangle, cell: row*columns + column
+GridRange GetBrickBoardRangeRec(const BrickBoard *board, Rectangle rec);    // Get board cells touching rectangle (edges included)
+Rectangle GetBrickBoardBounds(const BrickBoard *board);                     // Get board cells area
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // BRICK_BOARD_H
@@ -0,0 +1,281 @@
+/**********************************************************************************************
+*
+*   brick_field - Endless bricks field, brick rows streamed in chunks through a ring buffer
+*
+*   NOTE: Check brick_field.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "brick_field.h"
+
+#include <stddef.h>             // Required for: NULL
+#include <math.h>               // Required for: ceilf(), floorf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BRICK_FIELD_FULL_ROWS       5       // Procedural rows: first rows are full, like classic mode bricks
+#define BRICK_FIELD_MAX_HITS        9       // Hits required to destroy the hardest brick
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ResetBrickField(BrickField *field);         // Reset ring buffer, all chunks generated
+static void GenerateStagingRow(BrickField *field);      // Generate next row into staging chunk
+static unsigned int HashCell(unsigned int seed, int row, int column);  // Procedural cell hash
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize field with procedural rows, all chunks generated
+// NOTE: top is row 0 top position at start, rows above it are generated upwards
+void InitBrickField(BrickField *field, int width, float top, float rowHeight, unsigned int seed)
+{
+    field->cellSize = (Vector2){ (float)(width/BRICK_FIELD_COLUMNS), rowHeight };
+    field->top = top;
+    field->scrollSpeed = BRICK_FIELD_SCROLL_SPEED;
+    field->seed = seed;
+    field->levelRows = 0;
+
+    ResetBrickField(field);
+}
+
+// Load level rows from text file, field restarted with them
+// NOTE: File is only read here, rows are generated from level kept in field
+bool LoadBrickFieldLevel(BrickField *field, const char *fileName)
+{
+    char *text = LoadFileText(fileName);
+    if (text == NULL) return false;
+
+    // Read lines, first line is the top one
+    unsigned char lines[BRICK_FIELD_LEVEL_MAX_ROWS][BRICK_FIELD_COLUMNS] = { 0 };
+    int linesCount = 0;
+
+    for (char *line = text; (*line != '\0') && (linesCount < BRICK_FIELD_LEVEL_MAX_ROWS); )
+    {
+        char *next = line;
+        while ((*next != '\0') && (*next != '\n')) next++;
+
+        if ((*line != '#') && (*line != '\n') && (*line != '\r') && (*line != '\0'))
+        {
+            for (int i = 0; (i < BRICK_FIELD_COLUMNS) && (line + i < next); i++)
+            {
+                if ((line[i] >= '1') && (line[i] <= '9')) lines[linesCount][i] = (unsigned char)(line[i] - '0');
+            }
+
+            linesCount++;
+        }
+
+        line = (*next == '\n')? next + 1 : next;
+    }
+
+    UnloadFileText(text);
+
+    if (linesCount == 0)
+    {
+        TraceLog(LOG_WARNING, "FIELD: [%s] No level rows found", fileName);
+        return false;
+    }
+
+    // NOTE: Rows scroll down, last line is row 0 (first one to land)
+    for (int j = 0; j < linesCount; j++)
+    {
+        for (int i = 0; i < BRICK_FIELD_COLUMNS; i++) field->level[j][i] = lines[linesCount - 1 - j][i];
+    }
+
+    field->levelRows = linesCount;
+
+    ResetBrickField(field);
+
+    TraceLog(LOG_INFO, "FIELD: [%s] Level loaded successfully (%i rows)", fileName, linesCount);
+
+    return true;
+}
+
+// Scroll field, land rows reaching limit, generate one staging row
+// NOTE: Landed rows are cleared, returned count only includes rows with bricks left
+int UpdateBrickField(BrickField *field, float limit)
+{
+    int landed = 0;
+
+    field->scroll += field->scrollSpeed;
+
+    // Land rows with bottom reaching limit
+    for (BrickRow *row = GetBrickFieldRow(field, field->landedRows); row != NULL; row = GetBrickFieldRow(field, field->landedRows))
+    {
+        if ((GetBrickFieldRowY(field, row->index) + field->cellSize.y) < limit) break;
+
+        bool bricks = false;
+        for (int i = 0; i < BRICK_FIELD_COLUMNS; i++)
+        {
+            if (row->cells[i] > 0) bricks = true;
+            row->cells[i] = 0;
+        }
+
+        if (bricks) landed++;
+        field->landedRows++;
+
+        // Oldest chunk recycled once all its rows landed, it becomes the staging chunk
+        BrickChunk *chunk = &field->chunks[field->head];
+
+        if (field->landedRows >= (chunk->firstRow + BRICK_FIELD_CHUNK_ROWS))
+        {
+            // NOTE: Staging chunk is always complete by then (one row per update, rows land
+            // hundreds of updates apart), generation is only forced on very fast scroll speeds
+            while (field->resident < BRICK_FIELD_CHUNKS) GenerateStagingRow(field);
+
+            // Scroll kept relative to lowest resident row, it never grows
+            field->scroll -= BRICK_FIELD_CHUNK_ROWS*field->cellSize.y;
+
+            chunk->firstRow = field->nextRow;
+            chunk->rowsReady = 0;
+            field->head = (field->head + 1)%BRICK_FIELD_CHUNKS;
+            field->resident--;
+        }
+    }
+
+    if (field->resident < BRICK_FIELD_CHUNKS) GenerateStagingRow(field);
+
+    return landed;
+}
+
+// Get resident row, NULL if not resident
+// NOTE: Row is returned writable (collisions), field can be const for drawing
+BrickRow *GetBrickFieldRow(const BrickField *field, int index)
+{
+    int offset = index - field->chunks[field->head].firstRow;
+
+    if ((offset < 0) || (offset >= field->resident*BRICK_FIELD_CHUNK_ROWS)) return NULL;
+
+    const BrickChunk *chunk = &field->chunks[(field->head + offset/BRICK_FIELD_CHUNK_ROWS)%BRICK_FIELD_CHUNKS];
+
+    return (BrickRow *)&chunk->rows[offset%BRICK_FIELD_CHUNK_ROWS];
+}
+
+// Get row top position
+float GetBrickFieldRowY(const BrickField *field, int index)
+{
+    return field->top + field->scroll - (index - field->chunks[field->head].firstRow)*field->cellSize.y;
+}
+
+// Get brick rectangle, cell: row index*BRICK_FIELD_COLUMNS + column
+Rectangle GetBrickFieldCellRec(const BrickField *field, int cell)
+{
+    return (Rectangle){ (cell%BRICK_FIELD_COLUMNS)*field->cellSize.x, GetBrickFieldRowY(field, cell/BRICK_FIELD_COLUMNS), field->cellSize.x, field->cellSize.y };
+}
+
+// Get resident rows (not landed) and columns touching rectangle
+// NOTE: Row indices grow upwards, rectangle bottom gives first row; rows sharing only an edge
+// with rectangle are included. Range is empty (first > last) when no resident row touches it
+GridRange GetBrickFieldRangeRec(const BrickField *field, Rectangle rec)
+{
+    int baseRow = field->chunks[field->head].firstRow;
+    float top = field->top + field->scroll;     // Base row top position
+
+    GridRange range = GetGridRangeRec(rec, (Vector2){ 0.0f, 0.0f }, field->cellSize, BRICK_FIELD_COLUMNS, 1);
+
+    range.firstRow = baseRow + (int)ceilf((top - (rec.y + rec.height))/field->cellSize.y);
+    range.lastRow = baseRow + (int)floorf((top - rec.y)/field->cellSize.y) + 1;
+
+    if (range.firstRow < field->landedRows) range.firstRow = field->landedRows;
+    if (range.lastRow > (baseRow + field->resident*BRICK_FIELD_CHUNK_ROWS - 1)) range.lastRow = baseRow + field->resident*BRICK_FIELD_CHUNK_ROWS - 1;
+
+    return range;
+}
+
+// Get ring buffer rows area (staging chunk included), from highest row top to lowest row bottom
+// NOTE: Area height is constant, it only moves with scroll and chunks recycling
+Rectangle GetBrickFieldBounds(const BrickField *field)
+{
+    float bottom = GetBrickFieldRowY(field, field->chunks[field->head].firstRow) + field->cellSize.y;
+    float top = GetBrickFieldRowY(field, field->chunks[field->head].firstRow + BRICK_FIELD_CHUNKS*BRICK_FIELD_CHUNK_ROWS - 1);
+
+    return (Rectangle){ 0.0f, top, BRICK_FIELD_COLUMNS*field->cellSize.x, bottom - top };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Reset ring buffer, all chunks generated
+static void ResetBrickField(BrickField *field)
+{
+    field->head = 0;
+    field->resident = 0;
+    field->nextRow = 0;
+    field->landedRows = 0;
+    field->scroll = 0.0f;
+
+    for (int c = 0; c < BRICK_FIELD_CHUNKS; c++)
+    {
+        field->chunks[c].firstRow = c*BRICK_FIELD_CHUNK_ROWS;
+        field->chunks[c].rowsReady = 0;
+    }
+
+    while (field->resident < BRICK_FIELD_CHUNKS) GenerateStagingRow(field);
+}
+
+// Generate next row into staging chunk
+// NOTE: Staging chunk becomes resident once all its rows are generated
+static void GenerateStagingRow(BrickField *field)
+{
+    BrickChunk *chunk = &field->chunks[(field->head + field->resident)%BRICK_FIELD_CHUNKS];
+    BrickRow *row = &chunk->rows[chunk->rowsReady];
+    int index = field->nextRow;
+
+    row->index = index;
+
+    if (field->levelRows > 0)
+    {
+        // Level rows looped, one more hit required every loop
+        const unsigned char *level = field->level[index%field->levelRows];
+        int loop = index/field->levelRows;
+
+        for (int i = 0; i < BRICK_FIELD_COLUMNS; i++)
+        {
+            int hits = (level[i] > 0)? level[i] + loop : 0;
+            row->cells[i] = (unsigned char)((hits > BRICK_FIELD_MAX_HITS)? BRICK_FIELD_MAX_HITS : hits);
+        }
+    }
+    else
+    {
+        // Procedural rows: denser and harder with depth
+        int density = 45 + index/4;                 // Bricks probability (percent)
+        if (density > 90) density = 90;
+        int hardness = 1 + index/40;                // Hits range
+        if (hardness > BRICK_FIELD_MAX_HITS) hardness = BRICK_FIELD_MAX_HITS;
+
+        for (int i = 0; i < BRICK_FIELD_COLUMNS; i++)
+        {
+            unsigned int hash = HashCell(field->seed, index, i);
+
+            if ((index < BRICK_FIELD_FULL_ROWS) || ((int)(hash%100) < density)) row->cells[i] = (unsigned char)(1 + (hash/100)%hardness);
+            else row->cells[i] = 0;
+        }
+    }
+
+    field->nextRow++;
+    chunk->rowsReady++;
+
+    if (chunk->rowsReady == BRICK_FIELD_CHUNK_ROWS) field->resident++;
+}
+
+// Procedural cell hash
+// NOTE: Integer hash (xorshift-multiply), same seed generates same field on any platform
+static unsigned int HashCell(unsigned int seed, int row, int column)
+{
+    unsigned int hash = seed ^ ((unsigned int)row*0x9e3779b1u) ^ ((unsigned int)column*0x85ebca77u);
+
+    hash ^= hash >> 16;
+    hash *= 0x7feb352du;
+    hash ^= hash >> 15;
+    hash *= 0x846ca68bu;
+    hash ^= hash >> 16;
+
+    return hash;
+}
@@ -0,0 +1,115 @@
+/**********************************************************************************************
+*
+*   brick_field - Endless bricks field, brick rows streamed in chunks through a ring buffer
+*
+*   Brick rows scroll down from above the screen, endlessly: rows are generated from a
+*   procedural source (seeded hash, denser and harder with depth) or from level rows
+*   (text file, looped, one more hit required every loop), in chunks of
+*   BRICK_FIELD_CHUNK_ROWS rows kept in a ring buffer of BRICK_FIELD_CHUNKS chunks.
+*   Rows reaching the field limit (player zone) land: their bricks are cleared and the
+*   oldest chunk is recycled once all its rows landed.
+*
+*   Memory is constant (ring buffer inside the field, no allocations), a session can last
+*   forever. Only resident chunks are collided and drawn, rows and columns touching any
+*   rectangle are computed directly (GetBrickFieldRangeRec()), ball collision touches two
+*   or three rows, a few bricks each, drawing only visits rows in visible area.
+*
+*   Chunks are generated ahead of time, one row per update into the chunk following the
+*   resident ones (staging chunk), it becomes resident once complete. Row generation is a
+*   few hashes, no file access: level file is read once by LoadBrickFieldLevel(), an update
+*   cost is bounded and never hitches a frame.
+*
+*   Field is a plain structure (no pointers), it can be copied as raw bytes with the game
+*   state (simulation snapshots, replays, spectators), updates are deterministic.
+*
+*   LEVEL FILE FORMAT (text, one row per line, BRICK_FIELD_COLUMNS characters used):
+*       '.' or ' '      No brick
+*       '1'..'9'        Brick, hits required to destroy it
+*       '#'             Comment line (first character)
+*
+*   USAGE:
+*       InitBrickField(&field, screenWidth, 50, 20, 1234);     // Procedural rows
+*       LoadBrickFieldLevel(&field, "resources/blocks_endless.txt");   // Optional: level rows
+*
+*       // Every simulation step
+*       int landed = UpdateBrickField(&field, playerTop);      // Rows with bricks landed
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef BRICK_FIELD_H
+#define BRICK_FIELD_H
+
+#include "raylib.h"
+
+#include "collision.h"          // Required for: GridRange
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BRICK_FIELD_COLUMNS             20      // Bricks per row, same as classic mode lines
+#define BRICK_FIELD_CHUNK_ROWS          8       // Rows per chunk
+#define BRICK_FIELD_CHUNKS              4       // Chunks in ring buffer, resident ones and one being generated
+#define BRICK_FIELD_LEVEL_MAX_ROWS      64      // Level rows kept in field, looped
+#define BRICK_FIELD_SCROLL_SPEED        0.05f   // Field scroll per update (pixels), one row every 400 updates for 20 pixels rows
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Bricks row
+typedef struct BrickRow {
+    int index;                              // Row index since field start, rows above have higher indices
+    unsigned char cells[BRICK_FIELD_COLUMNS];   // Hits left per brick, 0: no brick
+} BrickRow;
+
+// Rows chunk, ring buffer entry
+typedef struct BrickChunk {
+    int firstRow;                           // First (lowest) row index
+    int rowsReady;                          // Rows generated, chunk resident once complete
+    BrickRow rows[BRICK_FIELD_CHUNK_ROWS];
+} BrickChunk;
+
+// Endless bricks field
+typedef struct BrickField {
+    BrickChunk chunks[BRICK_FIELD_CHUNKS];  // Ring buffer, oldest chunk at head
+    int head;                               // Oldest (lowest) resident chunk slot
+    int resident;                           // Resident chunks, staging chunk follows them
+    int nextRow;                            // Next row index generated
+    int landedRows;                         // Rows landed (row indices below it are cleared)
+
+    Vector2 cellSize;                       // Brick size (pixels)
+    float top;                              // Row 0 top position at start (pixels)
+    float scroll;                           // Field scroll since start (pixels)
+    float scrollSpeed;                      // Scroll per update (pixels)
+
+    unsigned int seed;                      // Procedural rows seed
+    int levelRows;                          // Level rows, 0: procedural rows
+    unsigned char level[BRICK_FIELD_LEVEL_MAX_ROWS][BRICK_FIELD_COLUMNS];  // Level rows, hits per brick
+} BrickField;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitBrickField(BrickField *field, int width, float top, float rowHeight, unsigned int seed);   // Initialize field with procedural rows, all chunks generated
+bool LoadBrickFieldLevel(BrickField *field, const char *fileName);     // Load level rows from text file, field restarted with them
+int UpdateBrickField(BrickField *field, float limit);                  // Scroll field, land rows reaching limit, generate one staging row, returns rows landed with bricks
+
+BrickRow *GetBrickFieldRow(const BrickField *field, int index);        // Get resident row, NULL if not resident
+float GetBrickFieldRowY(const BrickField *field, int index);           // Get row top position
+Rectangle GetBrickFieldCellRec(const BrickField *field, int cell);     // Get brick rectangle, cell: row index*BRICK_FIELD_COLUMNS + column
+GridRange GetBrickFieldRangeRec(const BrickField *field, Rectangle rec);   // Get resident rows (not landed) and columns touching rectangle
+Rectangle GetBrickFieldBounds(const BrickField *field);                // Get ring buffer rows area (staging chunk included), from highest row top to lowest row bottom
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // BRICK_FIELD_H
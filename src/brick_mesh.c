@@ -0,0 +1,159 @@
+/**********************************************************************************************
+*
+*   brick_mesh - Bricks grid greedy mesher, contiguous bricks merged into single quads
+*
+*   NOTE: Check brick_mesh.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "brick_mesh.h"
+
+#include <string.h>             // Required for: memcmp(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ATLAS_COLUMNS           (BRICK_MESH_MAX_COLUMNS + 1)    // Atlas columns, one extra column for odd first cells
+#define ATLAS_STATE_ROWS        BRICK_MESH_MAX_ROWS             // Atlas rows per state
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void BuildBrickMesh(BrickMesh *mesh);        // Greedy merge band cells into quads
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Re-mesh grid band at origin cell if its cells changed, returns true if re-meshed
+// NOTE: Grid cells are provided row after row, band covers up to BRICK_MESH_MAX_ROWS x BRICK_MESH_MAX_COLUMNS
+// cells from origin, clipped to grid size; larger grids are meshed with one band per origin
+bool UpdateBrickMesh(BrickMesh *mesh, const unsigned char *cells, int rows, int columns, int firstRow, int firstColumn)
+{
+    int bandRows = rows - firstRow;
+    int bandColumns = columns - firstColumn;
+
+    if ((firstRow < 0) || (firstColumn < 0) || (bandRows <= 0) || (bandColumns <= 0))
+    {
+        TraceLog(LOG_WARNING, "MESH: Band origin [%i, %i] outside grid (%i x %i)", firstRow, firstColumn, rows, columns);
+        bandRows = 0;
+        bandColumns = 0;
+    }
+
+    if (bandRows > BRICK_MESH_MAX_ROWS) bandRows = BRICK_MESH_MAX_ROWS;
+    if (bandColumns > BRICK_MESH_MAX_COLUMNS) bandColumns = BRICK_MESH_MAX_COLUMNS;
+
+    unsigned char band[BRICK_MESH_MAX_ROWS*BRICK_MESH_MAX_COLUMNS] = { 0 };
+    for (int j = 0; j < bandRows; j++) memcpy(&band[j*bandColumns], &cells[(firstRow + j)*columns + firstColumn], bandColumns);
+
+    if (mesh->ready && (mesh->firstRow == firstRow) && (mesh->firstColumn == firstColumn) &&
+        (mesh->rows == bandRows) && (mesh->columns == bandColumns) &&
+        (memcmp(mesh->cells, band, bandRows*bandColumns) == 0)) return false;
+
+    mesh->firstRow = firstRow;
+    mesh->firstColumn = firstColumn;
+    mesh->rows = bandRows;
+    mesh->columns = bandColumns;
+    memcpy(mesh->cells, band, bandRows*bandColumns);
+
+    BuildBrickMesh(mesh);
+    mesh->ready = true;
+
+    return true;
+}
+
+// Generate bricks atlas, tints: even and odd cells tint per state
+// NOTE: Every state section is a checkerboard of (BRICK_MESH_MAX_COLUMNS + 1) x BRICK_MESH_MAX_ROWS bricks,
+// first cell tinted with even tint, any band quad finds its cells pattern in it
+Image GenImageBrickAtlas(Image brick, const Color *tints, int states)
+{
+    Image atlas = GenImageColor(ATLAS_COLUMNS*brick.width, states*ATLAS_STATE_ROWS*brick.height, BLANK);
+
+    for (int s = 0; s < states; s++)
+    {
+        for (int j = 0; j < ATLAS_STATE_ROWS; j++)
+        {
+            for (int i = 0; i < ATLAS_COLUMNS; i++)
+            {
+                Rectangle dest = { (float)(i*brick.width), (float)((s*ATLAS_STATE_ROWS + j)*brick.height), (float)brick.width, (float)brick.height };
+
+                ImageDraw(&atlas, brick, (Rectangle){ 0, 0, (float)brick.width, (float)brick.height }, dest, tints[s*2 + (i + j)%2]);
+            }
+        }
+    }
+
+    return atlas;
+}
+
+// Get quad cells area in atlas, topRow/leftColumn: grid cell drawn at quad top-left
+// NOTE: Atlas area starts on first or second column, same tint parity as grid top-left cell,
+// checkerboard tints match grid ones (rows below top one alternate as in grid, going up or down)
+Rectangle GetBrickAtlasSourceRec(BrickQuad quad, int topRow, int leftColumn, Vector2 brickSize)
+{
+    Rectangle source = { 0 };
+
+    source.x = ((topRow + leftColumn) & 1)*brickSize.x;
+    source.y = (quad.state - 1)*ATLAS_STATE_ROWS*brickSize.y;
+    source.width = quad.width*brickSize.x;
+    source.height = quad.height*brickSize.y;
+
+    return source;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Greedy merge band cells into quads
+// NOTE: Scans cells in rows order, every uncovered brick starts a quad: it grows along the row
+// while cells match, then over next rows while the full run matches
+static void BuildBrickMesh(BrickMesh *mesh)
+{
+    bool covered[BRICK_MESH_MAX_ROWS*BRICK_MESH_MAX_COLUMNS] = { 0 };
+    const int columns = mesh->columns;
+
+    mesh->quadsCount = 0;
+    mesh->bricksCount = 0;
+
+    for (int j = 0; j < mesh->rows; j++)
+    {
+        for (int i = 0; i < columns; i++)
+        {
+            unsigned char state = mesh->cells[j*columns + i];
+
+            if (state == 0) continue;
+            mesh->bricksCount++;
+            if (covered[j*columns + i]) continue;
+
+            // Grow along the row
+            int width = 1;
+            while (((i + width) < columns) && !covered[j*columns + i + width] && (mesh->cells[j*columns + i + width] == state)) width++;
+
+            // Grow over next rows, full run must match
+            int height = 1;
+            while ((j + height) < mesh->rows)
+            {
+                bool match = true;
+
+                for (int k = i; k < (i + width); k++)
+                {
+                    if (covered[(j + height)*columns + k] || (mesh->cells[(j + height)*columns + k] != state)) { match = false; break; }
+                }
+
+                if (!match) break;
+                height++;
+            }
+
+            for (int y = j; y < (j + height); y++)
+            {
+                for (int x = i; x < (i + width); x++) covered[y*columns + x] = true;
+            }
+
+            mesh->quads[mesh->quadsCount++] = (BrickQuad){ (unsigned char)i, (unsigned char)j, (unsigned char)width, (unsigned char)height, state };
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/**********************************************************************************************
+*
+*   brick_mesh - Bricks grid greedy mesher, contiguous bricks merged into single quads
+*
+*   Bricks grids of any size are meshed in bands of up to BRICK_MESH_MAX_ROWS x BRICK_MESH_MAX_COLUMNS
+*   cells, every band is identified by its origin cell in grid (classic bricks lines are one band,
+*   large boards a set of bands, endless field chunks one band each). Cells with same state (0: empty)
+*   are merged greedily into rectangles, first along the row, then down the following rows while
+*   the whole run matches. A full band is one quad.
+*
+*   Checkerboard tint does not break merging: quads are drawn with a bricks atlas
+*   (GenImageBrickAtlas()), a bricks grid already tinted per state, quad source is a
+*   rectangle of cells in atlas with same tints pattern (GetBrickAtlasSourceRec()), the
+*   output is identical to one textured quad per brick.
+*
+*   Meshes are updated incrementally: band cells are kept with the mesh, UpdateBrickMesh()
+*   only re-meshes a band when its cells changed (brick destroyed or hit, row landed,
+*   chunk recycled), unchanged bands cost one compare.
+*
+*   Vertices counts before and after merging are available as bricksCount and quadsCount
+*   (4 vertices per quad).
+*
+*   USAGE:
+*       Image brick = LoadImage("resources/brick.png");
+*       Color tints[2] = { GRAY, DARKGRAY };    // Even and odd cells, per state
+*       Texture2D atlas = LoadTextureFromImage(GenImageBrickAtlas(brick, tints, 1));
+*
+*       // Every frame, every band: grid cells states (row after row), re-meshed only if changed
+*       BrickMesh *mesh = &meshes[band];
+*       UpdateBrickMesh(mesh, cells, rows, columns, bandRow*BRICK_MESH_MAX_ROWS, bandColumn*BRICK_MESH_MAX_COLUMNS);
+*       for (int i = 0; i < mesh->quadsCount; i++)
+*       {
+*           BrickQuad quad = mesh->quads[i];
+*           Rectangle source = GetBrickAtlasSourceRec(quad, mesh->firstRow + quad.row, mesh->firstColumn + quad.column, brickSize);
+*           // Draw source atlas area at quad position...
+*       }
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef BRICK_MESH_H
+#define BRICK_MESH_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BRICK_MESH_MAX_ROWS         8       // Rows per band (endless field chunk rows)
+#define BRICK_MESH_MAX_COLUMNS      20      // Columns per band (bricks per line)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Merged bricks quad, in cells units, relative to band
+typedef struct BrickQuad {
+    unsigned char column;       // First column
+    unsigned char row;          // First row (band rows order)
+    unsigned char width;        // Columns merged
+    unsigned char height;       // Rows merged
+    unsigned char state;        // Cells state, atlas section (1..states)
+} BrickQuad;
+
+// Bricks band mesh
+typedef struct BrickMesh {
+    int firstRow;               // Band origin row in grid
+    int firstColumn;            // Band origin column in grid
+    int rows;                   // Band rows
+    int columns;                // Band columns
+    unsigned char cells[BRICK_MESH_MAX_ROWS*BRICK_MESH_MAX_COLUMNS];    // Cells states meshed (0: empty)
+    BrickQuad quads[BRICK_MESH_MAX_ROWS*BRICK_MESH_MAX_COLUMNS];        // Merged quads
+    int quadsCount;             // Merged quads (4 vertices each)
+    int bricksCount;            // Non-empty cells, quads without merging
+    bool ready;                 // Mesh built at least once
+} BrickMesh;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool UpdateBrickMesh(BrickMesh *mesh, const unsigned char *cells, int rows, int columns, int firstRow, int firstColumn);  // Re-mesh grid band at origin cell if its cells changed, returns true if re-meshed
+
+Image GenImageBrickAtlas(Image brick, const Color *tints, int states);             // Generate bricks atlas, tints: even and odd cells tint per state
+Rectangle GetBrickAtlasSourceRec(BrickQuad quad, int topRow, int leftColumn, Vector2 brickSize);  // Get quad cells area in atlas, grid cell drawn at quad top-left
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // BRICK_MESH_H
@@ -0,0 +1,125 @@
+/**********************************************************************************************
+*
+*   camera_view - 2D camera over boards larger than the screen (pan, zoom, visible area)
+*
+*   NOTE: Check camera_view.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "camera_view.h"
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ClampCameraView(CameraView *view);      // Keep zoom in range and view inside world bounds
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize camera view, world bounds top-left at screen origin, zoom 1
+CameraView InitCameraView(Vector2 screenSize, Rectangle bounds)
+{
+    CameraView view = { 0 };
+
+    view.camera.offset = (Vector2){ 0.0f, 0.0f };
+    view.camera.target = (Vector2){ bounds.x, bounds.y };
+    view.camera.rotation = 0.0f;
+    view.camera.zoom = 1.0f;
+    view.screenSize = screenSize;
+    view.bounds = bounds;
+
+    ClampCameraView(&view);
+
+    return view;
+}
+
+// Set world bounds (board grown or shrunk), view kept inside
+void SetCameraViewBounds(CameraView *view, Rectangle bounds)
+{
+    view->bounds = bounds;
+
+    ClampCameraView(view);
+}
+
+// Move view by screen pixels
+// NOTE: View moves opposite to delta, dragged world follows cursor
+void PanCameraView(CameraView *view, Vector2 screenDelta)
+{
+    view->camera.target.x -= screenDelta.x/view->camera.zoom;
+    view->camera.target.y -= screenDelta.y/view->camera.zoom;
+
+    ClampCameraView(view);
+}
+
+// Scale zoom, world point under screen anchor stays fixed
+void ZoomCameraView(CameraView *view, float factor, Vector2 screenAnchor)
+{
+    if (factor == 1.0f) return;
+
+    // World point under anchor, before zoom
+    Vector2 anchor = { view->camera.target.x + screenAnchor.x/view->camera.zoom, view->camera.target.y + screenAnchor.y/view->camera.zoom };
+
+    view->camera.zoom *= factor;
+    ClampCameraView(view);
+
+    view->camera.target = (Vector2){ anchor.x - screenAnchor.x/view->camera.zoom, anchor.y - screenAnchor.y/view->camera.zoom };
+    ClampCameraView(view);
+}
+
+// Center view on world position, view kept inside
+void CenterCameraView(CameraView *view, Vector2 position)
+{
+    Rectangle visible = GetCameraViewRec(*view);
+
+    view->camera.target = (Vector2){ position.x - visible.width/2.0f, position.y - visible.height/2.0f };
+
+    ClampCameraView(view);
+}
+
+// Zoom 1, world bounds bottom-left corner on screen
+// NOTE: Boards grow upwards (endless mode rows), screen area stays at bottom of bounds
+void ResetCameraView(CameraView *view)
+{
+    view->camera.zoom = 1.0f;
+    view->camera.target = (Vector2){ view->bounds.x, view->bounds.y + view->bounds.height - view->screenSize.y };
+
+    ClampCameraView(view);
+}
+
+// Get visible world rectangle
+Rectangle GetCameraViewRec(CameraView view)
+{
+    return (Rectangle){ view.camera.target.x, view.camera.target.y, view.screenSize.x/view.camera.zoom, view.screenSize.y/view.camera.zoom };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Keep zoom in range and view inside world bounds
+// NOTE: Zooming out is limited to whole bounds fitting on screen (zoom 1 always allowed),
+// a view larger than bounds on one axis is centered on that axis
+static void ClampCameraView(CameraView *view)
+{
+    float minZoom = 1.0f;
+    if ((view->bounds.width > 0.0f) && ((view->screenSize.x/view->bounds.width) < minZoom)) minZoom = view->screenSize.x/view->bounds.width;
+    if ((view->bounds.height > 0.0f) && ((view->screenSize.y/view->bounds.height) < minZoom)) minZoom = view->screenSize.y/view->bounds.height;
+
+    if (view->camera.zoom < minZoom) view->camera.zoom = minZoom;
+    if (view->camera.zoom > CAMERA_VIEW_MAX_ZOOM) view->camera.zoom = CAMERA_VIEW_MAX_ZOOM;
+
+    Rectangle visible = GetCameraViewRec(*view);
+
+    if (visible.width >= view->bounds.width) view->camera.target.x = view->bounds.x + (view->bounds.width - visible.width)/2.0f;
+    else if (visible.x < view->bounds.x) view->camera.target.x = view->bounds.x;
+    else if ((visible.x + visible.width) > (view->bounds.x + view->bounds.width)) view->camera.target.x = view->bounds.x + view->bounds.width - visible.width;
+
+    if (visible.height >= view->bounds.height) view->camera.target.y = view->bounds.y + (view->bounds.height - visible.height)/2.0f;
+    else if (visible.y < view->bounds.y) view->camera.target.y = view->bounds.y;
+    else if ((visible.y + visible.height) > (view->bounds.y + view->bounds.height)) view->camera.target.y = view->bounds.y + view->bounds.height - visible.height;
+}
@@ -0,0 +1,73 @@
+/**********************************************************************************************
+*
+*   camera_view - 2D camera over boards larger than the screen (pan, zoom, visible area)
+*
+*   Wraps a raylib Camera2D used with BeginMode2D(): camera can be panned and zoomed
+*   (zoom keeps world point under anchor fixed) and it is kept inside world bounds,
+*   when zoomed out past bounds size the board is centered.
+*
+*   Drawing code culls with visible area: GetCameraViewRec() returns world rectangle on
+*   screen, it is queried against bricks grid (GetGridRangeRec(), check collision.h) so
+*   only cells on screen are visited, frame cost depends on what is visible, not on board
+*   size. Default camera (zoom 1, bounds = screen) draws exactly as without camera.
+*
+*   USAGE:
+*       CameraView view = InitCameraView((Vector2){ screenWidth, screenHeight }, boardBounds);
+*
+*       // Every frame
+*       if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) PanCameraView(&view, GetMouseDelta());
+*       ZoomCameraView(&view, 1.0f + 0.1f*GetMouseWheelMove(), GetMousePosition());
+*
+*       GridRange visible = GetGridRangeRec(GetCameraViewRec(view), origin, cellSize, columns, rows);
+*       BeginMode2D(view.camera);
+*           // Draw visible cells only
+*       EndMode2D();
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef CAMERA_VIEW_H
+#define CAMERA_VIEW_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define CAMERA_VIEW_MAX_ZOOM        4.0f    // Maximum zoom in (minimum zoom out fits world bounds)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Camera view over world
+// NOTE: Camera offset is kept at screen origin, camera target is visible area top-left corner
+typedef struct CameraView {
+    Camera2D camera;            // raylib camera, to be used with BeginMode2D()
+    Vector2 screenSize;         // Viewport size (pixels)
+    Rectangle bounds;           // World area camera can show
+} CameraView;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+CameraView InitCameraView(Vector2 screenSize, Rectangle bounds);       // Initialize camera view, world bounds top-left at screen origin, zoom 1
+void SetCameraViewBounds(CameraView *view, Rectangle bounds);           // Set world bounds (board grown or shrunk), view kept inside
+void PanCameraView(CameraView *view, Vector2 screenDelta);              // Move view by screen pixels (dragging moves world with cursor)
+void ZoomCameraView(CameraView *view, float factor, Vector2 screenAnchor);  // Scale zoom, world point under screen anchor stays fixed
+void CenterCameraView(CameraView *view, Vector2 position);              // Center view on world position (following a moving target), view kept inside
+void ResetCameraView(CameraView *view);                                 // Zoom 1, world bounds bottom-left corner on screen
+Rectangle GetCameraViewRec(CameraView view);                            // Get visible world rectangle
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // CAMERA_VIEW_H
@@ -0,0 +1,628 @@
+/**********************************************************************************************
+*
+*   clip_recorder - In-game clips recording (animated GIF or raw video) on a worker thread
+*
+*   NOTE: Check clip_recorder.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "clip_recorder.h"
+
+#include "screen_readback.h"    // Required for: ReadScreenPixelsInto(), FlipScreenPixels()
+#include "threads.h"            // Required for: StartThread(), LockMutex(), WaitCondition()...
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan(), ReleaseTraceThread()...
+
+#include <stdio.h>              // Required for: FILE, fopen(), fwrite(), fclose()
+#include <stdlib.h>             // Required for: qsort()
+#include <string.h>             // Required for: memcpy(), memset()
+
+#if !defined(CLIP_RECORDER_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>  // SSE2 intrinsics
+        #define CLIP_SSE2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>   // NEON intrinsics
+        #define CLIP_NEON
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GIF_PALETTE_SIZE            256     // Colors per frame palette
+#define GIF_HISTOGRAM_SIZE        65536     // Colors histogram bins (RGB565)
+#define GIF_LZW_MIN_CODE_SIZE         8     // LZW initial code size (bits per index)
+#define GIF_LZW_MAX_CODE           4095     // LZW maximum code (12 bits)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Histogram bin, colors falling in same RGB565 key
+typedef struct ColorBin {
+    unsigned int count;             // Pixels in bin
+    unsigned int sumR, sumG, sumB;  // Pixels color sums, bin color is their average
+} ColorBin;
+
+// LZW bit writer, codes packed LSB first
+typedef struct LzwWriter {
+    unsigned char *data;            // Output data (GIF sub-blocks not included)
+    int size;                       // Output data size
+    unsigned int bits;              // Pending bits
+    int bitsCount;                  // Pending bits count
+} LzwWriter;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static bool recording = false;                  // Clip recording started
+static FILE *clipFile = NULL;                   // Clip output file
+static ClipFormat clipFormat = CLIP_FORMAT_GIF; // Clip output format
+static int clipWidth = 0;                       // Clip frames width
+static int clipHeight = 0;                      // Clip frames height
+static int clipFps = 0;                         // Clip frames per second
+static ClipRecorderStats stats = { 0 };         // Recording statistics (protected by ringMutex)
+
+// Ring buffer, written by main thread, read by worker
+static unsigned char *ringBuffer = NULL;        // Frames slots (CLIP_RING_FRAMES*width*height*4)
+static int ringWrite = 0;                       // Next slot to write (main thread only)
+static int ringRead = 0;                        // Next slot to encode (worker only)
+static int ringCount = 0;                       // Slots written, waiting to be encoded (protected by ringMutex)
+static bool ringFlip[CLIP_RING_FRAMES] = { 0 }; // Slot read from screen, rows bottom-up (flipped by worker)
+
+static Thread worker = { 0 };                   // Encoding worker thread
+static Mutex ringMutex = { 0 };                 // Ring buffer state lock
+static Condition ringCond = { 0 };              // Signaled on new frames and on stop request
+static bool workerRunning = false;              // Worker thread started (false on platforms without threads)
+static bool stopRequested = false;              // Worker must exit once ring buffer is empty
+
+// GIF encoder state, used only by worker
+static int gifFrameIndex = 0;                   // Frames written, used for delays
+static unsigned short *gifKeys = NULL;          // Frame pixels RGB565 keys
+static unsigned char *gifIndices = NULL;        // Frame pixels palette indices
+static ColorBin *gifBins = NULL;                // Colors histogram (GIF_HISTOGRAM_SIZE)
+static unsigned short *gifUsedBins = NULL;      // Histogram bins used by current frame
+static unsigned char *gifBinIndex = NULL;       // Palette index for every histogram bin
+static unsigned short (*gifLzwTree)[256] = NULL;    // LZW dictionary: code for (prefix code, index)
+static LzwWriter gifLzw = { 0 };                // LZW output
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ClipWorker(void *arg);                          // Worker thread: encode frames until stop is requested
+static Color *ReserveClipSlot(void);                        // Get next free ring slot, NULL if ring is full (frame dropped)
+static void SubmitClipSlot(bool flip);                      // Publish written slot to worker
+static void EncodeClipFrame(int slot);                      // Encode and write one ring slot frame
+static void WriteGifHeader(void);                           // Write GIF header and looping extension
+static void WriteGifFrame(const Color *pixels);             // Quantize, LZW encode and write GIF frame
+static void ComputeColorKeys(const Color *pixels, unsigned short *keys, int count); // Pack pixels into RGB565 keys
+static int BuildPalette(const Color *pixels, int pixelsCount, Color *palette); // Build frame palette from colors histogram, returns colors count
+static void EncodeLzw(const unsigned char *indices, int count); // LZW encode palette indices into gifLzw
+static int CompareBinsCount(const void *a, const void *b);  // Sort histogram bins by count (descending)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Start recording clip
+bool StartClipRecording(const char *fileName, int width, int height, int fps, ClipFormat format)
+{
+    if (recording) StopClipRecording();
+
+    if ((width <= 0) || (height <= 0) || (fps <= 0)) return false;
+
+    int pixelsCount = width*height;
+
+    clipFile = fopen(fileName, "wb");
+
+    if (clipFile == NULL)
+    {
+        TraceLog(LOG_WARNING, "CLIP: [%s] Failed to open file for writing", fileName);
+        return false;
+    }
+
+    // NOTE: All memory is allocated on start, nothing is allocated while recording
+    ringBuffer = (unsigned char *)RL_MALLOC((size_t)CLIP_RING_FRAMES*pixelsCount*sizeof(Color));
+
+    if (format == CLIP_FORMAT_GIF)
+    {
+        gifKeys = (unsigned short *)RL_MALLOC(pixelsCount*sizeof(unsigned short));
+        gifIndices = (unsigned char *)RL_MALLOC(pixelsCount);
+        gifBins = (ColorBin *)RL_CALLOC(GIF_HISTOGRAM_SIZE, sizeof(ColorBin));
+        gifUsedBins = (unsigned short *)RL_MALLOC(GIF_HISTOGRAM_SIZE*sizeof(unsigned short));
+        gifBinIndex = (unsigned char *)RL_MALLOC(GIF_HISTOGRAM_SIZE);
+        gifLzwTree = (unsigned short (*)[256])RL_MALLOC((GIF_LZW_MAX_CODE + 1)*sizeof(*gifLzwTree));
+        gifLzw.data = (unsigned char *)RL_MALLOC(2*pixelsCount + 64);   // Worst case: 12 bits per index
+    }
+
+    clipFormat = format;
+    clipWidth = width;
+    clipHeight = height;
+    clipFps = fps;
+    gifFrameIndex = 0;
+
+    ringWrite = 0;
+    ringRead = 0;
+    ringCount = 0;
+    stats = (ClipRecorderStats){ 0 };
+    stopRequested = false;
+
+    if (clipFormat == CLIP_FORMAT_GIF) WriteGifHeader();
+
+    InitMutex(&ringMutex);
+    InitCondition(&ringCond);
+
+    workerRunning = StartThread(&worker, ClipWorker, NULL);
+    recording = true;
+
+    TraceLog(LOG_INFO, "CLIP: [%s] Recording started (%ix%i, %i fps, %s, %s)", fileName, width, height, fps,
+        (format == CLIP_FORMAT_GIF)? "GIF" : "RAW", workerRunning? "worker thread" : "main thread encoding");
+
+    return true;
+}
+
+// Stop recording clip
+// NOTE: Pending frames are encoded before returning, it can take some time
+void StopClipRecording(void)
+{
+    if (!recording) return;
+
+    if (workerRunning)
+    {
+        LockMutex(&ringMutex);
+        stopRequested = true;
+        SignalCondition(&ringCond);
+        UnlockMutex(&ringMutex);
+
+        JoinThread(&worker);
+        workerRunning = false;
+    }
+    else while (ringCount > 0) UpdateClipRecorder();
+
+    if (clipFormat == CLIP_FORMAT_GIF) fputc(0x3b, clipFile);     // GIF trailer
+
+    fclose(clipFile);
+    clipFile = NULL;
+
+    DestroyCondition(&ringCond);
+    DestroyMutex(&ringMutex);
+
+    RL_FREE(ringBuffer);
+    RL_FREE(gifKeys);
+    RL_FREE(gifIndices);
+    RL_FREE(gifBins);
+    RL_FREE(gifUsedBins);
+    RL_FREE(gifBinIndex);
+    RL_FREE(gifLzwTree);
+    RL_FREE(gifLzw.data);
+
+    ringBuffer = NULL;
+    gifKeys = NULL;
+    gifIndices = NULL;
+    gifBins = NULL;
+    gifUsedBins = NULL;
+    gifBinIndex = NULL;
+    gifLzwTree = NULL;
+    gifLzw.data = NULL;
+
+    recording = false;
+
+    TraceLog(LOG_INFO, "CLIP: Recording stopped (frames encoded: %i, dropped: %i)", stats.framesEncoded, stats.framesDropped);
+
+    if (clipFormat == CLIP_FORMAT_RAW)
+    {
+        TraceLog(LOG_INFO, "CLIP: Raw frames format: -f rawvideo -pixel_format rgba -video_size %ix%i -framerate %i", clipWidth, clipHeight, clipFps);
+    }
+}
+
+// Check if clip is being recorded
+bool IsClipRecording(void)
+{
+    return recording;
+}
+
+// Copy frame into ring buffer
+// NOTE: Copy is done without holding the lock, slot is only published to worker once written
+void CaptureClipFrame(const Color *pixels)
+{
+    if (!recording || (pixels == NULL)) return;
+
+    Color *slot = ReserveClipSlot();
+    if (slot == NULL) return;
+
+    memcpy(slot, pixels, (size_t)clipWidth*clipHeight*sizeof(Color));
+
+    SubmitClipSlot(false);
+}
+
+// Copy current screen into ring buffer
+// NOTE: Screen is read straight into ring slot (GPU to CPU copy on main thread, no allocation),
+// rows flip is done by worker; screen is read at clip size, it should match screen render size
+void CaptureClipScreen(void)
+{
+    if (!recording) return;
+
+    Color *slot = ReserveClipSlot();
+    if (slot == NULL) return;
+
+    ReadScreenPixelsInto(slot, clipWidth, clipHeight);
+
+    SubmitClipSlot(true);
+}
+
+// Encode one pending frame if there is no worker thread
+void UpdateClipRecorder(void)
+{
+    if (!recording || workerRunning || (ringCount == 0)) return;
+
+    EncodeClipFrame(ringRead);
+
+    ringRead = (ringRead + 1)%CLIP_RING_FRAMES;
+    ringCount--;
+    stats.framesEncoded++;
+}
+
+// Get clip recording statistics
+ClipRecorderStats GetClipRecorderStats(void)
+{
+    if (!recording) return stats;
+
+    LockMutex(&ringMutex);
+    ClipRecorderStats current = stats;
+    current.framesPending = ringCount;
+    UnlockMutex(&ringMutex);
+
+    return current;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Worker thread: encode frames until stop is requested
+// NOTE: Pending frames are always encoded before exiting
+static void ClipWorker(void *arg)
+{
+    (void)arg;
+
+    SetTraceThreadName("clip_recorder");
+
+    LockMutex(&ringMutex);
+
+    while (true)
+    {
+        while ((ringCount == 0) && !stopRequested) WaitCondition(&ringCond, &ringMutex);
+
+        if (ringCount == 0) break;      // Stop requested and nothing left to encode
+
+        int slot = ringRead;
+
+        UnlockMutex(&ringMutex);
+        EncodeClipFrame(slot);
+        LockMutex(&ringMutex);
+
+        ringRead = (ringRead + 1)%CLIP_RING_FRAMES;
+        ringCount--;
+        stats.framesEncoded++;
+    }
+
+    UnlockMutex(&ringMutex);
+
+    ReleaseTraceThread();
+}
+
+// Get next free ring slot, NULL if ring is full (frame dropped)
+// NOTE: Only main thread writes slots, ringWrite slot is free while ring is not full
+static Color *ReserveClipSlot(void)
+{
+    LockMutex(&ringMutex);
+    bool full = (ringCount == CLIP_RING_FRAMES);
+    if (full) stats.framesDropped++;
+    UnlockMutex(&ringMutex);
+
+    if (full) return NULL;
+
+    return (Color *)(ringBuffer + (size_t)ringWrite*clipWidth*clipHeight*sizeof(Color));
+}
+
+// Publish written slot to worker
+static void SubmitClipSlot(bool flip)
+{
+    ringFlip[ringWrite] = flip;
+    ringWrite = (ringWrite + 1)%CLIP_RING_FRAMES;
+
+    LockMutex(&ringMutex);
+    ringCount++;
+    stats.framesCaptured++;
+    SignalCondition(&ringCond);
+    UnlockMutex(&ringMutex);
+}
+
+// Encode and write one ring slot frame
+// NOTE: Screen readback slots are flipped here, on worker, before encoding
+static void EncodeClipFrame(int slot)
+{
+    Color *pixels = (Color *)(ringBuffer + (size_t)slot*clipWidth*clipHeight*sizeof(Color));
+
+    BeginTraceSpan("EncodeClipFrame", NULL);
+
+    if (ringFlip[slot]) FlipScreenPixels(pixels, clipWidth, clipHeight);
+
+    if (clipFormat == CLIP_FORMAT_GIF) WriteGifFrame(pixels);
+    else fwrite(pixels, sizeof(Color), (size_t)clipWidth*clipHeight, clipFile);
+
+    EndTraceSpan();
+}
+
+// Write GIF header and looping extension
+static void WriteGifHeader(void)
+{
+    unsigned char header[13] = { 'G', 'I', 'F', '8', '9', 'a',
+        (unsigned char)(clipWidth & 0xff), (unsigned char)(clipWidth >> 8),
+        (unsigned char)(clipHeight & 0xff), (unsigned char)(clipHeight >> 8),
+        0x00,           // No global color table, palettes are local to every frame
+        0x00, 0x00 };   // Background color index, pixel aspect ratio
+
+    // Application extension: loop forever
+    unsigned char loop[19] = { 0x21, 0xff, 0x0b, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00 };
+
+    fwrite(header, 1, sizeof(header), clipFile);
+    fwrite(loop, 1, sizeof(loop), clipFile);
+}
+
+// Quantize, LZW encode and write GIF frame
+static void WriteGifFrame(const Color *pixels)
+{
+    int pixelsCount = clipWidth*clipHeight;
+
+    // Palette quantization: pixels are binned by RGB565 key, most used bins become the palette
+    Color palette[GIF_PALETTE_SIZE] = { 0 };
+    ComputeColorKeys(pixels, gifKeys, pixelsCount);
+    BuildPalette(pixels, pixelsCount, palette);
+
+    for (int i = 0; i < pixelsCount; i++) gifIndices[i] = gifBinIndex[gifKeys[i]];
+
+    EncodeLzw(gifIndices, pixelsCount);
+
+    // Frame delay in hundredths of second, rounding error is not accumulated
+    int delay = (100*(gifFrameIndex + 1) + clipFps/2)/clipFps - (100*gifFrameIndex + clipFps/2)/clipFps;
+    gifFrameIndex++;
+
+    // Graphic control extension: delay, frame is not disposed (full frames)
+    unsigned char control[8] = { 0x21, 0xf9, 0x04, 0x04, (unsigned char)(delay & 0xff), (unsigned char)(delay >> 8), 0x00, 0x00 };
+
+    // Image descriptor: full frame, local color table of 256 entries
+    unsigned char descriptor[10] = { 0x2c, 0x00, 0x00, 0x00, 0x00,
+        (unsigned char)(clipWidth & 0xff), (unsigned char)(clipWidth >> 8),
+        (unsigned char)(clipHeight & 0xff), (unsigned char)(clipHeight >> 8), 0x87 };
+
+    unsigned char colors[GIF_PALETTE_SIZE*3] = { 0 };
+    for (int i = 0; i < GIF_PALETTE_SIZE; i++)
+    {
+        colors[i*3 + 0] = palette[i].r;
+        colors[i*3 + 1] = palette[i].g;
+        colors[i*3 + 2] = palette[i].b;
+    }
+
+    fwrite(control, 1, sizeof(control), clipFile);
+    fwrite(descriptor, 1, sizeof(descriptor), clipFile);
+    fwrite(colors, 1, sizeof(colors), clipFile);
+    fputc(GIF_LZW_MIN_CODE_SIZE, clipFile);
+
+    // Image data split in sub-blocks of up to 255 bytes
+    for (int offset = 0; offset < gifLzw.size; offset += 255)
+    {
+        int blockSize = ((gifLzw.size - offset) > 255)? 255 : (gifLzw.size - offset);
+
+        fputc(blockSize, clipFile);
+        fwrite(gifLzw.data + offset, 1, blockSize, clipFile);
+    }
+
+    fputc(0x00, clipFile);      // Block terminator
+}
+
+// Pack pixels into RGB565 keys
+// NOTE: 8 pixels per iteration with SIMD, same bits as scalar path
+static void ComputeColorKeys(const Color *pixels, unsigned short *keys, int count)
+{
+    int i = 0;
+
+#if defined(CLIP_SSE2)
+    const __m128i maskR = _mm_set1_epi32(0x0000f8);
+    const __m128i maskG = _mm_set1_epi32(0x00fc00);
+    const __m128i maskB = _mm_set1_epi32(0xf80000);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i *)(pixels + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i *)(pixels + i + 4));
+
+        __m128i k0 = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p0, maskR), 8),
+                     _mm_srli_epi32(_mm_and_si128(p0, maskG), 5)), _mm_srli_epi32(_mm_and_si128(p0, maskB), 19));
+        __m128i k1 = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p1, maskR), 8),
+                     _mm_srli_epi32(_mm_and_si128(p1, maskG), 5)), _mm_srli_epi32(_mm_and_si128(p1, maskB), 19));
+
+        // NOTE: Keys are 16bit unsigned, sign-extended before signed saturating pack to keep all bits
+        k0 = _mm_srai_epi32(_mm_slli_epi32(k0, 16), 16);
+        k1 = _mm_srai_epi32(_mm_slli_epi32(k1, 16), 16);
+
+        _mm_storeu_si128((__m128i *)(keys + i), _mm_packs_epi32(k0, k1));
+    }
+#elif defined(CLIP_NEON)
+    const uint32x4_t maskR = vdupq_n_u32(0x0000f8);
+    const uint32x4_t maskG = vdupq_n_u32(0x00fc00);
+    const uint32x4_t maskB = vdupq_n_u32(0xf80000);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint32x4_t p0 = vld1q_u32((const uint32_t *)(pixels + i));
+        uint32x4_t p1 = vld1q_u32((const uint32_t *)(pixels + i + 4));
+
+        uint32x4_t k0 = vorrq_u32(vorrq_u32(vshlq_n_u32(vandq_u32(p0, maskR), 8),
+                        vshrq_n_u32(vandq_u32(p0, maskG), 5)), vshrq_n_u32(vandq_u32(p0, maskB), 19));
+        uint32x4_t k1 = vorrq_u32(vorrq_u32(vshlq_n_u32(vandq_u32(p1, maskR), 8),
+                        vshrq_n_u32(vandq_u32(p1, maskG), 5)), vshrq_n_u32(vandq_u32(p1, maskB), 19));
+
+        vst1q_u16(keys + i, vcombine_u16(vmovn_u32(k0), vmovn_u32(k1)));
+    }
+#endif
+
+    for (; i < count; i++) keys[i] = (unsigned short)(((pixels[i].r >> 3) << 11) | ((pixels[i].g >> 2) << 5) | (pixels[i].b >> 3));
+}
+
+// Build frame palette from colors histogram, returns colors count
+// NOTE: Bin color is the average of its pixels, frames with up to 256 bins keep their exact colors
+// (games use few flat colors); otherwise most used bins and a colors cube are kept, rest mapped to nearest
+static int BuildPalette(const Color *pixels, int pixelsCount, Color *palette)
+{
+    int usedCount = 0;
+
+    for (int i = 0; i < pixelsCount; i++)
+    {
+        unsigned short key = gifKeys[i];
+        ColorBin *bin = &gifBins[key];
+
+        if (bin->count == 0) gifUsedBins[usedCount++] = key;
+
+        bin->count++;
+        bin->sumR += pixels[i].r;
+        bin->sumG += pixels[i].g;
+        bin->sumB += pixels[i].b;
+    }
+
+    if (usedCount > GIF_PALETTE_SIZE) qsort(gifUsedBins, usedCount, sizeof(unsigned short), CompareBinsCount);
+
+    // NOTE: When bins do not fit, half the palette is a uniform 4x8x4 colors cube,
+    // it bounds the error of colors far from the most used ones (i.e. gradients)
+    int popularCount = (usedCount > GIF_PALETTE_SIZE)? GIF_PALETTE_SIZE/2 : usedCount;
+    int colorsCount = (usedCount > GIF_PALETTE_SIZE)? GIF_PALETTE_SIZE : usedCount;
+
+    for (int i = 0; i < popularCount; i++)
+    {
+        ColorBin bin = gifBins[gifUsedBins[i]];
+        unsigned int r = (bin.sumR + bin.count/2)/bin.count;
+        unsigned int g = (bin.sumG + bin.count/2)/bin.count;
+        unsigned int b = (bin.sumB + bin.count/2)/bin.count;
+
+        palette[i] = (Color){ (unsigned char)r, (unsigned char)g, (unsigned char)b, 255 };
+        gifBinIndex[gifUsedBins[i]] = (unsigned char)i;
+    }
+
+    for (int i = popularCount; i < colorsCount; i++)
+    {
+        int cube = i - popularCount;
+        palette[i] = (Color){ (unsigned char)((cube >> 5)*85), (unsigned char)(((cube >> 2) & 0x7)*255/7), (unsigned char)((cube & 0x3)*85), 255 };
+    }
+
+    for (int i = popularCount; i < usedCount; i++)
+    {
+        unsigned short key = gifUsedBins[i];
+        ColorBin bin = gifBins[key];
+        int r = (int)(bin.sumR/bin.count);
+        int g = (int)(bin.sumG/bin.count);
+        int b = (int)(bin.sumB/bin.count);
+        int nearest = 0;
+        int nearestDistance = 0x7fffffff;
+
+        for (int c = 0; c < colorsCount; c++)
+        {
+            int dr = r - palette[c].r;
+            int dg = g - palette[c].g;
+            int db = b - palette[c].b;
+            int distance = dr*dr + dg*dg + db*db;
+
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                nearest = c;
+            }
+        }
+
+        gifBinIndex[key] = (unsigned char)nearest;
+    }
+
+    // Clear only used bins for next frame
+    for (int i = 0; i < usedCount; i++) gifBins[gifUsedBins[i]] = (ColorBin){ 0 };
+
+    return colorsCount;
+}
+
+// Append code to LZW output
+static inline void WriteLzwCode(LzwWriter *writer, unsigned int code, int codeSize)
+{
+    writer->bits |= (code << writer->bitsCount);
+    writer->bitsCount += codeSize;
+
+    while (writer->bitsCount >= 8)
+    {
+        writer->data[writer->size++] = (unsigned char)(writer->bits & 0xff);
+        writer->bits >>= 8;
+        writer->bitsCount -= 8;
+    }
+}
+
+// LZW encode palette indices into gifLzw
+// NOTE: Dictionary stores, for every code, the code for each possible next index (0 - not defined)
+static void EncodeLzw(const unsigned char *indices, int count)
+{
+    const unsigned int clearCode = 1 << GIF_LZW_MIN_CODE_SIZE;
+    int codeSize = GIF_LZW_MIN_CODE_SIZE + 1;
+    unsigned int maxCode = clearCode + 1;
+
+    gifLzw.size = 0;
+    gifLzw.bits = 0;
+    gifLzw.bitsCount = 0;
+
+    memset(gifLzwTree, 0, (GIF_LZW_MAX_CODE + 1)*sizeof(*gifLzwTree));
+
+    WriteLzwCode(&gifLzw, clearCode, codeSize);
+
+    unsigned int current = indices[0];
+
+    for (int i = 1; i < count; i++)
+    {
+        unsigned char next = indices[i];
+
+        if (gifLzwTree[current][next] != 0) current = gifLzwTree[current][next];
+        else
+        {
+            WriteLzwCode(&gifLzw, current, codeSize);
+
+            gifLzwTree[current][next] = (unsigned short)(++maxCode);
+
+            // Dictionary size crossed a power of two, codes need one more bit
+            if (maxCode >= (1u << codeSize)) codeSize++;
+
+            // Dictionary full, clear it and start again
+            if (maxCode == GIF_LZW_MAX_CODE)
+            {
+                WriteLzwCode(&gifLzw, clearCode, codeSize);
+                memset(gifLzwTree, 0, (GIF_LZW_MAX_CODE + 1)*sizeof(*gifLzwTree));
+                codeSize = GIF_LZW_MIN_CODE_SIZE + 1;
+                maxCode = clearCode + 1;
+            }
+
+            current = next;
+        }
+    }
+
+    WriteLzwCode(&gifLzw, current, codeSize);
+    WriteLzwCode(&gifLzw, clearCode + 1, codeSize);     // End of information code
+
+    if (gifLzw.bitsCount > 0) gifLzw.data[gifLzw.size++] = (unsigned char)(gifLzw.bits & 0xff);
+}
+
+// Sort histogram bins by count (descending), ties by key to keep palettes deterministic
+static int CompareBinsCount(const void *a, const void *b)
+{
+    unsigned short keyA = *(const unsigned short *)a;
+    unsigned short keyB = *(const unsigned short *)b;
+
+    if (gifBins[keyA].count != gifBins[keyB].count) return (gifBins[keyA].count > gifBins[keyB].count)? -1 : 1;
+
+    return (keyA < keyB)? -1 : 1;
+}
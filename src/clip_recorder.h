@@ -0,0 +1,90 @@
+/**********************************************************************************************
+*
+*   clip_recorder - In-game clips recording (animated GIF or raw video) on a worker thread
+*
+*   Recorded frames are copied into a ring buffer of preallocated slots, a worker thread
+*   takes them from there and does all the heavy work:
+*     - GIF: palette quantization (RGB565 histogram, SIMD key packing), LZW encoding, file writing
+*     - RAW: frames appended to file as RGBA8 (i.e. to be encoded later with ffmpeg)
+*
+*   Main thread only pays a memcpy per recorded frame (screen frames: readback straight into
+*   the ring slot, rows flipped by worker). If the worker can not keep up and
+*   the ring buffer is full, new frames are dropped (and counted), main loop never waits.
+*
+*   Frames can come from any CPU framebuffer (i.e. softrender, headless runs) with
+*   CaptureClipFrame() or from the current screen with CaptureClipScreen() (GPU readback).
+*
+*   CONFIGURATION:
+*       #define CLIP_RECORDER_NO_SIMD
+*           Use scalar color keys packing only
+*
+*   NOTE: On web without pthreads, frames are encoded on main thread by UpdateClipRecorder(),
+*   one frame per call, so encoding cost is spread along frames
+*
+*   USAGE:
+*       StartClipRecording("clip.gif", 800, 450, 30, CLIP_FORMAT_GIF);
+*
+*       // Every frame, after drawing
+*       CaptureClipFrame(target.pixels);
+*       UpdateClipRecorder();
+*
+*       StopClipRecording();        // Encode remaining frames and close file
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef CLIP_RECORDER_H
+#define CLIP_RECORDER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(CLIP_RING_FRAMES)
+    #define CLIP_RING_FRAMES        16      // Frames slots in ring buffer (800x450: 23 MB), worker delay absorbed
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Clip output format
+typedef enum ClipFormat {
+    CLIP_FORMAT_GIF = 0,            // Animated GIF, 256 colors palette per frame
+    CLIP_FORMAT_RAW                 // Raw RGBA8 frames, no header
+} ClipFormat;
+
+// Clip recording statistics
+typedef struct ClipRecorderStats {
+    int framesCaptured;             // Frames copied into ring buffer
+    int framesEncoded;              // Frames encoded and written by worker
+    int framesDropped;              // Frames dropped, ring buffer full
+    int framesPending;              // Frames waiting to be encoded
+} ClipRecorderStats;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool StartClipRecording(const char *fileName, int width, int height, int fps, ClipFormat format); // Start recording clip, fps defines frames delay
+void StopClipRecording(void);                   // Stop recording, wait for pending frames to be encoded and close file
+bool IsClipRecording(void);                     // Check if clip is being recorded
+
+void CaptureClipFrame(const Color *pixels);     // Copy frame (width*height RGBA8 pixels) into ring buffer
+void CaptureClipScreen(void);                   // Copy current screen into ring buffer (call after drawing, before EndDrawing())
+void UpdateClipRecorder(void);                  // Encode one pending frame if there is no worker thread (call once per frame)
+
+ClipRecorderStats GetClipRecorderStats(void);   // Get clip recording statistics
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // CLIP_RECORDER_H
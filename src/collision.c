@@ -0,0 +1,62 @@
+/**********************************************************************************************
+*
+*   collision - Collision detection helpers shared by game simulations
+*
+*   NOTE: Check collision.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "collision.h"
+
+#include <math.h>               // Required for: fabsf(), floorf(), ceilf()
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Check collision between circle and rectangle
+// NOTE: Operations order (including rectangle center truncation to int) follows raylib
+// CheckCollisionCircleRec(), results must match bit-for-bit
+bool CheckCollisionBallRec(Vector2 center, float radius, Rectangle rec)
+{
+    int recCenterX = (int)(rec.x + rec.width/2.0f);
+    int recCenterY = (int)(rec.y + rec.height/2.0f);
+
+    float dx = fabsf(center.x - (float)recCenterX);
+    float dy = fabsf(center.y - (float)recCenterY);
+
+    if (dx > (rec.width/2.0f + radius)) return false;
+    if (dy > (rec.height/2.0f + radius)) return false;
+
+    if (dx <= (rec.width/2.0f)) return true;
+    if (dy <= (rec.height/2.0f)) return true;
+
+    float cornerDistanceSq = (dx - rec.width/2.0f)*(dx - rec.width/2.0f) +
+                             (dy - rec.height/2.0f)*(dy - rec.height/2.0f);
+
+    return (cornerDistanceSq <= (radius*radius));
+}
+
+// Get grid cells touching rectangle (edges included), clamped to grid
+// NOTE: Cells sharing only an edge with rectangle are included, circle vs rectangle checks
+// touching an edge report collision
+GridRange GetGridRangeRec(Rectangle rec, Vector2 origin, Vector2 cellSize, int columns, int rows)
+{
+    GridRange range = { 0 };
+
+    range.firstColumn = (int)ceilf((rec.x - origin.x)/cellSize.x) - 1;
+    range.lastColumn = (int)floorf((rec.x + rec.width - origin.x)/cellSize.x);
+    range.firstRow = (int)ceilf((rec.y - origin.y)/cellSize.y) - 1;
+    range.lastRow = (int)floorf((rec.y + rec.height - origin.y)/cellSize.y);
+
+    if (range.firstColumn < 0) range.firstColumn = 0;
+    if (range.lastColumn > (columns - 1)) range.lastColumn = columns - 1;
+    if (range.firstRow < 0) range.firstRow = 0;
+    if (range.lastRow > (rows - 1)) range.lastRow = rows - 1;
+
+    return range;
+}
@@ -0,0 +1,49 @@
+/**********************************************************************************************
+*
+*   collision - Collision detection helpers shared by game simulations
+*
+*   Same results as raylib CheckCollisionCircleRec() but implemented in the game core,
+*   simulations only depend on raylib.h types and can be built and linked without raylib
+*   library (headless tools, servers, batched simulations)
+*
+*   Grid broad phase: GetGridRangeRec() returns cells of a regular grid touching a
+*   rectangle (ball bounds, visible area), only those cells need to be tested or drawn
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Grid cells range, inclusive, empty when first > last
+typedef struct GridRange {
+    int firstColumn;
+    int lastColumn;
+    int firstRow;
+    int lastRow;
+} GridRange;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool CheckCollisionBallRec(Vector2 center, float radius, Rectangle rec);    // Check collision between circle and rectangle (matches CheckCollisionCircleRec())
+GridRange GetGridRangeRec(Rectangle rec, Vector2 origin, Vector2 cellSize, int columns, int rows);  // Get grid cells touching rectangle (edges included), clamped to grid
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // COLLISION_H
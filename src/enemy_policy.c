@@ -0,0 +1,228 @@
+/**********************************************************************************************
+*
+*   enemy_policy - PONG enemy paddle controllers: scripted chase or learned tiny MLP policy
+*
+*   NOTE: Check enemy_policy.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "enemy_policy.h"
+
+#include "simd_lanes.h"         // Required for: LaneFloat, LoadFloat(), AddFloat(), MaxFloat()...
+
+#include <string.h>             // Required for: memcpy(), memcmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ENEMY_MLP_SPEED_SCALE       0.1f    // Ball speed inputs scale (1/10)
+#define ENEMY_MLP_HEADER_SIZE       16      // Magic + inputs, hidden, outputs
+
+#if (ENEMY_MLP_HIDDEN % SIMD_LANES) != 0
+    #error "ENEMY_MLP_HIDDEN must be a multiple of SIMD lanes"
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void EvaluateHiddenLayer(const float *input, int inputsCount, const float *weights, const float *bias, float *output);   // Hidden layer (ReLU), lanes over hidden units
+static int GetBestOutput(const float *output);     // Get output index with highest value (first one on ties)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Load MLP policy weights file
+EnemyPolicy LoadEnemyPolicy(const char *fileName)
+{
+    EnemyPolicy policy = { 0 };
+    policy.type = ENEMY_POLICY_CHASE;
+
+    unsigned int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+
+    if (data == NULL)
+    {
+        TraceLog(LOG_INFO, "ENEMY: [%s] Weights not available, using chase policy", fileName);
+        return policy;
+    }
+
+    int dims[3] = { 0 };
+    if (dataSize >= ENEMY_MLP_HEADER_SIZE) memcpy(dims, data + 4, sizeof(dims));
+
+    if ((dataSize != (ENEMY_MLP_HEADER_SIZE + sizeof(EnemyMlp))) || (memcmp(data, "EMLP", 4) != 0) ||
+        (dims[0] != ENEMY_MLP_INPUTS) || (dims[1] != ENEMY_MLP_HIDDEN) || (dims[2] != ENEMY_MLP_OUTPUTS))
+    {
+        TraceLog(LOG_WARNING, "ENEMY: [%s] Weights file not valid (expected %ix%ix%i MLP), using chase policy",
+            fileName, ENEMY_MLP_INPUTS, ENEMY_MLP_HIDDEN, ENEMY_MLP_OUTPUTS);
+    }
+    else
+    {
+        // NOTE: EnemyMlp is float arrays only, no padding, same order as file
+        memcpy(&policy.mlp, data + ENEMY_MLP_HEADER_SIZE, sizeof(EnemyMlp));
+        policy.type = ENEMY_POLICY_MLP;
+
+        TraceLog(LOG_INFO, "ENEMY: [%s] MLP policy loaded (%s, %i lanes)", fileName, SIMD_LANES_BACKEND, SIMD_LANES);
+    }
+
+    UnloadFileData(data);
+
+    return policy;
+}
+
+// Get policy type name
+const char *GetEnemyPolicyName(int type)
+{
+    return (type == ENEMY_POLICY_MLP)? "mlp" : "chase";
+}
+
+// Evaluate MLP for one match
+// NOTE: Chase policy is not evaluated here (pong_sim), returns 0
+int GetEnemyPolicyMove(const EnemyPolicy *policy, const PongGame *game)
+{
+    if (policy->type != ENEMY_POLICY_MLP) return 0;
+
+    const EnemyMlp *mlp = &policy->mlp;
+
+    float input[ENEMY_MLP_INPUTS] = {
+        game->ballPosition.x*(1.0f/game->screenWidth),
+        game->ballPosition.y*(1.0f/game->screenHeight),
+        (float)game->ballSpeedX*ENEMY_MLP_SPEED_SCALE,
+        (float)game->ballSpeedY*ENEMY_MLP_SPEED_SCALE,
+        game->enemy.y*(1.0f/game->screenHeight),
+        game->player.y*(1.0f/game->screenHeight)
+    };
+
+    float hidden1[ENEMY_MLP_HIDDEN];
+    float hidden2[ENEMY_MLP_HIDDEN];
+    float output[ENEMY_MLP_OUTPUTS];
+
+    EvaluateHiddenLayer(input, ENEMY_MLP_INPUTS, &mlp->w1[0][0], mlp->b1, hidden1);
+    EvaluateHiddenLayer(hidden1, ENEMY_MLP_HIDDEN, &mlp->w2[0][0], mlp->b2, hidden2);
+
+    // Output layer, few outputs: scalar, same operations order as batch kernel
+    for (int o = 0; o < ENEMY_MLP_OUTPUTS; o++) output[o] = mlp->b3[o];
+    for (int h = 0; h < ENEMY_MLP_HIDDEN; h++)
+    {
+        for (int o = 0; o < ENEMY_MLP_OUTPUTS; o++) output[o] = output[o] + hidden2[h]*mlp->w3[h][o];
+    }
+
+    return GetBestOutput(output) - 1;
+}
+
+// Set enemy control in match input
+void ApplyEnemyPolicy(const EnemyPolicy *policy, const PongGame *game, PongInput *input)
+{
+    if (policy->type != ENEMY_POLICY_MLP) return;
+
+    input->enemyControlled = true;
+    input->enemyMove = GetEnemyPolicyMove(policy, game);
+}
+
+// Add enemy control flags to batch inputs
+// NOTE: Lanes over matches, every weight is broadcast to all lanes, sums in same order as one match evaluation
+void ApplyEnemyPolicyBatch(const EnemyPolicy *policy, const PongBatch *batch, int *inputs)
+{
+    if (policy->type != ENEMY_POLICY_MLP) return;
+
+    const EnemyMlp *mlp = &policy->mlp;
+
+    const LaneFloat invWidth = SetFloat(1.0f/batch->screenWidth);
+    const LaneFloat invHeight = SetFloat(1.0f/batch->screenHeight);
+    const LaneFloat speedScale = SetFloat(ENEMY_MLP_SPEED_SCALE);
+    const LaneFloat zero = SetFloat(0.0f);
+
+    for (int i = 0; i < batch->capacity; i += SIMD_LANES)
+    {
+        LaneFloat input[ENEMY_MLP_INPUTS];
+        input[0] = MulFloat(LoadFloat(batch->ballX + i), invWidth);
+        input[1] = MulFloat(LoadFloat(batch->ballY + i), invHeight);
+        input[2] = MulFloat(IntToFloat(LoadInt(batch->ballSpeedX + i)), speedScale);
+        input[3] = MulFloat(IntToFloat(LoadInt(batch->ballSpeedY + i)), speedScale);
+        input[4] = MulFloat(LoadFloat(batch->enemyY + i), invHeight);
+        input[5] = MulFloat(LoadFloat(batch->playerY + i), invHeight);
+
+        LaneFloat hidden1[ENEMY_MLP_HIDDEN];
+        LaneFloat hidden2[ENEMY_MLP_HIDDEN];
+        LaneFloat output[ENEMY_MLP_OUTPUTS];
+
+        // NOTE: Inputs loop outside, every unit sum is an independent dependency chain
+        for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden1[h] = SetFloat(mlp->b1[h]);
+        for (int k = 0; k < ENEMY_MLP_INPUTS; k++)
+        {
+            for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden1[h] = AddFloat(hidden1[h], MulFloat(input[k], SetFloat(mlp->w1[k][h])));
+        }
+        for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden1[h] = MaxFloat(hidden1[h], zero);
+
+        for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden2[h] = SetFloat(mlp->b2[h]);
+        for (int k = 0; k < ENEMY_MLP_HIDDEN; k++)
+        {
+            for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden2[h] = AddFloat(hidden2[h], MulFloat(hidden1[k], SetFloat(mlp->w2[k][h])));
+        }
+        for (int h = 0; h < ENEMY_MLP_HIDDEN; h++) hidden2[h] = MaxFloat(hidden2[h], zero);
+
+        for (int o = 0; o < ENEMY_MLP_OUTPUTS; o++) output[o] = SetFloat(mlp->b3[o]);
+        for (int k = 0; k < ENEMY_MLP_HIDDEN; k++)
+        {
+            for (int o = 0; o < ENEMY_MLP_OUTPUTS; o++) output[o] = AddFloat(output[o], MulFloat(hidden2[k], SetFloat(mlp->w3[k][o])));
+        }
+
+        // Output with highest value, first one on ties
+        LaneFloat best = output[0];
+        LaneInt bestIndex = SetInt(0);
+
+        for (int o = 1; o < ENEMY_MLP_OUTPUTS; o++)
+        {
+            LaneInt greater = GreaterFloat(output[o], best);
+            best = SelectFloat(greater, output[o], best);
+            bestIndex = SelectInt(greater, SetInt(o), bestIndex);
+        }
+
+        // Outputs: 0 - up, 1 - stay, 2 - down
+        LaneInt flags = SetInt(PONG_INPUT_ENEMY_CONTROLLED);
+        flags = OrMask(flags, AndMask(EqualInt(bestIndex, SetInt(0)), SetInt(PONG_INPUT_ENEMY_UP)));
+        flags = OrMask(flags, AndMask(EqualInt(bestIndex, SetInt(2)), SetInt(PONG_INPUT_ENEMY_DOWN)));
+
+        StoreInt(inputs + i, OrMask(LoadInt(inputs + i), flags));
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Hidden layer (ReLU), lanes over hidden units
+// NOTE: Sums accumulated in inputs order, same operations as batch kernel
+static void EvaluateHiddenLayer(const float *input, int inputsCount, const float *weights, const float *bias, float *output)
+{
+    LaneFloat sums[ENEMY_MLP_HIDDEN/SIMD_LANES];
+
+    for (int j = 0; j < ENEMY_MLP_HIDDEN/SIMD_LANES; j++) sums[j] = LoadFloat(bias + j*SIMD_LANES);
+
+    for (int k = 0; k < inputsCount; k++)
+    {
+        LaneFloat value = SetFloat(input[k]);
+        const float *row = weights + k*ENEMY_MLP_HIDDEN;
+
+        for (int j = 0; j < ENEMY_MLP_HIDDEN/SIMD_LANES; j++) sums[j] = AddFloat(sums[j], MulFloat(value, LoadFloat(row + j*SIMD_LANES)));
+    }
+
+    for (int j = 0; j < ENEMY_MLP_HIDDEN/SIMD_LANES; j++) StoreFloat(output + j*SIMD_LANES, MaxFloat(sums[j], SetFloat(0.0f)));
+}
+
+// Get output index with highest value
+static int GetBestOutput(const float *output)
+{
+    int best = 0;
+
+    for (int o = 1; o < ENEMY_MLP_OUTPUTS; o++)
+    {
+        if (output[o] > output[best]) best = o;
+    }
+
+    return best;
+}
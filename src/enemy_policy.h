@@ -0,0 +1,98 @@
+/**********************************************************************************************
+*
+*   enemy_policy - PONG enemy paddle controllers: scripted chase or learned tiny MLP policy
+*
+*   Enemy controllers decide enemy paddle move on every simulation step:
+*     - ENEMY_POLICY_CHASE: scripted chase from pong_sim (ball crosses enemyVisionRange, enemy
+*       follows ball y), inputs are left untouched, also fallback when weights can not be loaded
+*     - ENEMY_POLICY_MLP: fixed size MLP (6 -> 16 ReLU -> 16 ReLU -> 3), move with highest output,
+*       inputs set as controlled enemy (PongInput.enemyControlled, PONG_INPUT_ENEMY_*)
+*
+*   MLP is evaluated with SIMD kernels (simd_lanes.h): one match vectorizes hidden units,
+*   batches (pong_batch) vectorize matches, same decisions on both paths. Weights are stored
+*   in policy struct, no allocations after loading.
+*
+*   MLP INPUTS (enemy point of view):
+*       [0] ball x/width, [1] ball y/height, [2] ball speed x/10, [3] ball speed y/10,
+*       [4] enemy y/height, [5] player y/height
+*
+*   MLP OUTPUTS: [0] move up, [1] stay, [2] move down
+*
+*   WEIGHTS FILE (.mlp, little-endian):
+*       char magic[4]               "EMLP"
+*       int inputs, hidden, outputs     Must be 6, 16, 3
+*       float w1[inputs][hidden], b1[hidden]        y = x*W + b (input-major rows)
+*       float w2[hidden][hidden], b2[hidden]
+*       float w3[hidden][outputs], b3[outputs]
+*
+*   USAGE:
+*       EnemyPolicy policy = LoadEnemyPolicy("resources/enemy_policy.mlp");
+*
+*       ApplyEnemyPolicy(&policy, &game, &input);       // Before UpdatePongGame(&game, input)
+*       ApplyEnemyPolicyBatch(&policy, &batch, inputs); // Before UpdatePongBatch(&batch, inputs)
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef ENEMY_POLICY_H
+#define ENEMY_POLICY_H
+
+#include "raylib.h"
+#include "pong_sim.h"           // Required for: PongGame, PongInput
+#include "pong_batch.h"         // Required for: PongBatch
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ENEMY_MLP_INPUTS         6
+#define ENEMY_MLP_HIDDEN        16      // NOTE: Multiple of SIMD lanes (8)
+#define ENEMY_MLP_OUTPUTS        3
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Enemy policy types
+typedef enum {
+    ENEMY_POLICY_CHASE = 0,     // Scripted chase (pong_sim)
+    ENEMY_POLICY_MLP            // Learned MLP policy
+} EnemyPolicyType;
+
+// Enemy MLP weights, layers as y = x*W + b
+typedef struct EnemyMlp {
+    float w1[ENEMY_MLP_INPUTS][ENEMY_MLP_HIDDEN];
+    float b1[ENEMY_MLP_HIDDEN];
+    float w2[ENEMY_MLP_HIDDEN][ENEMY_MLP_HIDDEN];
+    float b2[ENEMY_MLP_HIDDEN];
+    float w3[ENEMY_MLP_HIDDEN][ENEMY_MLP_OUTPUTS];
+    float b3[ENEMY_MLP_OUTPUTS];
+} EnemyMlp;
+
+// Enemy policy
+typedef struct EnemyPolicy {
+    int type;                   // Policy type (EnemyPolicyType)
+    EnemyMlp mlp;               // MLP weights (ENEMY_POLICY_MLP)
+} EnemyPolicy;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+EnemyPolicy LoadEnemyPolicy(const char *fileName);      // Load MLP policy weights file, chase policy if not valid
+const char *GetEnemyPolicyName(int type);               // Get policy type name: "chase" or "mlp"
+
+int GetEnemyPolicyMove(const EnemyPolicy *policy, const PongGame *game);   // Evaluate MLP for one match: -1 up, 0 stay, 1 down
+void ApplyEnemyPolicy(const EnemyPolicy *policy, const PongGame *game, PongInput *input);  // Set enemy control in match input (chase: untouched)
+void ApplyEnemyPolicyBatch(const EnemyPolicy *policy, const PongBatch *batch, int *inputs); // Add enemy control flags to batch inputs, capacity sized (chase: untouched)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ENEMY_POLICY_H
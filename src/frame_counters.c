@@ -0,0 +1,318 @@
+/**********************************************************************************************
+*
+*   frame_counters - Per-frame rendering and game work counters, overlay and CSV export
+*
+*   NOTE: Check frame_counters.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "frame_counters.h"
+
+#include "rlgl.h"               // Required for: rlLoadRenderBatch(), rlSetRenderBatchActive()...
+#include "game_audio.h"         // Required for: GetGameSoundsPlayedCount()
+
+#include <stdio.h>              // Required for: FILE, fopen(), fprintf(), fclose()
+#include <string.h>             // Required for: strncpy()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BATCH_DEPTH_START           -1.0f               // Batch depth after a flush (rlDrawRenderBatch())
+#define BATCH_DEPTH_INCREMENT       (1.0f/20000.0f)     // Batch depth increment per rlEnd()
+#define BATCH_VERTICES_PER_ELEMENT  4                   // Batch buffer vertices per element (quad)
+#define SUBMISSION_MIN_VERTICES     2                   // Smallest raylib submission (RL_LINES)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Render batch contents summary
+typedef struct BatchSample {
+    unsigned int submissions;       // rlEnd() calls since last flush
+    unsigned int drawCalls;         // Draw calls with vertices
+    unsigned int vertices;          // Vertices in all draw calls
+    unsigned int textureSwitches;   // Texture changes between consecutive draw calls
+} BatchSample;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static rlRenderBatch batch = { 0 };             // Counting render batch, active while initialized
+static bool initialized = false;                // Render batch loaded and active
+
+static unsigned int current[FRAME_COUNTER_COUNT] = { 0 };  // Frame being counted
+static unsigned int last[FRAME_COUNTER_COUNT] = { 0 };     // Last finished frame
+static unsigned int framesCounter = 0;          // Frames finished
+
+static BatchSample segmentSample = { 0 };       // Batch contents already counted (since last flush)
+static int segmentBuffer = 0;                   // Batch buffer in use when last counted
+static unsigned int submissionsMax = 0;         // Submissions a batch buffer can take before it is flushed
+
+static float replayDepth = BATCH_DEPTH_START;   // Batch depth already replayed (submissions counted)
+static unsigned int replaySubmissions = 0;      // Submissions counted up to replayDepth
+static int replayBuffer = 0;                    // Batch buffer replayDepth belongs to
+static unsigned int soundsPlayedStart = 0;      // Sounds played count at frame start
+
+static char frameTag[FRAME_COUNTERS_MAX_TAG] = { 0 };  // Tag written in CSV rows
+static FILE *csvFile = NULL;                    // CSV output file
+
+static const char *counterNames[FRAME_COUNTER_COUNT] = {
+    "draw_submissions",
+    "draw_calls",
+    "batch_flushes",
+    "vertices",
+    "texture_switches",
+    "collision_tests",
+    "cells_visited",
+    "sounds_played"
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static BatchSample GetBatchSample(void);        // Get current batch contents summary
+static void CountBatch(void);                   // Add batch contents not counted yet and flushes since last call
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Load counting render batch and make it active
+// NOTE: Same buffer size as default batch, more buffers so consecutive flushes can be counted
+void InitFrameCounters(void)
+{
+    if (initialized) return;
+
+    batch = rlLoadRenderBatch(FRAME_COUNTERS_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    rlSetRenderBatchActive(&batch);
+    initialized = true;
+
+    // rlEnd() flushes batch when its vertex buffer is full, every submission adds 2 vertices or more
+    submissionsMax = RL_DEFAULT_BATCH_BUFFER_ELEMENTS*BATCH_VERTICES_PER_ELEMENT/SUBMISSION_MIN_VERTICES;
+    replayDepth = BATCH_DEPTH_START;
+    replaySubmissions = 0;
+    replayBuffer = batch.currentBuffer;
+
+    BeginFrameCounters();
+
+    TraceLog(LOG_INFO, "COUNTERS: Render batch loaded (%i buffers)", FRAME_COUNTERS_BATCH_BUFFERS);
+}
+
+// Restore default render batch, unload it and close CSV file
+void CloseFrameCounters(void)
+{
+    StopFrameCountersCSV();
+
+    if (!initialized) return;
+
+    rlSetRenderBatchActive(NULL);   // Draws pending batch contents and restores default batch
+    rlUnloadRenderBatch(batch);
+    initialized = false;
+}
+
+// Start counting a new frame
+void BeginFrameCounters(void)
+{
+    for (int i = 0; i < FRAME_COUNTER_COUNT; i++) current[i] = 0;
+
+    if (initialized)
+    {
+        segmentSample = GetBatchSample();
+        segmentBuffer = batch.currentBuffer;
+    }
+
+    soundsPlayedStart = GetGameSoundsPlayedCount();
+}
+
+// Finish counting frame, store values and write CSV row
+// NOTE: EndDrawing() flush is counted here, it always follows
+void EndFrameCounters(void)
+{
+    if (initialized)
+    {
+        CountBatch();
+        current[COUNTER_BATCH_FLUSHES]++;
+    }
+
+    current[COUNTER_SOUNDS_PLAYED] = GetGameSoundsPlayedCount() - soundsPlayedStart;
+
+    for (int i = 0; i < FRAME_COUNTER_COUNT; i++) last[i] = current[i];
+    framesCounter++;
+
+    if (csvFile != NULL)
+    {
+        fprintf(csvFile, "%u,%s,%.3f", framesCounter, frameTag, GetFrameTime()*1000.0f);
+        for (int i = 0; i < FRAME_COUNTER_COUNT; i++) fprintf(csvFile, ",%u", last[i]);
+        fprintf(csvFile, "\n");
+    }
+}
+
+// Count current batch contents
+void SampleFrameCounters(void)
+{
+    if (initialized) CountBatch();
+}
+
+// Add value to counter for frame being counted
+// NOTE: Counters measured by game (i.e. collision tests counted in game state), call after BeginFrameCounters()
+void AddFrameCounter(FrameCounter counter, unsigned int value)
+{
+    if ((counter < 0) || (counter >= FRAME_COUNTER_COUNT)) return;
+
+    current[counter] += value;
+}
+
+// Get counter value for last finished frame
+unsigned int GetFrameCounter(FrameCounter counter)
+{
+    if ((counter < 0) || (counter >= FRAME_COUNTER_COUNT)) return 0;
+
+    return last[counter];
+}
+
+// Get counter name
+const char *GetFrameCounterName(FrameCounter counter)
+{
+    if ((counter < 0) || (counter >= FRAME_COUNTER_COUNT)) return "unknown";
+
+    return counterNames[counter];
+}
+
+// Set tag written in CSV rows
+// NOTE: Tag is copied, commas are not escaped
+void SetFrameCountersTag(const char *tag)
+{
+    strncpy(frameTag, (tag != NULL)? tag : "", FRAME_COUNTERS_MAX_TAG - 1);
+    frameTag[FRAME_COUNTERS_MAX_TAG - 1] = '\0';
+}
+
+// Draw last frame counters overlay
+void DrawFrameCounters(int posX, int posY)
+{
+    DrawRectangle(posX, posY, 200, 20 + 14*(FRAME_COUNTER_COUNT + 1), Fade(BLACK, 0.7f));
+
+    DrawText(TextFormat("frame_time: %.2f ms", GetFrameTime()*1000.0f), posX + 10, posY + 10, 10, GREEN);
+
+    for (int i = 0; i < FRAME_COUNTER_COUNT; i++)
+    {
+        DrawText(TextFormat("%s: %u", counterNames[i], last[i]), posX + 10, posY + 24 + 14*i, 10, RAYWHITE);
+    }
+
+    if (csvFile != NULL) DrawCircle(posX + 190, posY + 10, 4, RED);
+}
+
+// Start writing one CSV row per frame
+bool StartFrameCountersCSV(const char *fileName)
+{
+    StopFrameCountersCSV();
+
+    csvFile = fopen(fileName, "wt");
+
+    if (csvFile == NULL)
+    {
+        TraceLog(LOG_WARNING, "COUNTERS: [%s] Failed to open CSV file", fileName);
+        return false;
+    }
+
+    fprintf(csvFile, "frame,tag,frame_time_ms");
+    for (int i = 0; i < FRAME_COUNTER_COUNT; i++) fprintf(csvFile, ",%s", counterNames[i]);
+    fprintf(csvFile, "\n");
+
+    TraceLog(LOG_INFO, "COUNTERS: [%s] CSV export started", fileName);
+
+    return true;
+}
+
+// Stop writing and close CSV file
+void StopFrameCountersCSV(void)
+{
+    if (csvFile == NULL) return;
+
+    fclose(csvFile);
+    csvFile = NULL;
+
+    TraceLog(LOG_INFO, "COUNTERS: CSV export stopped");
+}
+
+// Check if CSV rows are being written
+bool IsFrameCountersCSVActive(void)
+{
+    return (csvFile != NULL);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get current batch contents summary
+// NOTE: rlgl does not count submissions, they are recovered from batch depth: every rlEnd()
+// adds BATCH_DEPTH_INCREMENT, same float additions are replayed to get the exact count.
+// Replay continues from depth counted on previous call, every submission is replayed once;
+// it starts again only when batch is flushed (next buffer in use or depth back to start)
+static BatchSample GetBatchSample(void)
+{
+    BatchSample sample = { 0 };
+
+    if ((batch.currentBuffer != replayBuffer) || (batch.currentDepth < replayDepth))
+    {
+        replayDepth = BATCH_DEPTH_START;
+        replaySubmissions = 0;
+        replayBuffer = batch.currentBuffer;
+    }
+
+    while ((replayDepth < batch.currentDepth) && (replaySubmissions < submissionsMax))
+    {
+        replayDepth += BATCH_DEPTH_INCREMENT;
+        replaySubmissions++;
+    }
+
+    // Batch is flushed before submissionsMax is reached, depth beyond it means rlgl changed
+    if (replayDepth < batch.currentDepth)
+    {
+        TraceLog(LOG_WARNING, "COUNTERS: Batch depth beyond %u submissions, draw submissions count clamped", submissionsMax);
+        replayDepth = batch.currentDepth;
+    }
+
+    sample.submissions = replaySubmissions;
+
+    unsigned int textureId = 0;
+
+    for (int i = 0; i < batch.drawCounter; i++)
+    {
+        if (batch.draws[i].vertexCount <= 0) continue;
+
+        if ((sample.drawCalls > 0) && (batch.draws[i].textureId != textureId)) sample.textureSwitches++;
+        textureId = batch.draws[i].textureId;
+
+        sample.drawCalls++;
+        sample.vertices += batch.draws[i].vertexCount;
+    }
+
+    return sample;
+}
+
+// Add batch contents not counted yet and flushes since last call
+// NOTE: A flush moves batch to next buffer, batch contents start from scratch
+static void CountBatch(void)
+{
+    BatchSample sample = GetBatchSample();
+    int flushes = (batch.currentBuffer - segmentBuffer + batch.bufferCount)%batch.bufferCount;
+
+    if (flushes > 0)
+    {
+        current[COUNTER_BATCH_FLUSHES] += flushes;
+        segmentSample = (BatchSample){ 0 };
+    }
+
+    current[COUNTER_DRAW_SUBMISSIONS] += sample.submissions - segmentSample.submissions;
+    current[COUNTER_DRAW_CALLS] += sample.drawCalls - segmentSample.drawCalls;
+    current[COUNTER_VERTICES] += sample.vertices - segmentSample.vertices;
+    current[COUNTER_TEXTURE_SWITCHES] += sample.textureSwitches - segmentSample.textureSwitches;
+
+    segmentSample = sample;
+    segmentBuffer = batch.currentBuffer;
+}
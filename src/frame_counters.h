@@ -0,0 +1,105 @@
+/**********************************************************************************************
+*
+*   frame_counters - Per-frame rendering and game work counters, overlay and CSV export
+*
+*   Counters measured every frame:
+*     - Draw submissions: rlBegin()/rlEnd() blocks (one per DrawRectangle(), DrawTexture()...)
+*     - Draw calls: GPU draw calls issued by render batch (consecutive submissions sharing
+*       mode and texture are merged into a single draw call)
+*     - Batch flushes: render batch uploaded and drawn (EndDrawing() and mid-frame flushes)
+*     - Vertices: vertices submitted to render batch
+*     - Texture switches: texture changes between consecutive draw calls
+*     - Collision tests: CheckCollisionBallRec() calls done by game simulation steps, added by game
+*     - Cells visited: bricks grid cells visited by drawing code, added by game, it stays
+*       constant on a larger board when drawing is culled to visible area
+*     - Sounds played: PlayGameSound() calls (check game_audio.h)
+*
+*   rlgl does not expose its internal batch, so this module loads its own render batch and
+*   makes it active on InitFrameCounters(); all raylib drawing goes through it and it is
+*   inspected before EndDrawing(). Sounds counter comes from game_audio module, collision tests
+*   are counted by every game state (simulations run on other threads or many at once) and added
+*   by game with AddFrameCounter(), simulations do not depend on this module.
+*
+*   NOTE: Batch contents drawn by a mid-frame flush (i.e. rlDrawRenderBatchActive() before
+*   reading screen pixels) are lost unless SampleFrameCounters() is called right before it;
+*   the flush itself is always counted
+*
+*   USAGE:
+*       InitFrameCounters();            // After InitWindow()
+*
+*       // Every frame
+*       BeginFrameCounters();           // Before update
+*       AddFrameCounter(COUNTER_COLLISION_TESTS, tests);    // Collision tests done since previous frame
+*       ...
+*       BeginDrawing();
+*           ...
+*           EndFrameCounters();         // After game drawing, overlay is not counted
+*           DrawFrameCounters(10, 10);
+*       EndDrawing();
+*
+*       CloseFrameCounters();           // Before CloseWindow()
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef FRAME_COUNTERS_H
+#define FRAME_COUNTERS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FRAME_COUNTERS_BATCH_BUFFERS     8      // Render batch buffers, mid-frame flushes counted exactly up to (buffers - 1)
+#define FRAME_COUNTERS_MAX_TAG          32      // Maximum frame tag length (i.e. "GAMEPLAY textures")
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Frame counters
+typedef enum FrameCounter {
+    COUNTER_DRAW_SUBMISSIONS = 0,   // rlBegin()/rlEnd() blocks submitted
+    COUNTER_DRAW_CALLS,             // Draw calls issued by render batch
+    COUNTER_BATCH_FLUSHES,          // Render batch flushes
+    COUNTER_VERTICES,               // Vertices submitted
+    COUNTER_TEXTURE_SWITCHES,       // Texture changes between draw calls
+    COUNTER_COLLISION_TESTS,        // Collision tests done
+    COUNTER_CELLS_VISITED,          // Bricks grid cells visited by drawing (culling check)
+    COUNTER_SOUNDS_PLAYED,          // Sounds played
+    FRAME_COUNTER_COUNT
+} FrameCounter;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitFrameCounters(void);                   // Load counting render batch and make it active (call after InitWindow())
+void CloseFrameCounters(void);                  // Restore default render batch, unload it and close CSV file
+
+void BeginFrameCounters(void);                  // Start counting a new frame (call before frame update)
+void EndFrameCounters(void);                    // Finish counting frame, store values and write CSV row (call after drawing, before EndDrawing())
+void SampleFrameCounters(void);                 // Count current batch contents (call before a mid-frame batch flush)
+void AddFrameCounter(FrameCounter counter, unsigned int value); // Add value to counter for frame being counted (counters measured by game, i.e. collision tests)
+
+unsigned int GetFrameCounter(FrameCounter counter); // Get counter value for last finished frame
+const char *GetFrameCounterName(FrameCounter counter); // Get counter name (also used as CSV column name)
+void SetFrameCountersTag(const char *tag);      // Set tag written in CSV rows (i.e. screen and render backend names)
+
+void DrawFrameCounters(int posX, int posY);     // Draw last frame counters overlay
+
+bool StartFrameCountersCSV(const char *fileName);   // Start writing one CSV row per frame
+void StopFrameCountersCSV(void);                // Stop writing and close CSV file
+bool IsFrameCountersCSVActive(void);            // Check if CSV rows are being written
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // FRAME_COUNTERS_H
@@ -0,0 +1,117 @@
+/**********************************************************************************************
+*
+*   game_audio - Sounds and music wrappers shared by games
+*
+*   NOTE: Check game_audio.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "game_audio.h"
+
+#include "raylib.h"
+#include "assets.h"             // Required for: IsAssetReady(), GetAssetMusic()
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan()
+
+#include <stddef.h>             // Required for: NULL
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static Sound sounds[MAX_GAME_SOUNDS] = { 0 };   // Loaded sounds
+static int soundsCount = 0;                     // Number of loaded sounds
+static unsigned int soundsPlayed = 0;           // Sounds played counter, read by frame counters
+
+static int musicAsset = -1;                     // Music asset id to be streamed
+static Music music = { 0 };                     // Music currently streaming
+static bool musicPlaying = false;               // Music streaming started
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize audio device
+void InitGameAudio(void)
+{
+    InitAudioDevice();
+
+    soundsCount = 0;
+    musicAsset = -1;
+    musicPlaying = false;
+}
+
+// Unload sounds and close audio device
+// NOTE: Music is owned by assets module, UnloadAssets() must be called before
+void CloseGameAudio(void)
+{
+    for (int i = 0; i < soundsCount; i++) UnloadSound(sounds[i]);
+    soundsCount = 0;
+
+    musicAsset = -1;
+    musicPlaying = false;
+
+    CloseAudioDevice();
+}
+
+// Load sound, returns sound id
+int LoadGameSound(const char *fileName)
+{
+    if (soundsCount >= MAX_GAME_SOUNDS)
+    {
+        TraceLog(LOG_WARNING, "AUDIO: [%s] Maximum number of sounds reached (%i)", fileName, MAX_GAME_SOUNDS);
+        return -1;
+    }
+
+    BeginTraceSpan("LoadSound", fileName);
+    sounds[soundsCount] = LoadSound(fileName);
+    EndTraceSpan();
+
+    return soundsCount++;
+}
+
+// Play sound by id
+void PlayGameSound(int id)
+{
+    if ((id >= 0) && (id < soundsCount))
+    {
+        PlaySound(sounds[id]);
+        soundsPlayed++;
+    }
+}
+
+// Get sounds played since program start
+unsigned int GetGameSoundsPlayedCount(void)
+{
+    return soundsPlayed;
+}
+
+// Set music asset to be streamed
+void PlayGameMusic(int asset)
+{
+    if (musicPlaying) StopMusicStream(music);
+
+    musicAsset = asset;
+    musicPlaying = false;
+}
+
+// Start music if ready and refill its buffers
+void UpdateGameAudio(void)
+{
+    if (!musicPlaying && IsAssetReady(musicAsset))
+    {
+        music = GetAssetMusic(musicAsset);
+        PlayMusicStream(music);     // Start music streaming
+        musicPlaying = true;
+    }
+
+    // NOTE: Music buffers must be refilled if consumed
+    if (musicPlaying)
+    {
+        BeginTraceSpan("UpdateMusicStream", NULL);
+        UpdateMusicStream(music);
+        EndTraceSpan();
+    }
+}
@@ -0,0 +1,45 @@
+/**********************************************************************************************
+*
+*   game_audio - Sounds and music wrappers shared by games
+*
+*   Sounds are referenced by id, games do not need to keep Sound variables around
+*   and simulation events can be mapped to sounds in a single place.
+*   Music is provided by assets module (it can arrive in background on web), it starts
+*   streaming as soon as it's ready, game runs silent until then.
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef GAME_AUDIO_H
+#define GAME_AUDIO_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAX_GAME_SOUNDS             16      // Maximum number of loaded sounds
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitGameAudio(void);                       // Initialize audio device
+void CloseGameAudio(void);                      // Unload sounds and close audio device (unload music assets before)
+
+int LoadGameSound(const char *fileName);        // Load sound, returns sound id (-1 on error)
+void PlayGameSound(int id);                     // Play sound by id (invalid ids are ignored)
+unsigned int GetGameSoundsPlayedCount(void);    // Get sounds played since program start (wraps around, use differences)
+
+void PlayGameMusic(int asset);                  // Set music asset to be streamed (starts once asset is ready)
+void UpdateGameAudio(void);                     // Start music if ready and refill its buffers (call once per frame)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GAME_AUDIO_H
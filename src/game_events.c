@@ -0,0 +1,137 @@
+/**********************************************************************************************
+*
+*   game_events - Gameplay events queue: simulation raises events, game systems react later
+*
+*   NOTE: Check game_events.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "game_events.h"
+
+#include "threads.h"            // Required for: AtomicLoad(), AtomicStore(), AtomicCompareExchange()...
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GAME_EVENTS_MASK        (GAME_EVENTS_CAPACITY - 1)
+
+#if (GAME_EVENTS_CAPACITY & GAME_EVENTS_MASK) != 0
+    #error "GAME_EVENTS_CAPACITY must be a power of two"
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+// NOTE: Slot sequence tells slot state for a position: position - free to write,
+// position + 1 - written, ready to read, position + capacity - read, free for next lap
+static GameEvent events[GAME_EVENTS_CAPACITY] = { 0 };
+static volatile unsigned int sequences[GAME_EVENTS_CAPACITY] = { 0 };
+static volatile unsigned int tail = 0;          // Next position to write, claimed by producers (atomic)
+static unsigned int head = 0;                   // Next position to read (consumer only)
+static volatile unsigned int dropped = 0;       // Events dropped, queue full (atomic)
+static unsigned int counts[GAME_EVENT_TYPE_COUNT] = { 0 };  // Events polled per type (consumer only)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize events queue
+void InitGameEvents(void)
+{
+    for (unsigned int i = 0; i < GAME_EVENTS_CAPACITY; i++) sequences[i] = i;
+
+    tail = 0;
+    head = 0;
+    dropped = 0;
+
+    for (int i = 0; i < GAME_EVENT_TYPE_COUNT; i++) counts[i] = 0;
+
+    AtomicFence();
+}
+
+// Push event
+bool PushGameEvent(int type, Vector2 position, int value)
+{
+    for (;;)
+    {
+        unsigned int ticket = AtomicLoad(&tail);
+        unsigned int slot = ticket & GAME_EVENTS_MASK;
+        int state = (int)(AtomicLoad(&sequences[slot]) - ticket);
+
+        if (state == 0)
+        {
+            // Slot free, claim it (another producer could claim it first)
+            if (AtomicCompareExchange(&tail, ticket, ticket + 1))
+            {
+                events[slot] = (GameEvent){ type, position, value };
+                AtomicStore(&sequences[slot], ticket + 1);     // Publish, event written before
+
+                return true;
+            }
+        }
+        else if (state < 0)
+        {
+            // Slot not read yet from previous lap, queue full
+            AtomicAdd(&dropped, 1);
+
+            return false;
+        }
+
+        // NOTE: Other producer claimed ticket, retry with next one
+    }
+}
+
+// Get oldest event
+bool PollGameEvent(GameEvent *event)
+{
+    unsigned int slot = head & GAME_EVENTS_MASK;
+
+    if (AtomicLoad(&sequences[slot]) != (head + 1)) return false;   // Not written yet
+
+    *event = events[slot];
+    AtomicStore(&sequences[slot], head + GAME_EVENTS_CAPACITY);     // Free slot for next lap
+    head++;
+
+    if ((event->type >= 0) && (event->type < GAME_EVENT_TYPE_COUNT)) counts[event->type]++;
+
+    return true;
+}
+
+// Get events of type polled since start or last counts reset
+unsigned int GetGameEventsCount(int type)
+{
+    return ((type >= 0) && (type < GAME_EVENT_TYPE_COUNT))? counts[type] : 0;
+}
+
+// Reset events polled counts
+// NOTE: Consumer side only, events still in queue are counted when polled
+void ResetGameEventsCounts(void)
+{
+    for (int i = 0; i < GAME_EVENT_TYPE_COUNT; i++) counts[i] = 0;
+}
+
+// Get events dropped because queue was full
+unsigned int GetGameEventsDropped(void)
+{
+    return AtomicLoad(&dropped);
+}
+
+// Get event type name
+const char *GetGameEventName(int type)
+{
+    switch (type)
+    {
+        case GAME_EVENT_BALL_HIT_PADDLE: return "BallHitPaddle";
+        case GAME_EVENT_BALL_BOUNCE: return "BallBounce";
+        case GAME_EVENT_BRICK_DESTROYED: return "BrickDestroyed";
+        case GAME_EVENT_LIFE_LOST: return "LifeLost";
+        case GAME_EVENT_SCORE: return "Score";
+        case GAME_EVENT_GAME_OVER: return "GameOver";
+        case GAME_EVENT_SCREEN_CHANGED: return "ScreenChanged";
+        default: return "None";
+    }
+}
@@ -0,0 +1,94 @@
+/**********************************************************************************************
+*
+*   game_events - Gameplay events queue: simulation raises events, game systems react later
+*
+*   Simulation steps do not play sounds, spawn particles or log anything: gameplay outcomes
+*   (ball hit paddle, brick destroyed, life lost, screen changed...) are pushed as events
+*   into a lock-free ring and main thread dispatches them once per frame to audio, particles
+*   and stats/telemetry. Simulation stays free of side effects outside its own state, and
+*   its cost does not depend on audio or logging.
+*
+*   Queue is multiple producers (simulation thread, main thread on screen changes) and
+*   single consumer (main thread): producers claim slots with a compare-exchange and publish
+*   them with a per-slot sequence number, consumer never blocks them. When the ring is full
+*   (consumer stalled for a long time) new events are dropped and counted.
+*
+*   CONFIGURATION:
+*       #define GAME_EVENTS_CAPACITY
+*           Events in queue (power of two), a frame usually raises a few
+*
+*   USAGE:
+*       InitGameEvents();
+*
+*       // Simulation step (any thread)
+*       PushGameEvent(GAME_EVENT_BRICK_DESTROYED, brickPosition, brickIndex);
+*
+*       // Main thread, once per frame
+*       GameEvent event = { 0 };
+*       while (PollGameEvent(&event))
+*       {
+*           if (event.type == GAME_EVENT_BRICK_DESTROYED) PlayGameSound(fxExplode);
+*       }
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(GAME_EVENTS_CAPACITY)
+    #define GAME_EVENTS_CAPACITY    256     // Events in queue, must be a power of two
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Gameplay event types
+typedef enum {
+    GAME_EVENT_NONE = 0,
+    GAME_EVENT_BALL_HIT_PADDLE,     // Ball bounced on a paddle (value: 0 - player, 1 - enemy)
+    GAME_EVENT_BALL_BOUNCE,         // Ball bounced on screen limits
+    GAME_EVENT_BRICK_DESTROYED,     // Brick destroyed (position: brick center, value: brick index)
+    GAME_EVENT_LIFE_LOST,           // Ball lost (value: lifes remaining)
+    GAME_EVENT_SCORE,               // Point scored (value: 0 - player, 1 - enemy)
+    GAME_EVENT_GAME_OVER,           // No lifes remaining
+    GAME_EVENT_SCREEN_CHANGED,      // Screen changed (value: new GameScreen)
+    GAME_EVENT_TYPE_COUNT
+} GameEventType;
+
+// Gameplay event
+typedef struct GameEvent {
+    int type;                   // Event type (GameEventType)
+    Vector2 position;           // Event position on playfield (if any)
+    int value;                  // Event value (check GameEventType)
+} GameEvent;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitGameEvents(void);                      // Initialize events queue (empty), call before starting producer threads
+bool PushGameEvent(int type, Vector2 position, int value);  // Push event (any thread), returns false if queue is full (event dropped)
+bool PollGameEvent(GameEvent *event);           // Get oldest event (main thread), returns false if queue is empty
+unsigned int GetGameEventsCount(int type);      // Get events of type polled since start or last counts reset
+void ResetGameEventsCounts(void);               // Reset events polled counts (main thread, i.e. on new game)
+unsigned int GetGameEventsDropped(void);        // Get events dropped because queue was full
+const char *GetGameEventName(int type);         // Get event type name (for logging/tracing)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GAME_EVENTS_H
@@ -0,0 +1,325 @@
+/**********************************************************************************************
+*
+*   gym_env - Vectorized environments API over game simulations (reset/step), for agents training
+*
+*   NOTE: Check gym_env.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "gym_env.h"
+
+#include <stdlib.h>             // Required for: malloc(), free()
+#include <stddef.h>             // Required for: NULL, size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// NOTE: Playfields size used by games (pong and lesson 07)
+#define GYM_PONG_SCREEN_WIDTH       800
+#define GYM_PONG_SCREEN_HEIGHT      600
+#define GYM_BLOCKS_SCREEN_WIDTH     800
+#define GYM_BLOCKS_SCREEN_HEIGHT    450
+
+#define GYM_PONG_POINT_SCORE       1000     // Score added per point by pong simulation
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);         // Get pseudo-random value (xorshift32)
+static void ResetPongEnv(GymEnv *env, int index);           // Start new pong episode
+static void ResetBlocksEnv(GymEnv *env, int index);         // Start new blocks episode
+static void UpdatePongObservations(GymEnv *env);            // Write all pong observations
+static void UpdateBlocksObservation(GymEnv *env, int index);    // Write one blocks observation
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get default configuration
+GymEnvConfig GetGymEnvConfigDefault(void)
+{
+    GymEnvConfig config = { 0 };
+
+    config.maxEpisodeSteps = 10000;
+    config.pongPoints = 5;
+    config.seed = 1;
+    config.enemyPolicy = NULL;      // Scripted chase
+
+    return config;
+}
+
+// Load environments
+GymEnv LoadGymEnv(int type, int count, GymEnvConfig config)
+{
+    GymEnv env = { 0 };
+
+    if (count < 1) count = 1;
+    if (config.pongPoints < 1) config.pongPoints = 1;
+    if (config.seed == 0) config.seed = 1;      // NOTE: xorshift state can not be 0
+
+    env.type = type;
+    env.count = count;
+    env.config = config;
+
+    if (type == GYM_ENV_PONG)
+    {
+        env.observationSize = GYM_PONG_OBSERVATION_SIZE;
+        env.actionsCount = GYM_PONG_ACTIONS;
+        env.pong = LoadPongBatch(count, GYM_PONG_SCREEN_WIDTH, GYM_PONG_SCREEN_HEIGHT);
+
+        // NOTE: Padding matches are stepped with no inputs
+        env.pongInputs = (int *)RL_MALLOC(env.pong.capacity*sizeof(int));
+        for (int i = 0; i < env.pong.capacity; i++) env.pongInputs[i] = 0;
+    }
+    else
+    {
+        env.type = GYM_ENV_BLOCKS;
+        env.observationSize = GYM_BLOCKS_OBSERVATION_SIZE;
+        env.actionsCount = GYM_BLOCKS_ACTIONS;
+        env.blocks = (BlocksGame *)RL_MALLOC(count*sizeof(BlocksGame));
+        env.bricksLeft = (int *)RL_MALLOC(count*sizeof(int));
+    }
+
+    env.episodeSteps = (int *)RL_MALLOC(count*sizeof(int));
+    env.seeds = (unsigned int *)RL_MALLOC(count*sizeof(unsigned int));
+
+    // Every environment gets its own random sequence
+    unsigned int state = config.seed;
+    for (int i = 0; i < count; i++)
+    {
+        env.seeds[i] = GetRandom(&state);
+        if (env.seeds[i] == 0) env.seeds[i] = 1;
+    }
+
+    env.observations = (float *)RL_MALLOC((size_t)count*env.observationSize*sizeof(float));
+    env.rewards = (float *)RL_MALLOC(count*sizeof(float));
+    env.dones = (int *)RL_MALLOC(count*sizeof(int));
+    env.ownsBuffers = true;
+
+    TraceLog(LOG_INFO, "GYM: Loaded %i %s environments (observation: %i floats, actions: %i)",
+        count, (env.type == GYM_ENV_PONG)? "pong" : "blocks", env.observationSize, env.actionsCount);
+
+    return env;
+}
+
+// Unload environments
+void UnloadGymEnv(GymEnv env)
+{
+    if (env.type == GYM_ENV_PONG)
+    {
+        UnloadPongBatch(env.pong);
+        RL_FREE(env.pongInputs);
+    }
+    else
+    {
+        RL_FREE(env.blocks);
+        RL_FREE(env.bricksLeft);
+    }
+
+    RL_FREE(env.episodeSteps);
+    RL_FREE(env.seeds);
+
+    if (env.ownsBuffers)
+    {
+        RL_FREE(env.observations);
+        RL_FREE(env.rewards);
+        RL_FREE(env.dones);
+    }
+}
+
+// Use external observations, rewards and dones buffers
+// NOTE: Buffers must hold count*observationSize floats, count floats and count ints,
+// current contents are not copied, call ResetGymEnv() after
+void SetGymEnvBuffers(GymEnv *env, float *observations, float *rewards, int *dones)
+{
+    if ((observations == NULL) || (rewards == NULL) || (dones == NULL)) return;
+
+    if (env->ownsBuffers)
+    {
+        RL_FREE(env->observations);
+        RL_FREE(env->rewards);
+        RL_FREE(env->dones);
+    }
+
+    env->observations = observations;
+    env->rewards = rewards;
+    env->dones = dones;
+    env->ownsBuffers = false;
+}
+
+// Reset all environments
+void ResetGymEnv(GymEnv *env)
+{
+    for (int i = 0; i < env->count; i++)
+    {
+        if (env->type == GYM_ENV_PONG) ResetPongEnv(env, i);
+        else
+        {
+            ResetBlocksEnv(env, i);
+            UpdateBlocksObservation(env, i);
+        }
+
+        env->rewards[i] = 0.0f;
+        env->dones[i] = GYM_RUNNING;
+    }
+
+    if (env->type == GYM_ENV_PONG) UpdatePongObservations(env);
+}
+
+// Step all environments
+// NOTE: Invalid actions are considered NOOP, finished environments are reset after
+// rewards and dones are set, observation is the first one of new episode
+void StepGymEnv(GymEnv *env, const int *actions)
+{
+    int maxSteps = env->config.maxEpisodeSteps;
+
+    if (env->type == GYM_ENV_PONG)
+    {
+        PongBatch *pong = &env->pong;
+
+        // NOTE: Padding matches inputs are cleared too, enemy policy adds flags to all of them
+        for (int i = 0; i < pong->capacity; i++)
+        {
+            int action = ((actions != NULL) && (i < env->count))? actions[i] : GYM_PONG_NOOP;
+
+            env->pongInputs[i] = (action == GYM_PONG_UP)? PONG_INPUT_UP : (action == GYM_PONG_DOWN)? PONG_INPUT_DOWN : 0;
+        }
+
+        if (env->config.enemyPolicy != NULL) ApplyEnemyPolicyBatch(env->config.enemyPolicy, pong, env->pongInputs);
+
+        UpdatePongBatch(pong, env->pongInputs);
+
+        int points = env->config.pongPoints*GYM_PONG_POINT_SCORE;
+
+        for (int i = 0; i < env->count; i++)
+        {
+            int events = pong->events[i];
+
+            env->rewards[i] = ((events & PONG_EVENT_PLAYER_SCORE)? 1.0f : 0.0f) - ((events & PONG_EVENT_ENEMY_SCORE)? 1.0f : 0.0f);
+            env->episodeSteps[i]++;
+
+            if ((pong->playerScore[i] + pong->enemyScore[i]) >= points) env->dones[i] = GYM_TERMINATED;
+            else if ((maxSteps > 0) && (env->episodeSteps[i] >= maxSteps)) env->dones[i] = GYM_TRUNCATED;
+            else env->dones[i] = GYM_RUNNING;
+
+            if (env->dones[i] != GYM_RUNNING) ResetPongEnv(env, i);
+        }
+
+        UpdatePongObservations(env);
+    }
+    else
+    {
+        for (int i = 0; i < env->count; i++)
+        {
+            BlocksGame *game = &env->blocks[i];
+            int action = (actions != NULL)? actions[i] : GYM_BLOCKS_NOOP;
+
+            BlocksInput input = { 0 };
+            input.left = (action == GYM_BLOCKS_LEFT);
+            input.right = (action == GYM_BLOCKS_RIGHT);
+            input.launch = (action == GYM_BLOCKS_LAUNCH);
+
+            unsigned int events = UpdateBlocksGame(game, input);
+
+            env->bricksLeft[i] -= game->hitBricksCount;
+            env->rewards[i] = (float)game->hitBricksCount - ((events & BLOCKS_EVENT_BALL_LOST)? 1.0f : 0.0f);
+            env->episodeSteps[i]++;
+
+            if ((events & BLOCKS_EVENT_GAME_OVER) || (env->bricksLeft[i] <= 0)) env->dones[i] = GYM_TERMINATED;
+            else if ((maxSteps > 0) && (env->episodeSteps[i] >= maxSteps)) env->dones[i] = GYM_TRUNCATED;
+            else env->dones[i] = GYM_RUNNING;
+
+            if (env->dones[i] != GYM_RUNNING) ResetBlocksEnv(env, i);
+
+            UpdateBlocksObservation(env, i);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get pseudo-random value (xorshift32)
+static unsigned int GetRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    *state = x;
+
+    return x;
+}
+
+// Start new pong episode
+// NOTE: Ball starts from playfield center with random direction, speeds as game start
+static void ResetPongEnv(GymEnv *env, int index)
+{
+    PongGame game = { 0 };
+    InitPongGame(&game, GYM_PONG_SCREEN_WIDTH, GYM_PONG_SCREEN_HEIGHT);
+
+    unsigned int random = GetRandom(&env->seeds[index]);
+    if (random & 0x01) game.ballSpeedX *= -1;
+    if (random & 0x02) game.ballSpeedY *= -1;
+
+    SetPongBatchMatch(&env->pong, index, &game);
+    env->episodeSteps[index] = 0;
+}
+
+// Start new blocks episode
+static void ResetBlocksEnv(GymEnv *env, int index)
+{
+    InitBlocksGame(&env->blocks[index], GYM_BLOCKS_SCREEN_WIDTH, GYM_BLOCKS_SCREEN_HEIGHT);
+
+    env->bricksLeft[index] = BRICKS_LINES*BRICKS_PER_LINE;
+    env->episodeSteps[index] = 0;
+}
+
+// Write all pong observations
+static void UpdatePongObservations(GymEnv *env)
+{
+    const PongBatch *pong = &env->pong;
+    float invWidth = 1.0f/pong->screenWidth;
+    float invHeight = 1.0f/pong->screenHeight;
+
+    for (int i = 0; i < env->count; i++)
+    {
+        float *observation = env->observations + (size_t)i*GYM_PONG_OBSERVATION_SIZE;
+
+        observation[0] = pong->ballX[i]*invWidth;
+        observation[1] = pong->ballY[i]*invHeight;
+        observation[2] = (float)pong->ballSpeedX[i]/GYM_SPEED_SCALE;
+        observation[3] = (float)pong->ballSpeedY[i]/GYM_SPEED_SCALE;
+        observation[4] = pong->playerY[i]*invHeight;
+        observation[5] = pong->enemyY[i]*invHeight;
+    }
+}
+
+// Write one blocks observation
+static void UpdateBlocksObservation(GymEnv *env, int index)
+{
+    const BlocksGame *game = &env->blocks[index];
+    float *observation = env->observations + (size_t)index*GYM_BLOCKS_OBSERVATION_SIZE;
+
+    observation[0] = game->player.position.x/game->screenWidth;
+    observation[1] = game->ball.position.x/game->screenWidth;
+    observation[2] = game->ball.position.y/game->screenHeight;
+    observation[3] = game->ball.speed.x/GYM_SPEED_SCALE;
+    observation[4] = game->ball.speed.y/GYM_SPEED_SCALE;
+    observation[5] = game->ball.active? 1.0f : 0.0f;
+    observation[6] = (float)game->player.lifes/PLAYER_LIFES;
+
+    float *bricks = observation + 7;
+
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++) bricks[j*BRICKS_PER_LINE + i] = game->bricks[j][i].active? 1.0f : 0.0f;
+    }
+}
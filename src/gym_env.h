@@ -0,0 +1,141 @@
+/**********************************************************************************************
+*
+*   gym_env - Vectorized environments API over game simulations (reset/step), for agents training
+*
+*   A batch of independent environments (pong or blocks) is stepped at once with one action
+*   per environment, every step produces:
+*     - Observations: compact game state, normalized floats (GYM_*_OBSERVATION_SIZE per env)
+*     - Rewards: pong +1 player scores, -1 enemy scores; blocks +1 per brick destroyed,
+*       -1 per life lost
+*     - Dones: episode finished (terminated or truncated), environment is reset automatically
+*       and its observation is the first one of the new episode
+*
+*   Pong environments are stepped with SIMD batch simulation (pong_batch), blocks ones with
+*   scalar simulation (blocks_sim). No window, inputs, audio or drawing involved.
+*
+*   OBSERVATIONS (pong):
+*       [0] ball x, [1] ball y, [2] ball speed x, [3] ball speed y, [4] player y, [5] enemy y
+*
+*   OBSERVATIONS (blocks):
+*       [0] player x, [1] ball x, [2] ball y, [3] ball speed x, [4] ball speed y,
+*       [5] ball active, [6] lifes, [7..106] bricks active (line by line)
+*
+*   NOTE: Positions are divided by playfield size, speeds by GYM_SPEED_SCALE, lifes by PLAYER_LIFES.
+*   Observations, rewards and dones buffers can be replaced by external memory (i.e. shared
+*   memory, check gym_shm.h) with SetGymEnvBuffers(), no copies involved
+*
+*   USAGE:
+*       GymEnv env = LoadGymEnv(GYM_ENV_PONG, 4096, GetGymEnvConfigDefault());
+*       ResetGymEnv(&env);
+*
+*       StepGymEnv(&env, actions);      // actions[i]: GYM_PONG_* or GYM_BLOCKS_* action
+*       // env.observations, env.rewards, env.dones
+*
+*       UnloadGymEnv(env);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef GYM_ENV_H
+#define GYM_ENV_H
+
+#include "raylib.h"
+#include "pong_batch.h"         // Required for: PongBatch
+#include "blocks_sim.h"         // Required for: BlocksGame, BRICKS_LINES, BRICKS_PER_LINE
+#include "enemy_policy.h"       // Required for: EnemyPolicy
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GYM_PONG_OBSERVATION_SIZE       6
+#define GYM_BLOCKS_OBSERVATION_SIZE     (7 + BRICKS_LINES*BRICKS_PER_LINE)
+
+#define GYM_SPEED_SCALE             10.0f   // Speeds observations scale (pixels per step)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Environment types
+typedef enum {
+    GYM_ENV_PONG = 0,
+    GYM_ENV_BLOCKS
+} GymEnvType;
+
+// Pong actions
+typedef enum {
+    GYM_PONG_NOOP = 0,
+    GYM_PONG_UP,
+    GYM_PONG_DOWN,
+    GYM_PONG_ACTIONS
+} GymPongAction;
+
+// Blocks actions
+typedef enum {
+    GYM_BLOCKS_NOOP = 0,
+    GYM_BLOCKS_LEFT,
+    GYM_BLOCKS_RIGHT,
+    GYM_BLOCKS_LAUNCH,
+    GYM_BLOCKS_ACTIONS
+} GymBlocksAction;
+
+// Episode end reasons, dones values
+typedef enum {
+    GYM_RUNNING = 0,            // Episode continues
+    GYM_TERMINATED = 1,         // Game finished (pong points reached, blocks game over or all bricks destroyed)
+    GYM_TRUNCATED = 2           // Steps limit reached
+} GymDone;
+
+// Environments configuration
+typedef struct GymEnvConfig {
+    int maxEpisodeSteps;        // Steps before episode is truncated (0 - no limit)
+    int pongPoints;             // Pong points (player + enemy) that finish an episode
+    unsigned int seed;          // Random seed for episodes initial state (pong ball direction)
+    const EnemyPolicy *enemyPolicy;     // Pong enemy policy, evaluated for whole batch (NULL - scripted chase)
+} GymEnvConfig;
+
+// Vectorized environments
+typedef struct GymEnv {
+    int type;                   // Environment type (GymEnvType)
+    int count;                  // Environments in batch
+    int observationSize;        // Floats per observation
+    int actionsCount;           // Discrete actions available
+    GymEnvConfig config;        // Environments configuration
+
+    PongBatch pong;             // Pong matches (GYM_ENV_PONG)
+    int *pongInputs;            // Pong batch inputs flags (GYM_ENV_PONG)
+    BlocksGame *blocks;         // Blocks games (GYM_ENV_BLOCKS)
+    int *bricksLeft;            // Blocks bricks remaining (GYM_ENV_BLOCKS)
+
+    int *episodeSteps;          // Steps since episode start, per env
+    unsigned int *seeds;        // Random state, per env
+
+    float *observations;        // Observations [count*observationSize]
+    float *rewards;             // Last step rewards [count]
+    int *dones;                 // Last step episode end (GymDone) [count]
+    bool ownsBuffers;           // Observations, rewards and dones allocated by environment
+} GymEnv;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+GymEnvConfig GetGymEnvConfigDefault(void);      // Get default configuration (10000 steps episodes, 5 points pong)
+GymEnv LoadGymEnv(int type, int count, GymEnvConfig config);    // Load environments (not reset)
+void UnloadGymEnv(GymEnv env);                  // Unload environments (external buffers are not freed)
+void SetGymEnvBuffers(GymEnv *env, float *observations, float *rewards, int *dones);   // Use external observations, rewards and dones buffers
+
+void ResetGymEnv(GymEnv *env);                  // Reset all environments, observations updated, rewards and dones cleared
+void StepGymEnv(GymEnv *env, const int *actions);   // Step all environments, finished ones are reset
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GYM_ENV_H
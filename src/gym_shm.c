@@ -0,0 +1,223 @@
+/**********************************************************************************************
+*
+*   gym_shm - Shared memory transport for vectorized environments (gym_env), no sockets or serialization
+*
+*   NOTE: Check gym_shm.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "gym_shm.h"
+
+#include "threads.h"            // Required for: AtomicLoad(), AtomicStore(), GetWallTime()
+
+#include <string.h>             // Required for: memset()
+
+#if defined(PLATFORM_WEB)
+    // NOTE: No shared memory between processes on web, functions fail
+#elif defined(_WIN32)
+    // NOTE: Declaring required functions directly, including windows.h conflicts with raylib names
+    __declspec(dllimport) int __stdcall SwitchToThread(void);
+#else
+    #include <sched.h>          // Required for: sched_yield()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GYM_SPIN_COUNT          4096        // Counter checks before yielding CPU while waiting
+
+#define ALIGN_SIZE(size)        (((size) + GYM_SHARED_ALIGNMENT - 1)/GYM_SHARED_ALIGNMENT*GYM_SHARED_ALIGNMENT)
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void SetRegionBuffers(GymShared *shared);                        // Set buffers pointers from header offsets
+static bool WaitCounter(volatile unsigned int *counter, unsigned int value, bool changed, double timeout);  // Spin/yield until counter changes from value (or reaches it)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Create region for environments
+// NOTE: Environments observations, rewards and dones are moved to region and reset,
+// region is ready for trainer requests once magic is written
+GymShared CreateGymShared(const char *name, GymEnv *env)
+{
+    GymShared shared = { 0 };
+
+    unsigned int actionsOffset = ALIGN_SIZE(sizeof(GymSharedHeader));
+    unsigned int observationsOffset = actionsOffset + ALIGN_SIZE(env->count*sizeof(int));
+    unsigned int rewardsOffset = observationsOffset + ALIGN_SIZE((size_t)env->count*env->observationSize*sizeof(float));
+    unsigned int donesOffset = rewardsOffset + ALIGN_SIZE(env->count*sizeof(float));
+    unsigned int size = donesOffset + ALIGN_SIZE(env->count*sizeof(int));
+
+    if (!CreateSharedRegion(&shared.region, name, size, false))
+    {
+        TraceLog(LOG_WARNING, "GYM: [%s] Failed to create shared memory region", shared.region.name);
+        return shared;
+    }
+
+    memset(shared.region.memory, 0, size);
+
+    GymSharedHeader *header = (GymSharedHeader *)shared.region.memory;
+    header->version = GYM_SHARED_VERSION;
+    header->size = size;
+    header->envType = env->type;
+    header->count = env->count;
+    header->observationSize = env->observationSize;
+    header->actionsCount = env->actionsCount;
+    header->actionsOffset = actionsOffset;
+    header->observationsOffset = observationsOffset;
+    header->rewardsOffset = rewardsOffset;
+    header->donesOffset = donesOffset;
+
+    shared.header = header;
+    SetRegionBuffers(&shared);
+    SetGymEnvBuffers(env, shared.observations, shared.rewards, shared.dones);
+    ResetGymEnv(env);
+
+    AtomicStore(&header->magic, GYM_SHARED_MAGIC);      // Publish, header and buffers written before
+
+    TraceLog(LOG_INFO, "GYM: [%s] Shared memory region created (%u bytes, %i environments)", shared.region.name, size, env->count);
+
+    return shared;
+}
+
+// Open region created by server
+GymShared OpenGymShared(const char *name)
+{
+    GymShared shared = { 0 };
+
+    if (OpenSharedRegion(&shared.region, name, false)) shared.header = (GymSharedHeader *)shared.region.memory;
+
+    if (shared.header == NULL) TraceLog(LOG_WARNING, "GYM: [%s] Failed to open shared memory region", shared.region.name);
+    else if (!IsGymSharedReady(&shared))
+    {
+        TraceLog(LOG_WARNING, "GYM: [%s] Shared memory region not ready or incompatible", shared.region.name);
+        CloseGymShared(&shared);
+    }
+    else
+    {
+        SetRegionBuffers(&shared);
+        shared.served = AtomicLoad(&shared.header->response);
+        TraceLog(LOG_INFO, "GYM: [%s] Shared memory region opened (%i environments)", shared.region.name, shared.header->count);
+    }
+
+    return shared;
+}
+
+// Unmap region, removed if owner
+// NOTE: Removed region name stays mapped by other processes until they close it
+void CloseGymShared(GymShared *shared)
+{
+    if (shared->region.memory == NULL) return;
+
+    CloseSharedRegion(&shared->region);
+
+    shared->header = NULL;
+    shared->actions = NULL;
+    shared->observations = NULL;
+    shared->rewards = NULL;
+    shared->dones = NULL;
+}
+
+// Check region is mapped and valid
+bool IsGymSharedReady(const GymShared *shared)
+{
+    if ((shared->region.memory == NULL) || (shared->region.size < sizeof(GymSharedHeader))) return false;
+
+    const GymSharedHeader *header = shared->header;
+
+    return (AtomicLoad((volatile unsigned int *)&header->magic) == GYM_SHARED_MAGIC) &&
+           (header->version == GYM_SHARED_VERSION) && (header->size <= shared->region.size);
+}
+
+// Wait for one request and serve it
+// NOTE: Actions are read from region, results written in place by environments
+int ServeGymShared(GymShared *shared, GymEnv *env, double timeout)
+{
+    if (shared->region.memory == NULL) return GYM_COMMAND_NONE;
+
+    GymSharedHeader *header = shared->header;
+
+    if (!WaitCounter(&header->request, shared->served, true, timeout)) return GYM_COMMAND_NONE;
+
+    unsigned int request = AtomicLoad(&header->request);     // Command and actions written before
+    int command = (int)header->command;
+
+    if (command == GYM_COMMAND_RESET) ResetGymEnv(env);
+    else if (command == GYM_COMMAND_STEP) StepGymEnv(env, shared->actions);
+
+    shared->served = request;
+    AtomicStore(&header->response, request);                 // Publish, results written before
+
+    return command;
+}
+
+// Send command and wait for response
+// NOTE: Actions must be written before, results can be read after on success.
+// Response must be this request one: after a timeout, a late response to previous request
+// changes the counter too, it must not be taken as this request results
+bool RequestGymShared(GymShared *shared, int command, double timeout)
+{
+    if (shared->region.memory == NULL) return false;
+
+    GymSharedHeader *header = shared->header;
+    unsigned int request = shared->served + 1;
+
+    header->command = (unsigned int)command;
+    shared->served = request;
+    AtomicStore(&header->request, request);                 // Publish, command and actions written before
+
+    if (command == GYM_COMMAND_CLOSE) return true;          // NOTE: Server could exit without response
+
+    return WaitCounter(&header->response, request, false, timeout);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Set buffers pointers from header offsets
+static void SetRegionBuffers(GymShared *shared)
+{
+    unsigned char *memory = (unsigned char *)shared->region.memory;
+    const GymSharedHeader *header = shared->header;
+
+    shared->actions = (int *)(memory + header->actionsOffset);
+    shared->observations = (float *)(memory + header->observationsOffset);
+    shared->rewards = (float *)(memory + header->rewardsOffset);
+    shared->dones = (int *)(memory + header->donesOffset);
+}
+
+// Spin/yield until counter changes from value (changed) or reaches value (!changed)
+// NOTE: Spinning keeps round trip latency low while trainer and server alternate,
+// CPU is yielded when the other side takes longer (i.e. trainer running its model)
+static bool WaitCounter(volatile unsigned int *counter, unsigned int value, bool changed, double timeout)
+{
+    for (int i = 0; i < GYM_SPIN_COUNT; i++)
+    {
+        if ((AtomicLoad(counter) != value) == changed) return true;
+    }
+
+    double start = GetWallTime();
+
+    while ((AtomicLoad(counter) != value) != changed)
+    {
+        if ((GetWallTime() - start) >= timeout) return false;
+
+#if defined(PLATFORM_WEB)
+        return false;
+#elif defined(_WIN32)
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+
+    return true;
+}
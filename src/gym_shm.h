@@ -0,0 +1,129 @@
+/**********************************************************************************************
+*
+*   gym_shm - Shared memory transport for vectorized environments (gym_env), no sockets or serialization
+*
+*   Environments process (server) creates a named shared memory region holding a header and
+*   the environments buffers: actions (written by trainer), observations, rewards and dones
+*   (written by environments, in place, check SetGymEnvBuffers()). Trainer process maps the
+*   same region and drives the environments through a request/response handshake:
+*
+*     1. Trainer writes actions and command, then increments header.request
+*     2. Server sees new request, resets or steps all environments, sets header.response = request
+*     3. Trainer waits for header.response == request (not any change: a late response to a
+*        timed out request is ignored), reads observations, rewards and dones
+*
+*   Waiting side spins on the sequence counters (yielding the CPU after a while), one round
+*   trip costs a few microseconds, steps a whole batch (i.e. 4096 environments).
+*
+*   REGION LAYOUT (little-endian, offsets in header, all buffers 64 bytes aligned):
+*       GymSharedHeader             header (magic 'GYM1', version, sizes, offsets, counters)
+*       int actions[count]          GymPongAction/GymBlocksAction per environment
+*       float observations[count*observationSize]
+*       float rewards[count]
+*       int dones[count]            GymDone per environment
+*
+*   NOTE: Region name is platform decorated (check shared_region.h): "/<name>" (POSIX shm_open(),
+*   Linux: /dev/shm/<name>), "Local\<name>" (Win32 file mapping), region is private to server
+*   user. Trainers in other languages (i.e. Python numpy) can map the region directly and follow
+*   same handshake. Not available on web platform
+*
+*   USAGE (server):
+*       GymEnv env = LoadGymEnv(GYM_ENV_PONG, 4096, GetGymEnvConfigDefault());
+*       GymShared shared = CreateGymShared("raylib_gym", &env);     // Uses shared buffers
+*
+*       while (ServeGymShared(&shared, &env, 10.0) != GYM_COMMAND_CLOSE) { }
+*
+*       CloseGymShared(&shared);
+*       UnloadGymEnv(env);
+*
+*   USAGE (trainer, C):
+*       GymShared shared = OpenGymShared("raylib_gym");
+*       RequestGymShared(&shared, GYM_COMMAND_RESET, 1.0);
+*
+*       shared.actions[i] = GYM_PONG_UP;
+*       RequestGymShared(&shared, GYM_COMMAND_STEP, 1.0);     // shared.observations, rewards, dones
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef GYM_SHM_H
+#define GYM_SHM_H
+
+#include "raylib.h"
+#include "gym_env.h"            // Required for: GymEnv
+#include "shared_region.h"      // Required for: SharedRegion
+
+#include <stddef.h>             // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GYM_SHARED_MAGIC        0x314D5947      // 'GYM1'
+#define GYM_SHARED_VERSION      1
+#define GYM_SHARED_ALIGNMENT    64              // Buffers alignment in region (cache line)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Trainer commands
+typedef enum {
+    GYM_COMMAND_NONE = 0,       // No request (server wait timed out)
+    GYM_COMMAND_RESET,          // Reset all environments
+    GYM_COMMAND_STEP,           // Step all environments with actions
+    GYM_COMMAND_CLOSE           // Trainer finished, server can exit
+} GymCommand;
+
+// Shared region header
+// NOTE: 32bit fields only, same layout for any compiler and language
+typedef struct GymSharedHeader {
+    unsigned int magic;                 // GYM_SHARED_MAGIC, written last by server (region ready)
+    unsigned int version;               // GYM_SHARED_VERSION
+    unsigned int size;                  // Region size in bytes
+    int envType;                        // GymEnvType
+    int count;                          // Environments
+    int observationSize;                // Floats per observation
+    int actionsCount;                   // Discrete actions available
+    unsigned int actionsOffset;         // Buffers offsets from region start
+    unsigned int observationsOffset;
+    unsigned int rewardsOffset;
+    unsigned int donesOffset;
+    volatile unsigned int command;      // GymCommand, written by trainer before request
+    volatile unsigned int request;      // Request sequence, incremented by trainer
+    volatile unsigned int response;     // Last served request sequence, written by server
+} GymSharedHeader;
+
+// Shared region mapping
+typedef struct GymShared {
+    SharedRegion region;        // Mapped region (region.memory NULL if not available)
+    GymSharedHeader *header;    // Region header
+    int *actions;               // Region buffers
+    float *observations;
+    float *rewards;
+    int *dones;
+    unsigned int served;        // Last request served (server) or sent (trainer)
+} GymShared;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+GymShared CreateGymShared(const char *name, GymEnv *env);   // Create region for environments, environments use its buffers
+GymShared OpenGymShared(const char *name);                  // Open region created by server (trainer side)
+void CloseGymShared(GymShared *shared);                     // Unmap region, removed if owner
+bool IsGymSharedReady(const GymShared *shared);             // Check region is mapped and valid
+
+int ServeGymShared(GymShared *shared, GymEnv *env, double timeout);     // Wait for one request and serve it, returns GymCommand served (NONE if timed out)
+bool RequestGymShared(GymShared *shared, int command, double timeout);  // Send command and wait for response, returns false if timed out
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GYM_SHM_H
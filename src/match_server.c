@@ -0,0 +1,644 @@
+/**********************************************************************************************
+*
+*   match_server - Headless PONG match server: thousands of concurrent matches over UDP
+*
+*   NOTE: Check match_server.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "match_server.h"
+
+#include "pong_net.h"           // Required for: PongNetMessage, WritePongNetMessage(), ReadPongNetMessage()
+#include "snapshot_codec.h"     // Required for: QuantizePongSnapshot(), EncodePongSnapshot()...
+
+#include <stdlib.h>             // Required for: malloc(), free()
+#include <string.h>             // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MATCH_SCREEN_WIDTH          800     // Matches playfield, same as pong game
+#define MATCH_SCREEN_HEIGHT         600
+#define MATCH_RECEIVE_BATCH         1024    // Datagrams handled per update, remaining ones on next update
+#define MATCH_TIMEOUT_CHECK_TIME    0.25    // Silent matches check period (seconds)
+
+#define ALIGN_SIZE(size)        (((size) + MATCH_SLOT_ALIGNMENT - 1)/MATCH_SLOT_ALIGNMENT*MATCH_SLOT_ALIGNMENT)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// States sent by one worker tick
+typedef struct TickCounters {
+    unsigned int packets;
+    unsigned int bytes;
+    unsigned int snapshotBytes;
+    unsigned int keyframes;
+    unsigned int errors;
+} TickCounters;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void RunMatchWorker(void *arg);          // Tick worker thread: wait for tick deadlines and step owned matches
+static TickCounters StepWorkerMatches(MatchWorker *worker);    // Step owned active matches and send encoded states
+static void HandleJoin(MatchServer *server, const PongNetMessage *message, NetAddress from, double time);    // Join client to a new or waiting match
+static void HandleInput(MatchServer *server, const PongNetMessage *message, NetAddress from, double time);   // Store client buttons and acknowledged state tick
+static ServerMatch *GetClientMatch(MatchServer *server, const PongNetMessage *message, NetAddress from);     // Get open match slot sending client belongs to, NULL if not valid
+static int AllocateMatch(MatchServer *server);  // Get free match slot from least loaded worker, -1 if full
+static void CloseMatch(MatchServer *server, int index);     // Close open match (freed by owner worker)
+static MatchWorker *GetMatchWorker(MatchServer *server, int index);     // Get match slot owner worker
+static MatchInput *GetMatchInput(MatchServer *server, int index);       // Get match inputs bookkeeping from arena
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get default configuration
+MatchServerConfig GetMatchServerConfigDefault(void)
+{
+    MatchServerConfig config = { 0 };
+
+    config.port = PONG_NET_PORT;
+    config.maxMatches = 4096;
+    config.workers = 2;
+    config.tickRate = 60;
+    config.maxCatchUpTicks = 4;
+    config.timeout = 5.0;
+
+    return config;
+}
+
+// Allocate arena, open socket and start tick workers
+bool StartMatchServer(MatchServer *server, MatchServerConfig config)
+{
+    memset(server, 0, sizeof(MatchServer));
+
+    if (config.workers < 1) config.workers = 1;
+    if (config.workers > MATCH_SERVER_MAX_WORKERS) config.workers = MATCH_SERVER_MAX_WORKERS;
+    if (config.maxMatches < config.workers) config.maxMatches = config.workers;
+    if (config.tickRate < 1) config.tickRate = 1;
+    if (config.maxCatchUpTicks < 1) config.maxCatchUpTicks = 1;
+
+    server->config = config;
+    server->waitingMatch = -1;
+
+    server->socket = OpenUdpSocket(config.port);
+    if (server->socket == -1) return false;
+
+    server->poller = LoadNetPoller();
+    AddNetPollerSocket(&server->poller, server->socket);
+
+    // Arena: match slots, inputs then workers, every entry (inputs: whole array) cache line aligned
+    // NOTE: Arena is cleared once, all pages are committed before first tick
+    server->matchStride = ALIGN_SIZE(sizeof(ServerMatch));
+    size_t slotsSize = (size_t)config.maxMatches*server->matchStride;
+    size_t inputsSize = ALIGN_SIZE((size_t)config.maxMatches*sizeof(MatchInput));
+    size_t workersSize = (size_t)config.workers*ALIGN_SIZE(sizeof(MatchWorker));
+
+    server->arenaSize = slotsSize + inputsSize + workersSize + MATCH_SLOT_ALIGNMENT;
+    server->arena = (unsigned char *)RL_MALLOC(server->arenaSize);
+
+    if (server->arena == NULL)
+    {
+        TraceLog(LOG_WARNING, "SERVER: Failed to allocate arena for %i matches", config.maxMatches);
+        UnloadNetPoller(&server->poller);
+        CloseUdpSocket(server->socket);
+        return false;
+    }
+
+    memset(server->arena, 0, server->arenaSize);
+
+    server->slots = server->arena + (MATCH_SLOT_ALIGNMENT - (size_t)server->arena%MATCH_SLOT_ALIGNMENT)%MATCH_SLOT_ALIGNMENT;
+    server->inputs = (MatchInput *)(server->slots + slotsSize);
+    server->workers = (MatchWorker *)(server->slots + slotsSize + inputsSize);
+
+    InitMutex(&server->mutex);
+    InitCondition(&server->wakeup);
+
+    server->startTime = GetWallTime();
+    server->statsTime = server->startTime;
+    server->lastTimeoutCheck = server->startTime;
+
+    // Contiguous match ranges per worker, last ones can be shorter
+    int rangeSize = (config.maxMatches + config.workers - 1)/config.workers;
+    int started = 0;
+
+    for (int w = 0; w < config.workers; w++)
+    {
+        MatchWorker *worker = &server->workers[w];
+
+        worker->server = server;
+        worker->first = w*rangeSize;
+        worker->count = config.maxMatches - worker->first;
+        if (worker->count > rangeSize) worker->count = rangeSize;
+        if (worker->count < 0) worker->count = 0;
+
+        InitMutex(&worker->statsMutex);
+
+        if (StartThread(&worker->thread, RunMatchWorker, worker)) started++;
+        else
+        {
+            DestroyMutex(&worker->statsMutex);
+            break;
+        }
+    }
+
+    server->running = true;
+
+    if (started < config.workers)
+    {
+        TraceLog(LOG_WARNING, "SERVER: Failed to start tick workers (%i/%i)", started, config.workers);
+        server->config.workers = started;
+        StopMatchServer(server);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "SERVER: Listening on UDP port %i, %i matches, %i workers, %i ticks per second",
+        config.port, config.maxMatches, config.workers, config.tickRate);
+    TraceLog(LOG_INFO, "SERVER: Arena %i KB, %i bytes per match", (int)(server->arenaSize/1024), server->matchStride + (int)sizeof(MatchInput));
+
+    return true;
+}
+
+// Stop tick workers, close socket and unload arena
+void StopMatchServer(MatchServer *server)
+{
+    if (!server->running) return;
+
+    LockMutex(&server->mutex);
+    server->stop = true;
+    BroadcastCondition(&server->wakeup);
+    UnlockMutex(&server->mutex);
+
+    for (int w = 0; w < server->config.workers; w++)
+    {
+        JoinThread(&server->workers[w].thread);
+        DestroyMutex(&server->workers[w].statsMutex);
+    }
+
+    DestroyCondition(&server->wakeup);
+    DestroyMutex(&server->mutex);
+
+    UnloadNetPoller(&server->poller);
+    CloseUdpSocket(server->socket);
+
+    RL_FREE(server->arena);
+
+    server->arena = NULL;
+    server->slots = NULL;
+    server->inputs = NULL;
+    server->workers = NULL;
+    server->running = false;
+}
+
+// Network thread: wait for datagrams and handle them
+void UpdateMatchServer(MatchServer *server, double timeout)
+{
+    if (!server->running) return;
+
+    if (WaitNetPoller(&server->poller, timeout) > 0)
+    {
+        unsigned char packet[PONG_NET_MAX_PACKET] = { 0 };
+        double time = GetWallTime();
+        NetAddress from = { 0 };
+        int size = 0;
+
+        for (int i = 0; (i < MATCH_RECEIVE_BATCH) && ((size = ReceiveUdp(server->socket, &from, packet, PONG_NET_MAX_PACKET)) >= 0); i++)
+        {
+            server->packetsIn++;
+            server->bytesIn += size;
+
+            PongNetMessage message = { 0 };
+            if (!ReadPongNetMessage(packet, size, &message)) continue;
+
+            switch (message.type)
+            {
+                case PONG_NET_JOIN: HandleJoin(server, &message, from, time); break;
+                case PONG_NET_INPUT: HandleInput(server, &message, from, time); break;
+                case PONG_NET_LEAVE:
+                {
+                    if (GetClientMatch(server, &message, from) != NULL) CloseMatch(server, message.match);
+                } break;
+                default: break;     // Server messages, ignored
+            }
+        }
+    }
+
+    // Close matches with silent clients
+    double time = GetWallTime();
+
+    if ((time - server->lastTimeoutCheck) >= MATCH_TIMEOUT_CHECK_TIME)
+    {
+        for (int i = 0; i < server->config.maxMatches; i++)
+        {
+            ServerMatch *match = GetServerMatch(server, i);
+            unsigned int state = AtomicLoad(&match->state);
+
+            if ((state != MATCH_ACTIVE) && (state != MATCH_WAITING)) continue;
+
+            const MatchInput *input = GetMatchInput(server, i);
+            int sides = (state == MATCH_WAITING)? 1 : match->players;
+
+            for (int side = 0; side < sides; side++)
+            {
+                if ((time - input->lastInputTimes[side]) > server->config.timeout)
+                {
+                    CloseMatch(server, i);
+                    break;
+                }
+            }
+        }
+
+        server->lastTimeoutCheck = time;
+    }
+}
+
+// Get match slot from arena
+ServerMatch *GetServerMatch(MatchServer *server, int index)
+{
+    return (ServerMatch *)(server->slots + (size_t)index*server->matchStride);
+}
+
+// Get stats since last reset
+// NOTE: Called from network thread, workers stats are locked while read
+MatchServerStats GetMatchServerStats(MatchServer *server, bool reset)
+{
+    MatchServerStats stats = { 0 };
+
+    if (!server->running) return stats;
+
+    double time = GetWallTime();
+
+    stats.elapsed = time - server->statsTime;
+    stats.packetsIn = server->packetsIn;
+    stats.bytesIn = server->bytesIn;
+    stats.matchSize = server->matchStride + (int)sizeof(MatchInput);
+    stats.arenaSize = server->arenaSize;
+
+    for (int w = 0; w < server->config.workers; w++)
+    {
+        MatchWorker *worker = &server->workers[w];
+
+        LockMutex(&worker->statsMutex);
+
+        stats.ticks += worker->ticks;
+        stats.ticksDropped += worker->ticksDropped;
+        stats.latencyAvg += worker->latencySum;
+        stats.workAvg += worker->workSum;
+        if (worker->latencyMax > stats.latencyMax) stats.latencyMax = worker->latencyMax;
+        stats.packetsOut += worker->packetsOut;
+        stats.bytesOut += worker->bytesOut;
+        stats.snapshotBytes += worker->snapshotBytes;
+        stats.keyframes += worker->keyframes;
+        stats.sendErrors += worker->sendErrors;
+
+        if (reset)
+        {
+            worker->ticks = 0;
+            worker->ticksDropped = 0;
+            worker->latencySum = 0.0;
+            worker->latencyMax = 0.0;
+            worker->workSum = 0.0;
+            worker->packetsOut = 0;
+            worker->bytesOut = 0;
+            worker->snapshotBytes = 0;
+            worker->keyframes = 0;
+            worker->sendErrors = 0;
+        }
+
+        UnlockMutex(&worker->statsMutex);
+    }
+
+    if (stats.ticks > 0)
+    {
+        stats.latencyAvg /= stats.ticks;
+        stats.workAvg /= stats.ticks;
+    }
+
+    if (stats.elapsed > 0.0)
+    {
+        stats.ticksPerSecond = stats.ticks/stats.elapsed;
+        stats.workerTicksPerSecond = stats.ticksPerSecond/server->config.workers;
+    }
+
+    for (int i = 0; i < server->config.maxMatches; i++)
+    {
+        unsigned int state = AtomicLoad(&GetServerMatch(server, i)->state);
+
+        if (state == MATCH_ACTIVE) stats.activeMatches++;
+        else if (state == MATCH_WAITING) stats.waitingMatches++;
+    }
+
+    if (reset)
+    {
+        server->statsTime = time;
+        server->packetsIn = 0;
+        server->bytesIn = 0;
+    }
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Tick worker thread
+// NOTE: Tick deadlines are start time multiples, shared by all workers, late ticks run
+// back to back (up to maxCatchUpTicks pending), older ones are dropped
+static void RunMatchWorker(void *arg)
+{
+    MatchWorker *worker = (MatchWorker *)arg;
+    MatchServer *server = worker->server;
+
+    double tickTime = 1.0/server->config.tickRate;
+    unsigned int tick = 0;          // Tick deadlines handled (run or dropped)
+
+    while (true)
+    {
+        double deadline = server->startTime + (tick + 1)*tickTime;
+
+        LockMutex(&server->mutex);
+        while (!server->stop)
+        {
+            double remaining = deadline - GetWallTime();
+            if (remaining <= 0.0) break;
+
+            WaitConditionTimeout(&server->wakeup, &server->mutex, remaining);
+        }
+        bool stop = server->stop;
+        UnlockMutex(&server->mutex);
+
+        if (stop) break;
+
+        double start = GetWallTime();
+        unsigned int due = (unsigned int)((start - server->startTime)/tickTime);   // Deadlines passed
+        unsigned int dropped = 0;
+
+        if (due > (tick + server->config.maxCatchUpTicks))
+        {
+            dropped = due - tick - server->config.maxCatchUpTicks;
+            tick += dropped;
+            deadline = server->startTime + (tick + 1)*tickTime;
+        }
+
+        tick++;
+
+        TickCounters counters = StepWorkerMatches(worker);
+
+        double end = GetWallTime();
+
+        LockMutex(&worker->statsMutex);
+        worker->ticks++;
+        worker->ticksDropped += dropped;
+        worker->latencySum += end - deadline;
+        if ((end - deadline) > worker->latencyMax) worker->latencyMax = end - deadline;
+        worker->workSum += end - start;
+        worker->packetsOut += counters.packets;
+        worker->bytesOut += counters.bytes;
+        worker->snapshotBytes += counters.snapshotBytes;
+        worker->keyframes += counters.keyframes;
+        worker->sendErrors += counters.errors;
+        UnlockMutex(&worker->statsMutex);
+    }
+}
+
+// Step owned active matches and send encoded states
+// NOTE: Every client gets the snapshot encoded against its own last acknowledged state
+static TickCounters StepWorkerMatches(MatchWorker *worker)
+{
+    MatchServer *server = worker->server;
+    TickCounters counters = { 0 };
+    unsigned char packet[PONG_NET_MAX_PACKET] = { 0 };
+
+    for (int i = worker->first; i < (worker->first + worker->count); i++)
+    {
+        ServerMatch *match = GetServerMatch(server, i);
+        unsigned int state = AtomicLoad(&match->state);
+
+        if (state == MATCH_CLOSING)
+        {
+            AtomicStore(&match->state, MATCH_FREE);     // Slot released to network thread
+            continue;
+        }
+        else if (state != MATCH_ACTIVE) continue;
+
+        unsigned int playerButtons = AtomicLoad(&match->buttons[PONG_SIDE_PLAYER]);
+
+        PongInput input = { 0 };
+        input.up = (playerButtons & PONG_NET_BUTTON_UP) != 0;
+        input.down = (playerButtons & PONG_NET_BUTTON_DOWN) != 0;
+
+        if (match->players == 2)
+        {
+            unsigned int enemyButtons = AtomicLoad(&match->buttons[PONG_SIDE_ENEMY]);
+
+            input.enemyControlled = true;
+            input.enemyMove = (enemyButtons & PONG_NET_BUTTON_UP)? -1 : (enemyButtons & PONG_NET_BUTTON_DOWN)? 1 : 0;
+        }
+
+        UpdatePongGame(&match->game, input);
+        match->tick++;
+
+        PongSnapshot snapshot = GetPongSnapshot(&match->game, match->tick);
+        QuantizePongSnapshot(&snapshot);
+        StoreSnapshotHistory(&match->history, &snapshot);
+
+        PongNetMessage message = { 0 };
+        message.type = PONG_NET_STATE;
+
+        for (int side = 0; side < match->players; side++)
+        {
+            const PongSnapshot *baseline = GetSnapshotHistory(&match->history, AtomicLoad(&match->acks[side]));
+
+            message.token = match->tokens[side];
+            message.payloadSize = EncodePongSnapshot(&snapshot, baseline, message.payload);
+
+            int size = WritePongNetMessage(&message, packet);
+
+            if (SendUdp(server->socket, match->clients[side], packet, size) == size)
+            {
+                counters.packets++;
+                counters.bytes += size;
+                counters.snapshotBytes += message.payloadSize;
+                if (IsSnapshotKeyframe(message.payload, message.payloadSize)) counters.keyframes++;
+            }
+            else counters.errors++;
+        }
+    }
+
+    return counters;
+}
+
+// Join client to a new or waiting match
+// NOTE: JOINED is sent again for a repeated join from the waiting client, repeated
+// joins from other clients open new matches (closed by timeout if never used)
+static void HandleJoin(MatchServer *server, const PongNetMessage *message, NetAddress from, double time)
+{
+    PongNetMessage reply = { 0 };
+    reply.type = PONG_NET_JOINED;
+    reply.token = message->token;
+    reply.match = -1;
+
+    int players = (message->players == 2)? 2 : 1;
+
+    if ((players == 2) && (server->waitingMatch != -1))
+    {
+        ServerMatch *match = GetServerMatch(server, server->waitingMatch);
+
+        reply.match = server->waitingMatch;
+
+        if (IsNetAddressEqual(match->clients[0], from) && (match->tokens[0] == message->token)) reply.side = PONG_SIDE_PLAYER;
+        else
+        {
+            MatchInput *input = GetMatchInput(server, server->waitingMatch);
+
+            match->clients[PONG_SIDE_ENEMY] = from;
+            match->tokens[PONG_SIDE_ENEMY] = message->token;
+            input->sequences[PONG_SIDE_ENEMY] = 0;
+            input->lastInputTimes[PONG_SIDE_ENEMY] = time;
+            AtomicStore(&match->acks[PONG_SIDE_ENEMY], 0);
+
+            AtomicStore(&match->state, MATCH_ACTIVE);   // Published to owner worker
+
+            server->waitingMatch = -1;
+            reply.side = PONG_SIDE_ENEMY;
+        }
+    }
+    else
+    {
+        int index = AllocateMatch(server);
+
+        if (index != -1)
+        {
+            ServerMatch *match = GetServerMatch(server, index);
+            MatchInput *input = GetMatchInput(server, index);
+
+            InitPongGame(&match->game, MATCH_SCREEN_WIDTH, MATCH_SCREEN_HEIGHT);
+            memset(&match->history, 0, sizeof(SnapshotHistory));
+            match->tick = 0;
+            match->players = players;
+            match->clients[PONG_SIDE_PLAYER] = from;
+            match->tokens[PONG_SIDE_PLAYER] = message->token;
+            input->sequences[PONG_SIDE_PLAYER] = 0;
+            input->lastInputTimes[PONG_SIDE_PLAYER] = time;
+            AtomicStore(&match->buttons[PONG_SIDE_PLAYER], 0);
+            AtomicStore(&match->buttons[PONG_SIDE_ENEMY], 0);
+            AtomicStore(&match->acks[PONG_SIDE_PLAYER], 0);
+            AtomicStore(&match->acks[PONG_SIDE_ENEMY], 0);
+
+            if (players == 2)
+            {
+                AtomicStore(&match->state, MATCH_WAITING);
+                server->waitingMatch = index;
+            }
+            else AtomicStore(&match->state, MATCH_ACTIVE);  // Published to owner worker
+
+            reply.match = index;
+            reply.side = PONG_SIDE_PLAYER;
+        }
+    }
+
+    unsigned char packet[PONG_NET_MAX_PACKET] = { 0 };
+    int size = WritePongNetMessage(&reply, packet);
+    SendUdp(server->socket, from, packet, size);
+}
+
+// Store client buttons and acknowledged state tick
+// NOTE: Older inputs (reordered datagrams) are ignored
+static void HandleInput(MatchServer *server, const PongNetMessage *message, NetAddress from, double time)
+{
+    ServerMatch *match = GetClientMatch(server, message, from);
+    if (match == NULL) return;
+
+    MatchInput *input = GetMatchInput(server, message->match);
+
+    if ((int)(message->sequence - input->sequences[message->side]) <= 0) return;
+
+    input->sequences[message->side] = message->sequence;
+    input->lastInputTimes[message->side] = time;
+
+    AtomicStore(&match->buttons[message->side], message->buttons);
+    AtomicStore(&match->acks[message->side], message->ack);
+}
+
+// Get open match slot sending client belongs to
+static ServerMatch *GetClientMatch(MatchServer *server, const PongNetMessage *message, NetAddress from)
+{
+    if ((message->match < 0) || (message->match >= server->config.maxMatches) ||
+        (message->side < 0) || (message->side > 1)) return NULL;
+
+    ServerMatch *match = GetServerMatch(server, message->match);
+    unsigned int state = AtomicLoad(&match->state);
+
+    if ((state != MATCH_ACTIVE) && (state != MATCH_WAITING)) return NULL;
+    if ((message->side >= match->players) || ((state == MATCH_WAITING) && (message->side != PONG_SIDE_PLAYER))) return NULL;
+    if (!IsNetAddressEqual(match->clients[message->side], from)) return NULL;
+
+    return match;
+}
+
+// Get free match slot from least loaded worker
+// NOTE: Closing slots are not free until their worker releases them, next worker is tried
+static int AllocateMatch(MatchServer *server)
+{
+    bool tried[MATCH_SERVER_MAX_WORKERS] = { 0 };
+
+    for (int attempt = 0; attempt < server->config.workers; attempt++)
+    {
+        MatchWorker *worker = NULL;
+
+        for (int w = 0; w < server->config.workers; w++)
+        {
+            if (!tried[w] && ((worker == NULL) || (server->workers[w].matches < worker->matches))) worker = &server->workers[w];
+        }
+
+        tried[worker - server->workers] = true;
+
+        for (int i = worker->first; i < (worker->first + worker->count); i++)
+        {
+            if (AtomicLoad(&GetServerMatch(server, i)->state) == MATCH_FREE)
+            {
+                worker->matches++;
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+// Close open match
+static void CloseMatch(MatchServer *server, int index)
+{
+    ServerMatch *match = GetServerMatch(server, index);
+
+    // Waiting matches are never touched by workers, released directly
+    if (AtomicLoad(&match->state) == MATCH_WAITING)
+    {
+        AtomicStore(&match->state, MATCH_FREE);
+        if (server->waitingMatch == index) server->waitingMatch = -1;
+    }
+    else AtomicStore(&match->state, MATCH_CLOSING);
+
+    GetMatchWorker(server, index)->matches--;
+}
+
+// Get match slot owner worker
+static MatchWorker *GetMatchWorker(MatchServer *server, int index)
+{
+    int rangeSize = (server->config.maxMatches + server->config.workers - 1)/server->config.workers;
+
+    return &server->workers[index/rangeSize];
+}
+
+// Get match inputs bookkeeping from arena
+static MatchInput *GetMatchInput(MatchServer *server, int index)
+{
+    return &server->inputs[index];
+}
@@ -0,0 +1,200 @@
+/**********************************************************************************************
+*
+*   match_server - Headless PONG match server: thousands of concurrent matches over UDP
+*
+*   Authoritative server, no window, no graphics: matches are simulated with pong_sim and
+*   clients only send paddle buttons and receive match states (pong_net protocol).
+*
+*     - Network thread (caller of UpdateMatchServer()): waits on the UDP socket (epoll on
+*       Linux, check net_udp.h), handles joins, inputs and leaves, closes silent matches
+*     - Tick workers: fixed tick scheduler, every worker owns a contiguous range of match
+*       slots and steps its active matches on every tick (same deadlines for all workers),
+*       then sends the new state to every match client, delta encoded against the last
+*       state acknowledged by the client (check snapshot_codec.h)
+*     - Match slots live in one preallocated arena (allocated on start, no allocations while
+*       running), slots are cache line aligned, workers never share a cache line. Inputs
+*       bookkeeping written by network thread on every input (sequences, input times) is kept
+*       in its own arena array, out of the cache lines workers write
+*
+*   Match slot lifetime, state changed with atomic stores:
+*       FREE -> WAITING (2 players match, one client joined, network thread)
+*       FREE/WAITING -> ACTIVE (all clients joined, network thread)
+*       ACTIVE -> CLOSING (client left or timed out, network thread)
+*       CLOSING -> FREE (owner worker, slot not touched by worker anymore)
+*
+*   Stats: ticks per second (all workers and per worker), tick latency (tick deadline to tick done, includes scheduling
+*   delay) and tick work time, packets, snapshot bytes per state, memory per match.
+*
+*   NOTE: Linux/POSIX only (check net_udp.h), StartMatchServer() fails on other platforms.
+*   Single player matches play against pong_sim scripted enemy.
+*   MatchServer structure must stay valid (not moved) until StopMatchServer()
+*
+*   USAGE:
+*       static MatchServer server = { 0 };
+*       StartMatchServer(&server, GetMatchServerConfigDefault());
+*
+*       while (running)
+*       {
+*           UpdateMatchServer(&server, 0.01);       // Network thread
+*           MatchServerStats stats = GetMatchServerStats(&server, true);
+*       }
+*
+*       StopMatchServer(&server);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef MATCH_SERVER_H
+#define MATCH_SERVER_H
+
+#include "raylib.h"
+#include "pong_sim.h"           // Required for: PongGame
+#include "net_udp.h"            // Required for: NetAddress, NetPoller
+#include "snapshot_codec.h"     // Required for: SnapshotHistory
+#include "threads.h"            // Required for: Thread, Mutex, Condition
+
+#include <stddef.h>             // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MATCH_SERVER_MAX_WORKERS    64
+#define MATCH_SLOT_ALIGNMENT        64      // Match slots alignment in arena (cache line)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Match slot states
+typedef enum {
+    MATCH_FREE = 0,             // Available for new match
+    MATCH_WAITING,              // Waiting for second client, not stepped
+    MATCH_ACTIVE,               // Stepped by owner worker
+    MATCH_CLOSING               // Closed by network thread, freed by owner worker
+} MatchState;
+
+// Match server configuration
+typedef struct MatchServerConfig {
+    unsigned short port;        // UDP port
+    int maxMatches;             // Match slots preallocated
+    int workers;                // Tick worker threads
+    int tickRate;               // Ticks per second
+    int maxCatchUpTicks;        // Maximum ticks run back to back when late, older ones are dropped
+    double timeout;             // Match closed after seconds without inputs
+} MatchServerConfig;
+
+// Match slot
+typedef struct ServerMatch {
+    volatile unsigned int state;    // Match state (MatchState, atomic)
+    volatile unsigned int buttons[2];   // Buttons down per side (PONG_NET_BUTTON_*, atomic)
+    volatile unsigned int acks[2];  // Last state tick received per side, 0 if none (atomic)
+    unsigned int tick;          // Ticks run by match (owner worker)
+    PongGame game;              // Match simulation (owner worker)
+    SnapshotHistory history;    // Snapshots sent, delta baselines (owner worker)
+
+    int players;                // Clients required: 1 (vs scripted enemy) or 2
+    NetAddress clients[2];      // Clients addresses per side
+    unsigned int tokens[2];     // Clients tokens per side
+} ServerMatch;
+
+// Match inputs bookkeeping, network thread only
+// NOTE: Not part of match slot, written on every input, owner worker cache lines stay untouched
+typedef struct MatchInput {
+    double lastInputTimes[2];   // Time of last input per side
+    unsigned int sequences[2];  // Last input sequence per side
+} MatchInput;
+
+// Tick worker
+typedef struct MatchWorker {
+    struct MatchServer *server; // Owner server
+    Thread thread;              // Worker thread
+    int first;                  // First match slot owned
+    int count;                  // Match slots owned
+    int matches;                // Open matches in range (network thread)
+
+    Mutex statsMutex;           // Stats lock (worker and network thread)
+    unsigned int ticks;         // Ticks run
+    unsigned int ticksDropped;  // Ticks dropped when late
+    double latencySum;          // Tick deadline to tick done (seconds)
+    double latencyMax;
+    double workSum;             // Tick work time (seconds)
+    unsigned int packetsOut;
+    unsigned int bytesOut;
+    unsigned int snapshotBytes; // Encoded snapshots bytes sent
+    unsigned int keyframes;     // Keyframe snapshots sent (no baseline acknowledged)
+    unsigned int sendErrors;    // Datagrams not sent (socket buffer full)
+} MatchWorker;
+
+// Match server stats, since last reset
+typedef struct MatchServerStats {
+    double elapsed;             // Seconds since last reset
+    int activeMatches;          // Matches being stepped
+    int waitingMatches;         // Matches waiting for second client
+    unsigned int ticks;         // Ticks run, all workers
+    unsigned int ticksDropped;  // Ticks dropped when late, all workers
+    double ticksPerSecond;      // Ticks per second, all workers
+    double workerTicksPerSecond;    // Ticks per second, per worker average (compare with tickRate)
+    double latencyAvg;          // Tick latency average (seconds)
+    double latencyMax;          // Tick latency maximum (seconds)
+    double workAvg;             // Tick work time average (seconds)
+    unsigned int packetsIn;
+    unsigned int packetsOut;
+    unsigned int bytesIn;
+    unsigned int bytesOut;
+    unsigned int snapshotBytes; // Encoded snapshots bytes (STATE payloads)
+    unsigned int keyframes;     // Keyframe snapshots sent
+    unsigned int sendErrors;
+    int matchSize;              // Arena bytes per match (slot and inputs)
+    size_t arenaSize;           // Arena bytes (match slots, inputs and workers)
+} MatchServerStats;
+
+// Match server state
+// NOTE: Fields are internal, shared ones are only accessed with atomic operations or locks
+typedef struct MatchServer {
+    MatchServerConfig config;   // Server configuration
+    int socket;                 // UDP socket
+    NetPoller poller;           // Socket readiness poller
+
+    unsigned char *arena;       // Preallocated arena: match slots, inputs and workers
+    size_t arenaSize;           // Arena size (bytes)
+    unsigned char *slots;       // Match slots (aligned, in arena)
+    int matchStride;            // Match slot size in arena (aligned)
+    MatchInput *inputs;         // Match inputs bookkeeping, one per slot (aligned, in arena)
+    MatchWorker *workers;       // Tick workers (in arena)
+    int waitingMatch;           // 2 players match waiting for second client, -1 if none (network thread)
+
+    double startTime;           // Server start time, ticks deadlines origin
+    double lastTimeoutCheck;    // Time of last silent matches check (network thread)
+    double statsTime;           // Time of last stats reset
+    unsigned int packetsIn;     // Network thread counters
+    unsigned int bytesIn;
+
+    Mutex mutex;                // Workers sleep lock
+    Condition wakeup;           // Signaled on stop
+    bool stop;                  // Workers must exit (protected by mutex)
+    bool running;               // Server started
+} MatchServer;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MatchServerConfig GetMatchServerConfigDefault(void);    // Get default configuration (port 7777, 4096 matches, 2 workers, 60 ticks per second)
+bool StartMatchServer(MatchServer *server, MatchServerConfig config);  // Allocate arena, open socket and start tick workers, returns false on failure
+void StopMatchServer(MatchServer *server);               // Stop tick workers, close socket and unload arena
+
+void UpdateMatchServer(MatchServer *server, double timeout);    // Network thread: wait for datagrams (up to timeout) and handle them
+ServerMatch *GetServerMatch(MatchServer *server, int index);    // Get match slot from arena
+MatchServerStats GetMatchServerStats(MatchServer *server, bool reset);  // Get stats since last reset (optionally reset them)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MATCH_SERVER_H
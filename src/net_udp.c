@@ -0,0 +1,215 @@
+/**********************************************************************************************
+*
+*   net_udp - Minimal non-blocking UDP sockets and readiness polling for headless servers
+*
+*   NOTE: Check net_udp.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "net_udp.h"
+
+#include "raylib.h"             // Required for: TraceLog()
+
+#include <stdio.h>              // Required for: sscanf()
+#include <stddef.h>             // Required for: NULL
+
+#if defined(_WIN32) || defined(PLATFORM_WEB)
+    #define NET_SUPPORTED   0
+#else
+    #define NET_SUPPORTED   1
+
+    #include <sys/socket.h>     // Required for: socket(), bind(), sendto(), recvfrom()
+    #include <netinet/in.h>     // Required for: sockaddr_in, htonl(), htons()
+    #include <fcntl.h>          // Required for: fcntl(), O_NONBLOCK
+    #include <unistd.h>         // Required for: close()
+    #include <poll.h>           // Required for: poll()
+    #if NET_POLLER_EPOLL
+        #include <sys/epoll.h>  // Required for: epoll_create1(), epoll_ctl(), epoll_wait()
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_SOCKET_BUFFER_SIZE      (4*1024*1024)   // Kernel send/receive buffers, servers burst thousands of datagrams per tick
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Open non-blocking UDP socket bound to port
+int OpenUdpSocket(unsigned short port)
+{
+#if NET_SUPPORTED
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock == -1) return -1;
+
+    int bufferSize = NET_SOCKET_BUFFER_SIZE;
+    setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+
+    if ((bind(sock, (struct sockaddr *)&address, sizeof(address)) == -1) ||
+        (fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK) == -1))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to open UDP socket on port %i", port);
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+#else
+    TraceLog(LOG_WARNING, "NET: UDP sockets not supported on this platform");
+    (void)port;
+    return -1;
+#endif
+}
+
+// Close UDP socket
+void CloseUdpSocket(int socket)
+{
+#if NET_SUPPORTED
+    if (socket != -1) close(socket);
+#else
+    (void)socket;
+#endif
+}
+
+// Send datagram
+// NOTE: Socket is non-blocking, datagram is dropped (-1) if kernel buffer is full
+int SendUdp(int socket, NetAddress to, const void *data, int size)
+{
+#if NET_SUPPORTED
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(to.host);
+    address.sin_port = htons(to.port);
+
+    return (int)sendto(socket, data, size, 0, (struct sockaddr *)&address, sizeof(address));
+#else
+    (void)socket; (void)to; (void)data; (void)size;
+    return -1;
+#endif
+}
+
+// Receive datagram
+int ReceiveUdp(int socket, NetAddress *from, void *data, int capacity)
+{
+#if NET_SUPPORTED
+    struct sockaddr_in address = { 0 };
+    socklen_t addressSize = sizeof(address);
+
+    int size = (int)recvfrom(socket, data, capacity, 0, (struct sockaddr *)&address, &addressSize);
+
+    if ((size >= 0) && (from != NULL))
+    {
+        from->host = ntohl(address.sin_addr.s_addr);
+        from->port = ntohs(address.sin_port);
+    }
+
+    return size;
+#else
+    (void)socket; (void)from; (void)data; (void)capacity;
+    return -1;
+#endif
+}
+
+// Get address from dotted IPv4 string
+NetAddress GetNetAddress(const char *host, unsigned short port)
+{
+    NetAddress address = { 0 };
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+
+    if (sscanf(host, "%u.%u.%u.%u", &a, &b, &c, &d) == 4) address.host = (a << 24) | (b << 16) | (c << 8) | d;
+    else TraceLog(LOG_WARNING, "NET: [%s] Address not valid, IPv4 dotted address expected", host);
+
+    address.port = port;
+
+    return address;
+}
+
+// Check addresses are equal
+bool IsNetAddressEqual(NetAddress a, NetAddress b)
+{
+    return (a.host == b.host) && (a.port == b.port);
+}
+
+// Load sockets poller
+NetPoller LoadNetPoller(void)
+{
+    NetPoller poller = { 0 };
+
+#if NET_SUPPORTED && NET_POLLER_EPOLL
+    poller.fd = epoll_create1(0);
+#else
+    poller.fd = -1;
+#endif
+
+    return poller;
+}
+
+// Unload sockets poller
+void UnloadNetPoller(NetPoller *poller)
+{
+#if NET_SUPPORTED && NET_POLLER_EPOLL
+    if (poller->fd != -1) close(poller->fd);
+#endif
+
+    poller->fd = -1;
+    poller->socketsCount = 0;
+}
+
+// Add socket to poller
+bool AddNetPollerSocket(NetPoller *poller, int socket)
+{
+    if ((socket == -1) || (poller->socketsCount >= NET_POLLER_MAX_SOCKETS)) return false;
+
+#if NET_SUPPORTED && NET_POLLER_EPOLL
+    struct epoll_event event = { 0 };
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+
+    if (epoll_ctl(poller->fd, EPOLL_CTL_ADD, socket, &event) == -1) return false;
+#endif
+
+    poller->sockets[poller->socketsCount++] = socket;
+
+    return true;
+}
+
+// Wait until a socket is readable
+// NOTE: Level-triggered, sockets stay readable until all pending datagrams are received
+int WaitNetPoller(NetPoller *poller, double timeout)
+{
+    int milliseconds = (int)(timeout*1000.0);
+
+#if NET_SUPPORTED && NET_POLLER_EPOLL
+    struct epoll_event events[NET_POLLER_MAX_SOCKETS];
+    int count = epoll_wait(poller->fd, events, NET_POLLER_MAX_SOCKETS, milliseconds);
+
+    return (count > 0)? count : 0;
+#elif NET_SUPPORTED
+    struct pollfd fds[NET_POLLER_MAX_SOCKETS] = { 0 };
+
+    for (int i = 0; i < poller->socketsCount; i++)
+    {
+        fds[i].fd = poller->sockets[i];
+        fds[i].events = POLLIN;
+    }
+
+    int count = poll(fds, poller->socketsCount, milliseconds);
+
+    return (count > 0)? count : 0;
+#else
+    (void)poller; (void)milliseconds;
+    return 0;
+#endif
+}
@@ -0,0 +1,84 @@
+/**********************************************************************************************
+*
+*   net_udp - Minimal non-blocking UDP sockets and readiness polling for headless servers
+*
+*   Thin wrapper over BSD sockets, just what game servers and bots need: IPv4 datagram
+*   sockets (non-blocking), send/receive with peer address, and a poller waiting for readable
+*   sockets: epoll on Linux, poll() on other POSIX platforms.
+*
+*   NOTE: Not available on Windows and web platform (functions fail, sockets are -1),
+*   headless servers and bots are intended to run on Linux boxes
+*
+*   USAGE:
+*       int socket = OpenUdpSocket(7777);                  // 0 - any free port (clients)
+*       NetPoller poller = LoadNetPoller();
+*       AddNetPollerSocket(&poller, socket);
+*
+*       if (WaitNetPoller(&poller, 0.01) > 0)
+*       {
+*           while ((size = ReceiveUdp(socket, &from, buffer, sizeof(buffer))) >= 0) ...
+*       }
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef NET_UDP_H
+#define NET_UDP_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(__linux__) && !defined(PLATFORM_WEB)
+    #define NET_POLLER_EPOLL        1       // epoll readiness notification
+#else
+    #define NET_POLLER_EPOLL        0       // poll() on sockets list
+#endif
+
+#define NET_POLLER_MAX_SOCKETS      16
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// IPv4 address and port, host byte order
+typedef struct NetAddress {
+    unsigned int host;          // i.e. 127.0.0.1 -> 0x7F000001
+    unsigned short port;
+} NetAddress;
+
+// Sockets readiness poller
+typedef struct NetPoller {
+    int fd;                     // epoll instance (NET_POLLER_EPOLL)
+    int sockets[NET_POLLER_MAX_SOCKETS];    // Sockets polled
+    int socketsCount;
+} NetPoller;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int OpenUdpSocket(unsigned short port);         // Open non-blocking UDP socket bound to port (0 - any), returns -1 on failure
+void CloseUdpSocket(int socket);                // Close UDP socket
+int SendUdp(int socket, NetAddress to, const void *data, int size);        // Send datagram, returns bytes sent or -1
+int ReceiveUdp(int socket, NetAddress *from, void *data, int capacity);    // Receive datagram, returns bytes received or -1 if none pending
+NetAddress GetNetAddress(const char *host, unsigned short port);           // Get address from dotted IPv4 string ("127.0.0.1")
+bool IsNetAddressEqual(NetAddress a, NetAddress b);                        // Check addresses are equal
+
+NetPoller LoadNetPoller(void);                  // Load sockets poller
+void UnloadNetPoller(NetPoller *poller);        // Unload sockets poller (sockets are not closed)
+bool AddNetPollerSocket(NetPoller *poller, int socket);     // Add socket to poller
+int WaitNetPoller(NetPoller *poller, double timeout);       // Wait until a socket is readable, returns readable sockets count (0 on timeout)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_UDP_H
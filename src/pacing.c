@@ -0,0 +1,284 @@
+/**********************************************************************************************
+*
+*   pacing - Frame pacing controller for raylib game loops
+*
+*   NOTE: Check pacing.h for configuration and usage details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "pacing.h"
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan()
+
+#include <stddef.h>             // Required for: NULL
+
+#if defined(_WIN32)
+    // NOTE: Declaring Sleep() directly, including windows.h conflicts with raylib names
+    __declspec(dllimport) void __stdcall Sleep(unsigned long msTimeout);
+#else
+    #include <time.h>           // Required for: nanosleep()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PACING_VSYNC_WINDOW         120     // Frames measured before deciding vsync state
+#define PACING_VSYNC_MAX_MISSES       3     // Deadline misses in window that disable vsync
+#define PACING_WORK_RISE            0.5     // Work time estimate smoothing when work grows
+#define PACING_WORK_DECAY          0.05     // Work time estimate smoothing when work shrinks
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void SleepSeconds(double seconds);                   // Coarse OS sleep
+static void WaitForFrameSlot(FramePacer *pacer);            // Sleep + busy-wait until frame work must start
+static void UpdateFrameStats(FramePacer *pacer, double present); // Update statistics and schedule next deadline
+static void UpdateAdaptiveVsync(FramePacer *pacer, bool missed); // Enable/disable vsync depending on misses
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get default pacer configuration
+FramePacerConfig GetFramePacerConfigDefault(void)
+{
+    FramePacerConfig config = { 0 };
+
+    config.targetFPS = 60;
+    config.spinTail = 0.002;        // Most OS schedulers wake up within 1-2 ms of requested time
+#if defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    config.lateInput = true;
+#else
+    config.lateInput = false;       // Inputs are polled by EndDrawing(), late sampling not available
+#endif
+    config.adaptiveVsync = false;
+    config.logInterval = 300;       // Log every 5 seconds at 60 fps
+
+    return config;
+}
+
+// Initialize frame pacer
+// NOTE: raylib internal frame waiting is disabled, pacer takes care of it
+FramePacer InitFramePacer(FramePacerConfig config)
+{
+    FramePacer pacer = { 0 };
+
+    pacer.config = config;
+    pacer.stats.min = 1e9;
+
+    SetTargetFPS(0);
+    SetFramePacerTarget(&pacer, config.targetFPS);
+
+#if !defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    if (config.lateInput)
+    {
+        TraceLog(LOG_WARNING, "PACING: Late input sampling requires SUPPORT_CUSTOM_FRAME_CONTROL, inputs polled by EndDrawing()");
+        pacer.config.lateInput = false;
+    }
+#endif
+    TraceLog(LOG_INFO, "PACING: Frame pacer initialized (target: %i fps, spin tail: %.2f ms, late input: %s)",
+        config.targetFPS, config.spinTail*1000.0, pacer.config.lateInput? "on" : "off");
+
+    return pacer;
+}
+
+// Change pacer target frames per second
+// NOTE: A target of 0 means unlimited, no waiting between frames
+void SetFramePacerTarget(FramePacer *pacer, int targetFPS)
+{
+    double now = GetTime();
+
+    pacer->config.targetFPS = targetFPS;
+    pacer->frameTime = (targetFPS > 0)? 1.0/(double)targetFPS : 0.0;
+    pacer->nextDeadline = now + pacer->frameTime;
+    pacer->previousPresent = now;
+    pacer->inputTime = now;
+}
+
+// Wait for next frame slot and sample inputs
+void BeginFramePacing(FramePacer *pacer)
+{
+#if defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    // NOTE: After a skipped frame inputs have just been polled, polling again would lose key presses
+    if (pacer->config.lateInput && !pacer->skipped)
+    {
+        // Wait until there is just enough time left to update, draw and present before the deadline,
+        // inputs are sampled after waiting so they are as fresh as possible when frame is presented
+        if (!pacer->vsync) WaitForFrameSlot(pacer);
+
+        PollInputEvents();
+        pacer->inputTime = GetTime();
+    }
+#endif
+
+    pacer->skipped = false;
+    pacer->workStart = GetTime();
+}
+
+// Present frame, update timings and vsync state
+void EndFramePacing(FramePacer *pacer)
+{
+#if defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    BeginTraceSpan("SwapScreenBuffer", NULL);
+    SwapScreenBuffer();
+    EndTraceSpan();
+#endif
+
+    double present = GetTime();
+
+    // Update work time estimate: rise fast on heavier frames, decay slowly
+    double work = present - pacer->workStart;
+
+    if (work > pacer->workEstimate) pacer->workEstimate += (work - pacer->workEstimate)*PACING_WORK_RISE;
+    else pacer->workEstimate += (work - pacer->workEstimate)*PACING_WORK_DECAY;
+
+    if (pacer->workEstimate > pacer->frameTime) pacer->workEstimate = pacer->frameTime;
+
+    UpdateFrameStats(pacer, present);
+
+#if defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    if (!pacer->config.lateInput)
+    {
+        PollInputEvents();
+        pacer->inputTime = GetTime();
+
+        if (!pacer->vsync) WaitForFrameSlot(pacer);
+    }
+#else
+    // NOTE: Inputs have just been polled by EndDrawing(), right after buffers swap
+    pacer->inputTime = present;
+
+    if (!pacer->vsync) WaitForFrameSlot(pacer);
+#endif
+}
+
+// Frame not drawn, schedule next deadline from now
+// NOTE: Skipped frames waited for events for an undefined time, they are not measured
+// and do not count as deadline misses (vsync state is kept)
+void SkipFramePacing(FramePacer *pacer)
+{
+    double now = GetTime();
+
+    pacer->nextDeadline = now + pacer->frameTime;
+    pacer->previousPresent = now;
+    pacer->inputTime = now;
+    pacer->skipped = true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Coarse OS sleep
+static void SleepSeconds(double seconds)
+{
+    if (seconds <= 0.0) return;
+
+#if defined(_WIN32)
+    Sleep((unsigned long)(seconds*1000.0));
+#else
+    struct timespec req = { 0 };
+    req.tv_sec = (time_t)seconds;
+    req.tv_nsec = (long)((seconds - (double)req.tv_sec)*1e9);
+
+    while (nanosleep(&req, &req) == -1) continue;   // Resume sleep if interrupted by a signal
+#endif
+}
+
+// Sleep + busy-wait until frame work must start
+// NOTE: OS sleep granularity is coarse, last spinTail seconds are busy-waited for precision
+static void WaitForFrameSlot(FramePacer *pacer)
+{
+    if (pacer->frameTime <= 0.0) return;
+
+    double target = pacer->nextDeadline - pacer->workEstimate;
+    double remaining = target - GetTime();
+
+    BeginTraceSpan("WaitForFrameSlot", NULL);
+
+    if (remaining > pacer->config.spinTail) SleepSeconds(remaining - pacer->config.spinTail);
+
+    while (GetTime() < target) { }      // Busy-wait tail
+
+    EndTraceSpan();
+}
+
+// Update statistics and schedule next deadline
+static void UpdateFrameStats(FramePacer *pacer, double present)
+{
+    FramePacerStats *stats = &pacer->stats;
+
+    double frame = present - pacer->previousPresent;
+    bool missed = (pacer->frameTime > 0.0) && (present > (pacer->nextDeadline + pacer->frameTime*0.5));
+
+    pacer->previousPresent = present;
+
+    // Running mean and variance (Welford)
+    stats->frameCount++;
+    double delta = frame - stats->mean;
+    stats->mean += delta/stats->frameCount;
+    stats->m2 += delta*(frame - stats->mean);
+
+    if (frame < stats->min) stats->min = frame;
+    if (frame > stats->max) stats->max = frame;
+    if (missed) stats->missed++;
+
+    // Input-to-photon estimate: time from inputs sampling to frame presentation
+    // NOTE: Display scanout latency is not included, it depends on the monitor
+    stats->inputLatency += present - pacer->inputTime;
+
+    // Schedule next deadline, keeping the phase unless current deadline was missed,
+    // in that case resynchronize to avoid a burst of short catch-up frames
+    if (missed) pacer->nextDeadline = present + pacer->frameTime;
+    else pacer->nextDeadline += pacer->frameTime;
+
+    if (pacer->config.adaptiveVsync) UpdateAdaptiveVsync(pacer, missed);
+
+    if ((pacer->config.logInterval > 0) && (stats->frameCount >= pacer->config.logInterval))
+    {
+        double variance = (stats->frameCount > 1)? stats->m2/(stats->frameCount - 1) : 0.0;
+
+        TraceLog(LOG_INFO, "PACING: %i frames | mean: %.3f ms | variance: %.4f ms^2 | min: %.3f ms | max: %.3f ms | missed: %i | input-to-photon: %.3f ms",
+            stats->frameCount, stats->mean*1000.0, variance*1e6, stats->min*1000.0, stats->max*1000.0,
+            stats->missed, stats->inputLatency/stats->frameCount*1000.0);
+
+        *stats = (FramePacerStats){ 0 };
+        stats->min = 1e9;
+    }
+}
+
+// Enable/disable vsync depending on measured deadline misses
+// NOTE: Vsync is only enabled when monitor refresh rate matches target, missing a vsync deadline
+// halves the framerate, in that case it's better to disable it and let the pacer drive the timing
+static void UpdateAdaptiveVsync(FramePacer *pacer, bool missed)
+{
+    pacer->vsyncFrames++;
+    if (missed) pacer->vsyncMisses++;
+
+    if (pacer->vsync && (pacer->vsyncMisses >= PACING_VSYNC_MAX_MISSES))
+    {
+        ClearWindowState(FLAG_VSYNC_HINT);
+        pacer->vsync = false;
+        pacer->vsyncFrames = 0;
+        pacer->vsyncMisses = 0;
+
+        TraceLog(LOG_INFO, "PACING: Vsync disabled, too many missed deadlines");
+    }
+    else if (pacer->vsyncFrames >= PACING_VSYNC_WINDOW)
+    {
+        if (!pacer->vsync && (pacer->vsyncMisses == 0) &&
+            (GetMonitorRefreshRate(GetCurrentMonitor()) == pacer->config.targetFPS))
+        {
+            SetWindowState(FLAG_VSYNC_HINT);
+            pacer->vsync = true;
+
+            TraceLog(LOG_INFO, "PACING: Vsync enabled, frames consistently within budget");
+        }
+
+        pacer->vsyncFrames = 0;
+        pacer->vsyncMisses = 0;
+    }
+}
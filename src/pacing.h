@@ -0,0 +1,105 @@
+/**********************************************************************************************
+*
+*   pacing - Frame pacing controller for raylib game loops
+*
+*   Replaces SetTargetFPS() coarse sleeping with a deadline based frame scheduler:
+*     - Coarse OS sleep until a configurable tail before the frame deadline, busy-wait for the tail
+*     - Late input sampling: inputs are polled after the wait, right before update and draw
+*     - Adaptive vsync: vsync enabled while frames hit the deadline, disabled on repeated misses
+*     - Frame-time statistics (mean, standard deviation, min, max, misses) and input-to-photon
+*       estimates logged periodically with TraceLog()
+*
+*   CONFIGURATION:
+*       #define SUPPORT_CUSTOM_FRAME_CONTROL
+*           Must match raylib build config (src/config.h). In that mode EndDrawing() does not swap
+*           buffers, poll inputs or wait, the pacer does it; it is required for late input sampling.
+*           Without it, the pacer only replaces raylib frame waiting (inputs are polled by EndDrawing()),
+*           input latency is the same as with SetTargetFPS() and late input is disabled by default.
+*
+*           Stock raylib builds do not define it: the input latency reduction (kiosk builds) requires
+*           raylib and game core built with it, lessons/Makefile: BUILD_CUSTOM_FRAME_CONTROL=TRUE,
+*           VS2022 projects: msbuild blocks.sln /p:BuildCustomFrameControl=true
+*
+*   USAGE:
+*       FramePacer pacer = InitFramePacer(GetFramePacerConfigDefault());
+*
+*       while (!WindowShouldClose())
+*       {
+*           BeginFramePacing(&pacer);   // Wait for frame slot, sample inputs
+*           // Update and Draw (BeginDrawing()/EndDrawing())
+*           EndFramePacing(&pacer);     // Present frame, measure timings
+*       }
+*
+*       // Frames not drawn (idle screens, check redraw.h) must call SkipFramePacing() instead of
+*       // EndFramePacing(): nothing to present, inputs already polled while waiting for events
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef PACING_H
+#define PACING_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Frame pacer configuration
+typedef struct FramePacerConfig {
+    int targetFPS;              // Target frames per second
+    double spinTail;            // Time before frame deadline (seconds) spent busy-waiting instead of sleeping
+    bool lateInput;             // Sample inputs right before update/draw instead of right after present
+    bool adaptiveVsync;         // Toggle vsync depending on measured deadline misses
+    int logInterval;            // Frames between statistics logs (0 - disabled)
+} FramePacerConfig;
+
+// Frame timing statistics (accumulated over logInterval frames)
+typedef struct FramePacerStats {
+    int frameCount;             // Frames measured
+    double mean;                // Frame time mean (seconds)
+    double m2;                  // Frame time sum of squared differences from the mean
+    double min;                 // Frame time minimum (seconds)
+    double max;                 // Frame time maximum (seconds)
+    int missed;                 // Frames that missed their deadline
+    double inputLatency;        // Input-to-photon accumulated estimate (seconds)
+} FramePacerStats;
+
+// Frame pacer state
+typedef struct FramePacer {
+    FramePacerConfig config;    // Pacer configuration
+    double frameTime;           // Target frame time (seconds)
+    double nextDeadline;        // Time when next frame must be presented
+    double previousPresent;     // Time last frame was presented
+    double inputTime;           // Time inputs were sampled for current frame
+    double workEstimate;        // Smoothed estimate of update + draw + present time (seconds)
+    double workStart;           // Time current frame work started
+    bool vsync;                 // Vsync currently enabled
+    int vsyncFrames;            // Frames measured in current vsync decision window
+    int vsyncMisses;            // Deadline misses in current vsync decision window
+    bool skipped;               // Last frame skipped, inputs already polled
+    FramePacerStats stats;      // Current statistics window
+} FramePacer;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+FramePacerConfig GetFramePacerConfigDefault(void);  // Get default pacer configuration (60 fps, 2 ms spin tail, late input if available)
+FramePacer InitFramePacer(FramePacerConfig config); // Initialize frame pacer (call after InitWindow(), replaces SetTargetFPS())
+void SetFramePacerTarget(FramePacer *pacer, int targetFPS); // Change pacer target frames per second
+void BeginFramePacing(FramePacer *pacer);           // Wait for next frame slot and sample inputs (late input mode)
+void EndFramePacing(FramePacer *pacer);             // Present frame (custom frame control), update timings and vsync state
+void SkipFramePacing(FramePacer *pacer);            // Frame not drawn: nothing presented or measured, schedule next deadline from now
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PACING_H
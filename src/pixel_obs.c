@@ -0,0 +1,187 @@
+/**********************************************************************************************
+*
+*   pixel_obs - Low-resolution pixel observations rasterized on CPU from simulation state
+*
+*   NOTE: Check pixel_obs.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "pixel_obs.h"
+
+#include <string.h>             // Required for: memset()
+#include <stddef.h>             // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Rasterization target: pixels buffer and playfield to pixels scale
+typedef struct PixelTarget {
+    unsigned char *pixels;
+    int width;
+    int height;
+    float scaleX;               // Pixels per playfield unit
+    float scaleY;
+    const unsigned char *values;    // Value written per object class
+} PixelTarget;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const unsigned char grayscaleValues[PIXEL_OBS_CLASS_COUNT] = { 0, 96, 255, 160, 208 };
+static const unsigned char paletteValues[PIXEL_OBS_CLASS_COUNT] = {
+    PIXEL_OBS_BACKGROUND, PIXEL_OBS_BRICK, PIXEL_OBS_PLAYER, PIXEL_OBS_ENEMY, PIXEL_OBS_BALL
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static PixelTarget BeginPixelTarget(unsigned char *pixels, int width, int height, int screenWidth, int screenHeight, int format);  // Clear pixels, compute scale
+static void FillPixelsRec(PixelTarget *target, float x, float y, float width, float height, int objectClass);    // Fill playfield rectangle
+static void FillPixelsBall(PixelTarget *target, float centerX, float centerY, float radius, int objectClass);   // Fill playfield circle (ellipse in pixels)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Rasterize blocks playfield
+void RenderBlocksPixels(const BlocksGame *game, unsigned char *pixels, int width, int height, int format)
+{
+    PixelTarget target = BeginPixelTarget(pixels, width, height, game->screenWidth, game->screenHeight, format);
+
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++)
+        {
+            const Brick *brick = &game->bricks[j][i];
+
+            if (brick->active) FillPixelsRec(&target, brick->position.x, brick->position.y, brick->size.x, brick->size.y, PIXEL_OBS_BRICK);
+        }
+    }
+
+    FillPixelsRec(&target, game->player.position.x, game->player.position.y, game->player.size.x, game->player.size.y, PIXEL_OBS_PLAYER);
+    FillPixelsBall(&target, game->ball.position.x, game->ball.position.y, game->ball.radius, PIXEL_OBS_BALL);
+}
+
+// Rasterize pong playfield
+void RenderPongPixels(const PongGame *game, unsigned char *pixels, int width, int height, int format)
+{
+    PixelTarget target = BeginPixelTarget(pixels, width, height, game->screenWidth, game->screenHeight, format);
+
+    FillPixelsRec(&target, game->player.x, game->player.y, game->player.width, game->player.height, PIXEL_OBS_PLAYER);
+    FillPixelsRec(&target, game->enemy.x, game->enemy.y, game->enemy.width, game->enemy.height, PIXEL_OBS_ENEMY);
+    FillPixelsBall(&target, game->ballPosition.x, game->ballPosition.y, game->ballRadius, PIXEL_OBS_BALL);
+}
+
+// Rasterize all environments
+// NOTE: Pong matches are read from batch arrays, shared fields (paddles size) included
+void RenderGymEnvPixels(const GymEnv *env, unsigned char *pixels, int width, int height, int format)
+{
+    size_t size = (size_t)width*height;
+
+    for (int i = 0; i < env->count; i++)
+    {
+        if (env->type == GYM_ENV_PONG)
+        {
+            PongGame game = { 0 };
+            GetPongBatchMatch(&env->pong, i, &game);
+
+            RenderPongPixels(&game, pixels + i*size, width, height, format);
+        }
+        else RenderBlocksPixels(&env->blocks[i], pixels + i*size, width, height, format);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Clear pixels, compute scale
+static PixelTarget BeginPixelTarget(unsigned char *pixels, int width, int height, int screenWidth, int screenHeight, int format)
+{
+    PixelTarget target = { 0 };
+
+    target.pixels = pixels;
+    target.width = width;
+    target.height = height;
+    target.scaleX = (float)width/screenWidth;
+    target.scaleY = (float)height/screenHeight;
+    target.values = (format == PIXEL_OBS_PALETTE)? paletteValues : grayscaleValues;
+
+    memset(pixels, target.values[PIXEL_OBS_BACKGROUND], (size_t)width*height);
+
+    return target;
+}
+
+// Fill playfield rectangle
+// NOTE: Edges are truncated to pixels, rectangles thinner than one pixel cover one pixel
+static void FillPixelsRec(PixelTarget *target, float x, float y, float width, float height, int objectClass)
+{
+    int x0 = (int)(x*target->scaleX);
+    int y0 = (int)(y*target->scaleY);
+    int x1 = (int)((x + width)*target->scaleX);
+    int y1 = (int)((y + height)*target->scaleY);
+
+    if (x1 <= x0) x1 = x0 + 1;
+    if (y1 <= y0) y1 = y0 + 1;
+
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > target->width) x1 = target->width;
+    if (y1 > target->height) y1 = target->height;
+    if ((x0 >= x1) || (y0 >= y1)) return;
+
+    unsigned char value = target->values[objectClass];
+
+    for (int py = y0; py < y1; py++) memset(target->pixels + (size_t)py*target->width + x0, value, x1 - x0);
+}
+
+// Fill playfield circle (ellipse in pixels)
+// NOTE: Pixel centers inside ellipse are filled, pixel containing center is always filled
+static void FillPixelsBall(PixelTarget *target, float centerX, float centerY, float radius, int objectClass)
+{
+    float cx = centerX*target->scaleX;
+    float cy = centerY*target->scaleY;
+    float rx = radius*target->scaleX;
+    float ry = radius*target->scaleY;
+
+    int x0 = (int)(cx - rx);
+    int y0 = (int)(cy - ry);
+    int x1 = (int)(cx + rx) + 1;
+    int y1 = (int)(cy + ry) + 1;
+
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > target->width) x1 = target->width;
+    if (y1 > target->height) y1 = target->height;
+
+    unsigned char value = target->values[objectClass];
+    float invRx2 = 1.0f/(rx*rx);
+    float invRy2 = 1.0f/(ry*ry);
+
+    for (int py = y0; py < y1; py++)
+    {
+        float dy = (py + 0.5f) - cy;
+        float rowY = dy*dy*invRy2;
+        unsigned char *row = target->pixels + (size_t)py*target->width;
+
+        for (int px = x0; px < x1; px++)
+        {
+            float dx = (px + 0.5f) - cx;
+
+            if ((dx*dx*invRx2 + rowY) <= 1.0f) row[px] = value;
+        }
+    }
+
+    int centerPx = (int)cx;
+    int centerPy = (int)cy;
+
+    if ((centerPx >= 0) && (centerPx < target->width) && (centerPy >= 0) && (centerPy < target->height))
+    {
+        target->pixels[(size_t)centerPy*target->width + centerPx] = value;
+    }
+}
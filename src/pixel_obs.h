@@ -0,0 +1,70 @@
+/**********************************************************************************************
+*
+*   pixel_obs - Low-resolution pixel observations rasterized on CPU from simulation state
+*
+*   Games playfields (blocks: paddle, ball, bricks; pong: paddles, ball) are rasterized
+*   straight from simulation state into small 8bit buffers (i.e. 84x84), one byte per pixel:
+*     - PIXEL_OBS_GRAYSCALE: objects intensity (background black, player white...)
+*     - PIXEL_OBS_PALETTE: object class index (PixelObsClass), for one-hot/embedding inputs
+*
+*   No window, GPU, BeginDrawing() or softrender involved: background is cleared with memset(),
+*   rectangles are filled by rows, ball is an ellipse (playfield aspect is not preserved),
+*   every object is at least one pixel big. Whole batches of environments (gym_env) are
+*   rendered into caller memory, environment i at pixels + i*width*height.
+*
+*   USAGE:
+*       unsigned char *pixels = (unsigned char *)malloc(env.count*84*84);
+*
+*       StepGymEnv(&env, actions);
+*       RenderGymEnvPixels(&env, pixels, 84, 84, PIXEL_OBS_GRAYSCALE);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef PIXEL_OBS_H
+#define PIXEL_OBS_H
+
+#include "raylib.h"
+#include "blocks_sim.h"         // Required for: BlocksGame
+#include "pong_sim.h"           // Required for: PongGame
+#include "gym_env.h"            // Required for: GymEnv
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Pixels format
+typedef enum {
+    PIXEL_OBS_GRAYSCALE = 0,    // Object intensity per pixel
+    PIXEL_OBS_PALETTE           // Object class index per pixel (PixelObsClass)
+} PixelObsFormat;
+
+// Object classes, palette indices
+typedef enum {
+    PIXEL_OBS_BACKGROUND = 0,
+    PIXEL_OBS_BRICK,
+    PIXEL_OBS_PLAYER,
+    PIXEL_OBS_ENEMY,
+    PIXEL_OBS_BALL,
+    PIXEL_OBS_CLASS_COUNT
+} PixelObsClass;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void RenderBlocksPixels(const BlocksGame *game, unsigned char *pixels, int width, int height, int format);  // Rasterize blocks playfield (width*height bytes)
+void RenderPongPixels(const PongGame *game, unsigned char *pixels, int width, int height, int format);      // Rasterize pong playfield (width*height bytes)
+void RenderGymEnvPixels(const GymEnv *env, unsigned char *pixels, int width, int height, int format);      // Rasterize all environments (count*width*height bytes)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PIXEL_OBS_H
@@ -0,0 +1,265 @@
+/**********************************************************************************************
+*
+*   pong_batch - Batch PONG simulation: thousands of independent matches stepped at once
+*
+*   NOTE: Check pong_batch.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "pong_batch.h"
+
+#include "simd_lanes.h"         // Required for: LaneFloat, LaneInt, LoadFloat(), AddFloat()...
+
+#include <stdlib.h>             // Required for: malloc(), free()
+#include <stddef.h>             // Required for: NULL, size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PONG_BATCH_BACKEND      SIMD_LANES_BACKEND
+#define PONG_BATCH_LANES        SIMD_LANES
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static inline LaneInt CheckCollisionBallRecLanes(LaneFloat ballX, LaneFloat ballY, LaneFloat radius,
+    LaneFloat recCenterX, LaneFloat recCenterY, LaneFloat halfWidth, LaneFloat halfHeight);    // Check collision between balls and rectangles (CheckCollisionBallRec())
+static inline LaneInt CheckInputLanes(LaneInt inputs, int flag);       // Get input flag mask
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Load batch, all matches initialized as InitPongGame()
+PongBatch LoadPongBatch(int count, int screenWidth, int screenHeight)
+{
+    PongBatch batch = { 0 };
+
+    PongGame game = { 0 };
+    InitPongGame(&game, screenWidth, screenHeight);
+
+    batch.count = count;
+    batch.capacity = (count + PONG_BATCH_LANES - 1)/PONG_BATCH_LANES*PONG_BATCH_LANES;
+
+    batch.screenWidth = game.screenWidth;
+    batch.screenHeight = game.screenHeight;
+    batch.ballRadius = game.ballRadius;
+    batch.player = game.player;
+    batch.playerSpeed = game.playerSpeed;
+    batch.enemy = game.enemy;
+    batch.enemySpeed = game.enemySpeed;
+
+    // NOTE: Padding matches (up to capacity) are stepped with the others, results are ignored
+    size_t size = (size_t)batch.capacity*sizeof(float);     // NOTE: sizeof(float) == sizeof(int)
+
+    batch.ballX = (float *)RL_MALLOC(size);
+    batch.ballY = (float *)RL_MALLOC(size);
+    batch.ballSpeedX = (int *)RL_MALLOC(size);
+    batch.ballSpeedY = (int *)RL_MALLOC(size);
+    batch.playerY = (float *)RL_MALLOC(size);
+    batch.playerScore = (int *)RL_MALLOC(size);
+    batch.enemyY = (float *)RL_MALLOC(size);
+    batch.enemyVisionRange = (int *)RL_MALLOC(size);
+    batch.enemyScore = (int *)RL_MALLOC(size);
+    batch.events = (int *)RL_MALLOC(size);
+
+    for (int i = 0; i < batch.capacity; i++)
+    {
+        SetPongBatchMatch(&batch, i, &game);
+        batch.events[i] = 0;
+    }
+
+    return batch;
+}
+
+// Unload batch arrays
+void UnloadPongBatch(PongBatch batch)
+{
+    RL_FREE(batch.ballX);
+    RL_FREE(batch.ballY);
+    RL_FREE(batch.ballSpeedX);
+    RL_FREE(batch.ballSpeedY);
+    RL_FREE(batch.playerY);
+    RL_FREE(batch.playerScore);
+    RL_FREE(batch.enemyY);
+    RL_FREE(batch.enemyVisionRange);
+    RL_FREE(batch.enemyScore);
+    RL_FREE(batch.events);
+}
+
+// Set match state from scalar game
+void SetPongBatchMatch(PongBatch *batch, int index, const PongGame *game)
+{
+    batch->ballX[index] = game->ballPosition.x;
+    batch->ballY[index] = game->ballPosition.y;
+    batch->ballSpeedX[index] = game->ballSpeedX;
+    batch->ballSpeedY[index] = game->ballSpeedY;
+    batch->playerY[index] = game->player.y;
+    batch->playerScore[index] = game->playerScore;
+    batch->enemyY[index] = game->enemy.y;
+    batch->enemyVisionRange[index] = game->enemyVisionRange;
+    batch->enemyScore[index] = game->enemyScore;
+}
+
+// Get match state as scalar game
+void GetPongBatchMatch(const PongBatch *batch, int index, PongGame *game)
+{
+    game->screenWidth = batch->screenWidth;
+    game->screenHeight = batch->screenHeight;
+
+    game->ballPosition = (Vector2){ batch->ballX[index], batch->ballY[index] };
+    game->ballRadius = batch->ballRadius;
+    game->ballSpeedX = batch->ballSpeedX[index];
+    game->ballSpeedY = batch->ballSpeedY[index];
+
+    game->player = batch->player;
+    game->player.y = batch->playerY[index];
+    game->playerSpeed = batch->playerSpeed;
+    game->playerScore = batch->playerScore[index];
+
+    game->enemy = batch->enemy;
+    game->enemy.y = batch->enemyY[index];
+    game->enemySpeed = batch->enemySpeed;
+    game->enemyVisionRange = batch->enemyVisionRange[index];
+    game->enemyScore = batch->enemyScore[index];
+}
+
+// Update one simulation step of all matches
+// NOTE: Same steps order as UpdatePongGame(), every branch is computed for all lanes
+// and applied with masks, one iteration steps PONG_BATCH_LANES matches
+void UpdatePongBatch(PongBatch *batch, const int *inputs)
+{
+    const LaneFloat zero = SetFloat(0.0f);
+    const LaneFloat width = SetFloat((float)batch->screenWidth);
+    const LaneFloat height = SetFloat((float)batch->screenHeight);
+    const LaneFloat radius = SetFloat(batch->ballRadius);
+
+    const LaneFloat playerSpeed = SetFloat(batch->playerSpeed);
+    const LaneFloat playerHeight = SetFloat(batch->player.height);
+    const LaneFloat playerBottomLimit = SetFloat((float)batch->screenHeight - batch->player.height);
+    const LaneFloat playerCenterX = SetFloat((float)(int)(batch->player.x + batch->player.width/2.0f));
+    const LaneFloat playerHalfWidth = SetFloat(batch->player.width/2.0f);
+    const LaneFloat playerHalfHeight = SetFloat(batch->player.height/2.0f);
+
+    const LaneFloat enemySpeed = SetFloat(batch->enemySpeed);
+    const LaneFloat enemyCenterX = SetFloat((float)(int)(batch->enemy.x + batch->enemy.width/2.0f));
+    const LaneFloat enemyHalfWidth = SetFloat(batch->enemy.width/2.0f);
+    const LaneFloat enemyHalfHeight = SetFloat(batch->enemy.height/2.0f);
+
+    const LaneInt noInputs = SetInt(0);
+
+    for (int i = 0; i < batch->capacity; i += PONG_BATCH_LANES)
+    {
+        LaneInt input = (inputs != NULL)? LoadInt(inputs + i) : noInputs;
+        LaneInt events = SetInt(0);
+
+        // Ball movement logic
+        LaneInt speedX = LoadInt(batch->ballSpeedX + i);
+        LaneInt speedY = LoadInt(batch->ballSpeedY + i);
+        LaneFloat ballX = AddFloat(LoadFloat(batch->ballX + i), IntToFloat(speedX));
+        LaneFloat ballY = AddFloat(LoadFloat(batch->ballY + i), IntToFloat(speedY));
+
+        LaneInt bounceX = OrMask(GreaterFloat(AddFloat(ballX, radius), width), LessFloat(SubFloat(ballX, radius), zero));
+        LaneInt bounceY = OrMask(GreaterFloat(AddFloat(ballY, radius), height), LessFloat(SubFloat(ballY, radius), zero));
+        speedX = SelectInt(bounceX, SubInt(SetInt(0), speedX), speedX);
+        speedY = SelectInt(bounceY, SubInt(SetInt(0), speedY), speedY);
+        events = OrMask(events, AndMask(OrMask(bounceX, bounceY), SetInt(PONG_EVENT_BOUNCE)));
+
+        LaneInt enemyScored = LessEqualFloat(SubFloat(ballX, radius), zero);
+        LaneInt playerScored = AndNotMask(enemyScored, GreaterFloat(AddFloat(ballX, radius), width));
+        StoreInt(batch->enemyScore + i, AddInt(LoadInt(batch->enemyScore + i), AndMask(enemyScored, SetInt(1000))));
+        StoreInt(batch->playerScore + i, AddInt(LoadInt(batch->playerScore + i), AndMask(playerScored, SetInt(1000))));
+        events = OrMask(events, AndMask(enemyScored, SetInt(PONG_EVENT_ENEMY_SCORE)));
+        events = OrMask(events, AndMask(playerScored, SetInt(PONG_EVENT_PLAYER_SCORE)));
+
+        // Player movement logic
+        LaneInt up = CheckInputLanes(input, PONG_INPUT_UP);
+        LaneInt down = AndNotMask(up, CheckInputLanes(input, PONG_INPUT_DOWN));
+        LaneFloat playerY = LoadFloat(batch->playerY + i);
+        playerY = SelectFloat(up, SubFloat(playerY, playerSpeed), SelectFloat(down, AddFloat(playerY, playerSpeed), playerY));
+
+        LaneInt atTop = LessEqualFloat(playerY, zero);
+        LaneInt atBottom = AndNotMask(atTop, GreaterEqualFloat(AddFloat(playerY, playerHeight), height));
+        playerY = SelectFloat(atTop, zero, SelectFloat(atBottom, playerBottomLimit, playerY));
+        StoreFloat(batch->playerY + i, playerY);
+
+        LaneFloat playerCenterY = IntToFloat(FloatToInt(AddFloat(playerY, playerHalfHeight)));
+        LaneInt playerHit = CheckCollisionBallRecLanes(ballX, ballY, radius, playerCenterX, playerCenterY, playerHalfWidth, playerHalfHeight);
+        speedX = SelectInt(playerHit, SubInt(SetInt(0), speedX), speedX);
+        events = OrMask(events, AndMask(playerHit, SetInt(PONG_EVENT_BOUNCE | PONG_EVENT_PLAYER_HIT)));
+
+        // Enemy movement logic
+        LaneInt visionRange = LoadInt(batch->enemyVisionRange + i);
+        LaneFloat enemyY = LoadFloat(batch->enemyY + i);
+        LaneInt controlled = CheckInputLanes(input, PONG_INPUT_ENEMY_CONTROLLED);
+        LaneInt chasing = AndNotMask(controlled, GreaterFloat(ballX, IntToFloat(visionRange)));
+        LaneFloat enemyChaseCenter = AddFloat(enemyY, enemyHalfHeight);
+        LaneInt controlledDown = AndMask(controlled, AndNotMask(CheckInputLanes(input, PONG_INPUT_ENEMY_UP), CheckInputLanes(input, PONG_INPUT_ENEMY_DOWN)));
+        LaneInt controlledUp = AndMask(controlled, CheckInputLanes(input, PONG_INPUT_ENEMY_UP));
+        LaneInt moveDown = OrMask(controlledDown, AndMask(chasing, GreaterFloat(ballY, enemyChaseCenter)));
+        LaneInt moveUp = AndNotMask(moveDown, OrMask(controlledUp, AndMask(chasing, LessFloat(ballY, enemyChaseCenter))));
+        enemyY = SelectFloat(moveDown, AddFloat(enemyY, enemySpeed), SelectFloat(moveUp, SubFloat(enemyY, enemySpeed), enemyY));
+        StoreFloat(batch->enemyY + i, enemyY);
+
+        LaneFloat enemyCenterY = IntToFloat(FloatToInt(AddFloat(enemyY, enemyHalfHeight)));
+        LaneInt enemyHit = CheckCollisionBallRecLanes(ballX, ballY, radius, enemyCenterX, enemyCenterY, enemyHalfWidth, enemyHalfHeight);
+        speedX = SelectInt(enemyHit, SubInt(SetInt(0), speedX), speedX);
+        events = OrMask(events, AndMask(enemyHit, SetInt(PONG_EVENT_BOUNCE | PONG_EVENT_ENEMY_HIT)));
+
+        LaneInt visionIncrease = CheckInputLanes(input, PONG_INPUT_VISION_INCREASE);
+        LaneInt visionDecrease = AndNotMask(visionIncrease, CheckInputLanes(input, PONG_INPUT_VISION_DECREASE));
+        visionRange = SubInt(AddInt(visionRange, AndMask(visionIncrease, SetInt(1))), AndMask(visionDecrease, SetInt(1)));
+        StoreInt(batch->enemyVisionRange + i, visionRange);
+
+        StoreFloat(batch->ballX + i, ballX);
+        StoreFloat(batch->ballY + i, ballY);
+        StoreInt(batch->ballSpeedX + i, speedX);
+        StoreInt(batch->ballSpeedY + i, speedY);
+        StoreInt(batch->events + i, events);
+    }
+}
+
+// Get SIMD backend name
+const char *GetPongBatchBackend(void)
+{
+    return PONG_BATCH_BACKEND;
+}
+
+// Get matches stepped per SIMD instruction
+int GetPongBatchLanes(void)
+{
+    return PONG_BATCH_LANES;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Check collision between balls and rectangles
+// NOTE: Same operations as CheckCollisionBallRec(), rectangles centers are already truncated to int,
+// early returns are replaced by masks
+static inline LaneInt CheckCollisionBallRecLanes(LaneFloat ballX, LaneFloat ballY, LaneFloat radius,
+    LaneFloat recCenterX, LaneFloat recCenterY, LaneFloat halfWidth, LaneFloat halfHeight)
+{
+    LaneFloat dx = AbsFloat(SubFloat(ballX, recCenterX));
+    LaneFloat dy = AbsFloat(SubFloat(ballY, recCenterY));
+
+    LaneInt outside = OrMask(GreaterFloat(dx, AddFloat(halfWidth, radius)), GreaterFloat(dy, AddFloat(halfHeight, radius)));
+    LaneInt inside = OrMask(LessEqualFloat(dx, halfWidth), LessEqualFloat(dy, halfHeight));
+
+    LaneFloat cornerX = SubFloat(dx, halfWidth);
+    LaneFloat cornerY = SubFloat(dy, halfHeight);
+    LaneInt corner = LessEqualFloat(AddFloat(MulFloat(cornerX, cornerX), MulFloat(cornerY, cornerY)), MulFloat(radius, radius));
+
+    return AndNotMask(outside, OrMask(inside, corner));
+}
+
+// Get input flag mask
+static inline LaneInt CheckInputLanes(LaneInt inputs, int flag)
+{
+    return EqualInt(AndMask(inputs, SetInt(flag)), SetInt(flag));
+}
@@ -0,0 +1,106 @@
+/**********************************************************************************************
+*
+*   pong_batch - Batch PONG simulation: thousands of independent matches stepped at once
+*
+*   Same gameplay logic as pong_sim (UpdatePongGame()) for N matches stored as structure of
+*   arrays (one array per field), stepped in SIMD lanes: every branch of the scalar logic is
+*   evaluated for all lanes and results are selected with comparison masks. Intended for AI
+*   training and balance testing, no window, audio or drawing required.
+*
+*   Results match scalar simulation bit-for-bit: same float operations in same order, no
+*   fused multiply-add, same float to int truncation. Check tools/pong_batch_bench.c
+*
+*   SIMD instruction set is selected at compile time (simd_lanes.h):
+*     - AVX2 (8 lanes): x86-64 built with -mavx2 (Makefile: BUILD_SIMD=AVX2), MSVC /arch:AVX2
+*     - NEON (4 lanes): AArch64, always available
+*     - Scalar (1 lane): any other platform, same code path
+*
+*   NOTE: Playfield size, ball radius, paddles size and speeds are shared by all matches
+*   (set by InitPongGame()), every match has its own ball, paddles positions, scores and
+*   enemy vision range. Collision tests are not counted (PongGame collisionTests)
+*
+*   USAGE:
+*       PongBatch batch = LoadPongBatch(4096, 800, 600);
+*
+*       int inputs[4096] = { 0 };        // PongBatchInput flags, one per match
+*       UpdatePongBatch(&batch, inputs);
+*       if (batch.events[i] & PONG_EVENT_PLAYER_SCORE) ...
+*
+*       UnloadPongBatch(batch);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef PONG_BATCH_H
+#define PONG_BATCH_H
+
+#include "raylib.h"
+#include "pong_sim.h"           // Required for: PongGame, PongEvent
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Pong batch inputs, flags per match
+typedef enum {
+    PONG_INPUT_UP               = 0x01, // Move player up
+    PONG_INPUT_DOWN             = 0x02, // Move player down
+    PONG_INPUT_VISION_INCREASE  = 0x04, // Move enemy vision range right
+    PONG_INPUT_VISION_DECREASE  = 0x08, // Move enemy vision range left
+    PONG_INPUT_ENEMY_CONTROLLED = 0x10, // Enemy moved by ENEMY_UP/ENEMY_DOWN instead of chasing the ball
+    PONG_INPUT_ENEMY_UP         = 0x20, // Move controlled enemy up
+    PONG_INPUT_ENEMY_DOWN       = 0x40  // Move controlled enemy down (ignored if ENEMY_UP set)
+} PongBatchInput;
+
+// Pong batch, matches state as structure of arrays
+typedef struct PongBatch {
+    int count;                  // Matches in batch
+    int capacity;               // Matches allocated (count rounded up to SIMD lanes)
+
+    // Shared by all matches
+    int screenWidth;            // Playfield width
+    int screenHeight;           // Playfield height
+    float ballRadius;
+    Rectangle player;           // Player paddle (x, width, height), y per match
+    float playerSpeed;
+    Rectangle enemy;            // Enemy paddle (x, width, height), y per match
+    float enemySpeed;
+
+    // Per match
+    float *ballX;
+    float *ballY;
+    int *ballSpeedX;
+    int *ballSpeedY;
+    float *playerY;
+    int *playerScore;
+    float *enemyY;
+    int *enemyVisionRange;
+    int *enemyScore;
+    int *events;                // Last step PongEvent flags
+} PongBatch;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+PongBatch LoadPongBatch(int count, int screenWidth, int screenHeight);  // Load batch, all matches initialized as InitPongGame()
+void UnloadPongBatch(PongBatch batch);                                  // Unload batch arrays
+
+void SetPongBatchMatch(PongBatch *batch, int index, const PongGame *game);  // Set match state from scalar game (shared fields are not changed)
+void GetPongBatchMatch(const PongBatch *batch, int index, PongGame *game);  // Get match state as scalar game
+void UpdatePongBatch(PongBatch *batch, const int *inputs);                  // Update one simulation step of all matches (inputs can be NULL)
+
+const char *GetPongBatchBackend(void);  // Get SIMD backend name: "AVX2", "NEON" or "scalar"
+int GetPongBatchLanes(void);            // Get matches stepped per SIMD instruction
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PONG_BATCH_H
@@ -0,0 +1,178 @@
+/**********************************************************************************************
+*
+*   pong_net - PONG network protocol: datagram messages between match server and clients
+*
+*   NOTE: Check pong_net.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "pong_net.h"
+
+#include <string.h>             // Required for: memcpy(), memset()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Message bytes cursor
+typedef struct NetCursor {
+    unsigned char *data;        // Write cursor (NULL when reading)
+    const unsigned char *read;  // Read cursor
+    int offset;                 // Bytes written/read
+    int size;                   // Bytes available to read
+} NetCursor;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void WriteBytes(NetCursor *cursor, unsigned int value, int bytes);   // Write little-endian value
+static unsigned int ReadBytes(NetCursor *cursor, int bytes);                // Read little-endian value (0 past the end)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Write message to buffer
+int WritePongNetMessage(const PongNetMessage *message, unsigned char *buffer)
+{
+    NetCursor cursor = { buffer, NULL, 0, 0 };
+
+    WriteBytes(&cursor, PONG_NET_PROTOCOL, 1);
+    WriteBytes(&cursor, message->type, 1);
+
+    switch (message->type)
+    {
+        case PONG_NET_JOIN:
+        {
+            WriteBytes(&cursor, message->token, 4);
+            WriteBytes(&cursor, message->players, 1);
+        } break;
+        case PONG_NET_JOINED:
+        {
+            WriteBytes(&cursor, message->token, 4);
+            WriteBytes(&cursor, (unsigned int)message->match, 4);
+            WriteBytes(&cursor, message->side, 1);
+        } break;
+        case PONG_NET_INPUT:
+        {
+            WriteBytes(&cursor, (unsigned int)message->match, 4);
+            WriteBytes(&cursor, message->side, 1);
+            WriteBytes(&cursor, message->sequence, 4);
+            WriteBytes(&cursor, message->buttons, 1);
+            WriteBytes(&cursor, message->ack, 4);
+        } break;
+        case PONG_NET_LEAVE:
+        {
+            WriteBytes(&cursor, (unsigned int)message->match, 4);
+            WriteBytes(&cursor, message->side, 1);
+        } break;
+        case PONG_NET_STATE:
+        {
+            WriteBytes(&cursor, message->token, 4);
+            memcpy(buffer + cursor.offset, message->payload, message->payloadSize);
+            cursor.offset += message->payloadSize;
+        } break;
+        default: break;
+    }
+
+    return cursor.offset;
+}
+
+// Read message from datagram
+bool ReadPongNetMessage(const unsigned char *data, int size, PongNetMessage *message)
+{
+    static const int messageSizes[] = { 0, 7, 11, 16, 7, 6 };     // Sizes by type, header included
+
+    memset(message, 0, sizeof(PongNetMessage));
+
+    if ((size < 2) || (data[0] != PONG_NET_PROTOCOL) || (data[1] < PONG_NET_JOIN) ||
+        (data[1] > PONG_NET_STATE) || (size < messageSizes[data[1]])) return false;
+
+    NetCursor cursor = { NULL, data, 2, size };
+
+    message->type = data[1];
+
+    switch (message->type)
+    {
+        case PONG_NET_JOIN:
+        {
+            message->token = ReadBytes(&cursor, 4);
+            message->players = (int)ReadBytes(&cursor, 1);
+        } break;
+        case PONG_NET_JOINED:
+        {
+            message->token = ReadBytes(&cursor, 4);
+            message->match = (int)ReadBytes(&cursor, 4);
+            message->side = (int)ReadBytes(&cursor, 1);
+        } break;
+        case PONG_NET_INPUT:
+        {
+            message->match = (int)ReadBytes(&cursor, 4);
+            message->side = (int)ReadBytes(&cursor, 1);
+            message->sequence = ReadBytes(&cursor, 4);
+            message->buttons = ReadBytes(&cursor, 1);
+            message->ack = ReadBytes(&cursor, 4);
+        } break;
+        case PONG_NET_LEAVE:
+        {
+            message->match = (int)ReadBytes(&cursor, 4);
+            message->side = (int)ReadBytes(&cursor, 1);
+        } break;
+        case PONG_NET_STATE:
+        {
+            message->token = ReadBytes(&cursor, 4);
+            message->payloadSize = size - cursor.offset;
+            if (message->payloadSize > PONG_NET_MAX_PAYLOAD) return false;
+            memcpy(message->payload, data + cursor.offset, message->payloadSize);
+        } break;
+        default: break;
+    }
+
+    return true;
+}
+
+// Get match state snapshot
+PongSnapshot GetPongSnapshot(const PongGame *game, unsigned int tick)
+{
+    PongSnapshot snapshot = { 0 };
+
+    snapshot.tick = tick;
+    snapshot.ballX = game->ballPosition.x;
+    snapshot.ballY = game->ballPosition.y;
+    snapshot.ballSpeedX = game->ballSpeedX;
+    snapshot.ballSpeedY = game->ballSpeedY;
+    snapshot.playerY = game->player.y;
+    snapshot.enemyY = game->enemy.y;
+    snapshot.playerScore = game->playerScore;
+    snapshot.enemyScore = game->enemyScore;
+
+    return snapshot;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Write little-endian value
+static void WriteBytes(NetCursor *cursor, unsigned int value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) cursor->data[cursor->offset++] = (unsigned char)(value >> (8*i));
+}
+
+// Read little-endian value
+static unsigned int ReadBytes(NetCursor *cursor, int bytes)
+{
+    unsigned int value = 0;
+
+    for (int i = 0; i < bytes; i++)
+    {
+        if (cursor->offset < cursor->size) value |= (unsigned int)cursor->read[cursor->offset] << (8*i);
+        cursor->offset++;
+    }
+
+    return value;
+}
@@ -0,0 +1,108 @@
+/**********************************************************************************************
+*
+*   pong_net - PONG network protocol: datagram messages between match server and clients
+*
+*   Clients join a match, send their paddle buttons and receive the match state on every
+*   server tick. Every message is one datagram, fields are written byte by byte (little-endian),
+*   no struct layout or compiler dependency:
+*
+*       u8 protocol                     PONG_NET_PROTOCOL, other datagrams are ignored
+*       u8 type                         PongNetMessageType
+*
+*       JOIN:   u32 token, u8 players   Client token (echoed by server), players required (1: vs server enemy, 2: vs client)
+*       JOINED: u32 token, i32 match, u8 side       Match slot (-1: server full) and paddle side
+*       INPUT:  i32 match, u8 side, u32 sequence, u8 buttons, u32 ack    PONG_NET_BUTTON_* down, last state tick received
+*       LEAVE:  i32 match, u8 side
+*       STATE:  u32 token, u8 payload[]     Sent to every match client after every tick
+*
+*   STATE payload is an encoded snapshot (snapshot_codec): delta against the last state tick
+*   acknowledged by the client, a few bytes per tick
+*
+*   NOTE: Datagrams can be lost, duplicated or reordered: inputs carry the client sequence
+*   (older ones are ignored), states carry the server tick (older ones are ignored by clients)
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef PONG_NET_H
+#define PONG_NET_H
+
+#include "raylib.h"
+#include "pong_sim.h"           // Required for: PongGame
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PONG_NET_PROTOCOL       0x50    // 'P'
+#define PONG_NET_PORT           7777    // Default server port
+#define PONG_NET_MAX_PAYLOAD    64      // Maximum STATE payload size (bytes)
+#define PONG_NET_MAX_PACKET     80      // Maximum datagram size (bytes)
+
+#define PONG_NET_BUTTON_UP      0x01
+#define PONG_NET_BUTTON_DOWN    0x02
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Message types
+typedef enum {
+    PONG_NET_JOIN = 1,          // Client -> server: join a match
+    PONG_NET_JOINED,            // Server -> client: match slot and side
+    PONG_NET_INPUT,             // Client -> server: paddle buttons
+    PONG_NET_LEAVE,             // Client -> server: leave match
+    PONG_NET_STATE              // Server -> client: match state after tick
+} PongNetMessageType;
+
+// Paddle sides
+typedef enum {
+    PONG_SIDE_PLAYER = 0,       // Left paddle (PongGame player)
+    PONG_SIDE_ENEMY             // Right paddle (PongGame enemy)
+} PongSide;
+
+// Match state sent to clients (encoded by snapshot_codec)
+typedef struct PongSnapshot {
+    unsigned int tick;          // Server ticks run by match
+    float ballX;
+    float ballY;
+    int ballSpeedX;
+    int ballSpeedY;
+    float playerY;
+    float enemyY;
+    int playerScore;
+    int enemyScore;
+} PongSnapshot;
+
+// Network message, fields used depend on type
+typedef struct PongNetMessage {
+    int type;                   // Message type (PongNetMessageType)
+    unsigned int token;         // Client token (JOIN, JOINED, STATE)
+    int match;                  // Match slot (JOINED, INPUT, LEAVE)
+    int side;                   // Paddle side (JOINED, INPUT, LEAVE)
+    int players;                // Players required (JOIN)
+    unsigned int sequence;      // Input sequence (INPUT)
+    unsigned int buttons;       // Buttons down (INPUT)
+    unsigned int ack;           // Last state tick received, 0 if none (INPUT)
+    unsigned char payload[PONG_NET_MAX_PAYLOAD];    // Encoded snapshot (STATE)
+    int payloadSize;            // Encoded snapshot size (STATE)
+} PongNetMessage;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int WritePongNetMessage(const PongNetMessage *message, unsigned char *buffer);     // Write message to buffer (PONG_NET_MAX_PACKET), returns size
+bool ReadPongNetMessage(const unsigned char *data, int size, PongNetMessage *message);  // Read message from datagram, returns false if not valid
+PongSnapshot GetPongSnapshot(const PongGame *game, unsigned int tick);      // Get match state snapshot
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PONG_NET_H
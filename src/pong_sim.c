@@ -0,0 +1,130 @@
+/**********************************************************************************************
+*
+*   pong_sim - PONG simulation (ball, player and enemy update)
+*
+*   NOTE: Check pong_sim.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "pong_sim.h"
+
+#include "collision.h"          // Required for: CheckCollisionBallRec()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool CheckCollisionGameBall(PongGame *game, Rectangle rec);  // Check collision between ball and rectangle, test counted by game
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize ball, player and enemy
+void InitPongGame(PongGame *game, int screenWidth, int screenHeight)
+{
+    game->screenWidth = screenWidth;
+    game->screenHeight = screenHeight;
+
+    // Ball
+    game->ballPosition = (Vector2){ screenWidth/2, screenHeight/2 };
+    game->ballRadius = 20.0f;
+    game->ballSpeedX = 6;
+    game->ballSpeedY = -4;
+
+    // Player
+    game->player = (Rectangle){ 10, screenHeight/2 - 50, 25, 100 };
+    game->playerSpeed = 8.0f;
+    game->playerScore = 0;
+
+    // Enemy
+    game->enemy = (Rectangle){ screenWidth - 10 - 25, screenHeight/2 - 50, 25, 100 };
+    game->enemySpeed = 3.0f;
+    game->enemyVisionRange = screenWidth/2;
+    game->enemyScore = 0;
+}
+
+// Update one simulation step
+unsigned int UpdatePongGame(PongGame *game, PongInput input)
+{
+    unsigned int events = 0;
+
+    // Ball movement logic
+    game->ballPosition.x += game->ballSpeedX;
+    game->ballPosition.y += game->ballSpeedY;
+
+    if (((game->ballPosition.x + game->ballRadius) > game->screenWidth) || ((game->ballPosition.x - game->ballRadius) < 0))
+    {
+        game->ballSpeedX *= -1;
+        events |= PONG_EVENT_BOUNCE;
+    }
+
+    if (((game->ballPosition.y + game->ballRadius) > game->screenHeight) || ((game->ballPosition.y - game->ballRadius) < 0))
+    {
+        game->ballSpeedY *= -1;
+        events |= PONG_EVENT_BOUNCE;
+    }
+
+    if ((game->ballPosition.x - game->ballRadius) <= 0)
+    {
+        game->enemyScore += 1000;
+        events |= PONG_EVENT_ENEMY_SCORE;
+    }
+    else if ((game->ballPosition.x + game->ballRadius) > game->screenWidth)
+    {
+        game->playerScore += 1000;
+        events |= PONG_EVENT_PLAYER_SCORE;
+    }
+
+    // Player movement logic
+    if (input.up) game->player.y -= game->playerSpeed;
+    else if (input.down) game->player.y += game->playerSpeed;
+
+    if (game->player.y <= 0) game->player.y = 0;
+    else if ((game->player.y + game->player.height) >= game->screenHeight) game->player.y = game->screenHeight - game->player.height;
+
+    if (CheckCollisionGameBall(game, game->player))
+    {
+        game->ballSpeedX *= -1;
+        events |= PONG_EVENT_BOUNCE | PONG_EVENT_PLAYER_HIT;
+    }
+
+    // Enemy movement logic
+    if (input.enemyControlled)
+    {
+        if (input.enemyMove > 0) game->enemy.y += game->enemySpeed;
+        else if (input.enemyMove < 0) game->enemy.y -= game->enemySpeed;
+    }
+    else if (game->ballPosition.x > game->enemyVisionRange)
+    {
+        if (game->ballPosition.y > (game->enemy.y + game->enemy.height/2)) game->enemy.y += game->enemySpeed;
+        else if (game->ballPosition.y < (game->enemy.y + game->enemy.height/2)) game->enemy.y -= game->enemySpeed;
+    }
+
+    if (CheckCollisionGameBall(game, game->enemy))
+    {
+        game->ballSpeedX *= -1;
+        events |= PONG_EVENT_BOUNCE | PONG_EVENT_ENEMY_HIT;
+    }
+
+    if (input.visionIncrease) game->enemyVisionRange++;
+    else if (input.visionDecrease) game->enemyVisionRange--;
+
+    return events;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Check collision between ball and rectangle, test counted by game
+// NOTE: Tests are counted in game state, every game (threads, server matches) only writes its own counter
+static bool CheckCollisionGameBall(PongGame *game, Rectangle rec)
+{
+    game->collisionTests++;
+
+    return CheckCollisionBallRec(game->ballPosition, game->ballRadius, rec);
+}
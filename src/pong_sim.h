@@ -0,0 +1,84 @@
+/**********************************************************************************************
+*
+*   pong_sim - PONG simulation (ball, player and enemy update)
+*
+*   Gameplay logic from raylib pong, decoupled from window, inputs, drawing and audio:
+*     - Inputs are provided by the game on every step (PongInput)
+*     - Enemy is controlled by a simple scripted logic, it follows the ball once
+*       the ball crosses its vision range
+*     - Gameplay outcomes are returned as events flags (PongEvent)
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef PONG_SIM_H
+#define PONG_SIM_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Pong game state
+typedef struct PongGame {
+    int screenWidth;            // Playfield width
+    int screenHeight;           // Playfield height
+
+    // Ball
+    Vector2 ballPosition;
+    float ballRadius;
+    int ballSpeedX;
+    int ballSpeedY;
+
+    // Player
+    Rectangle player;
+    float playerSpeed;
+    int playerScore;
+
+    // Enemy
+    Rectangle enemy;
+    float enemySpeed;
+    int enemyVisionRange;       // Enemy starts following the ball once it crosses this x position
+    int enemyScore;
+
+    unsigned int collisionTests;    // Collision tests done, not reset (wraps around, use differences)
+} PongGame;
+
+// Pong game inputs for one simulation step
+typedef struct PongInput {
+    bool up;                    // Move player up
+    bool down;                  // Move player down
+    bool visionIncrease;        // Move enemy vision range right
+    bool visionDecrease;        // Move enemy vision range left
+    bool enemyControlled;       // Enemy moved by enemyMove instead of chasing the ball (i.e. enemy policy)
+    int enemyMove;              // Enemy move when controlled: -1 up, 0 stay, 1 down
+} PongInput;
+
+// Pong game events, returned as flags by UpdatePongGame()
+typedef enum {
+    PONG_EVENT_BOUNCE       = 0x01, // Ball bounced on screen limits, player or enemy
+    PONG_EVENT_PLAYER_SCORE = 0x02, // Ball reached enemy side
+    PONG_EVENT_ENEMY_SCORE  = 0x04, // Ball reached player side
+    PONG_EVENT_PLAYER_HIT   = 0x08, // Ball bounced on player (PONG_EVENT_BOUNCE also set)
+    PONG_EVENT_ENEMY_HIT    = 0x10  // Ball bounced on enemy (PONG_EVENT_BOUNCE also set)
+} PongEvent;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitPongGame(PongGame *game, int screenWidth, int screenHeight);     // Initialize ball, player and enemy
+unsigned int UpdatePongGame(PongGame *game, PongInput input);            // Update one simulation step, returns PongEvent flags
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PONG_SIM_H
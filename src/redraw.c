@@ -0,0 +1,232 @@
+/**********************************************************************************************
+*
+*   redraw - Idle-aware redraw: static screens are drawn only when something changes
+*
+*   NOTE: Check redraw.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "redraw.h"
+
+#include "raylib.h"             // Required for: GetTime(), EnableEventWaiting(), PollInputEvents(), WaitTime()
+#include "threads.h"            // Required for: StartThread(), LockMutex(), WaitConditionTimeout(), GetWallTime()...
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan(), ReleaseTraceThread()...
+
+#include <stddef.h>             // Required for: NULL
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_DESKTOP) && THREADS_SUPPORTED
+    #define REDRAW_EVENT_WAITING    1       // Sleep on input events, timer thread wakes main thread up
+
+    // NOTE: GLFW is built into raylib static library, it's not exposed by raylib API
+    void glfwPostEmptyEvent(void);
+#else
+    #define REDRAW_EVENT_WAITING    0
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static bool idle = false;                       // Idle mode enabled
+static bool redrawRequested = true;             // Next frame must be drawn
+static double redrawTime = 0.0;                 // Time when a frame must be drawn (blink toggle), 0 - none
+static bool skipped = false;                    // Current frame skipped
+
+#if REDRAW_EVENT_WAITING
+static Thread timerThread = { 0 };              // Timer thread, wakes main thread up at timerDeadline
+static Mutex timerMutex = { 0 };                // Timer state lock
+static Condition timerCond = { 0 };             // Signaled when timer is armed or stop is requested
+static bool timerStarted = false;               // Timer thread running
+static double timerDeadline = 0.0;              // Main thread wake-up time (GetWallTime() clock), 0 - disarmed (protected by timerMutex)
+static bool timerFired = false;                 // Main thread woken up by timer (protected by timerMutex)
+static bool timerStop = false;                  // Timer thread must exit (protected by timerMutex)
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+#if REDRAW_EVENT_WAITING
+static void RedrawTimer(void *arg);             // Timer thread: post an empty event at deadline, waking up main thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Enable/disable idle mode
+// NOTE: Screen contents change when mode changes, a redraw is always requested
+void SetIdleRedraw(bool enabled)
+{
+    if (enabled != idle)
+    {
+        idle = enabled;
+        redrawRequested = true;
+    }
+}
+
+// Check if idle mode is enabled
+bool IsIdleRedraw(void)
+{
+    return idle;
+}
+
+// Request next frame to be drawn
+void RequestRedraw(void)
+{
+    redrawRequested = true;
+}
+
+// Get blink state, redraw is scheduled on next toggle
+// NOTE: Blink is based on time, frames are not drawn at a regular rate in idle mode
+bool RedrawBlink(double interval)
+{
+    double now = GetTime();
+    long long step = (long long)(now/interval);
+    double toggleTime = (double)(step + 1)*interval;
+
+    if ((redrawTime <= 0.0) || (toggleTime < redrawTime)) redrawTime = toggleTime;
+
+    return ((step%2) == 0);
+}
+
+// Check if current frame must be drawn
+bool ShouldRedraw(void)
+{
+    bool redraw = true;
+
+    if (idle) redraw = redrawRequested || ((redrawTime > 0.0) && (GetTime() >= redrawTime));
+
+    // NOTE: Frame being drawn schedules next blink toggle again, if still required
+    if (redraw)
+    {
+        redrawRequested = false;
+        redrawTime = 0.0;
+    }
+
+    skipped = !redraw;
+
+    return redraw;
+}
+
+// Frame skipped: sleep until event, blink timer or maximum wait, inputs are polled
+// NOTE: Waking up because of an event (input, window) requests a redraw, game update
+// runs on next frame with fresh inputs and screen shows the result
+void WaitRedrawEvents(void)
+{
+    double timeout = REDRAW_MAX_WAIT;
+
+    if (redrawTime > 0.0)
+    {
+        double remaining = redrawTime - GetTime();
+        if (remaining < timeout) timeout = (remaining > 0.0)? remaining : 0.0;
+    }
+
+    BeginTraceSpan("WaitRedrawEvents", NULL);
+
+#if REDRAW_EVENT_WAITING
+    if (!timerStarted)
+    {
+        InitMutex(&timerMutex);
+        InitCondition(&timerCond);
+        timerStop = false;
+        timerStarted = StartThread(&timerThread, RedrawTimer, NULL);
+    }
+
+    LockMutex(&timerMutex);
+    timerDeadline = GetWallTime() + timeout;    // NOTE: Timer thread clock, raylib GetTime() is main thread only
+    timerFired = false;
+    SignalCondition(&timerCond);
+    UnlockMutex(&timerMutex);
+
+    // NOTE: With event waiting enabled, PollInputEvents() sleeps until an event arrives
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+
+    LockMutex(&timerMutex);
+    bool fired = timerFired;
+    timerDeadline = 0.0;
+    UnlockMutex(&timerMutex);
+
+    if (!fired) redrawRequested = true;
+#else
+#if !defined(PLATFORM_WEB)
+    WaitTime(timeout);          // NOTE: No event waiting available, just sleep
+#endif
+    PollInputEvents();
+#endif
+
+    EndTraceSpan();
+}
+
+// Check if current frame was skipped
+bool IsRedrawSkipped(void)
+{
+    return skipped;
+}
+
+// Stop timer thread
+// NOTE: Call before CloseWindow(), timer thread posts window events
+void CloseRedraw(void)
+{
+#if REDRAW_EVENT_WAITING
+    if (!timerStarted) return;
+
+    LockMutex(&timerMutex);
+    timerStop = true;
+    SignalCondition(&timerCond);
+    UnlockMutex(&timerMutex);
+
+    JoinThread(&timerThread);
+
+    DestroyCondition(&timerCond);
+    DestroyMutex(&timerMutex);
+
+    timerStarted = false;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+#if REDRAW_EVENT_WAITING
+// Timer thread: post an empty event at deadline, waking up main thread
+static void RedrawTimer(void *arg)
+{
+    (void)arg;
+
+    SetTraceThreadName("redraw_timer");
+
+    LockMutex(&timerMutex);
+
+    while (!timerStop)
+    {
+        if (timerDeadline <= 0.0)
+        {
+            WaitCondition(&timerCond, &timerMutex);
+            continue;
+        }
+
+        double remaining = timerDeadline - GetWallTime();
+
+        if (remaining > 0.0) WaitConditionTimeout(&timerCond, &timerMutex, remaining);
+        else
+        {
+            timerFired = true;
+            timerDeadline = 0.0;
+            glfwPostEmptyEvent();
+        }
+    }
+
+    UnlockMutex(&timerMutex);
+
+    ReleaseTraceThread();
+}
+#endif
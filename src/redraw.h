@@ -0,0 +1,81 @@
+/**********************************************************************************************
+*
+*   redraw - Idle-aware redraw: static screens are drawn only when something changes
+*
+*   Screens that barely change (title, ending, pause) do not need to be cleared and redrawn
+*   60 times per second. In idle mode, frames are drawn only when:
+*     - Redraw is requested by the game (RequestRedraw()) or idle mode is entered/left
+*     - An input or window event arrives (key press, mouse, resize, expose...)
+*     - A blink timer toggles (RedrawBlink())
+*
+*   Otherwise the frame is skipped and main thread sleeps waiting for events (raylib event
+*   waiting), a timer thread wakes it up for blink timers and, at least every REDRAW_MAX_WAIT
+*   seconds, to keep music streams refilled. Game update still runs on every wake-up.
+*
+*   CONFIGURATION:
+*       #define REDRAW_MAX_WAIT
+*           Maximum time sleeping without a wake-up (seconds), must be shorter than music stream
+*           buffers duration
+*
+*   NOTE: On desktop, waking up the main thread requires glfwPostEmptyEvent(), available
+*   with raylib built as static library (GLFW included). On web, skipped frames keep the
+*   canvas contents and browser paces the loop; on other platforms, skipped frames sleep
+*
+*   USAGE:
+*       SetIdleRedraw(screen == SCREEN_TITLE);
+*
+*       if (ShouldRedraw())
+*       {
+*           BeginDrawing();
+*               if (RedrawBlink(0.5)) DrawText("PRESS ENTER", 10, 10, 20, GRAY);
+*           EndDrawing();
+*       }
+*       else WaitRedrawEvents();        // Sleep until next event or timer, inputs are polled
+*
+*       // Main loop, frame pacer must not present skipped frames
+*       if (IsRedrawSkipped()) SkipFramePacing(&pacer);
+*       else EndFramePacing(&pacer);
+*
+*       CloseRedraw();                  // Stop timer thread
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef REDRAW_H
+#define REDRAW_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(REDRAW_MAX_WAIT)
+    #define REDRAW_MAX_WAIT         0.05    // Maximum sleep time (seconds), music streams buffers last ~90 ms
+#endif
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void SetIdleRedraw(bool enabled);               // Enable/disable idle mode (frames drawn only when required), redraw requested on change
+bool IsIdleRedraw(void);                        // Check if idle mode is enabled
+void RequestRedraw(void);                       // Request next frame to be drawn
+bool RedrawBlink(double interval);              // Get blink state (toggles every interval seconds), redraw is scheduled on next toggle
+
+bool ShouldRedraw(void);                        // Check if current frame must be drawn (always true out of idle mode)
+void WaitRedrawEvents(void);                    // Frame skipped: sleep until event, blink timer or maximum wait, inputs are polled
+bool IsRedrawSkipped(void);                     // Check if current frame was skipped (not drawn)
+
+void CloseRedraw(void);                         // Stop timer thread
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // REDRAW_H
@@ -0,0 +1,429 @@
+/**********************************************************************************************
+*
+*   replay - Game sessions replay files: inputs stream, keyframes index, fast seeking
+*
+*   NOTE: Check replay.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "replay.h"
+
+#include "raylib.h"             // Required for: TraceLog(), RL_MALLOC(), RL_CALLOC(), RL_REALLOC(), RL_FREE()
+
+#include <stdio.h>              // Required for: FILE, fopen(), fread(), fwrite(), fseek(), ftell(), fflush(), fclose()
+#include <stdlib.h>             // Required for: malloc(), calloc(), realloc(), free()
+#include <string.h>             // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool WriteChunk(ReplayRecorder *recorder, unsigned int type, unsigned int step, unsigned int count, const void *data, unsigned int size);  // Append chunk to replay file
+static bool WriteInputsChunk(ReplayRecorder *recorder);    // Append current segment inputs runs, runs are reset
+static void CloseRecorder(ReplayRecorder *recorder);       // Close replay file and unload recorder buffers
+static bool AddKeyframe(ReplayKeyframe **keyframes, int *count, int *capacity, ReplayKeyframe keyframe);    // Append keyframe to index, grows it if required
+static bool ReadIndexFooter(Replay *replay);                // Load keyframes index from footer, returns false if recording not finished
+static bool LoadKeyframe(Replay *replay, int index);        // Load keyframe state into playback state
+static bool LoadSegment(Replay *replay, int segment);       // Decode segment inputs runs into inputs per step
+static long GetOpenFileSize(FILE *file);                    // Get current size of an open file (it can grow while recording)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Create replay file, file header written
+// NOTE: Keyframes are written every REPLAY_KEYFRAME_INTERVAL steps, first one with first step
+ReplayRecorder StartReplayRecording(const char *fileName, int game, int stateSize, int stepRate)
+{
+    ReplayRecorder recorder = { 0 };
+
+    if ((stateSize <= 0) || (stateSize > REPLAY_MAX_STATE_SIZE))
+    {
+        TraceLog(LOG_WARNING, "REPLAY: State size not supported (%i bytes, maximum %i)", stateSize, REPLAY_MAX_STATE_SIZE);
+        return recorder;
+    }
+
+    recorder.header.magic = REPLAY_MAGIC;
+    recorder.header.version = REPLAY_VERSION;
+    recorder.header.game = game;
+    recorder.header.stateSize = stateSize;
+    recorder.header.stepRate = stepRate;
+    recorder.header.keyframeInterval = REPLAY_KEYFRAME_INTERVAL;
+
+    recorder.file = fopen(fileName, "wb");
+
+    if ((recorder.file == NULL) || (fwrite(&recorder.header, sizeof(ReplayHeader), 1, recorder.file) != 1))
+    {
+        TraceLog(LOG_WARNING, "REPLAY: [%s] Failed to create replay file", fileName);
+        if (recorder.file != NULL) fclose(recorder.file);
+        recorder.file = NULL;
+        return recorder;
+    }
+
+    fflush(recorder.file);
+
+    recorder.offset = sizeof(ReplayHeader);
+    recorder.runs = (ReplayInputRun *)RL_MALLOC(REPLAY_KEYFRAME_INTERVAL*sizeof(ReplayInputRun));
+
+    TraceLog(LOG_INFO, "REPLAY: [%s] Recording started (state %i bytes, keyframe every %i steps)", fileName, stateSize, REPLAY_KEYFRAME_INTERVAL);
+
+    return recorder;
+}
+
+// Record step inputs, keyframe every interval
+// NOTE: Called with state before running the step, file is flushed after every keyframe,
+// readers see every complete segment
+void RecordReplayStep(ReplayRecorder *recorder, const void *state, SimInput input)
+{
+    if (recorder->file == NULL) return;
+
+    if ((recorder->steps%recorder->header.keyframeInterval) == 0)
+    {
+        bool written = ((recorder->steps == 0) || WriteInputsChunk(recorder));   // Previous segment inputs
+        ReplayKeyframe keyframe = { recorder->steps, recorder->offset };
+
+        if (!written || !WriteChunk(recorder, REPLAY_CHUNK_KEYFRAME, recorder->steps, 0, state, recorder->header.stateSize))
+        {
+            TraceLog(LOG_WARNING, "REPLAY: Failed to write replay file, recording stopped");
+            CloseRecorder(recorder);
+            return;
+        }
+
+        AddKeyframe(&recorder->keyframes, &recorder->keyframesCount, &recorder->keyframesCapacity, keyframe);
+
+        fflush(recorder->file);
+    }
+
+    ReplayInputRun *run = (recorder->runsCount > 0)? &recorder->runs[recorder->runsCount - 1] : NULL;
+
+    if ((run != NULL) && (run->down == input.down) && (run->pressed == input.pressed)) run->count++;
+    else recorder->runs[recorder->runsCount++] = (ReplayInputRun){ input.down, input.pressed, 1 };
+
+    recorder->steps++;
+}
+
+// Write last segment and index footer, close file
+void StopReplayRecording(ReplayRecorder *recorder)
+{
+    if (recorder->file == NULL) return;
+
+    unsigned int indexOffset = 0;
+    bool written = ((recorder->runsCount == 0) || WriteInputsChunk(recorder));
+
+    if (written)
+    {
+        indexOffset = recorder->offset;
+        written = WriteChunk(recorder, REPLAY_CHUNK_INDEX, recorder->steps, recorder->keyframesCount,
+            recorder->keyframes, recorder->keyframesCount*sizeof(ReplayKeyframe));
+    }
+
+    ReplayFooter footer = { REPLAY_FOOTER_MAGIC, indexOffset };
+    if (written) written = (fwrite(&footer, sizeof(ReplayFooter), 1, recorder->file) == 1);
+
+    if (written) TraceLog(LOG_INFO, "REPLAY: Recording stopped (%u steps, %i keyframes, %u bytes)", recorder->steps, recorder->keyframesCount, recorder->offset + (unsigned int)sizeof(ReplayFooter));
+    else TraceLog(LOG_WARNING, "REPLAY: Failed to write replay index, file played up to last keyframe");
+
+    CloseRecorder(recorder);
+}
+
+// Check replay file is being written
+bool IsReplayRecording(const ReplayRecorder *recorder)
+{
+    return (recorder->file != NULL);
+}
+
+// Open replay file, load keyframes index
+// NOTE: Finished recordings index is read from footer, otherwise chunks are scanned
+Replay LoadReplay(const char *fileName)
+{
+    Replay replay = { 0 };
+    replay.segment = -1;
+
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "REPLAY: [%s] Failed to open replay file", fileName);
+        return replay;
+    }
+
+    ReplayHeader header = { 0 };
+
+    if ((fread(&header, sizeof(ReplayHeader), 1, file) != 1) || (header.magic != REPLAY_MAGIC) || (header.version != REPLAY_VERSION) ||
+        (header.stateSize <= 0) || (header.stateSize > REPLAY_MAX_STATE_SIZE) || (header.keyframeInterval <= 0))
+    {
+        TraceLog(LOG_WARNING, "REPLAY: [%s] Replay file not valid", fileName);
+        fclose(file);
+        return replay;
+    }
+
+    replay.file = file;
+    replay.header = header;
+    replay.scanOffset = sizeof(ReplayHeader);
+    replay.state = (unsigned char *)RL_CALLOC(header.stateSize, 1);
+    replay.inputs = (SimInput *)RL_MALLOC(header.keyframeInterval*sizeof(SimInput));
+    replay.runs = (ReplayInputRun *)RL_MALLOC(header.keyframeInterval*sizeof(ReplayInputRun));
+
+    if (!ReadIndexFooter(&replay)) UpdateReplayIndex(&replay);
+
+    if (replay.keyframesCount > 0) LoadKeyframe(&replay, 0);
+
+    TraceLog(LOG_INFO, "REPLAY: [%s] Replay loaded (%u steps, %i keyframes, %s)", fileName, replay.steps, replay.keyframesCount,
+        replay.finished? "finished" : "recording not finished");
+
+    return replay;
+}
+
+// Close replay file, unload state and index
+void UnloadReplay(Replay *replay)
+{
+    if (replay->file != NULL) fclose(replay->file);
+
+    RL_FREE(replay->keyframes);
+    RL_FREE(replay->state);
+    RL_FREE(replay->inputs);
+    RL_FREE(replay->runs);
+
+    memset(replay, 0, sizeof(Replay));
+    replay->segment = -1;
+}
+
+// Check replay is open with at least one segment
+bool IsReplayReady(const Replay *replay)
+{
+    return (replay->file != NULL) && (replay->steps > 0);
+}
+
+// Scan segments appended since loading, returns steps available
+// NOTE: A chunk not completely written yet stops the scan, next update reads it
+unsigned int UpdateReplayIndex(Replay *replay)
+{
+    if ((replay->file == NULL) || replay->finished) return replay->steps;
+
+    long size = GetOpenFileSize(replay->file);
+    ReplayChunk chunk = { 0 };
+
+    while ((replay->scanOffset + sizeof(ReplayChunk)) <= (unsigned long)size)
+    {
+        fseek(replay->file, replay->scanOffset, SEEK_SET);
+        if ((fread(&chunk, sizeof(ReplayChunk), 1, replay->file) != 1) ||
+            ((replay->scanOffset + sizeof(ReplayChunk) + chunk.size) > (unsigned long)size)) break;
+
+        if (chunk.type == REPLAY_CHUNK_KEYFRAME)
+        {
+            if ((chunk.step != (unsigned int)replay->keyframesCount*replay->header.keyframeInterval) ||
+                (chunk.size != (unsigned int)replay->header.stateSize)) break;
+
+            ReplayKeyframe keyframe = { chunk.step, replay->scanOffset };
+            AddKeyframe(&replay->keyframes, &replay->keyframesCount, &replay->keyframesCapacity, keyframe);
+        }
+        else if (chunk.type == REPLAY_CHUNK_INPUTS)
+        {
+            // Segment playable once its inputs follow its keyframe
+            if ((replay->keyframesCount > 0) && (chunk.step == replay->keyframes[replay->keyframesCount - 1].step)) replay->steps = chunk.step + chunk.count;
+        }
+        else if (chunk.type == REPLAY_CHUNK_INDEX)
+        {
+            replay->finished = true;
+            break;
+        }
+        else break;
+
+        replay->scanOffset += sizeof(ReplayChunk) + chunk.size;
+    }
+
+    return replay->steps;
+}
+
+// Set playback state to step: nearest keyframe plus gap re-simulated
+// NOTE: Keyframe lookup is a direct index (steps are keyframe interval aligned), seeking forward
+// inside current segment runs the steps in between from current state
+bool SeekReplay(Replay *replay, unsigned int step, SimStepFunc stepFunc, void *userData)
+{
+    if (!IsReplayReady(replay)) return false;
+
+    if (step > replay->steps) step = replay->steps;
+
+    int index = step/replay->header.keyframeInterval;
+    if (index >= replay->keyframesCount) index = replay->keyframesCount - 1;
+
+    bool ahead = (replay->step <= step) && (replay->step >= replay->keyframes[index].step);
+
+    if (!ahead && !LoadKeyframe(replay, index)) return false;
+
+    StepReplay(replay, step - replay->step, stepFunc, userData);
+
+    return (replay->step == step);
+}
+
+// Run playback steps, returns events flags
+// NOTE: Stops at last step available, UpdateReplayIndex() extends it while recording
+unsigned int StepReplay(Replay *replay, int count, SimStepFunc stepFunc, void *userData)
+{
+    unsigned int events = 0;
+
+    for (int i = 0; (i < count) && (replay->step < replay->steps); i++)
+    {
+        if (!LoadSegment(replay, replay->step/replay->header.keyframeInterval)) break;
+
+        events |= stepFunc(replay->state, replay->inputs[replay->step%replay->header.keyframeInterval], userData);
+        replay->step++;
+    }
+
+    return events;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Append chunk to replay file
+static bool WriteChunk(ReplayRecorder *recorder, unsigned int type, unsigned int step, unsigned int count, const void *data, unsigned int size)
+{
+    ReplayChunk chunk = { type, step, count, size };
+
+    if (fwrite(&chunk, sizeof(ReplayChunk), 1, recorder->file) != 1) return false;
+    if ((size > 0) && (fwrite(data, size, 1, recorder->file) != 1)) return false;
+
+    recorder->offset += sizeof(ReplayChunk) + size;
+
+    return true;
+}
+
+// Append current segment inputs runs, runs are reset
+static bool WriteInputsChunk(ReplayRecorder *recorder)
+{
+    unsigned int count = 0;
+    for (int i = 0; i < recorder->runsCount; i++) count += recorder->runs[i].count;
+
+    bool written = WriteChunk(recorder, REPLAY_CHUNK_INPUTS, recorder->steps - count, count, recorder->runs, recorder->runsCount*sizeof(ReplayInputRun));
+    recorder->runsCount = 0;
+
+    return written;
+}
+
+// Close replay file and unload recorder buffers
+static void CloseRecorder(ReplayRecorder *recorder)
+{
+    fclose(recorder->file);
+
+    RL_FREE(recorder->runs);
+    RL_FREE(recorder->keyframes);
+
+    memset(recorder, 0, sizeof(ReplayRecorder));
+}
+
+// Append keyframe to index, grows it if required
+static bool AddKeyframe(ReplayKeyframe **keyframes, int *count, int *capacity, ReplayKeyframe keyframe)
+{
+    if (*count == *capacity)
+    {
+        int grown = (*capacity > 0)? 2*(*capacity) : 64;
+        ReplayKeyframe *resized = (ReplayKeyframe *)RL_REALLOC(*keyframes, grown*sizeof(ReplayKeyframe));
+
+        if (resized == NULL) return false;
+
+        *keyframes = resized;
+        *capacity = grown;
+    }
+
+    (*keyframes)[(*count)++] = keyframe;
+
+    return true;
+}
+
+// Load keyframes index from footer
+// NOTE: Index entries must be keyframe interval aligned, direct lookup relies on it
+static bool ReadIndexFooter(Replay *replay)
+{
+    long size = GetOpenFileSize(replay->file);
+    ReplayFooter footer = { 0 };
+    ReplayChunk chunk = { 0 };
+
+    if (size < (long)(sizeof(ReplayHeader) + sizeof(ReplayChunk) + sizeof(ReplayFooter))) return false;
+
+    fseek(replay->file, size - (long)sizeof(ReplayFooter), SEEK_SET);
+    if ((fread(&footer, sizeof(ReplayFooter), 1, replay->file) != 1) || (footer.magic != REPLAY_FOOTER_MAGIC)) return false;
+
+    fseek(replay->file, footer.indexOffset, SEEK_SET);
+    if ((fread(&chunk, sizeof(ReplayChunk), 1, replay->file) != 1) || (chunk.type != REPLAY_CHUNK_INDEX) ||
+        (chunk.size != chunk.count*sizeof(ReplayKeyframe)) ||
+        ((footer.indexOffset + sizeof(ReplayChunk) + chunk.size + sizeof(ReplayFooter)) != (unsigned long)size)) return false;
+
+    ReplayKeyframe *keyframes = (ReplayKeyframe *)RL_MALLOC((chunk.count > 0)? chunk.size : sizeof(ReplayKeyframe));
+    bool valid = (chunk.count == 0) || (fread(keyframes, chunk.size, 1, replay->file) == 1);
+
+    for (unsigned int i = 0; valid && (i < chunk.count); i++) valid = (keyframes[i].step == i*replay->header.keyframeInterval);
+
+    if (!valid)
+    {
+        RL_FREE(keyframes);
+        return false;
+    }
+
+    replay->keyframes = keyframes;
+    replay->keyframesCount = chunk.count;
+    replay->keyframesCapacity = chunk.count;
+    replay->steps = chunk.step;
+    replay->scanOffset = footer.indexOffset;
+    replay->finished = true;
+
+    return true;
+}
+
+// Load keyframe state into playback state
+static bool LoadKeyframe(Replay *replay, int index)
+{
+    fseek(replay->file, replay->keyframes[index].offset + sizeof(ReplayChunk), SEEK_SET);
+
+    if (fread(replay->state, replay->header.stateSize, 1, replay->file) != 1) return false;
+
+    replay->step = replay->keyframes[index].step;
+
+    return true;
+}
+
+// Decode segment inputs runs into inputs per step
+// NOTE: Segment inputs chunk follows its keyframe chunk, no lookup required
+static bool LoadSegment(Replay *replay, int segment)
+{
+    if (segment == replay->segment) return true;
+    if (segment >= replay->keyframesCount) return false;
+
+    int interval = replay->header.keyframeInterval;
+    ReplayChunk chunk = { 0 };
+
+    fseek(replay->file, replay->keyframes[segment].offset + sizeof(ReplayChunk) + replay->header.stateSize, SEEK_SET);
+
+    if ((fread(&chunk, sizeof(ReplayChunk), 1, replay->file) != 1) || (chunk.type != REPLAY_CHUNK_INPUTS) ||
+        (chunk.step != replay->keyframes[segment].step) || (chunk.count > (unsigned int)interval) ||
+        (chunk.size > interval*sizeof(ReplayInputRun)) || ((chunk.size%sizeof(ReplayInputRun)) != 0) ||
+        (fread(replay->runs, chunk.size, 1, replay->file) != 1)) return false;
+
+    unsigned int decoded = 0;
+
+    for (unsigned int i = 0; i < chunk.size/sizeof(ReplayInputRun); i++)
+    {
+        for (unsigned int j = 0; (j < replay->runs[i].count) && (decoded < chunk.count); j++)
+        {
+            replay->inputs[decoded++] = (SimInput){ replay->runs[i].down, replay->runs[i].pressed };
+        }
+    }
+
+    if (decoded != chunk.count) return false;
+
+    replay->segment = segment;
+
+    return true;
+}
+
+// Get current size of an open file
+static long GetOpenFileSize(FILE *file)
+{
+    fseek(file, 0, SEEK_END);
+
+    return ftell(file);
+}
@@ -0,0 +1,177 @@
+/**********************************************************************************************
+*
+*   replay - Game sessions replay files: inputs stream, keyframes index, fast seeking
+*
+*   Recorded sessions are the simulation inputs of every step (SimInput, run-length encoded)
+*   plus the full simulation state every REPLAY_KEYFRAME_INTERVAL steps (keyframe), games
+*   steps are deterministic (same state and inputs, same next state). Playing a replay runs
+*   the game step callback on the recorded inputs, without window, at any speed.
+*
+*   Seeking loads the keyframe at or before the target step (direct index lookup, steps are
+*   keyframe interval aligned) and re-simulates only the gap: at most keyframe interval - 1
+*   steps, whatever the session length. Seeking forward inside current segment just runs
+*   the steps in between.
+*
+*   File is streamable while recording: chunks are appended and flushed every keyframe,
+*   a file still being recorded (or left by a crashed game) is played up to its last
+*   complete segment, UpdateReplayIndex() picks up segments appended since loading. Once
+*   recording stops, an index footer (keyframes steps and offsets) is appended, loading a
+*   finished replay reads it instead of scanning chunks.
+*
+*   FILE LAYOUT (all fields 32bit, native endianness):
+*       ReplayHeader                magic 'RPL1', version, game, state size, step rate, keyframe interval
+*       ReplayChunk KEYFRAME        step k*interval, state before that step (stateSize bytes)
+*       ReplayChunk INPUTS          steps [k*interval, k*interval + count), ReplayInputRun entries
+*       ...                         keyframe and inputs chunks, one pair per segment
+*       ReplayChunk INDEX           total steps, ReplayKeyframe entries (written on stop)
+*       ReplayFooter                magic 'RPLX', index chunk offset
+*
+*   NOTE: State is stored as raw bytes, recording and playing builds must share the same
+*   game core (state size is checked). Step callback must not depend on anything else
+*   than state, inputs and user data (i.e. pong enemy policy weights must be the same)
+*
+*   USAGE (recording, simulation thread step callback):
+*       ReplayRecorder recorder = StartReplayRecording("pong.rpl", REPLAY_GAME_PONG, sizeof(PongGame), 60);
+*       RecordReplayStep(&recorder, state, input);      // Before running the step
+*       StopReplayRecording(&recorder);
+*
+*   USAGE (playing):
+*       Replay replay = LoadReplay("pong.rpl");
+*       SeekReplay(&replay, 30*60*60, StepPongGame, NULL);     // Minute 30, one keyframe gap re-simulated
+*       unsigned int events = StepReplay(&replay, 1, StepPongGame, NULL);
+*       DrawPong((const PongGame *)replay.state);
+*       UnloadReplay(&replay);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "sim_thread.h"         // Required for: SimInput, SimStepFunc
+
+#include <stdio.h>              // Required for: FILE
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define REPLAY_MAGIC                0x314C5052      // 'RPL1'
+#define REPLAY_FOOTER_MAGIC         0x584C5052      // 'RPLX'
+#define REPLAY_VERSION              1
+
+#define REPLAY_KEYFRAME_INTERVAL    300     // Steps between keyframes (5 seconds at 60 steps per second)
+#define REPLAY_MAX_STATE_SIZE       65536   // Maximum state size (bytes)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Games recorded
+typedef enum {
+    REPLAY_GAME_PONG = 1,       // State: PongGame (pong_sim.h)
+    REPLAY_GAME_BLOCKS          // State: BlocksGame (blocks_sim.h)
+} ReplayGame;
+
+// Replay chunks types
+typedef enum {
+    REPLAY_CHUNK_KEYFRAME = 1,  // Full state before chunk step
+    REPLAY_CHUNK_INPUTS,        // Inputs runs of segment starting at chunk step
+    REPLAY_CHUNK_INDEX          // Keyframes index, chunk step is total steps recorded
+} ReplayChunkType;
+
+// Replay file header
+typedef struct ReplayHeader {
+    unsigned int magic;         // REPLAY_MAGIC
+    unsigned int version;       // REPLAY_VERSION
+    int game;                   // ReplayGame
+    int stateSize;              // State size in bytes
+    int stepRate;               // Simulation steps per second
+    int keyframeInterval;       // Steps between keyframes
+    unsigned int reserved[2];
+} ReplayHeader;
+
+// Replay chunk header, followed by size bytes of payload
+typedef struct ReplayChunk {
+    unsigned int type;          // ReplayChunkType
+    unsigned int step;          // First step covered
+    unsigned int count;         // Steps covered (inputs) or entries (index)
+    unsigned int size;          // Payload size in bytes
+} ReplayChunk;
+
+// Inputs run: same inputs on count consecutive steps
+typedef struct ReplayInputRun {
+    unsigned int down;          // Buttons down (bitmask)
+    unsigned int pressed;       // Buttons pressed (bitmask)
+    unsigned int count;         // Steps
+} ReplayInputRun;
+
+// Keyframes index entry
+typedef struct ReplayKeyframe {
+    unsigned int step;          // Keyframe step (keyframe interval multiple)
+    unsigned int offset;        // Keyframe chunk offset from file start
+} ReplayKeyframe;
+
+// Replay file footer, last bytes of a finished recording
+typedef struct ReplayFooter {
+    unsigned int magic;         // REPLAY_FOOTER_MAGIC
+    unsigned int indexOffset;   // Index chunk offset from file start
+} ReplayFooter;
+
+// Replay recorder
+typedef struct ReplayRecorder {
+    FILE *file;                 // Replay file (NULL if not recording)
+    ReplayHeader header;        // Replay file header
+    unsigned int steps;         // Steps recorded
+    unsigned int offset;        // File size written
+    ReplayInputRun *runs;       // Inputs runs of current segment (keyframe interval capacity)
+    int runsCount;              // Inputs runs of current segment
+    ReplayKeyframe *keyframes;  // Keyframes written, index footer
+    int keyframesCount;
+    int keyframesCapacity;
+} ReplayRecorder;
+
+// Replay player
+typedef struct Replay {
+    FILE *file;                 // Replay file, kept open to read segments (NULL if not valid)
+    ReplayHeader header;        // Replay file header
+    ReplayKeyframe *keyframes;  // Keyframes index
+    int keyframesCount;
+    int keyframesCapacity;
+    unsigned int steps;         // Steps available (keyframe and inputs recorded)
+    unsigned int scanOffset;    // Next chunk offset to scan, file still being recorded
+    bool finished;              // Index footer found, recording finished
+
+    unsigned char *state;       // Playback state (header.stateSize bytes)
+    unsigned int step;          // Playback state step (steps run since recording start)
+    SimInput *inputs;           // Inputs of segment being played (keyframe interval entries)
+    ReplayInputRun *runs;       // Inputs runs read from file (keyframe interval capacity)
+    int segment;                // Segment decoded in inputs, -1 if none
+} Replay;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+ReplayRecorder StartReplayRecording(const char *fileName, int game, int stateSize, int stepRate);  // Create replay file, file header written
+void RecordReplayStep(ReplayRecorder *recorder, const void *state, SimInput input);     // Record step inputs, keyframe every interval (state before step)
+void StopReplayRecording(ReplayRecorder *recorder);         // Write last segment and index footer, close file
+bool IsReplayRecording(const ReplayRecorder *recorder);     // Check replay file is being written
+
+Replay LoadReplay(const char *fileName);                    // Open replay file, load keyframes index (footer or chunks scan)
+void UnloadReplay(Replay *replay);                          // Close replay file, unload state and index
+bool IsReplayReady(const Replay *replay);                   // Check replay is open with at least one segment
+unsigned int UpdateReplayIndex(Replay *replay);             // Scan segments appended since loading (recording not finished), returns steps available
+bool SeekReplay(Replay *replay, unsigned int step, SimStepFunc stepFunc, void *userData);  // Set playback state to step: nearest keyframe plus gap re-simulated
+unsigned int StepReplay(Replay *replay, int count, SimStepFunc stepFunc, void *userData);  // Run playback steps (stops at last step available), returns events flags
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // REPLAY_H
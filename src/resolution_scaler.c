@@ -0,0 +1,189 @@
+/**********************************************************************************************
+*
+*   resolution_scaler - Dynamic resolution scaling driven by measured frame time
+*
+*   NOTE: Check resolution_scaler.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "resolution_scaler.h"
+
+#include "rlgl.h"               // Required for: rlViewport(), rlMatrixMode(), rlOrtho()...
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SCALER_WORK_RISE            0.5     // Work time estimate smoothing when work grows
+#define SCALER_WORK_DECAY           0.1     // Work time estimate smoothing when work shrinks
+#define SCALER_DROPPED_RATIO        1.5     // Frame time over targetFrameTime*ratio is a dropped frame
+#define SCALER_COOLDOWN_FRAMES       10     // Frames measured at new scale before changing it again
+#define SCALER_HITCH_TIME          0.25     // Frame time over this is not a dropped frame (idle screens, window moved, loading)
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static int GetScaledDimension(int size, float scale);   // Get scaled size in pixels (at least 1)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get default configuration
+ResolutionScalerConfig GetResolutionScalerConfigDefault(void)
+{
+    ResolutionScalerConfig config = { 0 };
+
+    config.minScale = 0.5f;
+    config.maxScale = 1.0f;
+    config.scaleStep = 0.1f;
+    config.targetFrameTime = 1.0/60.0;
+    config.overloadRatio = 0.9;         // Some headroom left for frame pacing and OS jitter
+    config.underloadRatio = 0.6;
+    config.upscaleFrames = 120;         // Two seconds at 60 fps, avoids oscillating between scales
+    config.filter = TEXTURE_FILTER_BILINEAR;
+
+    return config;
+}
+
+// Load render target
+ResolutionScaler LoadResolutionScaler(int width, int height, ResolutionScalerConfig config)
+{
+    ResolutionScaler scaler = { 0 };
+
+    scaler.config = config;
+    scaler.width = width;
+    scaler.height = height;
+    scaler.scale = config.maxScale;
+    scaler.target = LoadRenderTexture(width, height);
+    SetTextureFilter(scaler.target.texture, config.filter);
+
+    TraceLog(LOG_INFO, "SCALER: Resolution scaler loaded (%ix%i, scale: %.2f..%.2f)", width, height, config.minScale, config.maxScale);
+
+    return scaler;
+}
+
+// Unload render target
+void UnloadResolutionScaler(ResolutionScaler scaler)
+{
+    UnloadRenderTexture(scaler.target);
+}
+
+// Start measuring frame work
+void BeginScalerFrame(ResolutionScaler *scaler)
+{
+    scaler->workStart = GetTime();
+}
+
+// Measure frame work and adapt scale
+void EndScalerFrame(ResolutionScaler *scaler)
+{
+    const ResolutionScalerConfig *config = &scaler->config;
+
+    double work = GetTime() - scaler->workStart;
+
+    if (work > scaler->workEstimate) scaler->workEstimate += (work - scaler->workEstimate)*SCALER_WORK_RISE;
+    else scaler->workEstimate += (work - scaler->workEstimate)*SCALER_WORK_DECAY;
+
+    if (scaler->cooldown > 0)
+    {
+        scaler->cooldown--;
+        return;
+    }
+
+    double frameTime = GetFrameTime();
+    bool dropped = (frameTime > config->targetFrameTime*SCALER_DROPPED_RATIO) && (frameTime < SCALER_HITCH_TIME);
+    float scale = scaler->scale;
+
+    if (dropped || (scaler->workEstimate > config->targetFrameTime*config->overloadRatio))
+    {
+        scale -= config->scaleStep;
+        scaler->lightFrames = 0;
+    }
+    else if (scaler->workEstimate < config->targetFrameTime*config->underloadRatio)
+    {
+        scaler->lightFrames++;
+
+        if (scaler->lightFrames >= config->upscaleFrames)
+        {
+            scale += config->scaleStep;
+            scaler->lightFrames = 0;
+        }
+    }
+    else scaler->lightFrames = 0;
+
+    float previous = scaler->scale;
+    SetResolutionScale(scaler, scale);
+
+    if (scaler->scale != previous)
+    {
+        scaler->cooldown = SCALER_COOLDOWN_FRAMES;
+        TraceLog(LOG_DEBUG, "SCALER: Resolution scale %.2f -> %.2f (work: %.2f ms)", previous, scaler->scale, scaler->workEstimate*1000.0);
+    }
+}
+
+// Begin drawing into scaled render target
+// NOTE: Viewport covers only the scaled part of the target, projection keeps native coordinates
+void BeginScaledMode(ResolutionScaler *scaler)
+{
+    BeginTextureMode(scaler->target);
+
+    // NOTE: Full target cleared, bilinear filtering can sample next to the scaled area
+    ClearBackground(BLANK);
+
+    rlViewport(0, 0, GetScaledDimension(scaler->width, scaler->scale), GetScaledDimension(scaler->height, scaler->scale));
+
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, scaler->width, scaler->height, 0, 0.0f, 1.0f);
+
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+}
+
+// End drawing into scaled render target
+void EndScaledMode(void)
+{
+    EndTextureMode();       // Draws batch into target, restores screen viewport and projection
+}
+
+// Draw scaled render target upscaled to native size
+// NOTE: Render textures are flipped vertically, source height is negative
+void DrawScaledTarget(ResolutionScaler scaler)
+{
+    float width = (float)GetScaledDimension(scaler.width, scaler.scale);
+    float height = (float)GetScaledDimension(scaler.height, scaler.scale);
+
+    DrawTexturePro(scaler.target.texture, (Rectangle){ 0, 0, width, -height },
+        (Rectangle){ 0, 0, (float)scaler.width, (float)scaler.height }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+// Set current scale
+void SetResolutionScale(ResolutionScaler *scaler, float scale)
+{
+    if (scale < scaler->config.minScale) scale = scaler->config.minScale;
+    if (scale > scaler->config.maxScale) scale = scaler->config.maxScale;
+
+    scaler->scale = scale;
+}
+
+// Get current render size in pixels
+Vector2 GetScaledSize(ResolutionScaler scaler)
+{
+    return (Vector2){ (float)GetScaledDimension(scaler.width, scaler.scale), (float)GetScaledDimension(scaler.height, scaler.scale) };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get scaled size in pixels
+static int GetScaledDimension(int size, float scale)
+{
+    int scaled = (int)((float)size*scale + 0.5f);
+
+    return (scaled > 0)? scaled : 1;
+}
@@ -0,0 +1,100 @@
+/**********************************************************************************************
+*
+*   resolution_scaler - Dynamic resolution scaling driven by measured frame time
+*
+*   Gameplay is drawn into an internal render target at a fraction of native resolution
+*   (scale), target is then upscaled to screen (nearest or bilinear filtering) and HUD is
+*   drawn on top at native resolution. Scale adapts every frame to measured frame work:
+*     - Work time over budget, or dropped frames: scale goes down one step right away
+*     - Work time well under budget for a while: scale goes up one step
+*
+*   Work time is measured from BeginScalerFrame() to EndScalerFrame(), after EndDrawing():
+*   update, draw submission and buffers swap. rlgl has no GPU timer queries, GPU load shows
+*   up as driver stalls on batch flushes and buffers swap; dropped frames (GetFrameTime())
+*   catch the rest (i.e. web, where swap does not block).
+*
+*   Render target is allocated once at native size, lower scales use a part of it (viewport),
+*   changing scale never reallocates GPU memory. Gameplay keeps drawing in native coordinates.
+*
+*   USAGE:
+*       ResolutionScaler scaler = LoadResolutionScaler(800, 450, GetResolutionScalerConfigDefault());
+*
+*       BeginScalerFrame(&scaler);          // Frame start, before update
+*       ...
+*       BeginDrawing();
+*           BeginScaledMode(&scaler);       // Gameplay, native coordinates
+*               DrawGameplay();
+*           EndScaledMode();
+*           DrawScaledTarget(scaler);       // Upscaled to native resolution
+*           DrawHud();                      // Native resolution
+*       EndDrawing();
+*       EndScalerFrame(&scaler);            // Measure work and adapt scale
+*
+*       UnloadResolutionScaler(scaler);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef RESOLUTION_SCALER_H
+#define RESOLUTION_SCALER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Resolution scaler configuration
+typedef struct ResolutionScalerConfig {
+    float minScale;             // Minimum resolution scale (i.e. 0.5 - half width and height)
+    float maxScale;             // Maximum resolution scale (1.0 - native)
+    float scaleStep;            // Scale change per adjustment
+    double targetFrameTime;     // Frame budget (seconds)
+    double overloadRatio;       // Work over targetFrameTime*overloadRatio scales down
+    double underloadRatio;      // Work under targetFrameTime*underloadRatio for upscaleFrames scales up
+    int upscaleFrames;          // Consecutive light frames required before scaling up
+    int filter;                 // Upscaling filter (TEXTURE_FILTER_POINT, TEXTURE_FILTER_BILINEAR)
+} ResolutionScalerConfig;
+
+// Resolution scaler state
+typedef struct ResolutionScaler {
+    ResolutionScalerConfig config;  // Scaler configuration
+    RenderTexture2D target;     // Render target, native size
+    int width;                  // Native width
+    int height;                 // Native height
+    float scale;                // Current resolution scale
+    double workStart;           // Current frame work start time
+    double workEstimate;        // Smoothed frame work time (seconds)
+    int lightFrames;            // Consecutive frames under underload threshold
+    int cooldown;               // Frames left before scale can change again
+} ResolutionScaler;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+ResolutionScalerConfig GetResolutionScalerConfigDefault(void);  // Get default configuration (0.5..1.0 scale, 60 fps budget, bilinear)
+ResolutionScaler LoadResolutionScaler(int width, int height, ResolutionScalerConfig config); // Load render target (call after InitWindow())
+void UnloadResolutionScaler(ResolutionScaler scaler);           // Unload render target
+
+void BeginScalerFrame(ResolutionScaler *scaler);    // Start measuring frame work (call at frame start)
+void EndScalerFrame(ResolutionScaler *scaler);      // Measure frame work and adapt scale (call after EndDrawing())
+
+void BeginScaledMode(ResolutionScaler *scaler);     // Begin drawing into scaled render target (native coordinates)
+void EndScaledMode(void);                           // End drawing into scaled render target
+void DrawScaledTarget(ResolutionScaler scaler);     // Draw scaled render target upscaled to native size
+
+void SetResolutionScale(ResolutionScaler *scaler, float scale); // Set current scale (clamped to configuration range)
+Vector2 GetScaledSize(ResolutionScaler scaler);     // Get current render size in pixels
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // RESOLUTION_SCALER_H
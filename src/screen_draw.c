@@ -0,0 +1,211 @@
+/**********************************************************************************************
+*
+*   screen_draw - Games screens drawing shared by games and headless tools
+*
+*   NOTE: Check screen_draw.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "screen_draw.h"
+
+#include "softrender.h"         // Required for: SoftDrawTexture(), SoftDrawTextEx()...
+
+#include <stddef.h>             // Required for: NULL
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrawTextureRaylib(ScreenTexture texture, int posX, int posY, Color tint);
+static void DrawTextureExRaylib(ScreenTexture texture, Vector2 position, float rotation, float scale, Color tint);
+static void DrawTextExRaylib(ScreenFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+static void DrawTextureSoft(ScreenTexture texture, int posX, int posY, Color tint);
+static void DrawTextureExSoft(ScreenTexture texture, Vector2 position, float rotation, float scale, Color tint);
+static void DrawTextExSoft(ScreenFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const ScreenDrawBackend drawBackends[2] = {
+    { "raylib", ClearBackground, DrawRectangleRec, DrawCircleV, DrawLine, DrawTextureRaylib, DrawTextureExRaylib, DrawText, DrawTextExRaylib, MeasureText },
+    { "soft", SoftClearBackground, SoftDrawRectangleRec, SoftDrawCircleV, SoftDrawLine, DrawTextureSoft, DrawTextureExSoft, SoftDrawText, DrawTextExSoft, SoftMeasureText },
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get draw backend
+const ScreenDrawBackend *GetScreenDrawBackend(ScreenDrawType type)
+{
+    return (type == SCREEN_DRAW_SOFT)? &drawBackends[1] : &drawBackends[0];
+}
+
+// Draw blocks screen (background cleared)
+void DrawBlocksScreen(const ScreenDrawBackend *draw, GameScreen screen, const BlocksScreenAssets *assets, BlocksScreenView view)
+{
+    const int screenWidth = view.screenWidth;
+    const int screenHeight = view.screenHeight;
+
+    draw->ClearBackground(RAYWHITE);
+
+    switch (screen)
+    {
+        case SCREEN_LOGO:
+        {
+            draw->DrawTexture(assets->logo, screenWidth/2 - assets->logo.width/2, screenHeight/2 - assets->logo.height/2, WHITE);
+        } break;
+        case SCREEN_TITLE:
+        {
+            draw->DrawTextEx(assets->font, "BLOCKS", (Vector2){ 100, 80 }, 160, 10, MAROON);   // Draw Title
+
+            if (view.blink) draw->DrawText("PRESS [ENTER] to START", screenWidth/2 - draw->MeasureText("PRESS [ENTER] to START", 20)/2, screenHeight/2 + 60, 20, DARKGRAY);
+        } break;
+        case SCREEN_GAMEPLAY:
+        {
+            // Player, ball and bricks: game render path or textures, all bricks visited
+            if (view.DrawGameplay != NULL) view.DrawGameplay(view.game);
+            else DrawBlocksGameplay(draw, assets, view.game->player, view.game->ball, view.game->bricks, (GridRange){ 0, BRICKS_PER_LINE - 1, 0, BRICKS_LINES - 1 });
+
+            // Draw GUI: player lives
+            for (int i = 0; i < view.game->player.lifes; i++) draw->DrawRectangleRec((Rectangle){ 20.0f + 40*i, screenHeight - 30.0f, 35, 10 }, LIGHTGRAY);
+
+            // Draw pause message when required
+            if (view.paused) draw->DrawText("GAME PAUSED", screenWidth/2 - draw->MeasureText("GAME PAUSED", 40)/2, screenHeight/2 + 60, 40, GRAY);
+        } break;
+        case SCREEN_ENDING:
+        {
+            // Draw ending message
+            draw->DrawTextEx(assets->font, "GAME FINISHED", (Vector2){ 80, 100 }, 80, 6, MAROON);
+
+            // Draw game stats, counted from gameplay events
+            draw->DrawText(TextFormat("BRICKS DESTROYED: %i   PADDLE HITS: %i   LIFES LOST: %i", view.bricksDestroyed, view.paddleHits, view.lifesLost), 80, 200, 20, DARKGRAY);
+
+            if (view.blink) draw->DrawText("PRESS [ENTER] TO PLAY AGAIN", screenWidth/2 - draw->MeasureText("PRESS [ENTER] TO PLAY AGAIN", 20)/2, screenHeight/2 + 80, 20, GRAY);
+        } break;
+        default: break;
+    }
+}
+
+// Draw player, ball and visible bricks (textures), returns cells visited
+// NOTE: Textures are not scaled, just using original size
+int DrawBlocksGameplay(const ScreenDrawBackend *draw, const BlocksScreenAssets *assets, Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GridRange visible)
+{
+    int cellsVisited = 0;
+
+    draw->DrawTextureEx(assets->paddle, player.position, 0.0f, 1.0f, WHITE);    // Draw player
+
+    draw->DrawTexture(assets->ball, ball.position.x - ball.radius/2, ball.position.y - ball.radius/2, MAROON);   // Draw ball
+
+    // Draw bricks
+    for (int j = visible.firstRow; j <= visible.lastRow; j++)
+    {
+        for (int i = visible.firstColumn; i <= visible.lastColumn; i++)
+        {
+            cellsVisited++;
+
+            if (bricks[j][i].active) draw->DrawTextureEx(assets->brick, bricks[j][i].position, 0.0f, 1.0f, ((i + j)%2 == 0)? GRAY : DARKGRAY);
+        }
+    }
+
+    return cellsVisited;
+}
+
+// Draw pong screen (background cleared)
+// NOTE: Pong playfield is the whole screen, screen size is game size
+void DrawPongScreen(const ScreenDrawBackend *draw, GameScreen screen, const PongScreenAssets *assets, PongScreenView view)
+{
+    const int screenWidth = view.game->screenWidth;
+    const int screenHeight = view.game->screenHeight;
+
+    draw->ClearBackground(RAYWHITE);
+
+    switch (screen)
+    {
+        case SCREEN_LOGO:
+        {
+            draw->DrawTexture(assets->logo, screenWidth/2 - assets->logo.width/2, screenHeight/2 - assets->logo.height/2 - 40, Fade(WHITE, view.logoAlpha));
+        } break;
+        case SCREEN_TITLE:
+        {
+            draw->DrawTextEx(assets->titleFont, "SUPER PONG", (Vector2){ 200, 100 }, assets->titleFont.baseSize*6, 4, LIME);
+
+            if (!view.blink) draw->DrawText("PRESS ENTER to START", 200, 300, 30, BLACK);
+        } break;
+        case SCREEN_GAMEPLAY:
+        {
+            // Ball and paddles: game render path or screens backend
+            if (view.DrawGameplay != NULL) view.DrawGameplay(view.game);
+            else DrawPongGameplay(draw, view.game);
+
+            // Draw hud
+            draw->DrawText(TextFormat("%04i", view.game->playerScore), 100, 10, 30, BLUE);
+            draw->DrawText(TextFormat("%04i", view.game->enemyScore), screenWidth - 200, 10, 30, DARKGREEN);
+
+            if (view.enemyPolicy != NULL) draw->DrawText(TextFormat("enemy: %s [E]", view.enemyPolicy), screenWidth - 200, 45, 10, DARKGREEN);
+
+            if (view.paused)
+            {
+                draw->DrawRectangleRec((Rectangle){ 0, 0, screenWidth, screenHeight }, Fade(WHITE, 0.8f));
+                draw->DrawText("GAME PAUSED", 320, 200, 30, RED);
+            }
+        } break;
+        case SCREEN_ENDING:
+        {
+            draw->DrawRectangleRec((Rectangle){ 0, 0, screenWidth, screenHeight }, RED);
+            draw->DrawText("SCREEN ENDING", 10, 10, 30, MAROON);
+        } break;
+        default: break;
+    }
+}
+
+// Draw ball, paddles and enemy vision range
+void DrawPongGameplay(const ScreenDrawBackend *draw, const PongGame *game)
+{
+    draw->DrawCircleV(game->ballPosition, game->ballRadius, RED);
+
+    draw->DrawRectangleRec(game->player, BLUE);
+
+    draw->DrawRectangleRec(game->enemy, DARKGREEN);
+
+    draw->DrawLine(game->enemyVisionRange, 0, game->enemyVisionRange, game->screenHeight, GRAY);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// raylib backend: resources are Texture2D and Font
+static void DrawTextureRaylib(ScreenTexture texture, int posX, int posY, Color tint)
+{
+    DrawTexture(*(const Texture2D *)texture.data, posX, posY, tint);
+}
+
+static void DrawTextureExRaylib(ScreenTexture texture, Vector2 position, float rotation, float scale, Color tint)
+{
+    DrawTextureEx(*(const Texture2D *)texture.data, position, rotation, scale, tint);
+}
+
+static void DrawTextExRaylib(ScreenFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    DrawTextEx(*(const Font *)font.data, text, position, fontSize, spacing, tint);
+}
+
+// softrender backend: resources are SoftTexture and SoftFont
+static void DrawTextureSoft(ScreenTexture texture, int posX, int posY, Color tint)
+{
+    SoftDrawTexture(*(const SoftTexture *)texture.data, posX, posY, tint);
+}
+
+static void DrawTextureExSoft(ScreenTexture texture, Vector2 position, float rotation, float scale, Color tint)
+{
+    SoftDrawTextureEx(*(const SoftTexture *)texture.data, position, rotation, scale, tint);
+}
+
+static void DrawTextExSoft(ScreenFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    SoftDrawTextEx(*(const SoftFont *)font.data, text, position, fontSize, spacing, tint);
+}
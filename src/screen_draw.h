@@ -0,0 +1,140 @@
+/**********************************************************************************************
+*
+*   screen_draw - Games screens drawing shared by games and headless tools
+*
+*   Blocks and pong screens are drawn once here, through a draw backend: raylib (GPU, games)
+*   or softrender (CPU, tools/golden_frames). Golden frames are drawn by the same code games
+*   run, screens can not drift between them.
+*
+*   Backends mirror raylib drawing functions used by screens; textures and fonts are passed
+*   as backend resources pointers (Texture2D/Font or SoftTexture/SoftFont) with their sizes.
+*
+*   Games only keep what can not be shared: GAMEPLAY world drawn by their own render paths
+*   (resolution scaler, camera, render backends), provided as a view callback, and time based
+*   states (blink phase, logo fade), provided as view values.
+*
+*   USAGE:
+*       BlocksScreenView view = { 0 };
+*       view.game = &game;
+*       view.screenWidth = GetScreenWidth();
+*       view.screenHeight = GetScreenHeight();
+*       view.blink = RedrawBlink(0.5);
+*
+*       BeginDrawing();
+*           DrawBlocksScreen(GetScreenDrawBackend(SCREEN_DRAW_RAYLIB), screen.current, &assets, view);
+*       EndDrawing();
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SCREEN_DRAW_H
+#define SCREEN_DRAW_H
+
+#include "raylib.h"
+
+#include "screens.h"            // Required for: GameScreen
+#include "collision.h"          // Required for: GridRange
+#include "blocks_sim.h"         // Required for: BlocksGame, Player, Ball, Brick
+#include "pong_sim.h"           // Required for: PongGame
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Draw backends available
+typedef enum ScreenDrawType {
+    SCREEN_DRAW_RAYLIB = 0,     // raylib drawing functions (GPU), resources: Texture2D, Font
+    SCREEN_DRAW_SOFT            // softrender drawing functions (CPU), resources: SoftTexture, SoftFont
+} ScreenDrawType;
+
+// Texture for current backend
+typedef struct ScreenTexture {
+    const void *data;           // Backend texture (Texture2D or SoftTexture)
+    int width;                  // Texture width
+    int height;                 // Texture height
+} ScreenTexture;
+
+// Font for current backend
+typedef struct ScreenFont {
+    const void *data;           // Backend font (Font or SoftFont)
+    int baseSize;               // Base size (default chars height)
+} ScreenFont;
+
+// Draw backend, same signatures as raylib drawing functions
+// NOTE: DrawText() and MeasureText() use backend default font
+typedef struct ScreenDrawBackend {
+    const char *name;
+    void (*ClearBackground)(Color color);
+    void (*DrawRectangleRec)(Rectangle rec, Color color);
+    void (*DrawCircleV)(Vector2 center, float radius, Color color);
+    void (*DrawLine)(int startPosX, int startPosY, int endPosX, int endPosY, Color color);
+    void (*DrawTexture)(ScreenTexture texture, int posX, int posY, Color tint);
+    void (*DrawTextureEx)(ScreenTexture texture, Vector2 position, float rotation, float scale, Color tint);
+    void (*DrawText)(const char *text, int posX, int posY, int fontSize, Color color);
+    void (*DrawTextEx)(ScreenFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+    int (*MeasureText)(const char *text, int fontSize);
+} ScreenDrawBackend;
+
+// Blocks screens resources
+typedef struct BlocksScreenAssets {
+    ScreenTexture logo;
+    ScreenTexture paddle;
+    ScreenTexture ball;
+    ScreenTexture brick;
+    ScreenFont font;            // Title and ending messages font
+} BlocksScreenAssets;
+
+// Blocks screens view: game state and screens values not part of it
+typedef struct BlocksScreenView {
+    const BlocksGame *game;
+    int screenWidth;            // Screen size, GUI layout (board mode playfield is larger than screen)
+    int screenHeight;
+    bool blink;                 // Blink phase (RedrawBlink()), blinking texts drawn when true
+    bool paused;                // GAMEPLAY pause message
+    int bricksDestroyed;        // ENDING stats
+    int paddleHits;
+    int lifesLost;
+    void (*DrawGameplay)(const BlocksGame *game);   // GAMEPLAY world drawing, NULL: DrawBlocksGameplay() with screens backend
+} BlocksScreenView;
+
+// Pong screens resources
+typedef struct PongScreenAssets {
+    ScreenTexture logo;
+    ScreenFont titleFont;
+} PongScreenAssets;
+
+// Pong screens view: game state and screens values not part of it
+typedef struct PongScreenView {
+    const PongGame *game;
+    bool blink;                 // Blink phase (RedrawBlink()), blinking texts drawn when false
+    bool paused;                // GAMEPLAY pause overlay
+    float logoAlpha;            // LOGO fade (0.0f..1.0f)
+    const char *enemyPolicy;    // GAMEPLAY enemy policy label, NULL: not drawn
+    void (*DrawGameplay)(const PongGame *game);     // GAMEPLAY world drawing, NULL: DrawPongGameplay() with screens backend
+} PongScreenView;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+const ScreenDrawBackend *GetScreenDrawBackend(ScreenDrawType type);     // Get draw backend
+
+// Blocks screens
+void DrawBlocksScreen(const ScreenDrawBackend *draw, GameScreen screen, const BlocksScreenAssets *assets, BlocksScreenView view);  // Draw blocks screen (background cleared)
+int DrawBlocksGameplay(const ScreenDrawBackend *draw, const BlocksScreenAssets *assets, Player player, Ball ball, const Brick bricks[BRICKS_LINES][BRICKS_PER_LINE], GridRange visible);  // Draw player, ball and visible bricks (textures), returns cells visited
+
+// Pong screens
+void DrawPongScreen(const ScreenDrawBackend *draw, GameScreen screen, const PongScreenAssets *assets, PongScreenView view);        // Draw pong screen (background cleared)
+void DrawPongGameplay(const ScreenDrawBackend *draw, const PongGame *game);  // Draw ball, paddles and enemy vision range
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SCREEN_DRAW_H
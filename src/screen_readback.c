@@ -0,0 +1,64 @@
+/**********************************************************************************************
+*
+*   screen_readback - Screen pixels readback into caller buffers, no allocation, no flip
+*
+*   NOTE: Check screen_readback.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "screen_readback.h"
+
+#include "rlgl.h"               // Required for: rlDrawRenderBatchActive()
+
+#include <stddef.h>             // Required for: size_t
+
+// NOTE: Declaring required function directly, OpenGL headers conflict with raylib/rlgl ones;
+// glReadPixels() is OpenGL 1.1 and OpenGL ES 2.0 core, exported by every GL library linked
+#if defined(_WIN32)
+    __declspec(dllimport) void __stdcall glReadPixels(int x, int y, int width, int height, unsigned int format, unsigned int type, void *pixels);
+#else
+    void glReadPixels(int x, int y, int width, int height, unsigned int format, unsigned int type, void *pixels);
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GL_RGBA                     0x1908
+#define GL_UNSIGNED_BYTE            0x1401
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Read current screen into buffer, rows bottom-up
+// NOTE: RGBA8 rows are always 4 bytes aligned, default GL_PACK_ALIGNMENT is fine
+void ReadScreenPixelsInto(Color *pixels, int width, int height)
+{
+    rlDrawRenderBatchActive();      // Make sure all pending draw calls reach the framebuffer
+
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+// Flip screen readback rows to top-down, alpha forced to 255
+// NOTE: Rows are swapped in place, same result as rlReadScreenPixels()
+void FlipScreenPixels(Color *pixels, int width, int height)
+{
+    for (int y = 0; y < height/2; y++)
+    {
+        Color *top = pixels + (size_t)y*width;
+        Color *bottom = pixels + (size_t)(height - 1 - y)*width;
+
+        for (int x = 0; x < width; x++)
+        {
+            Color pixel = top[x];
+            top[x] = bottom[x];
+            bottom[x] = pixel;
+        }
+    }
+
+    for (int i = 0; i < width*height; i++) pixels[i].a = 255;
+}
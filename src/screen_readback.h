@@ -0,0 +1,45 @@
+/**********************************************************************************************
+*
+*   screen_readback - Screen pixels readback into caller buffers, no allocation, no flip
+*
+*   raylib rlReadScreenPixels() allocates a new buffer on every call and flips rows on the
+*   calling thread. Here, screen is read into a buffer provided by caller (i.e. a preallocated
+*   ring slot) as OpenGL gives it: rows bottom-up, alpha as in framebuffer. Rows flip (and
+*   alpha forced to 255) is done later with FlipScreenPixels(), on any thread.
+*
+*   NOTE: glReadPixels() is a synchronous GPU to CPU copy, it waits for pending draw calls;
+*   asynchronous readback (pixel buffer objects) is not available on OpenGL ES 2.0/WebGL 1
+*
+*   USAGE:
+*       // Main thread, after drawing, before EndDrawing()
+*       ReadScreenPixelsInto(slot, width, height);
+*
+*       // Worker thread
+*       FlipScreenPixels(slot, width, height);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SCREEN_READBACK_H
+#define SCREEN_READBACK_H
+
+#include "raylib.h"
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void ReadScreenPixelsInto(Color *pixels, int width, int height);   // Read current screen into buffer (width*height), rows bottom-up
+void FlipScreenPixels(Color *pixels, int width, int height);       // Flip screen readback rows to top-down, alpha forced to 255
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SCREEN_READBACK_H
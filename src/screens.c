@@ -0,0 +1,46 @@
+/**********************************************************************************************
+*
+*   screens - Game screens state management shared by games
+*
+*   NOTE: Check screens.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "screens.h"
+
+#include "raylib.h"             // Required for: TraceLog()
+#include "trace_events.h"       // Required for: TraceInstantEvent()
+#include "game_events.h"        // Required for: PushGameEvent()
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Change current screen
+void ChangeScreen(ScreenState *state, GameScreen screen)
+{
+    TraceLog(LOG_DEBUG, "SCREENS: %s -> %s", GetScreenName(state->current), GetScreenName(screen));
+    TraceInstantEvent("ChangeScreen", GetScreenName(screen));
+
+    state->current = screen;
+    state->framesCounter = 0;
+
+    PushGameEvent(GAME_EVENT_SCREEN_CHANGED, (Vector2){ 0.0f, 0.0f }, screen);
+}
+
+// Get screen name
+const char *GetScreenName(GameScreen screen)
+{
+    switch (screen)
+    {
+        case SCREEN_LOGO: return "LOGO";
+        case SCREEN_TITLE: return "TITLE";
+        case SCREEN_GAMEPLAY: return "GAMEPLAY";
+        case SCREEN_ENDING: return "ENDING";
+        default: return "UNKNOWN";
+    }
+}
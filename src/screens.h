@@ -0,0 +1,47 @@
+/**********************************************************************************************
+*
+*   screens - Game screens state management shared by games
+*
+*   All games follow the same screens flow (LOGO -> TITLE -> GAMEPLAY -> ENDING),
+*   every game implements its own screens update/draw, this module only tracks
+*   current screen, frames spent on it and screen transitions
+*
+*   NOTE: Screen transitions are also pushed as gameplay events (GAME_EVENT_SCREEN_CHANGED)
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SCREENS_H
+#define SCREENS_H
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Game screens
+typedef enum GameScreen { SCREEN_LOGO = 0, SCREEN_TITLE, SCREEN_GAMEPLAY, SCREEN_ENDING } GameScreen;
+
+// Screens state
+typedef struct ScreenState {
+    GameScreen current;         // Current game screen
+    int framesCounter;          // Frames since current screen was entered
+} ScreenState;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void ChangeScreen(ScreenState *state, GameScreen screen);   // Change current screen, frames counter is reset
+const char *GetScreenName(GameScreen screen);               // Get screen name (for logging)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SCREENS_H
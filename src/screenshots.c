@@ -0,0 +1,326 @@
+/**********************************************************************************************
+*
+*   screenshots - Non-blocking screenshots, image encoding on a worker thread
+*
+*   NOTE: Check screenshots.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "screenshots.h"
+
+#include "screen_readback.h"    // Required for: ReadScreenPixelsInto(), FlipScreenPixels()
+#include "threads.h"            // Required for: StartThread(), LockMutex(), WaitCondition()...
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan(), ReleaseTraceThread()...
+
+#include <stdlib.h>             // Required for: NULL
+#include <string.h>             // Required for: memcpy(), strncpy()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Screenshot slot state
+typedef enum ScreenshotState {
+    SCREENSHOT_FREE = 0,            // Slot available
+    SCREENSHOT_FILLING,             // Frame being copied by main thread
+    SCREENSHOT_QUEUED,              // Waiting for worker
+    SCREENSHOT_ENCODING,            // Being encoded and written by worker
+    SCREENSHOT_DONE                 // Written (or failed), waiting for callback
+} ScreenshotState;
+
+// Screenshot slot, one pooled frame buffer
+typedef struct Screenshot {
+    ScreenshotState state;          // Slot state (protected by poolMutex)
+    unsigned int order;             // Queue order, encoded first in first out
+    Color *pixels;                  // Frame pixels buffer (preallocated)
+    bool flip;                      // Pixels read from screen, rows bottom-up (flipped by worker)
+    char fileName[SCREENSHOTS_MAX_FILENAME];    // Output file name
+    ScreenshotCallback callback;    // Completion callback (can be NULL)
+    void *userData;                 // Completion callback user data
+    bool success;                   // File written successfully
+} Screenshot;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static Screenshot pool[SCREENSHOTS_POOL_SIZE] = { 0 };  // Screenshots pool
+static int frameWidth = 0;                      // Frames width
+static int frameHeight = 0;                     // Frames height
+static unsigned int queueCounter = 0;           // Screenshots queued, used for queue order
+static bool initialized = false;                // Pool allocated
+
+static Thread worker = { 0 };                   // Encoding worker thread
+static Mutex poolMutex = { 0 };                 // Slots state lock
+static Condition poolCond = { 0 };              // Signaled on new screenshots and on stop request
+static bool workerRunning = false;              // Worker thread started (false on platforms without threads)
+static bool stopRequested = false;              // Worker must exit once queue is empty
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ScreenshotsWorker(void *arg);               // Worker thread: encode queued screenshots until stop is requested
+static int GetNextQueued(void);                         // Get oldest queued screenshot, -1 if none (call with poolMutex locked)
+static int ReserveScreenshot(const char *fileName, ScreenshotCallback callback, void *userData); // Reserve free slot, -1 if none
+static void SubmitScreenshot(int index);                // Queue filled slot for encoding
+static void EncodeScreenshot(Screenshot *screenshot);   // Encode and write screenshot image
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize screenshots pool and worker
+// NOTE: All buffers are allocated here, taking a screenshot does not allocate memory
+void InitScreenshots(int width, int height)
+{
+    if (initialized) CloseScreenshots();
+
+    frameWidth = width;
+    frameHeight = height;
+    queueCounter = 0;
+    stopRequested = false;
+
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++)
+    {
+        pool[i] = (Screenshot){ 0 };
+        pool[i].pixels = (Color *)RL_MALLOC((size_t)width*height*sizeof(Color));
+    }
+
+    InitMutex(&poolMutex);
+    InitCondition(&poolCond);
+
+    workerRunning = StartThread(&worker, ScreenshotsWorker, NULL);
+    initialized = true;
+
+    TraceLog(LOG_INFO, "SCREENSHOTS: Initialized (%ix%i, %i buffers, %s)", width, height, SCREENSHOTS_POOL_SIZE,
+        workerRunning? "worker thread" : "main thread encoding");
+}
+
+// Wait for pending screenshots, call their callbacks and free pool
+void CloseScreenshots(void)
+{
+    if (!initialized) return;
+
+    if (workerRunning)
+    {
+        LockMutex(&poolMutex);
+        stopRequested = true;
+        SignalCondition(&poolCond);
+        UnlockMutex(&poolMutex);
+
+        JoinThread(&worker);
+        workerRunning = false;
+    }
+    else while (GetScreenshotsPending() > 0) UpdateScreenshots();
+
+    UpdateScreenshots();        // Call remaining callbacks
+
+    DestroyCondition(&poolCond);
+    DestroyMutex(&poolMutex);
+
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++) RL_FREE(pool[i].pixels);
+
+    initialized = false;
+}
+
+// Queue current screen
+// NOTE: Screen is read straight into pool buffer (GPU to CPU copy on main thread, no allocation),
+// rows flip and encoding are done by worker
+bool TakeScreenshotAsync(const char *fileName, ScreenshotCallback callback, void *userData)
+{
+    int index = ReserveScreenshot(fileName, callback, userData);
+    if (index < 0) return false;
+
+    ReadScreenPixelsInto(pool[index].pixels, frameWidth, frameHeight);
+    pool[index].flip = true;
+
+    SubmitScreenshot(index);
+
+    return true;
+}
+
+// Queue frame
+bool QueueScreenshot(const Color *pixels, const char *fileName, ScreenshotCallback callback, void *userData)
+{
+    if (pixels == NULL) return false;
+
+    int index = ReserveScreenshot(fileName, callback, userData);
+    if (index < 0) return false;
+
+    memcpy(pool[index].pixels, pixels, (size_t)frameWidth*frameHeight*sizeof(Color));
+    pool[index].flip = false;
+
+    SubmitScreenshot(index);
+
+    return true;
+}
+
+// Call callbacks of finished screenshots
+// NOTE: Without worker thread, one queued screenshot is encoded per call
+void UpdateScreenshots(void)
+{
+    if (!initialized) return;
+
+    if (!workerRunning)
+    {
+        LockMutex(&poolMutex);
+        int index = GetNextQueued();
+        UnlockMutex(&poolMutex);
+
+        if (index >= 0)
+        {
+            EncodeScreenshot(&pool[index]);
+            pool[index].state = SCREENSHOT_DONE;
+        }
+    }
+
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++)
+    {
+        LockMutex(&poolMutex);
+        bool done = (pool[i].state == SCREENSHOT_DONE);
+        Screenshot screenshot = pool[i];
+        if (done) pool[i].state = SCREENSHOT_FREE;
+        UnlockMutex(&poolMutex);
+
+        // NOTE: Slot is released before calling callback, callback can take a new screenshot
+        if (done && (screenshot.callback != NULL)) screenshot.callback(screenshot.fileName, screenshot.success, screenshot.userData);
+    }
+}
+
+// Get screenshots queued or being encoded
+int GetScreenshotsPending(void)
+{
+    if (!initialized) return 0;
+
+    int pending = 0;
+
+    LockMutex(&poolMutex);
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++)
+    {
+        if ((pool[i].state == SCREENSHOT_QUEUED) || (pool[i].state == SCREENSHOT_ENCODING)) pending++;
+    }
+    UnlockMutex(&poolMutex);
+
+    return pending;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Worker thread: encode queued screenshots until stop is requested
+// NOTE: Queued screenshots are always encoded before exiting
+static void ScreenshotsWorker(void *arg)
+{
+    (void)arg;
+
+    SetTraceThreadName("screenshots");
+
+    LockMutex(&poolMutex);
+
+    while (true)
+    {
+        int index = GetNextQueued();
+
+        if (index < 0)
+        {
+            if (stopRequested) break;
+
+            WaitCondition(&poolCond, &poolMutex);
+            continue;
+        }
+
+        pool[index].state = SCREENSHOT_ENCODING;
+
+        UnlockMutex(&poolMutex);
+        EncodeScreenshot(&pool[index]);
+        LockMutex(&poolMutex);
+
+        pool[index].state = SCREENSHOT_DONE;
+    }
+
+    UnlockMutex(&poolMutex);
+
+    ReleaseTraceThread();
+}
+
+// Get oldest queued screenshot, -1 if none
+static int GetNextQueued(void)
+{
+    int index = -1;
+
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++)
+    {
+        if ((pool[i].state == SCREENSHOT_QUEUED) && ((index < 0) || ((int)(pool[i].order - pool[index].order) < 0))) index = i;
+    }
+
+    return index;
+}
+
+// Reserve free slot, -1 if none
+static int ReserveScreenshot(const char *fileName, ScreenshotCallback callback, void *userData)
+{
+    if (!initialized)
+    {
+        TraceLog(LOG_WARNING, "SCREENSHOTS: Screenshots not initialized, call InitScreenshots() first");
+        return -1;
+    }
+
+    int index = -1;
+
+    LockMutex(&poolMutex);
+    for (int i = 0; i < SCREENSHOTS_POOL_SIZE; i++)
+    {
+        if (pool[i].state == SCREENSHOT_FREE)
+        {
+            pool[i].state = SCREENSHOT_FILLING;
+            index = i;
+            break;
+        }
+    }
+    UnlockMutex(&poolMutex);
+
+    if (index < 0)
+    {
+        TraceLog(LOG_WARNING, "SCREENSHOTS: [%s] All buffers in use, screenshot skipped", fileName);
+        return -1;
+    }
+
+    strncpy(pool[index].fileName, fileName, SCREENSHOTS_MAX_FILENAME - 1);
+    pool[index].fileName[SCREENSHOTS_MAX_FILENAME - 1] = '\0';
+    pool[index].callback = callback;
+    pool[index].userData = userData;
+    pool[index].success = false;
+
+    return index;
+}
+
+// Queue filled slot for encoding
+static void SubmitScreenshot(int index)
+{
+    LockMutex(&poolMutex);
+    pool[index].order = queueCounter++;
+    pool[index].state = SCREENSHOT_QUEUED;
+    SignalCondition(&poolCond);
+    UnlockMutex(&poolMutex);
+}
+
+// Encode and write screenshot image
+// NOTE: Alpha is forced to 255, same as raylib TakeScreenshot(); format is selected by
+// ExportImage() from file extension (.png, .qoi...)
+static void EncodeScreenshot(Screenshot *screenshot)
+{
+    Image image = { screenshot->pixels, frameWidth, frameHeight, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+
+    BeginTraceSpan("EncodeScreenshot", screenshot->fileName);
+
+    if (screenshot->flip) FlipScreenPixels(screenshot->pixels, frameWidth, frameHeight);
+    else for (int i = 0; i < frameWidth*frameHeight; i++) screenshot->pixels[i].a = 255;
+
+    screenshot->success = ExportImage(image, screenshot->fileName);
+
+    EndTraceSpan();
+}
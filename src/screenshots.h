@@ -0,0 +1,68 @@
+/**********************************************************************************************
+*
+*   screenshots - Non-blocking screenshots, image encoding on a worker thread
+*
+*   raylib TakeScreenshot() encodes the image on the calling thread, dropping several frames.
+*   Here, the frame is copied (screen: read back) into a buffer from a preallocated pool and
+*   queued; a worker thread flips screen rows, encodes and writes it (PNG or QOI, from file extension) while the game keeps running.
+*   Once written, completion callback is called from UpdateScreenshots() on main thread,
+*   so it can safely use raylib functions.
+*
+*   If all pool buffers are in use, new screenshots are rejected (never waits).
+*
+*   NOTE: On web without pthreads, queued screenshots are encoded by UpdateScreenshots(),
+*   one per call, never in the frame the screenshot was taken
+*
+*   USAGE:
+*       InitScreenshots(800, 450);
+*
+*       // After drawing, before EndDrawing()
+*       if (IsKeyPressed(KEY_F10)) TakeScreenshotAsync("screenshot.png", OnScreenshotSaved, NULL);
+*       UpdateScreenshots();
+*
+*       CloseScreenshots();         // Wait for pending screenshots and free pool
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SCREENSHOTS_H
+#define SCREENSHOTS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SCREENSHOTS_POOL_SIZE        4      // Screenshots being encoded at the same time
+#define SCREENSHOTS_MAX_FILENAME   256      // Maximum screenshot file name length
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Screenshot completion callback, called on main thread
+typedef void (*ScreenshotCallback)(const char *fileName, bool success, void *userData);
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitScreenshots(int width, int height);    // Initialize screenshots pool and worker for frames of width x height
+void CloseScreenshots(void);                    // Wait for pending screenshots, call their callbacks and free pool
+
+bool TakeScreenshotAsync(const char *fileName, ScreenshotCallback callback, void *userData);   // Queue current screen (call after drawing, before EndDrawing())
+bool QueueScreenshot(const Color *pixels, const char *fileName, ScreenshotCallback callback, void *userData); // Queue frame (width*height RGBA8 pixels)
+void UpdateScreenshots(void);                   // Call callbacks of finished screenshots (call once per frame)
+int GetScreenshotsPending(void);                // Get screenshots queued or being encoded
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SCREENSHOTS_H
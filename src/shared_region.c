@@ -0,0 +1,201 @@
+/**********************************************************************************************
+*
+*   shared_region - Named shared memory regions between local processes
+*
+*   NOTE: Check shared_region.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "shared_region.h"
+
+#include <stdio.h>              // Required for: snprintf()
+
+#if defined(PLATFORM_WEB)
+    // NOTE: No shared memory between processes on web, functions fail
+#elif defined(_WIN32)
+    // NOTE: Declaring required functions directly, including windows.h conflicts with raylib names
+    __declspec(dllimport) void *__stdcall CreateFileMappingA(void *file, void *attributes, unsigned long protect, unsigned long sizeHigh, unsigned long sizeLow, const char *name);
+    __declspec(dllimport) void *__stdcall OpenFileMappingA(unsigned long access, int inherit, const char *name);
+    __declspec(dllimport) void *__stdcall MapViewOfFile(void *mapping, unsigned long access, unsigned long offsetHigh, unsigned long offsetLow, size_t size);
+    __declspec(dllimport) int __stdcall UnmapViewOfFile(const void *address);
+    __declspec(dllimport) size_t __stdcall VirtualQuery(const void *address, void *buffer, size_t length);
+    __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+
+    // MEMORY_BASIC_INFORMATION layout, filled by VirtualQuery()
+    typedef struct Win32MemoryInfo {
+        void *baseAddress;
+        void *allocationBase;
+        unsigned long allocationProtect;
+        size_t regionSize;
+        unsigned long state;
+        unsigned long protect;
+        unsigned long type;
+    } Win32MemoryInfo;
+
+    #define WIN32_INVALID_HANDLE_VALUE  ((void *)(long long)-1)
+    #define WIN32_PAGE_READWRITE        0x04
+    #define WIN32_FILE_MAP_ALL_ACCESS   0xF001F
+    #define WIN32_FILE_MAP_READ         0x0004
+#else
+    #include <sys/mman.h>       // Required for: shm_open(), shm_unlink(), mmap(), munmap()
+    #include <sys/stat.h>       // Required for: fstat()
+    #include <fcntl.h>          // Required for: O_CREAT, O_RDWR, O_RDONLY
+    #include <unistd.h>         // Required for: ftruncate(), close()
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void SetRegionName(SharedRegion *region, const char *name);     // Set platform decorated region name
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Create named region read/write
+// NOTE: An existing region with same name (i.e. from a crashed owner) is replaced,
+// public regions can be opened read-only by other users processes (POSIX)
+bool CreateSharedRegion(SharedRegion *region, const char *name, size_t size, bool publicRead)
+{
+    SetRegionName(region, name);
+    region->memory = NULL;
+    region->size = 0;
+    region->owner = false;
+    region->handle = NULL;
+
+#if defined(PLATFORM_WEB)
+    (void)size; (void)publicRead;
+    return false;
+#elif defined(_WIN32)
+    (void)publicRead;
+    region->handle = CreateFileMappingA(WIN32_INVALID_HANDLE_VALUE, NULL, WIN32_PAGE_READWRITE, 0, (unsigned long)size, region->name);
+    if (region->handle == NULL) return false;
+
+    region->memory = MapViewOfFile(region->handle, WIN32_FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+    if (region->memory == NULL)
+    {
+        CloseHandle(region->handle);
+        return false;
+    }
+#else
+    shm_unlink(region->name);           // Remove stale region from a crashed owner
+    int fd = shm_open(region->name, O_CREAT | O_RDWR, publicRead? 0644 : 0600);
+    if (fd == -1) return false;
+
+    if (ftruncate(fd, (off_t)size) == -1)
+    {
+        close(fd);
+        shm_unlink(region->name);
+        return false;
+    }
+
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);                          // NOTE: Mapping stays valid after closing descriptor
+
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(region->name);
+        return false;
+    }
+
+    region->memory = memory;
+#endif
+
+    region->size = size;
+    region->owner = true;
+
+    return true;
+}
+
+// Open named region created by other process
+// NOTE: Mapped size is read from platform, Win32 view size is rounded up to pages
+bool OpenSharedRegion(SharedRegion *region, const char *name, bool readOnly)
+{
+    SetRegionName(region, name);
+    region->memory = NULL;
+    region->size = 0;
+    region->owner = false;
+    region->handle = NULL;
+
+#if defined(PLATFORM_WEB)
+    (void)readOnly;
+    return false;
+#elif defined(_WIN32)
+    unsigned long access = readOnly? WIN32_FILE_MAP_READ : WIN32_FILE_MAP_ALL_ACCESS;
+
+    region->handle = OpenFileMappingA(access, 0, region->name);
+    if (region->handle == NULL) return false;
+
+    region->memory = MapViewOfFile(region->handle, access, 0, 0, 0);
+
+    Win32MemoryInfo info = { 0 };
+    if ((region->memory != NULL) && (VirtualQuery(region->memory, &info, sizeof(info)) != 0)) region->size = info.regionSize;
+
+    if (region->size == 0)
+    {
+        if (region->memory != NULL) UnmapViewOfFile(region->memory);
+        CloseHandle(region->handle);
+        region->memory = NULL;
+        return false;
+    }
+#else
+    int fd = shm_open(region->name, readOnly? O_RDONLY : O_RDWR, 0);
+
+    struct stat info = { 0 };
+    if ((fd == -1) || (fstat(fd, &info) != 0) || (info.st_size <= 0))
+    {
+        if (fd != -1) close(fd);
+        return false;
+    }
+
+    void *memory = mmap(NULL, (size_t)info.st_size, readOnly? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    close(fd);                          // NOTE: Mapping stays valid after closing descriptor
+
+    if (memory == MAP_FAILED) return false;
+
+    region->memory = memory;
+    region->size = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+// Unmap region, name removed if owner
+// NOTE: Removed region name stays mapped by other processes until they close it
+void CloseSharedRegion(SharedRegion *region)
+{
+    if (region->memory == NULL) return;
+
+#if defined(PLATFORM_WEB)
+    // Nothing to release
+#elif defined(_WIN32)
+    UnmapViewOfFile(region->memory);
+    CloseHandle(region->handle);
+#else
+    munmap(region->memory, region->size);
+    if (region->owner) shm_unlink(region->name);
+#endif
+
+    region->memory = NULL;
+    region->size = 0;
+    region->handle = NULL;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Set platform decorated region name
+static void SetRegionName(SharedRegion *region, const char *name)
+{
+#if defined(_WIN32)
+    snprintf(region->name, sizeof(region->name), "Local\\%s", name);
+#else
+    snprintf(region->name, sizeof(region->name), "/%s", name);
+#endif
+}
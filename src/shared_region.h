@@ -0,0 +1,70 @@
+/**********************************************************************************************
+*
+*   shared_region - Named shared memory regions between local processes
+*
+*   Thin wrapper over POSIX shm_open()/mmap() and Win32 file mappings, just what game core
+*   transports need (gym_shm, spectator_shm): owner process creates a named region read/write,
+*   other processes open it by name read/write or read-only, closing owner removes the name.
+*
+*   NOTE: Region name is platform decorated: "/<name>" (POSIX shm_open(), Linux: /dev/shm/<name>),
+*   "Local\<name>" (Win32 file mapping). POSIX regions are private to owner user (mode 0600)
+*   unless created public: processes of other users can open them read-only (mode 0644).
+*   On web there is no shared memory between processes, functions fail
+*
+*   USAGE:
+*       // Owner process
+*       SharedRegion region = { 0 };
+*       if (CreateSharedRegion(&region, "raylib_game", size, false)) memset(region.memory, 0, size);
+*
+*       // Other process, mapped size read from platform (page rounded on Win32)
+*       SharedRegion view = { 0 };
+*       OpenSharedRegion(&view, "raylib_game", true);
+*
+*       CloseSharedRegion(&region);     // Unmap, name removed if owner
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SHARED_REGION_H
+#define SHARED_REGION_H
+
+#include <stdbool.h>
+#include <stddef.h>             // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SHARED_REGION_MAX_NAME      64      // Platform decorated region name maximum length
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Shared region mapping
+typedef struct SharedRegion {
+    void *memory;               // Mapped region (NULL if not available)
+    size_t size;                // Mapped region size
+    bool owner;                 // Region created by this process (name removed on close)
+    void *handle;               // Win32 file mapping handle
+    char name[SHARED_REGION_MAX_NAME];  // Platform decorated region name
+} SharedRegion;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool CreateSharedRegion(SharedRegion *region, const char *name, size_t size, bool publicRead);   // Create named region read/write (replacing a stale one), returns false if not possible
+bool OpenSharedRegion(SharedRegion *region, const char *name, bool readOnly);               // Open named region created by other process, returns false if not available
+void CloseSharedRegion(SharedRegion *region);                                               // Unmap region, name removed if owner
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SHARED_REGION_H
@@ -0,0 +1,283 @@
+/**********************************************************************************************
+*
+*   sim_thread - Fixed rate simulation thread, state handed to renderer with a triple buffer
+*
+*   NOTE: Check sim_thread.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "sim_thread.h"
+
+#include "raylib.h"             // Required for: TraceLog(), RL_MALLOC(), RL_FREE()
+#include "trace_events.h"       // Required for: BeginTraceSpan(), EndTraceSpan(), SetTraceThreadName()...
+
+#include <stdlib.h>             // Required for: malloc(), free()
+#include <stddef.h>             // Required for: NULL, size_t
+#include <string.h>             // Required for: memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SIM_SLOT_INDEX_MASK     0x03    // Shared value: slot index
+#define SIM_SLOT_FRESH          0x04    // Shared value: slot holds a snapshot not acquired yet
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned char *GetSimSlot(SimThread *sim, unsigned int index);  // Get snapshot slot memory
+static void RunSimSteps(SimThread *sim);            // Run simulation steps due, publishing every one
+static SimInput ReadSimInput(SimThread *sim);       // Read inputs for next step, presses are consumed
+static void PublishSimState(SimThread *sim, unsigned int events);     // Copy state to back slot and swap it with shared slot
+static void SimThreadLoop(void *arg);               // Simulation thread: run steps at fixed rate, sleep while inactive
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get default configuration
+SimThreadConfig GetSimThreadConfigDefault(void)
+{
+    SimThreadConfig config = { 0 };
+
+    config.stepRate = 60;           // NOTE: Games logic moves pixels per step, designed for 60 steps per second
+    config.maxCatchUpSteps = 5;
+
+    return config;
+}
+
+// Start simulation
+// NOTE: All slots start with current state, a valid snapshot is always available
+bool StartSimThread(SimThread *sim, void *state, int stateSize, SimStepFunc step, void *userData, SimThreadConfig config)
+{
+    sim->config = config;
+    sim->step = step;
+    sim->userData = userData;
+    sim->state = state;
+    sim->stateSize = stateSize;
+
+    sim->slots = (unsigned char *)RL_MALLOC((size_t)stateSize*3);
+    for (int i = 0; i < 3; i++)
+    {
+        memcpy(GetSimSlot(sim, i), state, stateSize);
+        sim->slotEvents[i] = 0;
+    }
+
+    sim->back = 0;
+    sim->shared = 1;
+    sim->front = 2;
+    sim->carryEvents = 0;
+
+    sim->inputDown = 0;
+    for (int i = 0; i < SIM_INPUT_BUTTONS; i++)
+    {
+        sim->inputPresses[i] = 0;
+        sim->inputSeen[i] = 0;
+    }
+
+    sim->active = 0;
+    sim->steps = 0;
+    sim->stepping = false;
+    sim->nextStepTime = 0.0;
+
+    InitMutex(&sim->mutex);
+    InitCondition(&sim->wakeup);
+    sim->stop = false;
+
+    sim->threaded = StartThread(&sim->thread, SimThreadLoop, sim);
+
+    if (sim->threaded) TraceLog(LOG_INFO, "SIMULATION: Simulation thread started (%i steps per second)", config.stepRate);
+    else TraceLog(LOG_WARNING, "SIMULATION: Threads not available, simulation steps run on main thread");
+
+    return sim->threaded;
+}
+
+// Stop simulation thread and unload snapshots
+void StopSimThread(SimThread *sim)
+{
+    if (sim->slots == NULL) return;
+
+    LockMutex(&sim->mutex);
+    sim->stop = true;
+    SignalCondition(&sim->wakeup);
+    UnlockMutex(&sim->mutex);
+
+    if (sim->threaded) JoinThread(&sim->thread);
+
+    DestroyCondition(&sim->wakeup);
+    DestroyMutex(&sim->mutex);
+
+    RL_FREE(sim->slots);
+    sim->slots = NULL;
+    sim->threaded = false;
+
+    TraceLog(LOG_INFO, "SIMULATION: Simulation stopped (%u steps)", sim->steps);
+}
+
+// Start/stop running steps
+void SetSimActive(SimThread *sim, bool active)
+{
+    if (active == (AtomicLoad(&sim->active) != 0)) return;
+
+    LockMutex(&sim->mutex);
+    AtomicStore(&sim->active, active? 1 : 0);
+    SignalCondition(&sim->wakeup);
+    UnlockMutex(&sim->mutex);
+}
+
+// Set inputs for next steps
+// NOTE: Presses are counted per button, simulation hands every new press to one step
+void SetSimInput(SimThread *sim, unsigned int down, unsigned int pressed)
+{
+    AtomicStore(&sim->inputDown, down);
+
+    for (int i = 0; i < SIM_INPUT_BUTTONS; i++)
+    {
+        if (pressed & (1u << i)) AtomicAdd(&sim->inputPresses[i], 1);
+    }
+}
+
+// Get latest state snapshot and events raised since previous call
+// NOTE: Front slot is owned by render thread, it's not written until next call
+const void *AcquireSimState(SimThread *sim, unsigned int *events)
+{
+    unsigned int received = 0;
+
+    if (!sim->threaded) RunSimSteps(sim);
+
+    if (AtomicLoad(&sim->shared) & SIM_SLOT_FRESH)
+    {
+        unsigned int previous = AtomicExchange(&sim->shared, sim->front);
+
+        sim->front = previous & SIM_SLOT_INDEX_MASK;
+        received = sim->slotEvents[sim->front];
+    }
+
+    if (events != NULL) *events = received;
+
+    return GetSimSlot(sim, sim->front);
+}
+
+// Get simulation steps run since start
+unsigned int GetSimSteps(SimThread *sim)
+{
+    return AtomicLoad(&sim->steps);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get snapshot slot memory
+static unsigned char *GetSimSlot(SimThread *sim, unsigned int index)
+{
+    return sim->slots + (size_t)index*sim->stateSize;
+}
+
+// Run simulation steps due, publishing every one
+// NOTE: Step clock restarts on activation, paused time is not caught up
+static void RunSimSteps(SimThread *sim)
+{
+    if (!AtomicLoad(&sim->active))
+    {
+        sim->stepping = false;
+        return;
+    }
+
+    double stepTime = 1.0/sim->config.stepRate;
+    double time = GetWallTime();
+
+    if (!sim->stepping)
+    {
+        sim->nextStepTime = time;
+        sim->stepping = true;
+    }
+
+    for (int i = 0; (i < sim->config.maxCatchUpSteps) && (sim->nextStepTime <= time); i++)
+    {
+        SimInput input = ReadSimInput(sim);
+
+        BeginTraceSpan("SimStep", NULL);
+        unsigned int events = sim->step(sim->state, input, sim->userData);
+        PublishSimState(sim, events);
+        EndTraceSpan();
+
+        AtomicAdd(&sim->steps, 1);
+        sim->nextStepTime += stepTime;
+    }
+
+    // NOTE: Too far behind (debugger break, main thread fallback stalled), missed steps are dropped
+    if (sim->nextStepTime <= time) sim->nextStepTime = time + stepTime;
+}
+
+// Read inputs for next step, presses are consumed
+static SimInput ReadSimInput(SimThread *sim)
+{
+    SimInput input = { 0 };
+
+    input.down = AtomicLoad(&sim->inputDown);
+
+    for (int i = 0; i < SIM_INPUT_BUTTONS; i++)
+    {
+        unsigned int presses = AtomicLoad(&sim->inputPresses[i]);
+
+        if (presses != sim->inputSeen[i])
+        {
+            input.pressed |= (1u << i);
+            sim->inputSeen[i] = presses;
+        }
+    }
+
+    return input;
+}
+
+// Copy state to back slot and swap it with shared slot
+// NOTE: Exchange is a full barrier, snapshot is complete before its slot becomes visible
+static void PublishSimState(SimThread *sim, unsigned int events)
+{
+    memcpy(GetSimSlot(sim, sim->back), sim->state, sim->stateSize);
+    sim->slotEvents[sim->back] = events | sim->carryEvents;
+
+    unsigned int previous = AtomicExchange(&sim->shared, sim->back | SIM_SLOT_FRESH);
+    sim->back = previous & SIM_SLOT_INDEX_MASK;
+
+    // Replaced snapshot was never acquired, its events go with next snapshot
+    sim->carryEvents = (previous & SIM_SLOT_FRESH)? sim->slotEvents[sim->back] : 0;
+}
+
+// Simulation thread: run steps at fixed rate, sleep while inactive
+static void SimThreadLoop(void *arg)
+{
+    SimThread *sim = (SimThread *)arg;
+
+    SetTraceThreadName("simulation");
+
+    LockMutex(&sim->mutex);
+
+    while (!sim->stop)
+    {
+        if (!AtomicLoad(&sim->active))
+        {
+            sim->stepping = false;
+            WaitCondition(&sim->wakeup, &sim->mutex);
+            continue;
+        }
+
+        double remaining = sim->stepping? (sim->nextStepTime - GetWallTime()) : 0.0;
+
+        if (remaining > 0.0) WaitConditionTimeout(&sim->wakeup, &sim->mutex, remaining);
+        else
+        {
+            UnlockMutex(&sim->mutex);
+            RunSimSteps(sim);
+            LockMutex(&sim->mutex);
+        }
+    }
+
+    UnlockMutex(&sim->mutex);
+
+    ReleaseTraceThread();
+}
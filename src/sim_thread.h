@@ -0,0 +1,132 @@
+/**********************************************************************************************
+*
+*   sim_thread - Fixed rate simulation thread, state handed to renderer with a triple buffer
+*
+*   Game simulation (player, ball, bricks, AI) runs on its own thread at a fixed step rate,
+*   main thread keeps window, inputs, audio and drawing. Simulation and drawing overlap, a
+*   render stall (driver, vsync, screenshot) no longer delays simulation steps and the other
+*   way round.
+*
+*   Simulation state is published after every step as an immutable snapshot through a
+*   lock-free triple buffer: three state copies, one owned by simulation thread (written),
+*   one owned by render thread (drawn) and one shared, swapped with a single atomic exchange.
+*   Neither side ever waits for the other, renderer always gets the latest complete step.
+*
+*   Inputs are sampled by main thread (raylib inputs are not thread-safe) and handed as
+*   buttons bitmasks: buttons down are read on every step, button presses are counted so
+*   a press is seen by exactly one step even if simulation and frame rates differ.
+*
+*   Step callback returns gameplay events flags, events raised by steps whose snapshot was
+*   never drawn are carried to the next snapshot, every event is received once.
+*
+*   NOTE: Without threads support (web without pthreads) or if thread creation fails, due
+*   simulation steps run on main thread when snapshot is acquired, game code is the same.
+*   SimThread structure must stay valid (not moved) until StopSimThread()
+*
+*   USAGE:
+*       static SimThread sim = { 0 };
+*
+*       InitBlocksGame(&game, screenWidth, screenHeight);
+*       StartSimThread(&sim, &game, sizeof(BlocksGame), StepGame, NULL, GetSimThreadConfigDefault());
+*
+*       // Every frame, main thread
+*       SetSimInput(&sim, buttonsDown, buttonsPressed);
+*       SetSimActive(&sim, (screen == SCREEN_GAMEPLAY) && !paused);
+*
+*       unsigned int events = 0;
+*       const BlocksGame *view = (const BlocksGame *)AcquireSimState(&sim, &events);
+*       if (events & BLOCKS_EVENT_BRICK_HIT) PlayGameSound(fxExplode);
+*       DrawGameplay(view);
+*
+*       StopSimThread(&sim);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include "threads.h"            // Required for: Thread, Mutex, Condition, GetWallTime()
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SIM_INPUT_BUTTONS           8       // Buttons available in inputs bitmasks
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Simulation inputs for one step
+typedef struct SimInput {
+    unsigned int down;          // Buttons down (bitmask)
+    unsigned int pressed;       // Buttons pressed since previous step (bitmask)
+} SimInput;
+
+// Simulation step callback: updates state, returns gameplay events flags
+typedef unsigned int (*SimStepFunc)(void *state, SimInput input, void *userData);
+
+// Simulation thread configuration
+typedef struct SimThreadConfig {
+    int stepRate;               // Simulation steps per second
+    int maxCatchUpSteps;        // Maximum steps run back to back when late, older ones are dropped
+} SimThreadConfig;
+
+// Simulation thread state
+// NOTE: Fields are internal, shared ones are only accessed with atomic operations
+typedef struct SimThread {
+    SimThreadConfig config;     // Simulation thread configuration
+    SimStepFunc step;           // Step callback
+    void *userData;             // Step callback user data
+    void *state;                // Simulation state (owned by simulation thread while running)
+    int stateSize;              // Simulation state size (bytes)
+
+    unsigned char *slots;       // Triple buffer: three state snapshots
+    unsigned int slotEvents[3]; // Events flags published with every snapshot
+    volatile unsigned int shared;   // Shared slot index and fresh flag (atomic)
+    unsigned int back;          // Slot written by simulation thread
+    unsigned int front;         // Slot read by render thread
+    unsigned int carryEvents;   // Events of snapshots never acquired (simulation thread)
+
+    volatile unsigned int inputDown;    // Buttons down (atomic)
+    volatile unsigned int inputPresses[SIM_INPUT_BUTTONS];  // Presses counters per button (atomic)
+    unsigned int inputSeen[SIM_INPUT_BUTTONS];  // Presses already handed to steps (simulation thread)
+
+    volatile unsigned int active;   // Steps running, otherwise simulation waits (atomic)
+    volatile unsigned int steps;    // Steps run since start (atomic)
+    bool stepping;              // Steps running on last check, step clock restarts on activation (simulation thread)
+    double nextStepTime;        // Time of next step, GetWallTime() clock (simulation thread)
+
+    Thread thread;              // Simulation thread
+    Mutex mutex;                // Sleep lock (not used for state handoff)
+    Condition wakeup;           // Signaled on activation and stop
+    bool stop;                  // Simulation thread must exit (protected by mutex)
+    bool threaded;              // Simulation runs on its own thread
+} SimThread;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+SimThreadConfig GetSimThreadConfigDefault(void);    // Get default configuration (60 steps per second)
+bool StartSimThread(SimThread *sim, void *state, int stateSize, SimStepFunc step, void *userData, SimThreadConfig config);  // Start simulation (inactive), returns false if running on main thread
+void StopSimThread(SimThread *sim);                 // Stop simulation thread and unload snapshots, state keeps last step
+
+void SetSimActive(SimThread *sim, bool active);     // Start/stop running steps (i.e. paused, not in gameplay screen)
+void SetSimInput(SimThread *sim, unsigned int down, unsigned int pressed);  // Set inputs for next steps (buttons bitmasks)
+const void *AcquireSimState(SimThread *sim, unsigned int *events);  // Get latest state snapshot (valid until next call) and events raised since previous call
+unsigned int GetSimSteps(SimThread *sim);           // Get simulation steps run since start
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SIM_THREAD_H
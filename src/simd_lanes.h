@@ -0,0 +1,143 @@
+/**********************************************************************************************
+*
+*   simd_lanes - SIMD lanes types and operations shared by batch kernels (pong_batch, enemy_policy)
+*
+*   Kernels are written once with lanes macros, instruction set is selected at compile time:
+*     - AVX2 (8 lanes): x86-64 built with -mavx2 (Makefile: BUILD_SIMD=AVX2), MSVC /arch:AVX2
+*     - NEON (4 lanes): AArch64, always available
+*     - Scalar (1 lane): any other platform, same kernel code
+*
+*   Comparisons return masks (all bits set - true, zero - false), selections take masks.
+*   No fused multiply-add is used, lanes results match scalar C code bit-for-bit.
+*
+*   NOTE: Internal header for game core modules, macros names are generic (LoadFloat(),
+*   AddFloat()...), it must not be included by games code
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SIMD_LANES_H
+#define SIMD_LANES_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(__AVX2__)
+    #include <immintrin.h>
+
+    #define SIMD_LANES_BACKEND      "AVX2"
+    #define SIMD_LANES              8
+
+    typedef __m256 LaneFloat;
+    typedef __m256i LaneInt;
+
+    #define LoadFloat(ptr)          _mm256_loadu_ps(ptr)
+    #define StoreFloat(ptr, a)      _mm256_storeu_ps(ptr, a)
+    #define LoadInt(ptr)            _mm256_loadu_si256((const __m256i *)(ptr))
+    #define StoreInt(ptr, a)        _mm256_storeu_si256((__m256i *)(ptr), a)
+    #define SetFloat(x)             _mm256_set1_ps(x)
+    #define SetInt(x)               _mm256_set1_epi32(x)
+
+    #define AddFloat(a, b)          _mm256_add_ps(a, b)
+    #define SubFloat(a, b)          _mm256_sub_ps(a, b)
+    #define MulFloat(a, b)          _mm256_mul_ps(a, b)
+    #define MaxFloat(a, b)          _mm256_max_ps(a, b)
+    #define AbsFloat(a)             _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)))
+    #define AddInt(a, b)            _mm256_add_epi32(a, b)
+    #define SubInt(a, b)            _mm256_sub_epi32(a, b)
+    #define IntToFloat(a)           _mm256_cvtepi32_ps(a)
+    #define FloatToInt(a)           _mm256_cvttps_epi32(a)        // Truncation, same as (int) cast
+
+    #define GreaterFloat(a, b)      _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ))
+    #define LessFloat(a, b)         _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ))
+    #define LessEqualFloat(a, b)    _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ))
+    #define GreaterEqualFloat(a, b) _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GE_OQ))
+    #define EqualInt(a, b)          _mm256_cmpeq_epi32(a, b)
+
+    #define AndMask(a, b)           _mm256_and_si256(a, b)
+    #define OrMask(a, b)            _mm256_or_si256(a, b)
+    #define AndNotMask(a, b)        _mm256_andnot_si256(a, b)     // ~a & b
+    #define SelectFloat(m, a, b)    _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m))
+    #define SelectInt(m, a, b)      _mm256_blendv_epi8(b, a, m)
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+
+    // NOTE: AArch64 NEON floats are IEEE compliant (denormals included), 32bit ARM NEON flushes
+    // denormals to zero and could diverge from scalar code, it uses scalar backend
+    #define SIMD_LANES_BACKEND      "NEON"
+    #define SIMD_LANES              4
+
+    typedef float32x4_t LaneFloat;
+    typedef int32x4_t LaneInt;
+
+    #define LoadFloat(ptr)          vld1q_f32(ptr)
+    #define StoreFloat(ptr, a)      vst1q_f32(ptr, a)
+    #define LoadInt(ptr)            vld1q_s32(ptr)
+    #define StoreInt(ptr, a)        vst1q_s32(ptr, a)
+    #define SetFloat(x)             vdupq_n_f32(x)
+    #define SetInt(x)               vdupq_n_s32(x)
+
+    #define AddFloat(a, b)          vaddq_f32(a, b)
+    #define SubFloat(a, b)          vsubq_f32(a, b)
+    #define MulFloat(a, b)          vmulq_f32(a, b)
+    #define MaxFloat(a, b)          vmaxq_f32(a, b)
+    #define AbsFloat(a)             vabsq_f32(a)
+    #define AddInt(a, b)            vaddq_s32(a, b)
+    #define SubInt(a, b)            vsubq_s32(a, b)
+    #define IntToFloat(a)           vcvtq_f32_s32(a)
+    #define FloatToInt(a)           vcvtq_s32_f32(a)              // Truncation, same as (int) cast
+
+    #define GreaterFloat(a, b)      vreinterpretq_s32_u32(vcgtq_f32(a, b))
+    #define LessFloat(a, b)         vreinterpretq_s32_u32(vcltq_f32(a, b))
+    #define LessEqualFloat(a, b)    vreinterpretq_s32_u32(vcleq_f32(a, b))
+    #define GreaterEqualFloat(a, b) vreinterpretq_s32_u32(vcgeq_f32(a, b))
+    #define EqualInt(a, b)          vreinterpretq_s32_u32(vceqq_s32(a, b))
+
+    #define AndMask(a, b)           vandq_s32(a, b)
+    #define OrMask(a, b)            vorrq_s32(a, b)
+    #define AndNotMask(a, b)        vbicq_s32(b, a)               // ~a & b
+    #define SelectFloat(m, a, b)    vbslq_f32(vreinterpretq_u32_s32(m), a, b)
+    #define SelectInt(m, a, b)      vbslq_s32(vreinterpretq_u32_s32(m), a, b)
+#else
+    #include <math.h>           // Required for: fabsf()
+
+    #define SIMD_LANES_BACKEND      "scalar"
+    #define SIMD_LANES              1
+
+    typedef float LaneFloat;
+    typedef int LaneInt;
+
+    #define LoadFloat(ptr)          (*(ptr))
+    #define StoreFloat(ptr, a)      (*(ptr) = (a))
+    #define LoadInt(ptr)            (*(ptr))
+    #define StoreInt(ptr, a)        (*(ptr) = (a))
+    #define SetFloat(x)             (x)
+    #define SetInt(x)               (x)
+
+    #define AddFloat(a, b)          ((a) + (b))
+    #define SubFloat(a, b)          ((a) - (b))
+    #define MulFloat(a, b)          ((a)*(b))
+    #define MaxFloat(a, b)          (((a) > (b))? (a) : (b))
+    #define AbsFloat(a)             fabsf(a)
+    #define AddInt(a, b)            ((a) + (b))
+    #define SubInt(a, b)            ((a) - (b))
+    #define IntToFloat(a)           ((float)(a))
+    #define FloatToInt(a)           ((int)(a))
+
+    #define GreaterFloat(a, b)      (((a) > (b))? -1 : 0)
+    #define LessFloat(a, b)         (((a) < (b))? -1 : 0)
+    #define LessEqualFloat(a, b)    (((a) <= (b))? -1 : 0)
+    #define GreaterEqualFloat(a, b) (((a) >= (b))? -1 : 0)
+    #define EqualInt(a, b)          (((a) == (b))? -1 : 0)
+
+    #define AndMask(a, b)           ((a) & (b))
+    #define OrMask(a, b)            ((a) | (b))
+    #define AndNotMask(a, b)        (~(a) & (b))
+    #define SelectFloat(m, a, b)    ((m)? (a) : (b))
+    #define SelectInt(m, a, b)      ((m)? (a) : (b))
+#endif
+
+#endif // SIMD_LANES_H
@@ -0,0 +1,406 @@
+/**********************************************************************************************
+*
+*   snapshot_codec - PONG network snapshots codec: quantized, delta encoded, range coded
+*
+*   NOTE: Check snapshot_codec.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "snapshot_codec.h"
+
+#include <math.h>               // Required for: floorf()
+#include <string.h>             // Required for: memcpy(), memset()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SNAPSHOT_FIELDS             8       // Integer fields coded (tick excluded)
+#define SNAPSHOT_POSITION_LIMIT     65536   // Quantized positions range: [-limit, limit], keeps worst case size bounded
+#define SNAPSHOT_VALUE_LIMIT        (1 << 24)   // Speeds and scores range: [-limit, limit]
+
+#define RANGE_PROB_BITS             12      // Static probabilities precision, probability of bit 0
+#define RANGE_PROB_HALF             (1 << (RANGE_PROB_BITS - 1))
+#define RANGE_TOP                   (1u << 24)
+#define RANGE_BUFFER_SIZE           (SNAPSHOT_MAX_SIZE + 8)     // Encoder output, flush included
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Binary range encoder (LZMA style carry handling)
+typedef struct RangeEncoder {
+    unsigned long long low;     // Interval low (33 bits, carry on bit 32)
+    unsigned int range;         // Interval size
+    unsigned char cache;        // Byte pending output, carry can still change it
+    int cacheSize;              // Pending bytes (cache + 0xFF bytes)
+    unsigned char buffer[RANGE_BUFFER_SIZE];
+    int size;                   // Bytes written
+} RangeEncoder;
+
+// Binary range decoder, bytes past the end are read as 0
+typedef struct RangeDecoder {
+    const unsigned char *data;
+    int size;
+    int offset;
+    unsigned int range;
+    unsigned int code;
+} RangeDecoder;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+
+// Keyframes baseline: new match state (InitPongGame(), 800x600 playfield), tick 0
+static const int keyframeValues[SNAPSHOT_FIELDS] = { 400, 300, 6, -4, 250, 250, 0, 0 };
+
+// Residuals coding per field: probability of 0 residual (static model) and Exp-Golomb order
+// NOTE: Measured on bot matches (pong_bots), ball and speeds are mostly predicted, paddles
+// move half of the ticks (player 8 px/tick, enemy 3 px/tick), scores rarely change
+static const unsigned short zeroProbs[SNAPSHOT_FIELDS] = { 3968, 3968, 3968, 4000, 2048, 1536, 4088, 4088 };
+static const int golombOrders[SNAPSHOT_FIELDS] = { 2, 2, 3, 2, 3, 1, 10, 10 };
+
+#define KEYFRAME_FLAG_PROB      4064        // Probability of delta snapshot
+#define TICK_AGE_ORDER          0           // Ticks since baseline: mostly 1..3
+#define TICK_KEYFRAME_ORDER     8
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void GetSnapshotValues(const PongSnapshot *snapshot, int *values);      // Get snapshot integer fields
+static void SetSnapshotValues(PongSnapshot *snapshot, const int *values);      // Set snapshot fields from integers
+static void GetPredictedValues(const PongSnapshot *baseline, unsigned int age, int *values);   // Get fields predicted from baseline (NULL: keyframe)
+
+static void EncodeBit(RangeEncoder *encoder, int bit, unsigned int prob);      // Encode bit with probability of 0
+static void EncodeGolomb(RangeEncoder *encoder, unsigned int value, int order);    // Encode Exp-Golomb value, equiprobable bits
+static void ShiftLow(RangeEncoder *encoder);    // Output interval top byte (carry resolved)
+static int FlushEncoder(RangeEncoder *encoder, unsigned char *data);          // Finish with shortest tail, returns size
+
+static int DecodeBit(RangeDecoder *decoder, unsigned int prob);               // Decode bit with probability of 0
+static unsigned int DecodeGolomb(RangeDecoder *decoder, int order);          // Decode Exp-Golomb value
+static unsigned char ReadByte(RangeDecoder *decoder);                         // Read next byte (0 past the end)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Round positions to playfield pixels
+void QuantizePongSnapshot(PongSnapshot *snapshot)
+{
+    float *positions[4] = { &snapshot->ballX, &snapshot->ballY, &snapshot->playerY, &snapshot->enemyY };
+
+    for (int i = 0; i < 4; i++)
+    {
+        float value = floorf(*positions[i] + 0.5f);
+
+        if (value < -SNAPSHOT_POSITION_LIMIT) value = -SNAPSHOT_POSITION_LIMIT;
+        else if (value > SNAPSHOT_POSITION_LIMIT) value = SNAPSHOT_POSITION_LIMIT;
+
+        *positions[i] = value;
+    }
+
+    int *values[4] = { &snapshot->ballSpeedX, &snapshot->ballSpeedY, &snapshot->playerScore, &snapshot->enemyScore };
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (*values[i] < -SNAPSHOT_VALUE_LIMIT) *values[i] = -SNAPSHOT_VALUE_LIMIT;
+        else if (*values[i] > SNAPSHOT_VALUE_LIMIT) *values[i] = SNAPSHOT_VALUE_LIMIT;
+    }
+}
+
+// Encode quantized snapshot against baseline
+// NOTE: Baselines not older than snapshot or older than history are not used (keyframe)
+int EncodePongSnapshot(const PongSnapshot *snapshot, const PongSnapshot *baseline, unsigned char *data)
+{
+    RangeEncoder encoder = { 0 };
+    encoder.range = 0xFFFFFFFF;
+    encoder.cacheSize = 1;
+
+    unsigned int age = (baseline != NULL)? snapshot->tick - baseline->tick : 0;
+    if ((age == 0) || (age >= SNAPSHOT_HISTORY)) baseline = NULL;
+
+    int values[SNAPSHOT_FIELDS] = { 0 };
+    int predicted[SNAPSHOT_FIELDS] = { 0 };
+
+    GetSnapshotValues(snapshot, values);
+    GetPredictedValues(baseline, age, predicted);
+
+    EncodeBit(&encoder, (baseline == NULL), KEYFRAME_FLAG_PROB);
+
+    if (baseline == NULL) EncodeGolomb(&encoder, snapshot->tick, TICK_KEYFRAME_ORDER);
+    else
+    {
+        for (int i = 7; i >= 0; i--) EncodeBit(&encoder, (snapshot->tick >> i) & 1, RANGE_PROB_HALF);
+        EncodeGolomb(&encoder, age - 1, TICK_AGE_ORDER);
+    }
+
+    for (int i = 0; i < SNAPSHOT_FIELDS; i++)
+    {
+        int residual = values[i] - predicted[i];
+
+        EncodeBit(&encoder, (residual != 0), zeroProbs[i]);
+
+        if (residual != 0)
+        {
+            EncodeBit(&encoder, (residual < 0), RANGE_PROB_HALF);
+            EncodeGolomb(&encoder, (unsigned int)((residual < 0)? -residual : residual) - 1, golombOrders[i]);
+        }
+    }
+
+    return FlushEncoder(&encoder, data);
+}
+
+// Decode snapshot
+// NOTE: Delta snapshot tick is the one closest to history latest tick with same low 8 bits
+bool DecodePongSnapshot(const unsigned char *data, int size, const SnapshotHistory *history, PongSnapshot *snapshot)
+{
+    RangeDecoder decoder = { data, size, 0, 0xFFFFFFFF, 0 };
+    for (int i = 0; i < 4; i++) decoder.code = (decoder.code << 8) | ReadByte(&decoder);
+
+    const PongSnapshot *baseline = NULL;
+    unsigned int tick = 0;
+    unsigned int age = 0;
+
+    if (DecodeBit(&decoder, KEYFRAME_FLAG_PROB)) tick = DecodeGolomb(&decoder, TICK_KEYFRAME_ORDER);
+    else
+    {
+        unsigned int tickLow = 0;
+        for (int i = 0; i < 8; i++) tickLow = (tickLow << 1) | DecodeBit(&decoder, RANGE_PROB_HALF);
+
+        age = DecodeGolomb(&decoder, TICK_AGE_ORDER) + 1;
+        tick = history->latestTick + (unsigned int)(signed char)(tickLow - (history->latestTick & 0xFF));
+
+        baseline = GetSnapshotHistory(history, tick - age);
+        if ((baseline == NULL) || (age >= SNAPSHOT_HISTORY)) return false;
+    }
+
+    int values[SNAPSHOT_FIELDS] = { 0 };
+    GetPredictedValues(baseline, age, values);
+
+    for (int i = 0; i < SNAPSHOT_FIELDS; i++)
+    {
+        if (DecodeBit(&decoder, zeroProbs[i]))
+        {
+            bool negative = DecodeBit(&decoder, RANGE_PROB_HALF);
+            int magnitude = (int)DecodeGolomb(&decoder, golombOrders[i]) + 1;
+
+            values[i] += negative? -magnitude : magnitude;
+        }
+    }
+
+    memset(snapshot, 0, sizeof(PongSnapshot));
+    snapshot->tick = tick;
+    SetSnapshotValues(snapshot, values);
+
+    return true;
+}
+
+// Check encoded snapshot is a keyframe
+bool IsSnapshotKeyframe(const unsigned char *data, int size)
+{
+    RangeDecoder decoder = { data, size, 0, 0xFFFFFFFF, 0 };
+    for (int i = 0; i < 4; i++) decoder.code = (decoder.code << 8) | ReadByte(&decoder);
+
+    return DecodeBit(&decoder, KEYFRAME_FLAG_PROB);
+}
+
+// Store snapshot
+void StoreSnapshotHistory(SnapshotHistory *history, const PongSnapshot *snapshot)
+{
+    if (snapshot->tick == 0) return;
+
+    // Snapshots older than history are dropped, they would overwrite newer ones
+    if ((history->latestTick != 0) && ((int)(history->latestTick - snapshot->tick) >= SNAPSHOT_HISTORY)) return;
+
+    history->snapshots[snapshot->tick%SNAPSHOT_HISTORY] = *snapshot;
+    if ((int)(snapshot->tick - history->latestTick) > 0) history->latestTick = snapshot->tick;
+}
+
+// Get stored snapshot
+const PongSnapshot *GetSnapshotHistory(const SnapshotHistory *history, unsigned int tick)
+{
+    const PongSnapshot *snapshot = &history->snapshots[tick%SNAPSHOT_HISTORY];
+
+    if ((tick == 0) || (snapshot->tick != tick)) return NULL;
+
+    return snapshot;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get snapshot integer fields
+// NOTE: Quantized positions are integer values
+static void GetSnapshotValues(const PongSnapshot *snapshot, int *values)
+{
+    values[0] = (int)snapshot->ballX;
+    values[1] = (int)snapshot->ballY;
+    values[2] = snapshot->ballSpeedX;
+    values[3] = snapshot->ballSpeedY;
+    values[4] = (int)snapshot->playerY;
+    values[5] = (int)snapshot->enemyY;
+    values[6] = snapshot->playerScore;
+    values[7] = snapshot->enemyScore;
+}
+
+// Set snapshot fields from integers
+static void SetSnapshotValues(PongSnapshot *snapshot, const int *values)
+{
+    snapshot->ballX = (float)values[0];
+    snapshot->ballY = (float)values[1];
+    snapshot->ballSpeedX = values[2];
+    snapshot->ballSpeedY = values[3];
+    snapshot->playerY = (float)values[4];
+    snapshot->enemyY = (float)values[5];
+    snapshot->playerScore = values[6];
+    snapshot->enemyScore = values[7];
+}
+
+// Get fields predicted from baseline
+// NOTE: Ball keeps moving at baseline speed, bounces since baseline are residuals
+static void GetPredictedValues(const PongSnapshot *baseline, unsigned int age, int *values)
+{
+    if (baseline == NULL)
+    {
+        memcpy(values, keyframeValues, sizeof(keyframeValues));
+        return;
+    }
+
+    GetSnapshotValues(baseline, values);
+
+    values[0] += baseline->ballSpeedX*(int)age;
+    values[1] += baseline->ballSpeedY*(int)age;
+}
+
+// Encode bit with probability of 0
+static void EncodeBit(RangeEncoder *encoder, int bit, unsigned int prob)
+{
+    unsigned int bound = (encoder->range >> RANGE_PROB_BITS)*prob;
+
+    if (bit == 0) encoder->range = bound;
+    else
+    {
+        encoder->low += bound;
+        encoder->range -= bound;
+    }
+
+    while (encoder->range < RANGE_TOP)
+    {
+        encoder->range <<= 8;
+        ShiftLow(encoder);
+    }
+}
+
+// Encode Exp-Golomb value: unary prefix (extra bits count), then value bits
+static void EncodeGolomb(RangeEncoder *encoder, unsigned int value, int order)
+{
+    unsigned long long shifted = (unsigned long long)value + (1ull << order);
+    int bits = 0;
+    while ((shifted >> (bits + 1)) != 0) bits++;
+
+    for (int i = order; i < bits; i++) EncodeBit(encoder, 1, RANGE_PROB_HALF);
+    EncodeBit(encoder, 0, RANGE_PROB_HALF);
+
+    for (int i = bits - 1; i >= 0; i--) EncodeBit(encoder, (int)((shifted >> i) & 1), RANGE_PROB_HALF);
+}
+
+// Output interval top byte
+// NOTE: 0xFF bytes are held back until no carry can change them
+static void ShiftLow(RangeEncoder *encoder)
+{
+    if (((unsigned int)encoder->low < 0xFF000000) || ((encoder->low >> 32) != 0))
+    {
+        unsigned char carry = (unsigned char)(encoder->low >> 32);
+        unsigned char temp = encoder->cache;
+
+        do
+        {
+            if (encoder->size < RANGE_BUFFER_SIZE) encoder->buffer[encoder->size] = temp + carry;
+            encoder->size++;
+            temp = 0xFF;
+        } while (--encoder->cacheSize != 0);
+
+        encoder->cache = (unsigned char)(encoder->low >> 24);
+    }
+
+    encoder->cacheSize++;
+    encoder->low = (encoder->low & 0x00FFFFFF) << 8;
+}
+
+// Finish with shortest tail
+// NOTE: Final value is the one in interval with most trailing zero bytes, decoder reads
+// missing bytes as 0, so trailing zeros are not stored, first byte is always 0 (skipped)
+static int FlushEncoder(RangeEncoder *encoder, unsigned char *data)
+{
+    for (int bytes = 1; bytes <= 4; bytes++)
+    {
+        unsigned long long mask = (1ull << (32 - 8*bytes)) - 1;
+        unsigned long long value = (encoder->low + mask) & ~mask;
+
+        if (value <= (encoder->low + encoder->range - 1))
+        {
+            encoder->low = value;
+            break;
+        }
+    }
+
+    for (int i = 0; i < 5; i++) ShiftLow(encoder);
+
+    int size = encoder->size;
+    while ((size > 1) && (encoder->buffer[size - 1] == 0)) size--;
+
+    size -= 1;
+    if (size > SNAPSHOT_MAX_SIZE) size = SNAPSHOT_MAX_SIZE;     // NOTE: Not reachable with quantized limits
+    memcpy(data, encoder->buffer + 1, size);
+
+    return size;
+}
+
+// Decode bit with probability of 0
+static int DecodeBit(RangeDecoder *decoder, unsigned int prob)
+{
+    unsigned int bound = (decoder->range >> RANGE_PROB_BITS)*prob;
+    int bit = 0;
+
+    if (decoder->code < bound) decoder->range = bound;
+    else
+    {
+        decoder->code -= bound;
+        decoder->range -= bound;
+        bit = 1;
+    }
+
+    while (decoder->range < RANGE_TOP)
+    {
+        decoder->range <<= 8;
+        decoder->code = (decoder->code << 8) | ReadByte(decoder);
+    }
+
+    return bit;
+}
+
+// Decode Exp-Golomb value
+// NOTE: Prefix is limited, corrupted data can not loop or overflow
+static unsigned int DecodeGolomb(RangeDecoder *decoder, int order)
+{
+    int bits = order;
+    while (DecodeBit(decoder, RANGE_PROB_HALF) && (bits < 32)) bits++;     // Prefix end bit is read at 32 bits too (encoder writes it)
+
+    unsigned long long shifted = 1;
+    for (int i = 0; i < bits; i++) shifted = (shifted << 1) | (unsigned int)DecodeBit(decoder, RANGE_PROB_HALF);
+
+    return (unsigned int)(shifted - (1ull << order));
+}
+
+// Read next byte
+static unsigned char ReadByte(RangeDecoder *decoder)
+{
+    unsigned char value = (decoder->offset < decoder->size)? decoder->data[decoder->offset] : 0;
+    decoder->offset++;
+
+    return value;
+}
@@ -0,0 +1,85 @@
+/**********************************************************************************************
+*
+*   snapshot_codec - PONG network snapshots codec: quantized, delta encoded, range coded
+*
+*   Match states are sent every tick, most fields do not change or change as predicted.
+*   Snapshots are encoded against the last snapshot acknowledged by the client (baseline):
+*
+*     1. Quantization: positions rounded to playfield pixels, all fields become integers
+*     2. Prediction: ball position predicted from baseline position and speed (ticks elapsed),
+*        other fields predicted as baseline ones, residuals = value - prediction
+*     3. Binarization: per field zero flag, sign and Exp-Golomb magnitude (order per field)
+*     4. Range coding: binary range coder with static probabilities (no state between
+*        packets, datagrams can be lost or reordered), flush trimmed to the shortest tail
+*
+*   No baseline (first snapshots, baseline too old) -> keyframe: residuals against a new
+*   match state (InitPongGame()), same coding. Typical delta snapshot: 3..4 bytes, keyframe:
+*   about 6 bytes vs 28 bytes fixed layout (check tools/snapshot_codec_bench.c).
+*
+*   ENCODED LAYOUT (range coded bits):
+*       keyframe flag
+*       keyframe: tick (Exp-Golomb) | delta: tick low 8 bits, ticks since baseline (Exp-Golomb)
+*       8 fields residuals: ballX, ballY, ballSpeedX, ballSpeedY, playerY, enemyY, playerScore, enemyScore
+*
+*   NOTE: Decoder finds baseline in its history by tick low bits, snapshots history must keep
+*   last SNAPSHOT_HISTORY ticks received (check StoreSnapshotHistory()), encoder only uses
+*   baselines less than SNAPSHOT_HISTORY ticks old
+*
+*   USAGE:
+*       // Server, every tick and client
+*       PongSnapshot snapshot = GetPongSnapshot(&game, tick);
+*       QuantizePongSnapshot(&snapshot);
+*       StoreSnapshotHistory(&history, &snapshot);
+*       int size = EncodePongSnapshot(&snapshot, GetSnapshotHistory(&history, clientAck), data);
+*
+*       // Client, every datagram
+*       if (DecodePongSnapshot(data, size, &history, &snapshot)) StoreSnapshotHistory(&history, &snapshot);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include "raylib.h"
+#include "pong_net.h"           // Required for: PongSnapshot
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SNAPSHOT_HISTORY        16      // Snapshots kept for baselines (ticks), power of 2
+#define SNAPSHOT_MAX_SIZE       PONG_NET_MAX_PAYLOAD    // Maximum encoded snapshot size (bytes), extreme values keyframe: 51 bytes
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Snapshots history, indexed by tick
+typedef struct SnapshotHistory {
+    PongSnapshot snapshots[SNAPSHOT_HISTORY];   // Slot: tick%SNAPSHOT_HISTORY (tick 0 - empty)
+    unsigned int latestTick;    // Latest tick stored, 0 if empty
+} SnapshotHistory;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void QuantizePongSnapshot(PongSnapshot *snapshot);      // Round positions to playfield pixels (values sent to clients)
+int EncodePongSnapshot(const PongSnapshot *snapshot, const PongSnapshot *baseline, unsigned char *data);   // Encode quantized snapshot against baseline (NULL: keyframe), returns size
+bool DecodePongSnapshot(const unsigned char *data, int size, const SnapshotHistory *history, PongSnapshot *snapshot);   // Decode snapshot, returns false if baseline not in history
+bool IsSnapshotKeyframe(const unsigned char *data, int size);  // Check encoded snapshot is a keyframe
+
+void StoreSnapshotHistory(SnapshotHistory *history, const PongSnapshot *snapshot);     // Store snapshot (older ticks than latest are stored too)
+const PongSnapshot *GetSnapshotHistory(const SnapshotHistory *history, unsigned int tick);  // Get stored snapshot, NULL if not available
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SNAPSHOT_CODEC_H
@@ -0,0 +1,797 @@
+/**********************************************************************************************
+*
+*   softrender - CPU software rasterizer for the drawing subset used by games
+*
+*   NOTE: Check softrender.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "softrender.h"
+
+#include <stdlib.h>             // Required for: calloc(), free()
+#include <string.h>             // Required for: memcpy()
+#include <math.h>               // Required for: ceilf(), floorf(), sqrtf()
+
+#if !defined(SOFTRENDER_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>  // SSE2 intrinsics
+        #define SOFTRENDER_SSE2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>   // NEON intrinsics
+        #define SOFTRENDER_NEON
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SOFT_FONT_FIRST_CHAR        32      // First character in image fonts (raylib default)
+#define SOFT_FONT_GLYPHS_COUNT      95      // Glyphs loaded from TTF fonts (ASCII 32..126, raylib default)
+#define SOFT_FONT_GLYPHS_PADDING     4      // Glyphs padding in TTF atlas (raylib default)
+#define SOFT_FONT_MAX_IMAGE_GLYPHS 256      // Maximum glyphs in image fonts
+#define SOFT_FONT_DEFAULT_SIZE      10      // Default font size (raylib default font)
+
+#define COLOR_EQUAL(col1, col2) ((col1.r == col2.r) && (col1.g == col2.g) && (col1.b == col2.b) && (col1.a == col2.a))
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static SoftFramebuffer *target = NULL;              // Current framebuffer to draw into
+static SoftFont fontDefault = { 0 };                // Font used by SoftDrawText()
+static Color spanBuffer[SOFTRENDER_MAX_WIDTH];      // Texels gathered for one span (scaled textures)
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static inline unsigned int MulDiv255(unsigned int x);                       // Compute round(x/255) for x in [0..65025]
+static void FillSpan(Color *dst, int count, Color color);                   // Fill span with color, blended
+static void BlendSpan(Color *dst, const Color *src, int count, Color tint);  // Blend tinted texels span
+static void GetCoveredRange(float start, float size, int limit, int *first, int *last); // Get pixels covered by [start, start + size)
+static SoftFont LoadSoftFontFromImage(Image image, Color key, int firstChar);   // Load image font, glyphs separated by key color
+static int GetSoftGlyphIndex(SoftFont font, int codepoint);                 // Get glyph index for codepoint ('?' if not found)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Framebuffer management
+//----------------------------------------------------------------------------------
+
+// Load framebuffer
+SoftFramebuffer LoadSoftFramebuffer(int width, int height)
+{
+    SoftFramebuffer target = { 0 };
+
+    if ((width <= 0) || (height <= 0) || (width > SOFTRENDER_MAX_WIDTH))
+    {
+        TraceLog(LOG_WARNING, "SOFTRENDER: Framebuffer size not supported (%ix%i)", width, height);
+        return target;
+    }
+
+    target.pixels = (Color *)RL_CALLOC(width*height, sizeof(Color));
+
+    if (target.pixels != NULL)
+    {
+        target.width = width;
+        target.height = height;
+    }
+
+    return target;
+}
+
+// Unload framebuffer
+void UnloadSoftFramebuffer(SoftFramebuffer target)
+{
+    RL_FREE(target.pixels);
+}
+
+// Export framebuffer to image file
+// NOTE: Alpha is forced to 255, same as raylib screenshots (no transparent images)
+bool ExportSoftFramebuffer(SoftFramebuffer target, const char *fileName)
+{
+    if (target.pixels == NULL) return false;
+
+    Image image = { 0 };
+    image.data = RL_MALLOC(target.width*target.height*sizeof(Color));
+    image.width = target.width;
+    image.height = target.height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    if (image.data == NULL) return false;
+
+    Color *pixels = (Color *)image.data;
+    memcpy(pixels, target.pixels, target.width*target.height*sizeof(Color));
+    for (int i = 0; i < target.width*target.height; i++) pixels[i].a = 255;
+
+    bool success = ExportImage(image, fileName);
+
+    RL_FREE(image.data);
+
+    return success;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Textures and fonts loading
+//----------------------------------------------------------------------------------
+
+// Load texture from image file
+SoftTexture LoadSoftTexture(const char *fileName)
+{
+    Image image = LoadImage(fileName);
+    SoftTexture texture = LoadSoftTextureFromImage(image);
+    UnloadImage(image);
+
+    return texture;
+}
+
+// Load texture from image data
+SoftTexture LoadSoftTextureFromImage(Image image)
+{
+    SoftTexture texture = { 0 };
+
+    if ((image.data == NULL) || (image.width <= 0) || (image.height <= 0)) return texture;
+
+    // NOTE: LoadImageColors() converts any pixel format to RGBA8 (allocated with RL_MALLOC)
+    texture.pixels = LoadImageColors(image);
+
+    if (texture.pixels != NULL)
+    {
+        texture.width = image.width;
+        texture.height = image.height;
+    }
+
+    return texture;
+}
+
+// Unload texture
+void UnloadSoftTexture(SoftTexture texture)
+{
+    UnloadImageColors(texture.pixels);
+}
+
+// Load font
+// NOTE: Same loading process as raylib LoadFontEx()/LoadFont() without GPU texture upload
+SoftFont LoadSoftFont(const char *fileName, int fontSize)
+{
+    SoftFont font = { 0 };
+
+    if (IsFileExtension(fileName, ".ttf;.otf"))
+    {
+        unsigned int fileSize = 0;
+        unsigned char *fileData = LoadFileData(fileName, &fileSize);
+
+        if (fileData != NULL)
+        {
+            GlyphInfo *glyphs = LoadFontData(fileData, fileSize, fontSize, NULL, SOFT_FONT_GLYPHS_COUNT, FONT_DEFAULT);
+
+            if (glyphs != NULL)
+            {
+                font.baseSize = fontSize;
+                font.glyphCount = SOFT_FONT_GLYPHS_COUNT;
+                font.glyphPadding = SOFT_FONT_GLYPHS_PADDING;
+
+                Image atlas = GenImageFontAtlas(glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 0);
+                font.atlas = LoadSoftTextureFromImage(atlas);
+                UnloadImage(atlas);
+
+                // Glyphs images are already in atlas, only metrics are kept
+                font.glyphs = (GlyphInfo *)RL_CALLOC(font.glyphCount, sizeof(GlyphInfo));
+                for (int i = 0; i < font.glyphCount; i++)
+                {
+                    font.glyphs[i] = glyphs[i];
+                    font.glyphs[i].image = (Image){ 0 };
+                }
+
+                UnloadFontData(glyphs, SOFT_FONT_GLYPHS_COUNT);
+            }
+
+            UnloadFileData(fileData);
+        }
+    }
+    else
+    {
+        Image image = LoadImage(fileName);
+        if (image.data != NULL) font = LoadSoftFontFromImage(image, MAGENTA, SOFT_FONT_FIRST_CHAR);
+        UnloadImage(image);
+    }
+
+    if (font.atlas.pixels != NULL) TraceLog(LOG_INFO, "SOFTRENDER: [%s] Font loaded successfully (%i glyphs, base size: %i)", fileName, font.glyphCount, font.baseSize);
+    else TraceLog(LOG_WARNING, "SOFTRENDER: [%s] Failed to load font", fileName);
+
+    return font;
+}
+
+// Unload font
+void UnloadSoftFont(SoftFont font)
+{
+    UnloadSoftTexture(font.atlas);
+    RL_FREE(font.recs);
+    RL_FREE(font.glyphs);
+}
+
+// Set font used by SoftDrawText() and SoftMeasureText()
+// NOTE: raylib default font can not be retrieved without a GPU context, games must provide one
+void SetSoftFontDefault(SoftFont font)
+{
+    fontDefault = font;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Drawing
+//----------------------------------------------------------------------------------
+
+// Set framebuffer to draw into
+void BeginSoftDrawing(SoftFramebuffer *framebuffer)
+{
+    target = framebuffer;
+}
+
+// End drawing into framebuffer
+void EndSoftDrawing(void)
+{
+    target = NULL;
+}
+
+// Set all framebuffer pixels to color
+// NOTE: Color is written, not blended, same as glClear()
+void SoftClearBackground(Color color)
+{
+    if ((target == NULL) || (target->pixels == NULL)) return;
+
+    Color opaque = color;
+    opaque.a = 255;
+
+    Color *pixels = target->pixels;
+    int count = target->width*target->height;
+
+    FillSpan(pixels, count, opaque);
+
+    if (color.a != 255) for (int i = 0; i < count; i++) pixels[i].a = color.a;
+}
+
+// Draw a color-filled rectangle
+void SoftDrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    SoftDrawRectangleRec((Rectangle){ (float)posX, (float)posY, (float)width, (float)height }, color);
+}
+
+// Draw a color-filled rectangle
+void SoftDrawRectangleRec(Rectangle rec, Color color)
+{
+    if ((target == NULL) || (target->pixels == NULL) || (color.a == 0)) return;
+
+    int x0, x1, y0, y1;
+    GetCoveredRange(rec.x, rec.width, target->width, &x0, &x1);
+    GetCoveredRange(rec.y, rec.height, target->height, &y0, &y1);
+
+    for (int y = y0; y < y1; y++) FillSpan(target->pixels + y*target->width + x0, x1 - x0, color);
+}
+
+// Draw a color-filled circle
+// NOTE: Covered pixels are computed per row, one span per row
+void SoftDrawCircleV(Vector2 center, float radius, Color color)
+{
+    if ((target == NULL) || (target->pixels == NULL) || (color.a == 0) || (radius <= 0.0f)) return;
+
+    int y0, y1;
+    GetCoveredRange(center.y - radius, 2.0f*radius, target->height, &y0, &y1);
+
+    for (int y = y0; y < y1; y++)
+    {
+        float dy = (float)y + 0.5f - center.y;
+        float dx2 = radius*radius - dy*dy;
+
+        if (dx2 < 0.0f) continue;
+
+        float dx = sqrtf(dx2);
+
+        int x0, x1;
+        GetCoveredRange(center.x - dx, 2.0f*dx, target->width, &x0, &x1);
+
+        FillSpan(target->pixels + y*target->width + x0, x1 - x0, color);
+    }
+}
+
+// Draw a 1px line
+// NOTE: Bresenham algorithm, end point excluded (same as OpenGL lines)
+void SoftDrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color)
+{
+    if ((target == NULL) || (target->pixels == NULL) || (color.a == 0)) return;
+
+    // Vertical and horizontal lines are spans or columns, common case (i.e. pong field lines)
+    if (startPosY == endPosY)
+    {
+        if ((startPosY < 0) || (startPosY >= target->height)) return;
+
+        int x0 = (startPosX < endPosX)? startPosX : endPosX + 1;
+        int x1 = (startPosX < endPosX)? endPosX : startPosX + 1;
+        if (x0 < 0) x0 = 0;
+        if (x1 > target->width) x1 = target->width;
+
+        if (x1 > x0) FillSpan(target->pixels + startPosY*target->width + x0, x1 - x0, color);
+        return;
+    }
+
+    int dx = abs(endPosX - startPosX);
+    int dy = -abs(endPosY - startPosY);
+    int sx = (startPosX < endPosX)? 1 : -1;
+    int sy = (startPosY < endPosY)? 1 : -1;
+    int error = dx + dy;
+    int x = startPosX;
+    int y = startPosY;
+
+    while ((x != endPosX) || (y != endPosY))
+    {
+        if ((x >= 0) && (x < target->width) && (y >= 0) && (y < target->height)) FillSpan(target->pixels + y*target->width + x, 1, color);
+
+        int e2 = 2*error;
+        if (e2 >= dy) { error += dy; x += sx; }
+        if (e2 <= dx) { error += dx; y += sy; }
+    }
+}
+
+// Draw a texture
+void SoftDrawTexture(SoftTexture texture, int posX, int posY, Color tint)
+{
+    SoftDrawTextureEx(texture, (Vector2){ (float)posX, (float)posY }, 0.0f, 1.0f, tint);
+}
+
+// Draw a texture with scale
+void SoftDrawTextureEx(SoftTexture texture, Vector2 position, float rotation, float scale, Color tint)
+{
+    if (rotation != 0.0f) TraceLog(LOG_DEBUG, "SOFTRENDER: Texture rotation not supported, drawn without rotation");
+
+    Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    Rectangle dest = { position.x, position.y, (float)texture.width*scale, (float)texture.height*scale };
+
+    SoftDrawTextureRec(texture, source, dest, tint);
+}
+
+// Draw part of a texture scaled into dest rectangle
+// NOTE: Nearest sampling at pixel centers, same as TEXTURE_FILTER_POINT
+void SoftDrawTextureRec(SoftTexture texture, Rectangle source, Rectangle dest, Color tint)
+{
+    if ((target == NULL) || (target->pixels == NULL) || (texture.pixels == NULL) || (tint.a == 0)) return;
+    if ((source.width <= 0.0f) || (source.height <= 0.0f) || (dest.width <= 0.0f) || (dest.height <= 0.0f)) return;
+
+    int x0, x1, y0, y1;
+    GetCoveredRange(dest.x, dest.width, target->width, &x0, &x1);
+    GetCoveredRange(dest.y, dest.height, target->height, &y0, &y1);
+
+    if ((x1 <= x0) || (y1 <= y0)) return;
+
+    float stepU = source.width/dest.width;
+    float stepV = source.height/dest.height;
+
+    // Texels are contiguous in source row when texture is not scaled horizontally
+    bool contiguous = (stepU == 1.0f);
+    int u0 = (int)floorf(source.x + ((float)x0 + 0.5f - dest.x));
+
+    if (contiguous && ((u0 < 0) || ((u0 + x1 - x0) > texture.width))) contiguous = false;
+
+    for (int y = y0; y < y1; y++)
+    {
+        int v = (int)floorf(source.y + ((float)y + 0.5f - dest.y)*stepV);
+        if (v < 0) v = 0;
+        else if (v >= texture.height) v = texture.height - 1;
+
+        const Color *row = texture.pixels + v*texture.width;
+        const Color *texels = NULL;
+
+        if (contiguous) texels = row + u0;
+        else
+        {
+            for (int x = x0; x < x1; x++)
+            {
+                int u = (int)floorf(source.x + ((float)x + 0.5f - dest.x)*stepU);
+                if (u < 0) u = 0;
+                else if (u >= texture.width) u = texture.width - 1;
+
+                spanBuffer[x - x0] = row[u];
+            }
+
+            texels = spanBuffer;
+        }
+
+        BlendSpan(target->pixels + y*target->width + x0, texels, x1 - x0, tint);
+    }
+}
+
+// Draw text using default soft font
+// NOTE: Same spacing as raylib DrawText()
+void SoftDrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    if (fontDefault.atlas.pixels == NULL) return;
+
+    if (fontSize < SOFT_FONT_DEFAULT_SIZE) fontSize = SOFT_FONT_DEFAULT_SIZE;
+    int spacing = fontSize/SOFT_FONT_DEFAULT_SIZE;
+
+    SoftDrawTextEx(fontDefault, text, (Vector2){ (float)posX, (float)posY }, (float)fontSize, (float)spacing, color);
+}
+
+// Draw text using font and additional parameters
+// NOTE: Same glyphs layout as raylib DrawTextEx(), text is processed as ASCII
+void SoftDrawTextEx(SoftFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    if ((text == NULL) || (font.atlas.pixels == NULL)) return;
+
+    float scaleFactor = fontSize/(float)font.baseSize;
+    float textOffsetX = 0.0f;
+    float textOffsetY = 0.0f;
+
+    for (int i = 0; text[i] != '\0'; i++)
+    {
+        int codepoint = (unsigned char)text[i];
+
+        if (codepoint == '\n')
+        {
+            textOffsetY += (float)((int)((font.baseSize + font.baseSize/2)*scaleFactor));
+            textOffsetX = 0.0f;
+            continue;
+        }
+
+        int index = GetSoftGlyphIndex(font, codepoint);
+
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            float padding = (float)font.glyphPadding;
+            Rectangle rec = font.recs[index];
+
+            Rectangle source = { rec.x - padding, rec.y - padding, rec.width + 2.0f*padding, rec.height + 2.0f*padding };
+            Rectangle dest = { position.x + textOffsetX + font.glyphs[index].offsetX*scaleFactor - padding*scaleFactor,
+                               position.y + textOffsetY + font.glyphs[index].offsetY*scaleFactor - padding*scaleFactor,
+                               source.width*scaleFactor, source.height*scaleFactor };
+
+            SoftDrawTextureRec(font.atlas, source, dest, tint);
+        }
+
+        if (font.glyphs[index].advanceX == 0) textOffsetX += (font.recs[index].width*scaleFactor + spacing);
+        else textOffsetX += ((float)font.glyphs[index].advanceX*scaleFactor + spacing);
+    }
+}
+
+// Measure text width for default soft font
+int SoftMeasureText(const char *text, int fontSize)
+{
+    if ((text == NULL) || (fontDefault.atlas.pixels == NULL)) return 0;
+
+    if (fontSize < SOFT_FONT_DEFAULT_SIZE) fontSize = SOFT_FONT_DEFAULT_SIZE;
+    int spacing = fontSize/SOFT_FONT_DEFAULT_SIZE;
+
+    return (int)SoftMeasureTextEx(fontDefault, text, (float)fontSize, (float)spacing).x;
+}
+
+// Measure text size for font
+// NOTE: Same measure as raylib MeasureTextEx()
+Vector2 SoftMeasureTextEx(SoftFont font, const char *text, float fontSize, float spacing)
+{
+    Vector2 size = { 0 };
+
+    if ((text == NULL) || (font.atlas.pixels == NULL)) return size;
+
+    float scaleFactor = fontSize/(float)font.baseSize;
+    float textWidth = 0.0f;
+    float maxTextWidth = 0.0f;
+    float textHeight = (float)font.baseSize;
+    int lineLength = 0;
+    int maxLineLength = 0;
+
+    for (int i = 0; text[i] != '\0'; i++)
+    {
+        int codepoint = (unsigned char)text[i];
+
+        if (codepoint == '\n')
+        {
+            if (textWidth > maxTextWidth) maxTextWidth = textWidth;
+            if (lineLength > maxLineLength) maxLineLength = lineLength;
+            textWidth = 0.0f;
+            lineLength = 0;
+            textHeight += (float)font.baseSize*1.5f;
+            continue;
+        }
+
+        int index = GetSoftGlyphIndex(font, codepoint);
+
+        if (font.glyphs[index].advanceX != 0) textWidth += (float)font.glyphs[index].advanceX;
+        else textWidth += (font.recs[index].width + (float)font.glyphs[index].offsetX);
+
+        lineLength++;
+    }
+
+    if (textWidth > maxTextWidth) maxTextWidth = textWidth;
+    if (lineLength > maxLineLength) maxLineLength = lineLength;
+
+    size.x = maxTextWidth*scaleFactor + (float)((maxLineLength - 1)*spacing);
+    size.y = textHeight*scaleFactor;
+
+    return size;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Compute round(x/255) for x in [0..65025], exact, no division
+// NOTE: Same operations used by SIMD kernels, keep them in sync
+static inline unsigned int MulDiv255(unsigned int x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+#if defined(SOFTRENDER_SSE2)
+// Compute round(x/255) for 8 x 16bit lanes
+static inline __m128i Div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Replicate alpha lane of 2 pixels (16bit channels) into all channels
+static inline __m128i BroadcastAlphax8(__m128i x)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+#endif
+
+#if defined(SOFTRENDER_NEON)
+// Compute round(x/255) for 8 x 16bit lanes
+static inline uint16x8_t Div255x8(uint16x8_t x)
+{
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    return vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+// Replicate alpha lane of 2 pixels (16bit channels) into all channels
+static inline uint16x8_t BroadcastAlphax8(uint16x8_t x)
+{
+    return vcombine_u16(vdup_lane_u16(vget_low_u16(x), 3), vdup_lane_u16(vget_high_u16(x), 3));
+}
+#endif
+
+// Fill span with color, blended
+// NOTE: Opaque colors are stored directly, 4 pixels per SIMD store
+static void FillSpan(Color *dst, int count, Color color)
+{
+    if ((count <= 0) || (color.a == 0)) return;
+
+    int i = 0;
+
+    if (color.a == 255)
+    {
+#if defined(SOFTRENDER_SSE2)
+        unsigned int value = 0;
+        memcpy(&value, &color, sizeof(Color));
+        __m128i fill = _mm_set1_epi32((int)value);
+
+        for (; i + 4 <= count; i += 4) _mm_storeu_si128((__m128i *)(dst + i), fill);
+#elif defined(SOFTRENDER_NEON)
+        unsigned int value = 0;
+        memcpy(&value, &color, sizeof(Color));
+        uint32x4_t fill = vdupq_n_u32(value);
+
+        for (; i + 4 <= count; i += 4) vst1q_u32((uint32_t *)(dst + i), fill);
+#endif
+        for (; i < count; i++) dst[i] = color;
+
+        return;
+    }
+
+    unsigned int alpha = color.a;
+    unsigned int invAlpha = 255 - alpha;
+
+#if defined(SOFTRENDER_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_set_epi16(color.a*alpha, color.b*alpha, color.g*alpha, color.r*alpha,
+                                color.a*alpha, color.b*alpha, color.g*alpha, color.r*alpha);
+    __m128i inv = _mm_set1_epi16((short)invAlpha);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i lo = Div255x8(_mm_add_epi16(src, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv)));
+        __m128i hi = Div255x8(_mm_add_epi16(src, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv)));
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(SOFTRENDER_NEON)
+    const uint16_t srcValues[8] = { color.r*alpha, color.g*alpha, color.b*alpha, color.a*alpha,
+                                    color.r*alpha, color.g*alpha, color.b*alpha, color.a*alpha };
+    uint16x8_t src = vld1q_u16(srcValues);
+    uint16x8_t inv = vdupq_n_u16((uint16_t)invAlpha);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+        uint16x8_t lo = Div255x8(vmlaq_u16(src, vmovl_u8(vget_low_u8(d)), inv));
+        uint16x8_t hi = Div255x8(vmlaq_u16(src, vmovl_u8(vget_high_u8(d)), inv));
+
+        vst1q_u8((uint8_t *)(dst + i), vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i].r = (unsigned char)MulDiv255(color.r*alpha + dst[i].r*invAlpha);
+        dst[i].g = (unsigned char)MulDiv255(color.g*alpha + dst[i].g*invAlpha);
+        dst[i].b = (unsigned char)MulDiv255(color.b*alpha + dst[i].b*invAlpha);
+        dst[i].a = (unsigned char)MulDiv255(color.a*alpha + dst[i].a*invAlpha);
+    }
+}
+
+// Blend tinted texels span
+// NOTE: Texel is modulated by tint first (same as default shader), then alpha blended
+static void BlendSpan(Color *dst, const Color *src, int count, Color tint)
+{
+    int i = 0;
+
+#if defined(SOFTRENDER_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i max = _mm_set1_epi16(255);
+    __m128i tnt = _mm_set_epi16(tint.a, tint.b, tint.g, tint.r, tint.a, tint.b, tint.g, tint.r);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+
+        __m128i slo = Div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), tnt));
+        __m128i shi = Div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), tnt));
+        __m128i alo = BroadcastAlphax8(slo);
+        __m128i ahi = BroadcastAlphax8(shi);
+
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(slo, alo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(max, alo)));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(shi, ahi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(max, ahi)));
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(Div255x8(lo), Div255x8(hi)));
+    }
+#elif defined(SOFTRENDER_NEON)
+    const uint16_t tintValues[8] = { tint.r, tint.g, tint.b, tint.a, tint.r, tint.g, tint.b, tint.a };
+    uint16x8_t max = vdupq_n_u16(255);
+    uint16x8_t tnt = vld1q_u16(tintValues);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint8x16_t s = vld1q_u8((const uint8_t *)(src + i));
+        uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+
+        uint16x8_t slo = Div255x8(vmulq_u16(vmovl_u8(vget_low_u8(s)), tnt));
+        uint16x8_t shi = Div255x8(vmulq_u16(vmovl_u8(vget_high_u8(s)), tnt));
+        uint16x8_t alo = BroadcastAlphax8(slo);
+        uint16x8_t ahi = BroadcastAlphax8(shi);
+
+        uint16x8_t lo = vmlaq_u16(vmulq_u16(slo, alo), vmovl_u8(vget_low_u8(d)), vsubq_u16(max, alo));
+        uint16x8_t hi = vmlaq_u16(vmulq_u16(shi, ahi), vmovl_u8(vget_high_u8(d)), vsubq_u16(max, ahi));
+
+        vst1q_u8((uint8_t *)(dst + i), vcombine_u8(vmovn_u16(Div255x8(lo)), vmovn_u16(Div255x8(hi))));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        unsigned int r = MulDiv255(src[i].r*tint.r);
+        unsigned int g = MulDiv255(src[i].g*tint.g);
+        unsigned int b = MulDiv255(src[i].b*tint.b);
+        unsigned int a = MulDiv255(src[i].a*tint.a);
+        unsigned int invAlpha = 255 - a;
+
+        dst[i].r = (unsigned char)MulDiv255(r*a + dst[i].r*invAlpha);
+        dst[i].g = (unsigned char)MulDiv255(g*a + dst[i].g*invAlpha);
+        dst[i].b = (unsigned char)MulDiv255(b*a + dst[i].b*invAlpha);
+        dst[i].a = (unsigned char)MulDiv255(a*a + dst[i].a*invAlpha);
+    }
+}
+
+// Get pixels covered by [start, start + size), pixel covered if its center is inside
+// NOTE: Result is clamped to [0, limit), last is exclusive
+static void GetCoveredRange(float start, float size, int limit, int *first, int *last)
+{
+    float begin = ceilf(start - 0.5f);
+    float end = ceilf(start + size - 0.5f);
+
+    if (begin < 0.0f) begin = 0.0f;
+    if (end > (float)limit) end = (float)limit;
+    if (end < begin) end = begin;
+
+    *first = (int)begin;
+    *last = (int)end;
+}
+
+// Load image font, glyphs separated by key color
+// NOTE: Same glyphs detection as raylib LoadFontFromImage()
+static SoftFont LoadSoftFontFromImage(Image image, Color key, int firstChar)
+{
+    SoftFont font = { 0 };
+
+    Color *pixels = LoadImageColors(image);
+    if (pixels == NULL) return font;
+
+    int width = image.width;
+    int height = image.height;
+    int x = 0;
+    int y = 0;
+
+    // Parse image data to get charSpacing and lineSpacing
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++) if (!COLOR_EQUAL(pixels[y*width + x], key)) break;
+        if ((x < width) && !COLOR_EQUAL(pixels[y*width + x], key)) break;
+    }
+
+    int charSpacing = x;
+    int lineSpacing = y;
+
+    if ((charSpacing >= width) || (lineSpacing >= height))
+    {
+        UnloadImageColors(pixels);
+        return font;
+    }
+
+    // Parse image data to get chars height
+    int charHeight = 0;
+    while (((lineSpacing + charHeight) < height) && !COLOR_EQUAL(pixels[(lineSpacing + charHeight)*width + charSpacing], key)) charHeight++;
+
+    int values[SOFT_FONT_MAX_IMAGE_GLYPHS] = { 0 };
+    Rectangle recs[SOFT_FONT_MAX_IMAGE_GLYPHS] = { 0 };
+    int index = 0;
+    int lineToRead = 0;
+
+    // Parse image data to get glyphs rectangles
+    while (((lineSpacing + lineToRead*(charHeight + lineSpacing)) < height) && (index < SOFT_FONT_MAX_IMAGE_GLYPHS))
+    {
+        int lineY = lineSpacing + lineToRead*(charHeight + lineSpacing);
+        int xPosToRead = charSpacing;
+
+        while ((xPosToRead < width) && !COLOR_EQUAL(pixels[lineY*width + xPosToRead], key) && (index < SOFT_FONT_MAX_IMAGE_GLYPHS))
+        {
+            int charWidth = 0;
+            while (((xPosToRead + charWidth) < width) && !COLOR_EQUAL(pixels[lineY*width + xPosToRead + charWidth], key)) charWidth++;
+
+            values[index] = firstChar + index;
+            recs[index] = (Rectangle){ (float)xPosToRead, (float)lineY, (float)charWidth, (float)charHeight };
+            index++;
+
+            xPosToRead += (charWidth + charSpacing);
+        }
+
+        lineToRead++;
+    }
+
+    // Remove key color borders from image
+    for (int i = 0; i < width*height; i++) if (COLOR_EQUAL(pixels[i], key)) pixels[i] = BLANK;
+
+    if (index > 0)
+    {
+        font.glyphCount = index;
+        font.glyphPadding = 0;
+        font.baseSize = (int)recs[0].height;
+        font.atlas = (SoftTexture){ width, height, pixels };
+        font.recs = (Rectangle *)RL_MALLOC(index*sizeof(Rectangle));
+        font.glyphs = (GlyphInfo *)RL_CALLOC(index, sizeof(GlyphInfo));
+
+        for (int i = 0; i < index; i++)
+        {
+            font.recs[i] = recs[i];
+            font.glyphs[i].value = values[i];
+        }
+    }
+    else UnloadImageColors(pixels);
+
+    return font;
+}
+
+// Get glyph index for codepoint
+static int GetSoftGlyphIndex(SoftFont font, int codepoint)
+{
+    int fallbackIndex = 0;
+
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        if (font.glyphs[i].value == codepoint) return i;
+        if (font.glyphs[i].value == '?') fallbackIndex = i;
+    }
+
+    return fallbackIndex;
+}
@@ -0,0 +1,122 @@
+/**********************************************************************************************
+*
+*   softrender - CPU software rasterizer for the drawing subset used by games
+*
+*   Draws into a CPU framebuffer (RGBA8) without any GPU or OpenGL context, intended for
+*   headless runs (CI golden-image checks, CPU-only performance measures, frame capture).
+*   Functions mirror raylib drawing functions used by games, game drawing code can be ported
+*   just adding the Soft prefix:
+*     - ClearBackground(), DrawRectangle(), DrawRectangleRec(), DrawCircleV(), DrawLine()
+*     - DrawTexture(), DrawTextureEx() (nearest sampling, tinted, no rotation)
+*     - DrawText(), DrawTextEx(), MeasureText() (bitmap fonts: image fonts and TTF atlas)
+*
+*   Blending matches raylib default mode (BLEND_ALPHA): c = src*a + dst*(1 - a)
+*   Pixels are covered when their center is inside the shape (same rule as OpenGL fill)
+*
+*   Spans are filled with SIMD kernels (SSE2 or NEON, selected at compile time); all paths
+*   use the same integer math, results are bit-identical across platforms and kernels.
+*
+*   CONFIGURATION:
+*       #define SOFTRENDER_NO_SIMD
+*           Use scalar span kernels only
+*
+*   NOTE: Textures and fonts are loaded with raylib CPU functions (LoadImage(), LoadFontData()),
+*   raylib library is required but InitWindow() is not, no GPU resources are created.
+*   Module is not thread-safe, draw from a single thread.
+*
+*   USAGE:
+*       SoftFramebuffer target = LoadSoftFramebuffer(800, 450);
+*
+*       BeginSoftDrawing(&target);
+*           SoftClearBackground(RAYWHITE);
+*           SoftDrawRectangle(10, 10, 100, 20, MAROON);
+*       EndSoftDrawing();
+*
+*       ExportSoftFramebuffer(target, "frame.png");
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SOFTRENDER_H
+#define SOFTRENDER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SOFTRENDER_MAX_WIDTH        4096    // Maximum framebuffer width (span buffers size)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Software framebuffer, RGBA8 pixels, row-major
+typedef struct SoftFramebuffer {
+    int width;                  // Framebuffer width
+    int height;                 // Framebuffer height
+    Color *pixels;              // Framebuffer pixels (width*height)
+} SoftFramebuffer;
+
+// Software texture, RGBA8 pixels, row-major
+typedef struct SoftTexture {
+    int width;                  // Texture width
+    int height;                 // Texture height
+    Color *pixels;              // Texture pixels (width*height)
+} SoftTexture;
+
+// Software font, same layout as raylib Font with a CPU atlas
+typedef struct SoftFont {
+    int baseSize;               // Base size (default chars height)
+    int glyphCount;             // Number of glyph characters
+    int glyphPadding;           // Padding around the glyph characters
+    SoftTexture atlas;          // Characters atlas
+    Rectangle *recs;            // Rectangles in atlas for the glyphs
+    GlyphInfo *glyphs;          // Glyphs info data (images not loaded)
+} SoftFont;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+
+// Framebuffer management
+SoftFramebuffer LoadSoftFramebuffer(int width, int height);         // Load framebuffer (cleared to BLANK)
+void UnloadSoftFramebuffer(SoftFramebuffer target);                 // Unload framebuffer
+bool ExportSoftFramebuffer(SoftFramebuffer target, const char *fileName); // Export framebuffer to image file (PNG), alpha forced opaque
+
+// Textures and fonts loading (CPU only)
+SoftTexture LoadSoftTexture(const char *fileName);                  // Load texture from image file
+SoftTexture LoadSoftTextureFromImage(Image image);                  // Load texture from image data (any pixel format)
+void UnloadSoftTexture(SoftTexture texture);                        // Unload texture
+SoftFont LoadSoftFont(const char *fileName, int fontSize);          // Load font: TTF/OTF rasterized at fontSize, image fonts (MAGENTA key) ignore fontSize
+void UnloadSoftFont(SoftFont font);                                 // Unload font
+void SetSoftFontDefault(SoftFont font);                             // Set font used by SoftDrawText() and SoftMeasureText()
+
+// Drawing
+void BeginSoftDrawing(SoftFramebuffer *target);                     // Set framebuffer to draw into
+void EndSoftDrawing(void);                                          // End drawing into framebuffer
+void SoftClearBackground(Color color);                              // Set all framebuffer pixels to color
+void SoftDrawRectangle(int posX, int posY, int width, int height, Color color);     // Draw a color-filled rectangle
+void SoftDrawRectangleRec(Rectangle rec, Color color);                              // Draw a color-filled rectangle
+void SoftDrawCircleV(Vector2 center, float radius, Color color);                    // Draw a color-filled circle
+void SoftDrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color);  // Draw a 1px line
+void SoftDrawTexture(SoftTexture texture, int posX, int posY, Color tint);          // Draw a texture
+void SoftDrawTextureEx(SoftTexture texture, Vector2 position, float rotation, float scale, Color tint); // Draw a texture with scale (rotation not supported, must be 0)
+void SoftDrawTextureRec(SoftTexture texture, Rectangle source, Rectangle dest, Color tint); // Draw part of a texture scaled into dest rectangle
+void SoftDrawText(const char *text, int posX, int posY, int fontSize, Color color); // Draw text using default soft font
+void SoftDrawTextEx(SoftFont font, const char *text, Vector2 position, float fontSize, float spacing, Color tint); // Draw text using font and additional parameters
+int SoftMeasureText(const char *text, int fontSize);                                // Measure text width for default soft font
+Vector2 SoftMeasureTextEx(SoftFont font, const char *text, float fontSize, float spacing); // Measure text size for font
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SOFTRENDER_H
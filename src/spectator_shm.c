@@ -0,0 +1,350 @@
+/**********************************************************************************************
+*
+*   spectator_shm - Shared memory spectator fan-out, live game state for local viewer processes
+*
+*   NOTE: Check spectator_shm.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "spectator_shm.h"
+
+#include "threads.h"            // Required for: AtomicLoad(), AtomicStore(), AtomicFence()
+
+#include <stdlib.h>             // Required for: calloc(), free()
+#include <string.h>             // Required for: memcpy(), memcmp(), memset()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ALIGN_SIZE(size)            (((size) + SPECTATOR_ALIGNMENT - 1)/SPECTATOR_ALIGNMENT*SPECTATOR_ALIGNMENT)
+#define CHUNKS_COUNT(stateSize)     (((stateSize) + SPECTATOR_CHUNK_SIZE - 1)/SPECTATOR_CHUNK_SIZE)
+#define MASK_SIZE(chunksCount)      (((chunksCount) + 127)/128*16)     // Chunks bitmask bytes, chunk data stays 16 bytes aligned
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int ReadSequence(const volatile unsigned int *sequence);   // Read counter (acquire), no writes into read-only region
+static bool ReadKeyframe(SpectatorView *view);                     // Copy keyframe into view state, returns false if torn or not newer
+static bool ApplyEntry(SpectatorView *view, unsigned int frame);   // Copy ring entry and apply it to view state, returns false if torn or overwritten
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Create region for game state
+// NOTE: An existing region with same name (i.e. from a crashed host) is replaced
+SpectatorHost CreateSpectatorHost(const char *name, int game, int stateSize)
+{
+    SpectatorHost host = { 0 };
+
+    if ((stateSize <= 0) || (stateSize > SPECTATOR_MAX_STATE_SIZE))
+    {
+        TraceLog(LOG_WARNING, "SPECTATOR: State size not supported (%i bytes, maximum %i)", stateSize, SPECTATOR_MAX_STATE_SIZE);
+        return host;
+    }
+
+    int chunksCount = CHUNKS_COUNT(stateSize);
+    unsigned int entrySize = ALIGN_SIZE(sizeof(SpectatorEntry) + MASK_SIZE(chunksCount) + chunksCount*SPECTATOR_CHUNK_SIZE);
+    unsigned int keyframeOffset = ALIGN_SIZE(sizeof(SpectatorHeader));
+    unsigned int ringOffset = keyframeOffset + ALIGN_SIZE(stateSize);
+    unsigned int size = ringOffset + SPECTATOR_RING_FRAMES*entrySize;
+
+    if (!CreateSharedRegion(&host.region, name, size, true))
+    {
+        TraceLog(LOG_WARNING, "SPECTATOR: [%s] Failed to create shared memory region", host.region.name);
+        return host;
+    }
+
+    memset(host.region.memory, 0, size);
+    host.previous = (unsigned char *)RL_CALLOC(chunksCount*SPECTATOR_CHUNK_SIZE, 1);
+
+    SpectatorHeader *header = (SpectatorHeader *)host.region.memory;
+    header->version = SPECTATOR_VERSION;
+    header->size = size;
+    header->game = game;
+    header->stateSize = stateSize;
+    header->chunkSize = SPECTATOR_CHUNK_SIZE;
+    header->ringFrames = SPECTATOR_RING_FRAMES;
+    header->entrySize = (int)entrySize;
+    header->keyframeOffset = keyframeOffset;
+    header->ringOffset = ringOffset;
+
+    host.header = header;
+
+    AtomicStore(&header->magic, SPECTATOR_MAGIC);       // Publish, header written before
+
+    TraceLog(LOG_INFO, "SPECTATOR: [%s] Shared memory region created (%u bytes, state %i bytes)", host.region.name, size, stateSize);
+
+    return host;
+}
+
+// Mark region closed, unmap and remove it
+// NOTE: Viewers keep their mapping (removed name) until they close it, they see it closed
+void CloseSpectatorHost(SpectatorHost *host)
+{
+    if (host->region.memory == NULL) return;
+
+    AtomicStore(&host->header->closed, 1);
+
+    CloseSharedRegion(&host->region);
+
+    RL_FREE(host->previous);
+
+    host->header = NULL;
+    host->previous = NULL;
+}
+
+// Publish frame state and events
+// NOTE: Cost is one state compare and changed chunks copy (plus one state copy every
+// keyframe interval), viewers are not involved
+void PublishSpectatorFrame(SpectatorHost *host, const void *state, unsigned int events)
+{
+    if (host->region.memory == NULL) return;
+
+    SpectatorHeader *header = host->header;
+    const unsigned char *bytes = (const unsigned char *)state;
+    unsigned int frame = host->frame + 1;
+    int stateSize = header->stateSize;
+    int chunksCount = CHUNKS_COUNT(stateSize);
+
+    SpectatorEntry *entry = (SpectatorEntry *)((unsigned char *)host->region.memory + header->ringOffset + (frame%SPECTATOR_RING_FRAMES)*header->entrySize);
+    unsigned char *mask = (unsigned char *)(entry + 1);
+    unsigned char *data = mask + MASK_SIZE(chunksCount);
+
+    AtomicStore(&entry->sequence, 2*frame + 1);         // Entry being written
+    AtomicFence();                                      // Entry writes are not moved before odd sequence
+
+    memset(mask, 0, MASK_SIZE(chunksCount));
+    unsigned int changed = 0;
+
+    for (int i = 0; i < chunksCount; i++)
+    {
+        int offset = i*SPECTATOR_CHUNK_SIZE;
+        int size = (stateSize - offset < SPECTATOR_CHUNK_SIZE)? stateSize - offset : SPECTATOR_CHUNK_SIZE;
+
+        if (memcmp(bytes + offset, host->previous + offset, size) != 0)
+        {
+            mask[i/8] |= (unsigned char)(1 << (i%8));
+            memcpy(data + changed*SPECTATOR_CHUNK_SIZE, bytes + offset, size);
+            memcpy(host->previous + offset, bytes + offset, size);
+            changed++;
+        }
+    }
+
+    entry->frame = frame;
+    entry->events = events;
+    entry->chunksCount = changed;
+
+    AtomicStore(&entry->sequence, 2*frame + 2);         // Publish entry, written before
+
+    // Keyframe: first frame and every interval
+    if ((frame == 1) || ((frame%SPECTATOR_KEYFRAME_INTERVAL) == 0))
+    {
+        AtomicStore(&header->keyframeSequence, 2*frame + 1);
+        AtomicFence();
+
+        memcpy((unsigned char *)host->region.memory + header->keyframeOffset, bytes, stateSize);
+        header->keyframeFrame = frame;
+        header->keyframeEvents = events;
+
+        AtomicStore(&header->keyframeSequence, 2*frame + 2);
+    }
+
+    host->frame = frame;
+    host->bytes += changed*SPECTATOR_CHUNK_SIZE;
+
+    AtomicStore(&header->frame, frame);                 // Frame available to viewers
+}
+
+// Open region created by host (read-only)
+SpectatorView OpenSpectatorView(const char *name)
+{
+    SpectatorView view = { 0 };
+
+    if (!OpenSharedRegion(&view.region, name, true))
+    {
+        TraceLog(LOG_WARNING, "SPECTATOR: [%s] Failed to open shared memory region", view.region.name);
+        return view;
+    }
+
+    view.header = (const SpectatorHeader *)view.region.memory;
+
+    if (!IsSpectatorViewReady(&view))
+    {
+        TraceLog(LOG_WARNING, "SPECTATOR: [%s] Shared memory region not ready or incompatible", view.region.name);
+        CloseSpectatorView(&view);
+        return view;
+    }
+
+    view.state = (unsigned char *)RL_CALLOC(view.header->entrySize, 1);
+    view.entry = (unsigned char *)RL_CALLOC(view.header->entrySize, 1);
+
+    TraceLog(LOG_INFO, "SPECTATOR: [%s] Shared memory region opened (game %i, state %i bytes)", view.region.name, view.header->game, view.header->stateSize);
+
+    return view;
+}
+
+// Unmap region
+void CloseSpectatorView(SpectatorView *view)
+{
+    if (view->region.memory == NULL) return;
+
+    CloseSharedRegion(&view->region);
+
+    RL_FREE(view->state);
+    RL_FREE(view->entry);
+
+    view->header = NULL;
+    view->state = NULL;
+    view->entry = NULL;
+    view->frame = 0;
+}
+
+// Check region is mapped and valid
+bool IsSpectatorViewReady(const SpectatorView *view)
+{
+    if ((view->region.memory == NULL) || (view->region.size < sizeof(SpectatorHeader))) return false;
+
+    const SpectatorHeader *header = view->header;
+    int chunksCount = CHUNKS_COUNT(header->stateSize);
+
+    return (ReadSequence(&header->magic) == SPECTATOR_MAGIC) && (header->version == SPECTATOR_VERSION) &&
+           (header->size <= view->region.size) && (header->chunkSize == SPECTATOR_CHUNK_SIZE) && (header->ringFrames == SPECTATOR_RING_FRAMES) &&
+           (header->stateSize > 0) && (header->stateSize <= SPECTATOR_MAX_STATE_SIZE) &&
+           (header->entrySize >= (int)(sizeof(SpectatorEntry) + MASK_SIZE(chunksCount) + chunksCount*SPECTATOR_CHUNK_SIZE)) &&
+           (header->keyframeOffset + header->stateSize <= header->size) &&
+           (header->ringOffset + (unsigned int)SPECTATOR_RING_FRAMES*header->entrySize <= header->size);
+}
+
+// Apply frames published since last update
+// NOTE: Viewer starts from latest keyframe, it resyncs from keyframe when it falls behind
+// ring (frames overwritten) or an entry is overwritten while being read
+int UpdateSpectatorView(SpectatorView *view)
+{
+    view->events = 0;
+
+    if (view->region.memory == NULL) return 0;
+
+    unsigned int latest = ReadSequence(&view->header->frame);
+    if (latest == 0) return 0;
+
+    int applied = 0;
+
+    if (view->frame == 0)
+    {
+        if (!ReadKeyframe(view)) return 0;      // NOTE: Keyframe being written, next update gets it
+        applied++;
+    }
+
+    // NOTE: Frame and state always match, on resync failure view keeps its state and retries on next update
+    while ((int)(latest - view->frame) > 0)
+    {
+        bool behind = ((int)(latest - view->frame) >= SPECTATOR_RING_FRAMES);
+
+        if (!behind && ApplyEntry(view, view->frame + 1)) applied++;
+        else if (ReadKeyframe(view))
+        {
+            view->resyncs++;
+            applied++;
+        }
+        else break;
+    }
+
+    view->frames += applied;
+
+    return applied;
+}
+
+// Check host closed region
+bool IsSpectatorHostClosed(const SpectatorView *view)
+{
+    return (view->region.memory == NULL) || (ReadSequence(&view->header->closed) != 0);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Read counter (acquire)
+// NOTE: MSVC AtomicLoad() is an interlocked exchange, it writes (fails on read-only mapping),
+// aligned volatile reads are atomic, fence keeps later reads after it
+static unsigned int ReadSequence(const volatile unsigned int *sequence)
+{
+#if defined(_MSC_VER)
+    unsigned int value = *sequence;
+    AtomicFence();
+
+    return value;
+#else
+    return AtomicLoad((volatile unsigned int *)sequence);
+#endif
+}
+
+// Copy keyframe into view state
+// NOTE: Only a keyframe newer than view state is applied, view frame never goes back
+static bool ReadKeyframe(SpectatorView *view)
+{
+    const SpectatorHeader *header = view->header;
+    unsigned int sequence = ReadSequence(&header->keyframeSequence);
+
+    if ((sequence == 0) || (sequence & 1)) return false;
+    if ((view->frame != 0) && ((int)(sequence/2 - 1 - view->frame) <= 0)) return false;  // Not newer than view state
+
+    unsigned int frame = header->keyframeFrame;
+    unsigned int events = header->keyframeEvents;
+    memcpy(view->entry, (const unsigned char *)view->region.memory + header->keyframeOffset, header->stateSize);
+
+    AtomicFence();                          // Copy reads are not moved after sequence check
+    if ((ReadSequence(&header->keyframeSequence) != sequence) || (sequence != 2*frame + 2)) return false;
+
+    memcpy(view->state, view->entry, header->stateSize);
+    view->frame = frame;
+    view->events |= events;
+
+    return true;
+}
+
+// Copy ring entry and apply it to view state
+// NOTE: Entry is copied before applied, a torn copy is discarded and view state is untouched
+static bool ApplyEntry(SpectatorView *view, unsigned int frame)
+{
+    const SpectatorHeader *header = view->header;
+    int stateSize = header->stateSize;
+    int chunksCount = CHUNKS_COUNT(stateSize);
+    const SpectatorEntry *entry = (const SpectatorEntry *)((const unsigned char *)view->region.memory + header->ringOffset + (frame%SPECTATOR_RING_FRAMES)*header->entrySize);
+
+    unsigned int sequence = ReadSequence(&entry->sequence);
+    if (sequence != 2*frame + 2) return false;          // Overwritten by a newer frame (or being written)
+
+    unsigned int changed = entry->chunksCount;
+    if (changed > (unsigned int)chunksCount) changed = chunksCount;    // NOTE: Torn count, copy size stays in entry
+
+    memcpy(view->entry, entry, sizeof(SpectatorEntry) + MASK_SIZE(chunksCount) + changed*SPECTATOR_CHUNK_SIZE);
+
+    AtomicFence();                          // Copy reads are not moved after sequence check
+    if (ReadSequence(&entry->sequence) != sequence) return false;
+
+    const SpectatorEntry *copy = (const SpectatorEntry *)view->entry;
+    const unsigned char *mask = view->entry + sizeof(SpectatorEntry);
+    const unsigned char *data = mask + MASK_SIZE(chunksCount);
+
+    for (int i = 0, applied = 0; (i < chunksCount) && (applied < (int)changed); i++)
+    {
+        if (!(mask[i/8] & (1 << (i%8)))) continue;
+
+        int offset = i*SPECTATOR_CHUNK_SIZE;
+        int size = (stateSize - offset < SPECTATOR_CHUNK_SIZE)? stateSize - offset : SPECTATOR_CHUNK_SIZE;
+
+        memcpy(view->state + offset, data + applied*SPECTATOR_CHUNK_SIZE, size);
+        applied++;
+    }
+
+    view->frame = frame;
+    view->events |= copy->events;
+
+    return true;
+}
@@ -0,0 +1,148 @@
+/**********************************************************************************************
+*
+*   spectator_shm - Shared memory spectator fan-out, live game state for local viewer processes
+*
+*   Running game (host) publishes its simulation state once per frame into a named shared
+*   memory region, any number of viewer processes map the same region read-only and follow
+*   it at their own rate. Host never knows about viewers: no handshake, no per viewer work,
+*   publishing cost does not depend on viewers count.
+*
+*   Every frame is published as a delta: state is split in SPECTATOR_CHUNK_SIZE chunks, only
+*   chunks changed since previous frame are written (changed chunks bitmask + chunks data)
+*   into a ring of SPECTATOR_RING_FRAMES entries. Every SPECTATOR_KEYFRAME_INTERVAL frames
+*   the full state is also written (keyframe), viewers start from it or resync from it when
+*   they fall behind the ring.
+*
+*   Ring entries and keyframe are seqlock protected: writer sets their sequence odd before
+*   writing and even (frame number based) after, readers copy data and check sequence did
+*   not change, torn or overwritten entries are detected and never applied. Viewers never
+*   write into the region.
+*
+*   REGION LAYOUT (offsets in header, all blocks 64 bytes aligned):
+*       SpectatorHeader             header (magic 'SPC1', version, sizes, offsets, latest frame)
+*       keyframe                    full state, keyframe sequence and frame in header
+*       entries[SPECTATOR_RING_FRAMES]  SpectatorEntry, changed chunks bitmask, changed chunks data
+*
+*   NOTE: Region name is platform decorated (check shared_region.h): "/<name>" (POSIX shm_open()),
+*   "Local\<name>" (Win32 file mapping), region is public (viewers of other users can open it).
+*   State is copied as raw bytes, host and viewers must be built with same game core (state
+*   size is checked on open). Not available on web platform
+*
+*   USAGE (host, every frame):
+*       SpectatorHost host = CreateSpectatorHost("raylib_pong", SPECTATOR_GAME_PONG, sizeof(PongGame));
+*       PublishSpectatorFrame(&host, view, events);
+*       CloseSpectatorHost(&host);
+*
+*   USAGE (viewer, any rate):
+*       SpectatorView view = OpenSpectatorView("raylib_pong");
+*       if (UpdateSpectatorView(&view) > 0) DrawPong((const PongGame *)view.state);
+*       CloseSpectatorView(&view);
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef SPECTATOR_SHM_H
+#define SPECTATOR_SHM_H
+
+#include "raylib.h"
+
+#include "shared_region.h"      // Required for: SharedRegion
+
+#include <stddef.h>             // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SPECTATOR_MAGIC                 0x31435053      // 'SPC1'
+#define SPECTATOR_VERSION               1
+#define SPECTATOR_ALIGNMENT             64      // Region blocks alignment (cache line)
+
+#define SPECTATOR_CHUNK_SIZE            16      // State delta granularity (bytes)
+#define SPECTATOR_MAX_STATE_SIZE        16384   // Maximum state size (bytes)
+#define SPECTATOR_RING_FRAMES           128     // Frames kept in ring, power of 2 (~2 seconds at 60 fps)
+#define SPECTATOR_KEYFRAME_INTERVAL     32      // Frames between keyframes, less than ring frames
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Games published
+typedef enum {
+    SPECTATOR_GAME_PONG = 1,    // State: PongGame (pong_sim.h)
+    SPECTATOR_GAME_BLOCKS       // State: BlocksGame (blocks_sim.h)
+} SpectatorGame;
+
+// Shared region header
+// NOTE: 32bit fields only, same layout for any compiler and language
+typedef struct SpectatorHeader {
+    unsigned int magic;                 // SPECTATOR_MAGIC, written last by host (region ready)
+    unsigned int version;               // SPECTATOR_VERSION
+    unsigned int size;                  // Region size in bytes
+    int game;                           // SpectatorGame
+    int stateSize;                      // State size in bytes
+    int chunkSize;                      // SPECTATOR_CHUNK_SIZE
+    int ringFrames;                     // SPECTATOR_RING_FRAMES
+    int entrySize;                      // Ring entry size in bytes (header, bitmask and all chunks)
+    unsigned int keyframeOffset;        // Blocks offsets from region start
+    unsigned int ringOffset;
+    volatile unsigned int frame;        // Latest frame published, 0 if none
+    volatile unsigned int keyframeSequence; // Keyframe seqlock: odd while written, 2*frame + 2 once written
+    unsigned int keyframeFrame;         // Keyframe frame (read under keyframe seqlock)
+    unsigned int keyframeEvents;        // Events flags published with keyframe frame
+    volatile unsigned int closed;       // Host closed region, no more frames
+} SpectatorHeader;
+
+// Ring entry header, followed by changed chunks bitmask and changed chunks data
+typedef struct SpectatorEntry {
+    volatile unsigned int sequence;     // Entry seqlock: odd while written, 2*frame + 2 once written
+    unsigned int frame;                 // Frame published
+    unsigned int events;                // Game events flags (i.e. PongEvent, BlocksEvent) raised since previous frame
+    unsigned int chunksCount;           // Changed chunks
+} SpectatorEntry;
+
+// Host side: region owner, publishes frames
+typedef struct SpectatorHost {
+    SharedRegion region;        // Mapped region (region.memory NULL if not available)
+    SpectatorHeader *header;    // Region header
+    unsigned char *previous;    // State published on previous frame (delta reference)
+    unsigned int frame;         // Frames published
+    unsigned long long bytes;   // Chunks bytes published (deltas, keyframes excluded)
+} SpectatorHost;
+
+// Viewer side: read-only mapping, local state copy
+typedef struct SpectatorView {
+    SharedRegion region;        // Mapped region, read-only (region.memory NULL if not available)
+    const SpectatorHeader *header;  // Region header
+    unsigned char *state;       // Latest state applied (header->stateSize bytes)
+    unsigned char *entry;       // Ring entry or keyframe copy, validated before applied to state
+    unsigned int frame;         // Frame of state, 0 if not synced
+    unsigned int events;        // Events flags of frames applied by last update
+    unsigned int frames;        // Frames applied since open
+    unsigned int resyncs;       // Keyframe resyncs after falling behind ring or torn reads
+} SpectatorView;
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+SpectatorHost CreateSpectatorHost(const char *name, int game, int stateSize);   // Create region for game state (stateSize bytes)
+void CloseSpectatorHost(SpectatorHost *host);               // Mark region closed, unmap and remove it
+void PublishSpectatorFrame(SpectatorHost *host, const void *state, unsigned int events);    // Publish frame state (delta) and events
+
+SpectatorView OpenSpectatorView(const char *name);          // Open region created by host (read-only)
+void CloseSpectatorView(SpectatorView *view);               // Unmap region
+bool IsSpectatorViewReady(const SpectatorView *view);       // Check region is mapped and valid
+int UpdateSpectatorView(SpectatorView *view);               // Apply frames published since last update, returns frames applied
+bool IsSpectatorHostClosed(const SpectatorView *view);      // Check host closed region
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SPECTATOR_SHM_H
@@ -0,0 +1,307 @@
+/**********************************************************************************************
+*
+*   threads - Minimal threads, mutexes and condition variables for background workers
+*
+*   NOTE: Check threads.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "threads.h"
+
+#include <stddef.h>             // Required for: size_t, NULL
+
+#if defined(_WIN32)
+    // NOTE: Declaring required functions directly, including windows.h conflicts with raylib names
+    __declspec(dllimport) void *__stdcall CreateThread(void *attributes, size_t stackSize, unsigned long (__stdcall *start)(void *), void *param, unsigned long flags, unsigned long *id);
+    __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+    __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+    __declspec(dllimport) void __stdcall InitializeSRWLock(void *lock);
+    __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(void *lock);
+    __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(void *lock);
+    __declspec(dllimport) void __stdcall InitializeConditionVariable(void *cond);
+    __declspec(dllimport) int __stdcall SleepConditionVariableSRW(void *cond, void *lock, unsigned long milliseconds, unsigned long flags);
+    __declspec(dllimport) unsigned long __stdcall GetLastError(void);
+    __declspec(dllimport) void __stdcall WakeConditionVariable(void *cond);
+    __declspec(dllimport) void __stdcall WakeAllConditionVariable(void *cond);
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequency);
+
+    #define WIN32_INFINITE  0xFFFFFFFF
+    #define WIN32_ERROR_TIMEOUT     1460
+#else
+    #include <time.h>           // Required for: clock_gettime(), CLOCK_REALTIME, CLOCK_MONOTONIC
+    #include <errno.h>          // Required for: ETIMEDOUT
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>         // Required for: _InterlockedExchange(), _InterlockedExchangeAdd()...
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+#if THREADS_SUPPORTED
+#if defined(_WIN32)
+static unsigned long __stdcall ThreadEntry(void *param);   // Platform thread entry, calls thread func
+#else
+static void *ThreadEntry(void *param);                      // Platform thread entry, calls thread func
+#endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Start thread running func(arg)
+bool StartThread(Thread *thread, ThreadFunc func, void *arg)
+{
+    thread->func = func;
+    thread->arg = arg;
+
+#if !THREADS_SUPPORTED
+    return false;
+#elif defined(_WIN32)
+    thread->handle = CreateThread(NULL, 0, ThreadEntry, thread, 0, NULL);
+    return (thread->handle != NULL);
+#else
+    return (pthread_create(&thread->handle, NULL, ThreadEntry, thread) == 0);
+#endif
+}
+
+// Wait for thread to finish and release it
+void JoinThread(Thread *thread)
+{
+#if !THREADS_SUPPORTED
+    (void)thread;
+#elif defined(_WIN32)
+    WaitForSingleObject(thread->handle, WIN32_INFINITE);
+    CloseHandle(thread->handle);
+    thread->handle = NULL;
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+}
+
+// Initialize mutex
+void InitMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    InitializeSRWLock(&mutex->lock);
+#else
+    pthread_mutex_init(&mutex->lock, NULL);
+#endif
+}
+
+// Destroy mutex
+void DestroyMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    (void)mutex;                // SRW locks do not need to be destroyed
+#else
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+}
+
+// Lock mutex
+void LockMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+// Unlock mutex
+void UnlockMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+// Initialize condition variable
+void InitCondition(Condition *cond)
+{
+#if defined(_WIN32)
+    InitializeConditionVariable(&cond->cond);
+#else
+    pthread_cond_init(&cond->cond, NULL);
+#endif
+}
+
+// Destroy condition variable
+void DestroyCondition(Condition *cond)
+{
+#if defined(_WIN32)
+    (void)cond;                 // Condition variables do not need to be destroyed
+#else
+    pthread_cond_destroy(&cond->cond);
+#endif
+}
+
+// Unlock mutex and sleep until signaled
+// NOTE: Spurious wake-ups are possible, always wait inside a loop checking the condition
+void WaitCondition(Condition *cond, Mutex *mutex)
+{
+#if defined(_WIN32)
+    SleepConditionVariableSRW(&cond->cond, &mutex->lock, WIN32_INFINITE, 0);
+#else
+    pthread_cond_wait(&cond->cond, &mutex->lock);
+#endif
+}
+
+// Unlock mutex and sleep until signaled or timed out
+// NOTE: Spurious wake-ups are possible, always wait inside a loop checking the condition
+bool WaitConditionTimeout(Condition *cond, Mutex *mutex, double seconds)
+{
+    if (seconds < 0.0) seconds = 0.0;
+
+#if defined(_WIN32)
+    if (SleepConditionVariableSRW(&cond->cond, &mutex->lock, (unsigned long)(seconds*1000.0 + 0.5), 0)) return true;
+
+    return (GetLastError() != WIN32_ERROR_TIMEOUT);
+#else
+    // NOTE: Timeout is an absolute time measured with CLOCK_REALTIME (pthread_cond_timedwait() default clock)
+    struct timespec deadline = { 0 };
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    long long nsec = (long long)deadline.tv_nsec + (long long)((seconds - (double)(long long)seconds)*1e9);
+    deadline.tv_sec += (time_t)seconds + (time_t)(nsec/1000000000);
+    deadline.tv_nsec = (long)(nsec%1000000000);
+
+    return (pthread_cond_timedwait(&cond->cond, &mutex->lock, &deadline) != ETIMEDOUT);
+#endif
+}
+
+// Wake one thread waiting on condition
+void SignalCondition(Condition *cond)
+{
+#if defined(_WIN32)
+    WakeConditionVariable(&cond->cond);
+#else
+    pthread_cond_signal(&cond->cond);
+#endif
+}
+
+// Wake all threads waiting on condition
+void BroadcastCondition(Condition *cond)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(&cond->cond);
+#else
+    pthread_cond_broadcast(&cond->cond);
+#endif
+}
+
+// Load value (acquire)
+unsigned int AtomicLoad(volatile unsigned int *ptr)
+{
+#if defined(_MSC_VER)
+    return (unsigned int)_InterlockedCompareExchange((volatile long *)ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// Store value (release)
+void AtomicStore(volatile unsigned int *ptr, unsigned int value)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchange((volatile long *)ptr, (long)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Add value, returns previous value
+unsigned int AtomicAdd(volatile unsigned int *ptr, unsigned int value)
+{
+#if defined(_MSC_VER)
+    return (unsigned int)_InterlockedExchangeAdd((volatile long *)ptr, (long)value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Store value, returns previous value
+unsigned int AtomicExchange(volatile unsigned int *ptr, unsigned int value)
+{
+#if defined(_MSC_VER)
+    return (unsigned int)_InterlockedExchange((volatile long *)ptr, (long)value);
+#else
+    return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Store value if current one is expected
+bool AtomicCompareExchange(volatile unsigned int *ptr, unsigned int expected, unsigned int value)
+{
+#if defined(_MSC_VER)
+    return ((unsigned int)_InterlockedCompareExchange((volatile long *)ptr, (long)value, (long)expected) == expected);
+#else
+    return __atomic_compare_exchange_n(ptr, &expected, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Full memory barrier
+void AtomicFence(void)
+{
+#if defined(_MSC_VER)
+    static volatile long barrier = 0;
+    _InterlockedOr(&barrier, 0);    // Interlocked operations are full barriers on all architectures
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+// Get monotonic wall-clock time in seconds
+// NOTE: Performance counter frequency is fixed at boot, it's queried once
+double GetWallTime(void)
+{
+#if defined(_WIN32)
+    static long long frequency = 0;
+    long long counter = 0;
+
+    if (frequency == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (double)counter/(double)frequency;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Platform thread entry, calls thread func
+#if THREADS_SUPPORTED
+#if defined(_WIN32)
+static unsigned long __stdcall ThreadEntry(void *param)
+{
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+
+    return 0;
+}
+#else
+static void *ThreadEntry(void *param)
+{
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+
+    return NULL;
+}
+#endif
+#endif
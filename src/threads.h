@@ -0,0 +1,114 @@
+/**********************************************************************************************
+*
+*   threads - Minimal threads, mutexes and condition variables for background workers
+*
+*   Thin wrapper over Win32 threads/SRW locks and POSIX threads, just what game core workers
+*   need: one worker thread per module, a mutex protecting its queue and a condition variable
+*   to sleep on when there is no work.
+*
+*   Lock-free code (per-thread buffers, single producer queues) gets a few 32bit atomic
+*   operations and a thread-local storage qualifier (THREAD_LOCAL).
+*
+*   Workers, servers and headless tools measure time with GetWallTime(), a monotonic clock
+*   available on any thread, raylib GetTime() requires a window (timer initialized by InitWindow()).
+*
+*   NOTE: On web, unless built with pthreads (-pthread, __EMSCRIPTEN_PTHREADS__), StartThread()
+*   fails and modules must do their background work on main thread, check THREADS_SUPPORTED.
+*   Thread structure must stay valid (not moved) until JoinThread(), it's used by the new thread
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <stdbool.h>
+
+#if !defined(_WIN32)
+    #include <pthread.h>        // Required for: pthread_t, pthread_mutex_t, pthread_cond_t
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+    #define THREADS_SUPPORTED       0       // Background work must be done on main thread
+#else
+    #define THREADS_SUPPORTED       1
+#endif
+
+// Thread-local storage qualifier, one variable instance per thread
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL            __declspec(thread)
+#else
+    #define THREAD_LOCAL            __thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Thread entry point
+typedef void (*ThreadFunc)(void *arg);
+
+#if defined(_WIN32)
+// NOTE: Handle and SRW locks/condition variables are pointer-sized opaque values,
+// windows.h is not included, it conflicts with raylib names
+typedef struct Thread {
+    void *handle;               // Thread handle
+    ThreadFunc func;            // Thread entry point
+    void *arg;                  // Thread entry point argument
+} Thread;
+
+typedef struct Mutex { void *lock; } Mutex;             // SRWLOCK
+typedef struct Condition { void *cond; } Condition;     // CONDITION_VARIABLE
+#else
+typedef struct Thread {
+    pthread_t handle;           // Thread handle
+    ThreadFunc func;            // Thread entry point
+    void *arg;                  // Thread entry point argument
+} Thread;
+
+typedef struct Mutex { pthread_mutex_t lock; } Mutex;
+typedef struct Condition { pthread_cond_t cond; } Condition;
+#endif
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool StartThread(Thread *thread, ThreadFunc func, void *arg);  // Start thread running func(arg), returns false if not possible
+void JoinThread(Thread *thread);                                // Wait for thread to finish and release it
+
+void InitMutex(Mutex *mutex);                   // Initialize mutex
+void DestroyMutex(Mutex *mutex);                // Destroy mutex
+void LockMutex(Mutex *mutex);                   // Lock mutex (wait if locked by another thread)
+void UnlockMutex(Mutex *mutex);                 // Unlock mutex
+
+void InitCondition(Condition *cond);            // Initialize condition variable
+void DestroyCondition(Condition *cond);         // Destroy condition variable
+void WaitCondition(Condition *cond, Mutex *mutex);  // Unlock mutex and sleep until signaled, mutex locked again on return
+bool WaitConditionTimeout(Condition *cond, Mutex *mutex, double seconds);  // Same as WaitCondition(), returns false if timed out
+void SignalCondition(Condition *cond);          // Wake one thread waiting on condition
+void BroadcastCondition(Condition *cond);       // Wake all threads waiting on condition
+
+unsigned int AtomicLoad(volatile unsigned int *ptr);    // Load value, later reads/writes are not moved before it (acquire)
+void AtomicStore(volatile unsigned int *ptr, unsigned int value);   // Store value, previous reads/writes are not moved after it (release)
+unsigned int AtomicAdd(volatile unsigned int *ptr, unsigned int value); // Add value, returns previous value (full barrier)
+unsigned int AtomicExchange(volatile unsigned int *ptr, unsigned int value);    // Store value, returns previous value (full barrier)
+bool AtomicCompareExchange(volatile unsigned int *ptr, unsigned int expected, unsigned int value);  // Store value if current one is expected, returns true if stored (full barrier)
+void AtomicFence(void);                         // Full memory barrier, no reads/writes are moved across it
+
+double GetWallTime(void);                       // Get monotonic wall-clock time in seconds (any thread, no window required)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // THREADS_H
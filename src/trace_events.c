@@ -0,0 +1,387 @@
+/**********************************************************************************************
+*
+*   trace_events - Timeline spans recording, exported as Chrome trace-event JSON
+*
+*   NOTE: Check trace_events.h for details
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#include "trace_events.h"
+
+#include "raylib.h"             // Required for: TraceLog(), RL_MALLOC(), RL_FREE()
+#include "threads.h"            // Required for: THREAD_LOCAL, AtomicLoad(), AtomicStore(), GetWallTime()...
+
+#include <stdlib.h>             // Required for: malloc(), calloc(), free()
+#include <stdio.h>              // Required for: FILE, fopen(), fprintf(), fputc(), fclose()
+#include <string.h>             // Required for: memcpy(), strncpy(), strcmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define TRACE_MAX_FILENAME          256     // Maximum trace file name length
+#define TRACE_MAX_THREAD_NAME        32     // Maximum thread name length
+#define TRACE_INSTANT              -1.0     // Duration value marking instant events
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Trace event, span or instant
+typedef struct TraceEvent {
+    const char *name;               // Event name (not copied)
+    double start;                   // Start time in microseconds since InitTraceEvents()
+    double duration;                // Duration in microseconds, TRACE_INSTANT for instant events
+    char detail[TRACE_MAX_DETAIL];  // Event detail, shown as event argument
+} TraceEvent;
+
+// Thread events buffer
+// NOTE: Only owner thread writes events and open spans, head is published with AtomicStore()
+typedef struct TraceBuffer {
+    TraceEvent *events;             // Events ring buffer (TRACE_EVENTS_PER_THREAD)
+    volatile unsigned int head;     // Events written since start, next event goes to head%TRACE_EVENTS_PER_THREAD
+    volatile unsigned int base;     // First event of current owner thread, previous owners events are discarded
+    volatile unsigned int ready;    // Buffer allocated, it can be read by SaveTraceEvents()
+    volatile unsigned int owned;    // Buffer used by a running thread (0: released, events kept until reused)
+    TraceEvent spans[TRACE_MAX_DEPTH];  // Open spans, waiting for EndTraceSpan()
+    int depth;                      // Open spans count (can go over TRACE_MAX_DEPTH)
+    char threadName[TRACE_MAX_THREAD_NAME]; // Thread name shown in timeline
+} TraceBuffer;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static TraceBuffer buffers[TRACE_MAX_THREADS] = { 0 };  // Threads buffers
+static volatile unsigned int buffersCount = 0;  // Buffers claimed by threads (can go over TRACE_MAX_THREADS)
+static volatile unsigned int enabled = 0;       // Recording enabled
+static double startTime = 0.0;                  // Trace start time in seconds
+static char traceFileName[TRACE_MAX_FILENAME] = { 0 };  // Trace output file
+
+static THREAD_LOCAL int threadBuffer = -1;      // Calling thread buffer index (-1 - not claimed yet, -2 - no buffers left)
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static TraceBuffer *GetThreadBuffer(void);      // Get calling thread buffer, claimed on first use (NULL if none left)
+static int ClaimTraceBuffer(const char *name);  // Claim buffer for calling thread, released one with same name first, returns -2 if none left
+static void PushTraceEvent(TraceBuffer *buffer, const TraceEvent *event);  // Write event and publish it
+static void CopyDetail(char *dst, const char *detail);  // Copy detail, truncated
+static void WriteJsonString(FILE *file, const char *text);  // Write JSON escaped string
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Start recording
+void InitTraceEvents(const char *fileName)
+{
+    strncpy(traceFileName, fileName, TRACE_MAX_FILENAME - 1);
+    traceFileName[TRACE_MAX_FILENAME - 1] = '\0';
+
+    startTime = GetWallTime();
+    AtomicStore(&enabled, 1);
+
+    SetTraceThreadName("main");
+
+    TraceLog(LOG_INFO, "TRACE: Recording events (%i per thread), output: %s", TRACE_EVENTS_PER_THREAD, traceFileName);
+}
+
+// Stop recording, save trace and free buffers
+// NOTE: Worker threads must be finished, their buffers are freed
+void CloseTraceEvents(void)
+{
+    if (!AtomicLoad(&enabled)) return;
+
+    AtomicStore(&enabled, 0);
+    SaveTraceEvents();
+
+    unsigned int count = AtomicLoad(&buffersCount);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        RL_FREE(buffers[i].events);
+        buffers[i] = (TraceBuffer){ 0 };
+    }
+
+    AtomicStore(&buffersCount, 0);
+    threadBuffer = -1;      // NOTE: Only calling thread index can be reset
+}
+
+// Write recorded events to trace file
+// NOTE: Buffers are copied while their threads keep writing, events that could have been
+// overwritten during the copy (ring wrapped around) are discarded, open spans are not written
+bool SaveTraceEvents(void)
+{
+    FILE *file = fopen(traceFileName, "wt");
+
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "TRACE: [%s] Failed to open trace file", traceFileName);
+        return false;
+    }
+
+    TraceEvent *events = (TraceEvent *)RL_MALLOC(TRACE_EVENTS_PER_THREAD*sizeof(TraceEvent));
+    unsigned int count = AtomicLoad(&buffersCount);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+
+    int written = 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":");
+    WriteJsonString(file, traceFileName);
+    fprintf(file, "}}");
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        TraceBuffer *buffer = &buffers[i];
+        if (!AtomicLoad(&buffer->ready)) continue;
+
+        // Copy events published so far
+        unsigned int head = AtomicLoad(&buffer->head);
+        unsigned int recorded = head - AtomicLoad(&buffer->base);
+        unsigned int available = (recorded < TRACE_EVENTS_PER_THREAD)? recorded : TRACE_EVENTS_PER_THREAD;
+        unsigned int first = head - available;
+
+        for (unsigned int e = first; e != head; e++) events[e - first] = buffer->events[e%TRACE_EVENTS_PER_THREAD];
+
+        // Discard events the owner thread could have overwritten while copying
+        // NOTE: Once ring has wrapped, owner thread writes oldest slot before publishing it (head),
+        // one more event than published ones could be partially overwritten (not if released)
+        AtomicFence();
+        unsigned int headAfter = AtomicLoad(&buffer->head);
+        unsigned int overwritten = headAfter - head;
+        if ((head >= TRACE_EVENTS_PER_THREAD) && AtomicLoad(&buffer->owned)) overwritten++;
+        unsigned int skip = (overwritten > available)? available : overwritten;
+
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", i);
+        WriteJsonString(file, (buffer->threadName[0] != '\0')? buffer->threadName : "thread");
+        fprintf(file, "}}");
+
+        for (unsigned int e = skip; e < available; e++)
+        {
+            const TraceEvent *event = &events[e];
+
+            fprintf(file, ",\n{\"name\":");
+            WriteJsonString(file, event->name);
+
+            if (event->duration == TRACE_INSTANT) fprintf(file, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", event->start);
+            else fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", event->start, event->duration);
+
+            fprintf(file, ",\"pid\":1,\"tid\":%u", i);
+
+            if (event->detail[0] != '\0')
+            {
+                fprintf(file, ",\"args\":{\"detail\":");
+                WriteJsonString(file, event->detail);
+                fprintf(file, "}");
+            }
+
+            fprintf(file, "}");
+            written++;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    RL_FREE(events);
+
+    TraceLog(LOG_INFO, "TRACE: [%s] Trace saved (%i events)", traceFileName, written);
+
+    return true;
+}
+
+// Begin span on calling thread
+void BeginTraceSpan(const char *name, const char *detail)
+{
+    if (!AtomicLoad(&enabled)) return;
+
+    TraceBuffer *buffer = GetThreadBuffer();
+    if (buffer == NULL) return;
+
+    if (buffer->depth < TRACE_MAX_DEPTH)
+    {
+        TraceEvent *span = &buffer->spans[buffer->depth];
+        span->name = name;
+        CopyDetail(span->detail, detail);
+        span->start = (GetWallTime() - startTime)*1000000.0;
+    }
+
+    buffer->depth++;
+}
+
+// End last span begun on calling thread
+void EndTraceSpan(void)
+{
+    if (!AtomicLoad(&enabled)) return;
+
+    TraceBuffer *buffer = GetThreadBuffer();
+    if ((buffer == NULL) || (buffer->depth == 0)) return;
+
+    buffer->depth--;
+
+    if (buffer->depth < TRACE_MAX_DEPTH)
+    {
+        TraceEvent *span = &buffer->spans[buffer->depth];
+        span->duration = (GetWallTime() - startTime)*1000000.0 - span->start;
+
+        PushTraceEvent(buffer, span);
+    }
+}
+
+// Record instant event on calling thread
+void TraceInstantEvent(const char *name, const char *detail)
+{
+    if (!AtomicLoad(&enabled)) return;
+
+    TraceBuffer *buffer = GetThreadBuffer();
+    if (buffer == NULL) return;
+
+    TraceEvent event = { 0 };
+    event.name = name;
+    event.start = (GetWallTime() - startTime)*1000000.0;
+    event.duration = TRACE_INSTANT;
+    CopyDetail(event.detail, detail);
+
+    PushTraceEvent(buffer, &event);
+}
+
+// Set calling thread name shown in timeline
+// NOTE: A thread without buffer yet continues the released buffer of a previous thread
+// with same name (i.e. worker started again), same timeline track
+void SetTraceThreadName(const char *name)
+{
+    if (!AtomicLoad(&enabled)) return;
+
+    if (threadBuffer == -1) threadBuffer = ClaimTraceBuffer(name);
+
+    TraceBuffer *buffer = GetThreadBuffer();
+    if (buffer == NULL) return;
+
+    strncpy(buffer->threadName, name, TRACE_MAX_THREAD_NAME - 1);
+    buffer->threadName[TRACE_MAX_THREAD_NAME - 1] = '\0';
+}
+
+// Release calling thread buffer (call before thread exits)
+// NOTE: Released buffer events are kept (saved with trace) until another thread reuses it
+void ReleaseTraceThread(void)
+{
+    if (threadBuffer >= 0) AtomicStore(&buffers[threadBuffer].owned, 0);
+
+    threadBuffer = -1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get calling thread buffer, claimed on first use
+static TraceBuffer *GetThreadBuffer(void)
+{
+    if (threadBuffer == -1) threadBuffer = ClaimTraceBuffer(NULL);
+
+    return (threadBuffer >= 0)? &buffers[threadBuffer] : NULL;
+}
+
+// Claim buffer for calling thread
+// NOTE: Order: released buffer with same thread name (events continue), unused buffer,
+// any released buffer (previous thread events are discarded)
+static int ClaimTraceBuffer(const char *name)
+{
+    unsigned int count = AtomicLoad(&buffersCount);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+
+    if (name != NULL)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            TraceBuffer *buffer = &buffers[i];
+
+            // NOTE: Buffer is owned before reading its name, released again if name does not match
+            if (AtomicLoad(&buffer->ready) && AtomicCompareExchange(&buffer->owned, 0, 1))
+            {
+                if (strcmp(buffer->threadName, name) == 0)
+                {
+                    buffer->depth = 0;
+                    return (int)i;
+                }
+
+                AtomicStore(&buffer->owned, 0);
+            }
+        }
+    }
+
+    if (count < TRACE_MAX_THREADS)
+    {
+        unsigned int index = AtomicAdd(&buffersCount, 1);
+
+        if (index < TRACE_MAX_THREADS)
+        {
+            TraceBuffer *buffer = &buffers[index];
+            buffer->events = (TraceEvent *)RL_CALLOC(TRACE_EVENTS_PER_THREAD, sizeof(TraceEvent));
+            buffer->head = 0;
+            buffer->base = 0;
+            buffer->depth = 0;
+            buffer->owned = 1;
+            AtomicStore(&buffer->ready, 1);
+
+            return (int)index;
+        }
+    }
+
+    for (unsigned int i = 0; i < TRACE_MAX_THREADS; i++)
+    {
+        TraceBuffer *buffer = &buffers[i];
+
+        if (AtomicLoad(&buffer->ready) && AtomicCompareExchange(&buffer->owned, 0, 1))
+        {
+            buffer->depth = 0;
+            buffer->threadName[0] = '\0';
+            AtomicStore(&buffer->base, buffer->head);
+            return (int)i;
+        }
+    }
+
+    TraceLog(LOG_WARNING, "TRACE: Maximum number of threads running (%i), thread events ignored", TRACE_MAX_THREADS);
+
+    return -2;
+}
+
+// Write event and publish it
+static void PushTraceEvent(TraceBuffer *buffer, const TraceEvent *event)
+{
+    unsigned int head = buffer->head;      // NOTE: Only this thread writes head, no atomic load required
+
+    memcpy(&buffer->events[head%TRACE_EVENTS_PER_THREAD], event, sizeof(TraceEvent));
+    AtomicStore(&buffer->head, head + 1);
+}
+
+// Copy detail, truncated
+static void CopyDetail(char *dst, const char *detail)
+{
+    if (detail == NULL) dst[0] = '\0';
+    else
+    {
+        strncpy(dst, detail, TRACE_MAX_DETAIL - 1);
+        dst[TRACE_MAX_DETAIL - 1] = '\0';
+    }
+}
+
+// Write JSON escaped string
+static void WriteJsonString(FILE *file, const char *text)
+{
+    fputc('"', file);
+
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if ((*c == '"') || (*c == '\\')) fprintf(file, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) fprintf(file, "\\u%04x", (unsigned char)*c);
+        else fputc(*c, file);
+    }
+
+    fputc('"', file);
+}
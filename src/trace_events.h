@@ -0,0 +1,77 @@
+/**********************************************************************************************
+*
+*   trace_events - Timeline spans recording, exported as Chrome trace-event JSON
+*
+*   Spans (begin/end pairs) and instant events are recorded by any thread into its own
+*   ring buffer, no locks involved: each thread is the only writer of its buffer and
+*   publishes new events with an atomic store. Buffers keep the latest TRACE_EVENTS_PER_THREAD
+*   events per thread (flight recorder), older ones are overwritten.
+*
+*   SaveTraceEvents() writes all buffers to a JSON file that can be opened with Perfetto
+*   (ui.perfetto.dev) or chrome://tracing, while threads keep recording.
+*
+*   Worker threads call ReleaseTraceThread() before exiting: buffer events are kept and the
+*   buffer is reused by next thread, a thread named like the previous owner (SetTraceThreadName(),
+*   i.e. worker started again) continues in the same timeline track.
+*
+*   Span names must be string literals (or live until trace is closed), only the pointer
+*   is stored; details (i.e. file names) are copied, truncated to TRACE_MAX_DETAIL chars.
+*
+*   CONFIGURATION:
+*       #define TRACE_EVENTS_PER_THREAD
+*           Events kept per thread (power of two), older events are overwritten
+*
+*   USAGE:
+*       InitTraceEvents("trace.json");          // Calling thread is named "main"
+*
+*       BeginTraceSpan("LoadTexture", "resources/ball.png");
+*       texBall = LoadTexture("resources/ball.png");
+*       EndTraceSpan();
+*
+*       if (IsKeyPressed(KEY_F8)) SaveTraceEvents();
+*
+*       CloseTraceEvents();                     // Save trace and free buffers
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(TRACE_EVENTS_PER_THREAD)
+    #define TRACE_EVENTS_PER_THREAD  16384      // Events kept per thread (~1.1 MB), several seconds of frames
+#endif
+#define TRACE_MAX_THREADS               8       // Maximum threads recording at the same time, later threads are ignored
+#define TRACE_MAX_DEPTH                32       // Maximum nested spans per thread, deeper spans are ignored
+#define TRACE_MAX_DETAIL               40       // Maximum event detail length (including '\0')
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitTraceEvents(const char *fileName);     // Start recording, trace is saved to fileName
+void CloseTraceEvents(void);                    // Stop recording, save trace and free buffers (call after worker threads are joined)
+bool SaveTraceEvents(void);                     // Write recorded events to trace file, recording continues
+
+void BeginTraceSpan(const char *name, const char *detail);  // Begin span on calling thread (detail can be NULL)
+void EndTraceSpan(void);                        // End last span begun on calling thread
+void TraceInstantEvent(const char *name, const char *detail);   // Record instant event on calling thread (detail can be NULL)
+void SetTraceThreadName(const char *name);      // Set calling thread name shown in timeline
+void ReleaseTraceThread(void);                  // Release calling thread buffer, events kept (call before worker thread exits)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // TRACE_EVENTS_H
@@ -0,0 +1,248 @@
+/*******************************************************************************************
+*
+*   enemy_policy_bench - PONG enemy MLP policy inference cost next to scripted chase logic
+*
+*   Thousands of matches are played by MLP enemies (weights file or random weights), then:
+*     - One match and batch MLP evaluations are compared every step, exit code 1 on any
+*       different decision
+*     - Cost per match of chase logic (scalar and batch simulation steps) and MLP inference
+*       (one match and batch) is measured in nanoseconds
+*
+*   USAGE:
+*       enemy_policy_bench [--matches <count>] [--steps <count>] [--seed <value>] [--weights <file.mlp>]
+*
+*         --matches <count>   Matches stepped at once, default: 4096
+*         --steps <count>     Simulation steps, default: 1000
+*         --seed <value>      Random weights, initial states and inputs seed, default: 1
+*         --weights <file>    MLP weights file (check src/enemy_policy.h), default: random weights
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o enemy_policy_bench enemy_policy_bench.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"               // Game simulation: PongGame, UpdatePongGame()...
+#include "pong_batch.h"             // Batch simulation: PongBatch, UpdatePongBatch()...
+#include "enemy_policy.h"           // Enemy policies: EnemyPolicy, ApplyEnemyPolicyBatch()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), malloc(), free()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int matchesCount = 4096;
+static int stepsCount = 1000;
+static unsigned int seed = 1;
+static const char *weightsFile = NULL;
+
+static volatile int sink = 0;       // Keeps timed results alive
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);         // Get pseudo-random value (xorshift32)
+static float GetRandomWeight(unsigned int *state);          // Get pseudo-random weight in [-1, 1]
+static void InitRandomPolicy(EnemyPolicy *policy, unsigned int *state);    // Initialize MLP policy with random weights
+static void InitRandomMatch(PongGame *game, unsigned int *state);   // Initialize match with random ball state
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--matches")) matchesCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--steps")) stepsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--seed")) seed = (unsigned int)atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--weights")) weightsFile = argv[++i];
+    }
+
+    if (matchesCount < 1) matchesCount = 1;
+    if (stepsCount < 1) stepsCount = 1;
+    if (seed == 0) seed = 1;        // NOTE: xorshift state can not be 0
+
+    unsigned int state = seed;
+
+    EnemyPolicy policy = { 0 };
+    if (weightsFile != NULL) policy = LoadEnemyPolicy(weightsFile);
+    else InitRandomPolicy(&policy, &state);
+
+    if (policy.type != ENEMY_POLICY_MLP)
+    {
+        printf("MLP policy not available\n");
+        return 1;
+    }
+
+    PongGame *games = (PongGame *)malloc(matchesCount*sizeof(PongGame));
+    PongBatch batch = LoadPongBatch(matchesCount, 800, 600);
+    int *inputs = (int *)malloc(batch.capacity*sizeof(int));
+
+    for (int i = 0; i < matchesCount; i++)
+    {
+        InitRandomMatch(&games[i], &state);
+        SetPongBatchMatch(&batch, i, &games[i]);
+    }
+
+    printf("enemy policy: %i matches, %i steps, %ix%ix%i MLP, backend %s (%i lanes)\n", matchesCount, stepsCount,
+        ENEMY_MLP_INPUTS, ENEMY_MLP_HIDDEN, ENEMY_MLP_OUTPUTS, GetPongBatchBackend(), GetPongBatchLanes());
+    //--------------------------------------------------------------------------------------
+
+    // Check: one match vs batch decisions, every match after every step
+    //--------------------------------------------------------------------------------------
+    int mismatches = 0;
+    int moves[3] = { 0 };
+
+    for (int step = 0; (step < stepsCount) && (mismatches == 0); step++)
+    {
+        for (int i = 0; i < batch.capacity; i++) inputs[i] = (int)(GetRandom(&state)%4);     // Player up/down
+
+        ApplyEnemyPolicyBatch(&policy, &batch, inputs);
+
+        for (int i = 0; i < matchesCount; i++)
+        {
+            PongGame match = { 0 };
+            GetPongBatchMatch(&batch, i, &match);
+
+            int move = GetEnemyPolicyMove(&policy, &match);
+            int batchMove = (inputs[i] & PONG_INPUT_ENEMY_UP)? -1 : (inputs[i] & PONG_INPUT_ENEMY_DOWN)? 1 : 0;
+
+            if (!(inputs[i] & PONG_INPUT_ENEMY_CONTROLLED) || (move != batchMove))
+            {
+                if (mismatches == 0) printf("MISMATCH: match %i, step %i: move %i vs batch %i\n", i, step, move, batchMove);
+                mismatches++;
+            }
+
+            moves[move + 1]++;
+        }
+
+        UpdatePongBatch(&batch, inputs);
+    }
+
+    if (mismatches == 0)
+    {
+        printf("check: %i matches, same decisions after %i steps (up %i, stay %i, down %i)\n",
+            matchesCount, stepsCount, moves[0], moves[1], moves[2]);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // Cost per match: chase steps vs MLP inference
+    // NOTE: Inference is timed alone and with simulation step, inputs are kept constant
+    //--------------------------------------------------------------------------------------
+    PongInput chaseInput = { 0 };
+    double start = GetWallTime();
+    for (int step = 0; step < stepsCount; step++)
+    {
+        for (int i = 0; i < matchesCount; i++) UpdatePongGame(&games[i], chaseInput);
+    }
+    double chaseTime = GetWallTime() - start;
+
+    start = GetWallTime();
+    for (int step = 0; step < stepsCount; step++)
+    {
+        for (int i = 0; i < matchesCount; i++) sink += GetEnemyPolicyMove(&policy, &games[i]);
+    }
+    double mlpTime = GetWallTime() - start;
+
+    start = GetWallTime();
+    for (int step = 0; step < stepsCount; step++)
+    {
+        for (int i = 0; i < matchesCount; i++)
+        {
+            PongInput input = { 0 };
+            ApplyEnemyPolicy(&policy, &games[i], &input);
+            UpdatePongGame(&games[i], input);
+        }
+    }
+    double mlpStepTime = GetWallTime() - start;
+
+    start = GetWallTime();
+    for (int step = 0; step < stepsCount; step++) UpdatePongBatch(&batch, NULL);
+    double batchChaseTime = GetWallTime() - start;
+
+    start = GetWallTime();
+    for (int step = 0; step < stepsCount; step++)
+    {
+        for (int i = 0; i < batch.capacity; i++) inputs[i] = 0;
+        ApplyEnemyPolicyBatch(&policy, &batch, inputs);
+    }
+    double batchMlpTime = GetWallTime() - start;
+
+    double toNs = 1e9/((double)matchesCount*stepsCount);
+
+    printf("scalar chase step:          %7.1f ns/match\n", chaseTime*toNs);
+    printf("scalar mlp inference:       %7.1f ns/match\n", mlpTime*toNs);
+    printf("scalar mlp inference+step:  %7.1f ns/match\n", mlpStepTime*toNs);
+    printf("batch chase step:           %7.1f ns/match\n", batchChaseTime*toNs);
+    printf("batch mlp inference:        %7.1f ns/match\n", batchMlpTime*toNs);
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    UnloadPongBatch(batch);
+
+    free(games);
+    free(inputs);
+    //--------------------------------------------------------------------------------------
+
+    return (mismatches == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get pseudo-random value (xorshift32)
+static unsigned int GetRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    *state = x;
+
+    return x;
+}
+
+// Get pseudo-random weight in [-1, 1]
+static float GetRandomWeight(unsigned int *state)
+{
+    return (float)(GetRandom(state)%20001)/10000.0f - 1.0f;
+}
+
+// Initialize MLP policy with random weights
+// NOTE: Weights layout does not matter for random values, filled as one float array
+static void InitRandomPolicy(EnemyPolicy *policy, unsigned int *state)
+{
+    float *weights = (float *)&policy->mlp;
+    int count = sizeof(EnemyMlp)/sizeof(float);
+
+    for (int i = 0; i < count; i++) weights[i] = GetRandomWeight(state);
+
+    policy->type = ENEMY_POLICY_MLP;
+}
+
+// Initialize match with random ball state
+static void InitRandomMatch(PongGame *game, unsigned int *state)
+{
+    InitPongGame(game, 800, 600);
+
+    game->ballPosition.x = 40.0f + (float)(GetRandom(state)%720);
+    game->ballPosition.y = 40.0f + (float)(GetRandom(state)%520);
+    game->ballSpeedX = (3 + (int)(GetRandom(state)%6))*((GetRandom(state)%2)? 1 : -1);
+    game->ballSpeedY = (2 + (int)(GetRandom(state)%6))*((GetRandom(state)%2)? 1 : -1);
+    game->enemy.y = (float)(GetRandom(state)%500);
+}
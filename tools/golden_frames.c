@@ -0,0 +1,344 @@
+/*******************************************************************************************
+*
+*   golden_frames - Headless games screens rendering, golden images and CPU timings
+*
+*   Every screen of every game (blocks, pong) is rendered with the software renderer
+*   (no window, no GPU), exported as PNG and timed, so:
+*     - Rendering changes can be checked against reference images (--compare), i.e. on CI
+*     - CPU rendering cost per screen is measured without GPU or vsync interference
+*
+*   Games state is reproduced with game core simulations and scripted inputs, screens are
+*   drawn by the same code games run (src/screen_draw.h) with softrender draw backend;
+*   blink phases are fixed so blinking texts are drawn, pong logo is captured fully faded-in
+*
+*   USAGE:
+*       golden_frames [--output <dir>] [--compare <dir>] [--frames <count>] [--clip <file.gif>]
+*
+*         --output <dir>      Directory to export frames into, default: golden
+*         --compare <dir>     Directory with reference frames, exit code 1 on any difference
+*                             (references are kept in tools/golden, 'make golden' updates them)
+*         --frames <count>    Frames rendered per screen to measure timings, default: 100
+*         --clip <file>       Record blocks gameplay clip (GIF, or raw frames if not .gif) and
+*                             measure main thread capture cost
+*
+*   NOTE: Tool must be run from tools directory (games resources are loaded from ../lessons/resources
+*   and ../pong/resources). raylib default font can not be loaded without a GPU context,
+*   DrawText() calls are rendered with pixantiqua font instead
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o golden_frames golden_frames.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "blocks_sim.h"             // Game simulation: BlocksGame, UpdateBlocksGame()...
+#include "pong_sim.h"               // Game simulation: PongGame, UpdatePongGame()...
+#include "screens.h"                // Screens management: GameScreen, GetScreenName()
+#include "screen_draw.h"            // Games screens drawing: DrawBlocksScreen(), DrawPongScreen()...
+#include "softrender.h"             // CPU software rasterizer: LoadSoftTexture(), ExportSoftFramebuffer()...
+#include "clip_recorder.h"          // Clips recording: StartClipRecording(), CaptureClipFrame()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BLOCKS_RESOURCES_PATH   "../lessons/resources/"
+#define PONG_RESOURCES_PATH     "../pong/resources/"
+
+#define GAMEPLAY_STEPS          120     // Simulation steps run before GAMEPLAY screen capture
+#define CLIP_STEPS              600     // Simulation steps recorded in clip (10 seconds at 60 fps)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Golden frames run results
+typedef struct GoldenReport {
+    int framesExported;             // Frames exported successfully
+    int framesMismatched;           // Frames different from reference (or reference missing)
+} GoldenReport;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const char *outputPath = "golden";
+static const char *comparePath = NULL;
+static int framesCount = 100;
+static const char *clipFileName = NULL;
+
+// Blocks resources
+static SoftTexture texBlocksLogo = { 0 };
+static SoftTexture texBall = { 0 };
+static SoftTexture texPaddle = { 0 };
+static SoftTexture texBrick = { 0 };
+static SoftFont fntBlocks = { 0 };
+static BlocksScreenAssets blocksAssets = { 0 };
+static BlocksScreenView blocksView = { 0 };
+
+// Pong resources
+static SoftTexture texPongLogo = { 0 };
+static SoftFont fntPongTitle = { 0 };
+static PongScreenAssets pongAssets = { 0 };
+static PongScreenView pongView = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void RenderGameScreen(const char *gameName, GameScreen screen, SoftFramebuffer *target,
+                             void (*DrawScreen)(GameScreen), GoldenReport *report);   // Render, time, export and compare game screen
+static int CompareSoftFramebuffer(SoftFramebuffer target, const char *fileName);  // Compare framebuffer with reference image, returns different pixels (-1 on error)
+static void RecordBlocksClip(SoftFramebuffer *target);     // Record blocks gameplay clip with scripted inputs
+
+static void DrawBlocksScreenCallback(GameScreen screen) { DrawBlocksScreen(GetScreenDrawBackend(SCREEN_DRAW_SOFT), screen, &blocksAssets, blocksView); }
+static void DrawPongScreenCallback(GameScreen screen) { DrawPongScreen(GetScreenDrawBackend(SCREEN_DRAW_SOFT), screen, &pongAssets, pongView); }
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--output")) outputPath = argv[++i];
+        else if (TextIsEqual(argv[i], "--compare")) comparePath = argv[++i];
+        else if (TextIsEqual(argv[i], "--frames")) framesCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--clip")) clipFileName = argv[++i];
+    }
+
+    if (framesCount < 1) framesCount = 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (!DirectoryExists(outputPath))
+    {
+        TraceLog(LOG_ERROR, "GOLDEN: Output directory not found: %s", outputPath);
+        return 1;
+    }
+
+    // NOTE: Only CPU resources are loaded, no window required
+    texBlocksLogo = LoadSoftTexture(BLOCKS_RESOURCES_PATH "raylib_logo.png");
+    texBall = LoadSoftTexture(BLOCKS_RESOURCES_PATH "ball.png");
+    texPaddle = LoadSoftTexture(BLOCKS_RESOURCES_PATH "paddle.png");
+    texBrick = LoadSoftTexture(BLOCKS_RESOURCES_PATH "brick.png");
+    fntBlocks = LoadSoftFont(BLOCKS_RESOURCES_PATH "setback.png", 0);
+
+    texPongLogo = LoadSoftTexture(PONG_RESOURCES_PATH "logo_raylib.png");
+    fntPongTitle = LoadSoftFont(PONG_RESOURCES_PATH "pixantiqua.ttf", 12);
+
+    blocksAssets.logo = (ScreenTexture){ &texBlocksLogo, texBlocksLogo.width, texBlocksLogo.height };
+    blocksAssets.paddle = (ScreenTexture){ &texPaddle, texPaddle.width, texPaddle.height };
+    blocksAssets.ball = (ScreenTexture){ &texBall, texBall.width, texBall.height };
+    blocksAssets.brick = (ScreenTexture){ &texBrick, texBrick.width, texBrick.height };
+    blocksAssets.font = (ScreenFont){ &fntBlocks, fntBlocks.baseSize };
+
+    pongAssets.logo = (ScreenTexture){ &texPongLogo, texPongLogo.width, texPongLogo.height };
+    pongAssets.titleFont = (ScreenFont){ &fntPongTitle, fntPongTitle.baseSize };
+
+    // Default font replacement, same base size as raylib default font
+    SoftFont fntDefault = LoadSoftFont(PONG_RESOURCES_PATH "pixantiqua.ttf", 10);
+    SetSoftFontDefault(fntDefault);
+
+    SoftFramebuffer blocksTarget = LoadSoftFramebuffer(800, 450);
+    SoftFramebuffer pongTarget = LoadSoftFramebuffer(800, 600);
+
+    GoldenReport report = { 0 };
+    //--------------------------------------------------------------------------------------
+
+    printf("%-8s %-10s %10s %10s\n", "GAME", "SCREEN", "ms/frame", "CPU fps");
+
+    // Blocks game screens
+    // NOTE: GAMEPLAY state comes from a launch and free ball steps, ENDING stats are counted
+    // from those steps events, same as game gameplay events
+    BlocksGame blocks = { 0 };
+    InitBlocksGame(&blocks, blocksTarget.width, blocksTarget.height);
+
+    blocksView.game = &blocks;
+    blocksView.screenWidth = blocksTarget.width;
+    blocksView.screenHeight = blocksTarget.height;
+    blocksView.blink = true;        // Blinking texts drawn on RedrawBlink() true phase
+
+    for (int i = 0; i < GAMEPLAY_STEPS; i++)
+    {
+        unsigned int events = UpdateBlocksGame(&blocks, (BlocksInput){ .launch = (i == 0) });
+
+        if (events & BLOCKS_EVENT_PADDLE_HIT) blocksView.paddleHits++;
+        if (events & BLOCKS_EVENT_BALL_LOST) blocksView.lifesLost++;
+        blocksView.bricksDestroyed += blocks.hitBricksCount;
+    }
+
+    for (int s = SCREEN_LOGO; s <= SCREEN_ENDING; s++) RenderGameScreen("blocks", s, &blocksTarget, DrawBlocksScreenCallback, &report);
+
+    // Pong game screens
+    // NOTE: GAMEPLAY state comes from enemy AI and free ball steps
+    PongGame pong = { 0 };
+    InitPongGame(&pong, pongTarget.width, pongTarget.height);
+
+    pongView.game = &pong;
+    pongView.blink = false;         // Blinking text drawn on RedrawBlink() false phase
+    pongView.logoAlpha = 1.0f;
+
+    for (int i = 0; i < GAMEPLAY_STEPS; i++) UpdatePongGame(&pong, (PongInput){ 0 });
+
+    for (int s = SCREEN_LOGO; s <= SCREEN_ENDING; s++) RenderGameScreen("pong", s, &pongTarget, DrawPongScreenCallback, &report);
+
+    if (clipFileName != NULL) RecordBlocksClip(&blocksTarget);
+
+    printf("\n%i frames exported to %s", report.framesExported, outputPath);
+    if (comparePath != NULL) printf(", %i different from %s", report.framesMismatched, comparePath);
+    printf("\n");
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    UnloadSoftFramebuffer(blocksTarget);
+    UnloadSoftFramebuffer(pongTarget);
+
+    UnloadSoftTexture(texBlocksLogo);
+    UnloadSoftTexture(texBall);
+    UnloadSoftTexture(texPaddle);
+    UnloadSoftTexture(texBrick);
+    UnloadSoftFont(fntBlocks);
+
+    UnloadSoftTexture(texPongLogo);
+    UnloadSoftFont(fntPongTitle);
+    UnloadSoftFont(fntDefault);
+    //--------------------------------------------------------------------------------------
+
+    return (report.framesMismatched > 0)? 1 : 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Render game screen, measure timings, export frame and compare it with reference
+static void RenderGameScreen(const char *gameName, GameScreen screen, SoftFramebuffer *target,
+                             void (*DrawScreen)(GameScreen), GoldenReport *report)
+{
+    double start = GetWallTime();
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        BeginSoftDrawing(target);
+            DrawScreen(screen);
+        EndSoftDrawing();
+    }
+
+    double msPerFrame = 1000.0*(GetWallTime() - start)/framesCount;
+
+    printf("%-8s %-10s %10.3f %10.1f\n", gameName, GetScreenName(screen), msPerFrame, (msPerFrame > 0.0)? 1000.0/msPerFrame : 0.0);
+
+    const char *fileName = TextFormat("%s_%s.png", gameName, TextToLower(GetScreenName(screen)));
+
+    if (ExportSoftFramebuffer(*target, TextFormat("%s/%s", outputPath, fileName))) report->framesExported++;
+    else TraceLog(LOG_WARNING, "GOLDEN: [%s] Frame could not be exported", fileName);
+
+    if (comparePath != NULL)
+    {
+        int differences = CompareSoftFramebuffer(*target, TextFormat("%s/%s", comparePath, fileName));
+
+        if (differences != 0)
+        {
+            if (differences < 0) TraceLog(LOG_WARNING, "GOLDEN: [%s] Reference frame not found or size mismatch", fileName);
+            else TraceLog(LOG_WARNING, "GOLDEN: [%s] Frame differs from reference (%i pixels)", fileName, differences);
+
+            report->framesMismatched++;
+        }
+    }
+}
+
+// Compare framebuffer with reference image, returns different pixels (-1 on error)
+// NOTE: Exported frames are opaque, alpha is not compared
+static int CompareSoftFramebuffer(SoftFramebuffer target, const char *fileName)
+{
+    if (!FileExists(fileName)) return -1;
+
+    Image reference = LoadImage(fileName);
+
+    if ((reference.width != target.width) || (reference.height != target.height))
+    {
+        UnloadImage(reference);
+        return -1;
+    }
+
+    Color *pixels = LoadImageColors(reference);
+    int differences = 0;
+
+    for (int i = 0; i < target.width*target.height; i++)
+    {
+        if ((pixels[i].r != target.pixels[i].r) ||
+            (pixels[i].g != target.pixels[i].g) ||
+            (pixels[i].b != target.pixels[i].b)) differences++;
+    }
+
+    UnloadImageColors(pixels);
+    UnloadImage(reference);
+
+    return differences;
+}
+
+// Record blocks gameplay clip with scripted inputs
+// NOTE: Paddle follows the ball, one out of two frames is captured (30 fps clip),
+// only CaptureClipFrame() cost is paid here, encoding happens on recorder worker
+static void RecordBlocksClip(SoftFramebuffer *target)
+{
+    ClipFormat format = IsFileExtension(clipFileName, ".gif")? CLIP_FORMAT_GIF : CLIP_FORMAT_RAW;
+
+    if (!StartClipRecording(clipFileName, target->width, target->height, 30, format)) return;
+
+    BlocksGame game = { 0 };
+    InitBlocksGame(&game, target->width, target->height);
+
+    BlocksScreenView view = blocksView;
+    view.game = &game;
+
+    double captureTime = 0.0;
+    double captureTimeMax = 0.0;
+    int captures = 0;
+
+    for (int i = 0; i < CLIP_STEPS; i++)
+    {
+        BlocksInput input = { 0 };
+        float paddleCenter = game.player.position.x + game.player.size.x/2;
+        input.left = (game.ball.position.x < (paddleCenter - 10));
+        input.right = (game.ball.position.x > (paddleCenter + 10));
+        input.launch = !game.ball.active;
+
+        UpdateBlocksGame(&game, input);
+
+        BeginSoftDrawing(target);
+            DrawBlocksScreen(GetScreenDrawBackend(SCREEN_DRAW_SOFT), SCREEN_GAMEPLAY, &blocksAssets, view);
+        EndSoftDrawing();
+
+        if (i%2 == 0)
+        {
+            double start = GetWallTime();
+            CaptureClipFrame(target->pixels);
+            double elapsed = GetWallTime() - start;
+
+            captureTime += elapsed;
+            if (elapsed > captureTimeMax) captureTimeMax = elapsed;
+            captures++;
+        }
+
+        UpdateClipRecorder();
+    }
+
+    double stopStart = GetWallTime();
+    ClipRecorderStats stats = GetClipRecorderStats();
+    StopClipRecording();
+
+    printf("\nclip %s: %i frames captured, %i dropped, capture %.3f ms/frame (max %.3f ms), %i frames pending encoded on stop in %.1f ms\n",
+        clipFileName, stats.framesCaptured, stats.framesDropped, 1000.0*captureTime/captures, 1000.0*captureTimeMax,
+        stats.framesPending, 1000.0*(GetWallTime() - stopStart));
+}
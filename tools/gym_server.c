@@ -0,0 +1,232 @@
+/*******************************************************************************************
+*
+*   gym_server - Vectorized environments server over shared memory, for external trainers
+*
+*   A batch of pong or blocks environments (gym_env) is exposed in a named shared memory
+*   region (gym_shm), trainer process writes actions and requests resets/steps, server
+*   runs them until trainer sends close command (or no request arrives for --timeout seconds)
+*
+*   With --bench, no external trainer is needed: environments are stepped directly and then
+*   through shared memory by a trainer thread with random actions, measuring throughput
+*
+*   USAGE:
+*       gym_server [--env pong|blocks] [--envs <count>] [--name <region>] [--seed <value>]
+*                  [--timeout <seconds>] [--bench <steps>] [--pixels <size>] [--enemy <file.mlp>]
+*
+*         --env <type>        Environment type, default: pong
+*         --envs <count>      Environments stepped at once, default: 4096
+*         --name <region>     Shared memory region name, default: raylib_gym
+*         --seed <value>      Episodes random seed, default: 1
+*         --timeout <sec>     Exit if no request arrives in time, default: 60
+*         --bench <steps>     Measure direct and shared memory steps throughput and exit
+*         --pixels <size>     With --bench, also measure <size>x<size> pixel observations rendering
+*         --enemy <file>      Pong enemy MLP policy weights (check src/enemy_policy.h), default: chase
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o gym_server gym_server.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   NOTE: Region layout and handshake are described in src/gym_shm.h
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "gym_env.h"                // Environments: GymEnv, StepGymEnv()...
+#include "gym_shm.h"                // Shared memory transport: GymShared, ServeGymShared()...
+#include "pixel_obs.h"              // Pixel observations: RenderGymEnvPixels()
+#include "enemy_policy.h"           // Enemy policies: EnemyPolicy, LoadEnemyPolicy()
+#include "threads.h"                // Threads: Thread, StartThread(), JoinThread(), GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), atof(), malloc(), free()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int envType = GYM_ENV_PONG;
+static int envsCount = 4096;
+static const char *regionName = "raylib_gym";
+static unsigned int seed = 1;
+static double timeout = 60.0;
+static int benchSteps = 0;
+static int pixelsSize = 0;
+static const char *enemyWeights = NULL;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);         // Get pseudo-random value (xorshift32)
+static void TrainerThread(void *arg);                       // Bench trainer: reset, random actions steps, close
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--env")) envType = TextIsEqual(argv[++i], "blocks")? GYM_ENV_BLOCKS : GYM_ENV_PONG;
+        else if (TextIsEqual(argv[i], "--envs")) envsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--name")) regionName = argv[++i];
+        else if (TextIsEqual(argv[i], "--seed")) seed = (unsigned int)atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--timeout")) timeout = atof(argv[++i]);
+        else if (TextIsEqual(argv[i], "--bench")) benchSteps = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--pixels")) pixelsSize = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--enemy")) enemyWeights = argv[++i];
+    }
+
+    if (envsCount < 1) envsCount = 1;
+
+    GymEnvConfig config = GetGymEnvConfigDefault();
+    config.seed = seed;
+
+    EnemyPolicy enemyPolicy = { 0 };
+    if (enemyWeights != NULL) enemyPolicy = LoadEnemyPolicy(enemyWeights);
+    if (enemyPolicy.type == ENEMY_POLICY_MLP) config.enemyPolicy = &enemyPolicy;
+
+    GymEnv env = LoadGymEnv(envType, envsCount, config);
+    //--------------------------------------------------------------------------------------
+
+    // Bench: direct steps, environments own buffers
+    //--------------------------------------------------------------------------------------
+    if (benchSteps > 0)
+    {
+        int *actions = (int *)malloc(envsCount*sizeof(int));
+        unsigned int state = (seed == 0)? 1 : seed;
+
+        for (int i = 0; i < envsCount; i++) actions[i] = (int)(GetRandom(&state)%env.actionsCount);
+
+        ResetGymEnv(&env);
+
+        double start = GetWallTime();
+        for (int step = 0; step < benchSteps; step++) StepGymEnv(&env, actions);
+        double elapsed = GetWallTime() - start;
+
+        printf("direct: %i steps x %i envs, %.1f ms, %.2f M env-steps/sec\n", benchSteps, envsCount, elapsed*1000.0, (double)benchSteps*envsCount/elapsed/1e6);
+
+        // Pixel observations rendered after every step, rendering timed alone
+        if (pixelsSize > 0)
+        {
+            unsigned char *pixels = (unsigned char *)malloc((size_t)envsCount*pixelsSize*pixelsSize);
+            double renderTime = 0.0;
+
+            for (int step = 0; step < benchSteps; step++)
+            {
+                StepGymEnv(&env, actions);
+
+                double renderStart = GetWallTime();
+                RenderGymEnvPixels(&env, pixels, pixelsSize, pixelsSize, PIXEL_OBS_GRAYSCALE);
+                renderTime += GetWallTime() - renderStart;
+            }
+
+            printf("pixels: %ix%i, %.1f ms, %.2f M observations/sec\n", pixelsSize, pixelsSize, renderTime*1000.0, (double)benchSteps*envsCount/renderTime/1e6);
+
+            free(pixels);
+        }
+
+        free(actions);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // Serve requests until trainer closes (or times out)
+    //--------------------------------------------------------------------------------------
+    GymShared shared = CreateGymShared(regionName, &env);
+
+    if (shared.region.memory == NULL)
+    {
+        UnloadGymEnv(env);
+        return 1;
+    }
+
+    Thread trainer = { 0 };
+    bool benchTrainer = (benchSteps > 0) && StartThread(&trainer, TrainerThread, NULL);
+
+    int served = 0;
+    double start = GetWallTime();
+
+    for (;;)
+    {
+        int command = ServeGymShared(&shared, &env, timeout);
+
+        if (command == GYM_COMMAND_NONE)
+        {
+            printf("no request for %.1f seconds, exiting\n", timeout);
+            break;
+        }
+        else if (command == GYM_COMMAND_CLOSE) break;
+        else if (command == GYM_COMMAND_STEP) served++;
+    }
+
+    double elapsed = GetWallTime() - start;
+
+    if (benchTrainer)
+    {
+        JoinThread(&trainer);
+        printf("shared: %i steps x %i envs, %.1f ms, %.2f M env-steps/sec\n", served, envsCount, elapsed*1000.0, (double)served*envsCount/elapsed/1e6);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    CloseGymShared(&shared);
+    UnloadGymEnv(env);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get pseudo-random value (xorshift32)
+static unsigned int GetRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    *state = x;
+
+    return x;
+}
+
+// Bench trainer: reset, random actions steps, close
+// NOTE: Region is opened as an external trainer process would, actions change every step
+static void TrainerThread(void *arg)
+{
+    (void)arg;
+
+    GymShared shared = OpenGymShared(regionName);
+    if (shared.region.memory == NULL) return;
+
+    int count = shared.header->count;
+    int actionsCount = shared.header->actionsCount;
+    unsigned int state = (seed == 0)? 1 : seed;
+    double rewards = 0.0;
+
+    RequestGymShared(&shared, GYM_COMMAND_RESET, timeout);
+
+    for (int step = 0; step < benchSteps; step++)
+    {
+        for (int i = 0; i < count; i++) shared.actions[i] = (int)(GetRandom(&state)%actionsCount);
+
+        if (!RequestGymShared(&shared, GYM_COMMAND_STEP, timeout)) break;
+
+        for (int i = 0; i < count; i++) rewards += shared.rewards[i];
+    }
+
+    printf("trainer: total reward %.0f\n", rewards);
+
+    RequestGymShared(&shared, GYM_COMMAND_CLOSE, timeout);
+    CloseGymShared(&shared);
+}
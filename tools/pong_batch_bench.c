@@ -0,0 +1,231 @@
+/*******************************************************************************************
+*
+*   pong_batch_bench - Batch PONG simulation check against scalar simulation and throughput
+*
+*   Thousands of matches with different initial states and random inputs are stepped with
+*   batch simulation (pong_batch) and with scalar simulation (pong_sim), then:
+*     - Every match state is compared bit-for-bit after every step, exit code 1 on mismatch
+*     - Throughput of both simulations is measured in matches-steps per second
+*
+*   USAGE:
+*       pong_batch_bench [--matches <count>] [--steps <count>] [--seed <value>]
+*
+*         --matches <count>   Matches stepped at once, default: 4096
+*         --steps <count>     Simulation steps, default: 2000
+*         --seed <value>      Random initial states and inputs seed, default: 1
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o pong_batch_bench pong_batch_bench.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   NOTE: Game core library built with BUILD_SIMD=AVX2 uses AVX2 lanes on x86-64, AArch64 always
+*   uses NEON lanes, check pong_batch.h
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"               // Game simulation: PongGame, UpdatePongGame()...
+#include "pong_batch.h"             // Batch simulation: PongBatch, UpdatePongBatch()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), malloc(), free()
+#include <string.h>                 // Required for: memcmp()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int matchesCount = 4096;
+static int stepsCount = 2000;
+static unsigned int seed = 1;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);         // Get pseudo-random value (xorshift32), same sequence on every platform
+static void InitRandomMatch(PongGame *game, unsigned int *state);   // Initialize match with random ball state and enemy vision range
+static void GenerateInputs(int *inputs, int count, unsigned int *state);    // Generate random inputs flags for all matches
+static PongInput GetPongInput(int flags);                   // Convert batch input flags to scalar input
+static bool CompareMatch(const PongGame *a, const PongGame *b);     // Compare matches state bit-for-bit
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--matches")) matchesCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--steps")) stepsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--seed")) seed = (unsigned int)atoi(argv[++i]);
+    }
+
+    if (matchesCount < 1) matchesCount = 1;
+    if (stepsCount < 1) stepsCount = 1;
+    if (seed == 0) seed = 1;        // NOTE: xorshift state can not be 0
+
+    PongGame *games = (PongGame *)malloc(matchesCount*sizeof(PongGame));
+    PongGame *initial = (PongGame *)malloc(matchesCount*sizeof(PongGame));
+    int *inputs = (int *)malloc(matchesCount*sizeof(int));
+    int *events = (int *)malloc(matchesCount*sizeof(int));
+
+    unsigned int state = seed;
+    for (int i = 0; i < matchesCount; i++) InitRandomMatch(&initial[i], &state);
+
+    PongBatch batch = LoadPongBatch(matchesCount, 800, 600);
+
+    printf("pong batch: %i matches, %i steps, backend %s (%i lanes)\n", matchesCount, stepsCount, GetPongBatchBackend(), GetPongBatchLanes());
+    //--------------------------------------------------------------------------------------
+
+    // Check: batch vs scalar, every match after every step
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < matchesCount; i++)
+    {
+        games[i] = initial[i];
+        SetPongBatchMatch(&batch, i, &initial[i]);
+    }
+
+    int mismatches = 0;
+    state = seed;
+
+    for (int step = 0; (step < stepsCount) && (mismatches == 0); step++)
+    {
+        GenerateInputs(inputs, matchesCount, &state);
+
+        for (int i = 0; i < matchesCount; i++) events[i] = (int)UpdatePongGame(&games[i], GetPongInput(inputs[i]));
+        UpdatePongBatch(&batch, inputs);
+
+        for (int i = 0; i < matchesCount; i++)
+        {
+            PongGame match = { 0 };
+            GetPongBatchMatch(&batch, i, &match);
+
+            if (!CompareMatch(&games[i], &match) || (events[i] != batch.events[i]))
+            {
+                if (mismatches == 0)
+                {
+                    printf("MISMATCH: match %i, step %i: ball (%.9g, %.9g) vs (%.9g, %.9g), events 0x%02x vs 0x%02x\n", i, step,
+                        games[i].ballPosition.x, games[i].ballPosition.y, match.ballPosition.x, match.ballPosition.y, events[i], batch.events[i]);
+                }
+
+                mismatches++;
+            }
+        }
+    }
+
+    if (mismatches == 0) printf("check: %i matches identical to scalar simulation after %i steps\n", matchesCount, stepsCount);
+    //--------------------------------------------------------------------------------------
+
+    // Throughput: same steps and inputs, checking excluded
+    // NOTE: Inputs are generated once, timings only include simulation steps
+    //--------------------------------------------------------------------------------------
+    state = seed;
+    GenerateInputs(inputs, matchesCount, &state);
+
+    for (int i = 0; i < matchesCount; i++)
+    {
+        games[i] = initial[i];
+        SetPongBatchMatch(&batch, i, &initial[i]);
+    }
+
+    double scalarStart = GetWallTime();
+    for (int step = 0; step < stepsCount; step++)
+    {
+        for (int i = 0; i < matchesCount; i++) UpdatePongGame(&games[i], GetPongInput(inputs[i]));
+    }
+    double scalarTime = GetWallTime() - scalarStart;
+
+    double batchStart = GetWallTime();
+    for (int step = 0; step < stepsCount; step++) UpdatePongBatch(&batch, inputs);
+    double batchTime = GetWallTime() - batchStart;
+
+    double matchesSteps = (double)matchesCount*stepsCount;
+
+    printf("scalar: %.1f ms, %.2f M matches-steps/sec\n", scalarTime*1000.0, matchesSteps/scalarTime/1e6);
+    printf("batch:  %.1f ms, %.2f M matches-steps/sec (x%.1f)\n", batchTime*1000.0, matchesSteps/batchTime/1e6, scalarTime/batchTime);
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    UnloadPongBatch(batch);
+
+    free(games);
+    free(initial);
+    free(inputs);
+    free(events);
+    //--------------------------------------------------------------------------------------
+
+    return (mismatches == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get pseudo-random value (xorshift32)
+static unsigned int GetRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    *state = x;
+
+    return x;
+}
+
+// Initialize match with random ball state and enemy vision range
+// NOTE: Ball speeds are kept in game range, ball starts inside playfield
+static void InitRandomMatch(PongGame *game, unsigned int *state)
+{
+    InitPongGame(game, 800, 600);
+
+    game->ballPosition.x = 40.0f + (float)(GetRandom(state)%720);
+    game->ballPosition.y = 40.0f + (float)(GetRandom(state)%520);
+    game->ballSpeedX = (3 + (int)(GetRandom(state)%6))*((GetRandom(state)%2)? 1 : -1);
+    game->ballSpeedY = (2 + (int)(GetRandom(state)%6))*((GetRandom(state)%2)? 1 : -1);
+    game->player.y = (float)(GetRandom(state)%500);
+    game->enemy.y = (float)(GetRandom(state)%500);
+    game->enemyVisionRange = 200 + (int)(GetRandom(state)%400);
+}
+
+// Generate random inputs flags for all matches
+static void GenerateInputs(int *inputs, int count, unsigned int *state)
+{
+    for (int i = 0; i < count; i++) inputs[i] = (int)(GetRandom(state)%128);    // All PongBatchInput flags combinations
+}
+
+// Convert batch input flags to scalar input
+static PongInput GetPongInput(int flags)
+{
+    PongInput input = { 0 };
+
+    input.up = (flags & PONG_INPUT_UP) != 0;
+    input.down = (flags & PONG_INPUT_DOWN) != 0;
+    input.visionIncrease = (flags & PONG_INPUT_VISION_INCREASE) != 0;
+    input.visionDecrease = (flags & PONG_INPUT_VISION_DECREASE) != 0;
+    input.enemyControlled = (flags & PONG_INPUT_ENEMY_CONTROLLED) != 0;
+    input.enemyMove = (flags & PONG_INPUT_ENEMY_UP)? -1 : (flags & PONG_INPUT_ENEMY_DOWN)? 1 : 0;
+
+    return input;
+}
+
+// Compare matches state bit-for-bit
+// NOTE: Fields are compared one by one, struct padding is not compared
+static bool CompareMatch(const PongGame *a, const PongGame *b)
+{
+    return (memcmp(&a->ballPosition, &b->ballPosition, sizeof(Vector2)) == 0) &&
+           (a->ballSpeedX == b->ballSpeedX) && (a->ballSpeedY == b->ballSpeedY) &&
+           (memcmp(&a->player, &b->player, sizeof(Rectangle)) == 0) && (a->playerScore == b->playerScore) &&
+           (memcmp(&a->enemy, &b->enemy, sizeof(Rectangle)) == 0) && (a->enemyScore == b->enemyScore) &&
+           (a->enemyVisionRange == b->enemyVisionRange);
+}
@@ -0,0 +1,267 @@
+/*******************************************************************************************
+*
+*   pong_bots - PONG bot clients for match server load tests (one socket, thousands of bots)
+*
+*   Bots join pong_server matches (vs server enemy or paired with another bot), then answer
+*   every match state with paddle buttons following the ball and the state tick acknowledged,
+*   like a real client sending inputs every frame. All bots share one UDP socket, states are
+*   routed by client token and decoded against bot snapshots history (src/snapshot_codec.h).
+*   Every second, reports joined bots, states received (and missed, from tick gaps, or not
+*   decoded), inputs sent, bytes received and snapshot bytes per state; bots leave their
+*   matches on exit.
+*
+*   USAGE:
+*       pong_bots [--host <address>] [--port <port>] [--bots <count>] [--players 1|2] [--seconds <time>]
+*
+*         --host <address>    Server IPv4 address, default: 127.0.0.1
+*         --port <port>       Server UDP port, default: 7777
+*         --bots <count>      Bot clients, default: 1000
+*         --players <count>   1: every bot plays vs server enemy, 2: bots play in pairs, default: 1
+*         --seconds <time>    Run time, default: 10
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o pong_bots pong_bots.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "net_udp.h"                // UDP sockets: OpenUdpSocket(), SendUdp(), ReceiveUdp()...
+#include "pong_net.h"               // Protocol: PongNetMessage, WritePongNetMessage()...
+#include "snapshot_codec.h"         // Snapshots: SnapshotHistory, DecodePongSnapshot()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), atof(), calloc(), free()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define JOIN_BURST              256         // Join requests sent per loop, keeps server receive buffer from overflowing
+#define JOIN_RETRY_TIME         1.0         // Join requests resent if not answered in time (seconds)
+#define RECEIVE_BATCH           4096        // Datagrams handled per loop, keeps joins and reports going under load
+#define PADDLE_HEIGHT           100         // Match paddles height (pong_sim)
+#define PADDLE_DEAD_ZONE        10          // Paddle stays if ball is closer than this to its center
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Bot client
+typedef struct Bot {
+    int match;                  // Match slot, -1 if not joined
+    int side;                   // Paddle side (PongSide)
+    double joinTime;            // Time of last join request, 0 if never sent
+    unsigned int sequence;      // Inputs sent
+    SnapshotHistory history;    // Match states received, delta baselines
+} Bot;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const char *host = "127.0.0.1";
+static unsigned short port = PONG_NET_PORT;
+static int botsCount = 1000;
+static int players = 1;
+static double runSeconds = 10.0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetBotButtons(const PongSnapshot *snapshot, int side);  // Get paddle buttons following the ball
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--host")) host = argv[++i];
+        else if (TextIsEqual(argv[i], "--port")) port = (unsigned short)atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--bots")) botsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--players")) players = (atoi(argv[++i]) == 2)? 2 : 1;
+        else if (TextIsEqual(argv[i], "--seconds")) runSeconds = atof(argv[++i]);
+    }
+
+    if (botsCount < 1) botsCount = 1;
+
+    NetAddress server = GetNetAddress(host, port);
+    int socket = OpenUdpSocket(0);
+
+    if (socket == -1)
+    {
+        printf("bots socket could not be opened\n");
+        return 1;
+    }
+
+    NetPoller poller = LoadNetPoller();
+    AddNetPollerSocket(&poller, socket);
+
+    Bot *bots = (Bot *)calloc(botsCount, sizeof(Bot));
+    for (int i = 0; i < botsCount; i++) bots[i].match = -1;
+
+    printf("pong bots: %i bots (%i players matches) -> %s:%i, %.0f seconds\n", botsCount, players, host, port, runSeconds);
+    //--------------------------------------------------------------------------------------
+
+    // Bots loop: join, answer states with inputs, stats every second
+    //--------------------------------------------------------------------------------------
+    unsigned char packet[PONG_NET_MAX_PACKET] = { 0 };
+    int joinCursor = 0;
+    int joined = 0;
+    unsigned int states = 0, statesMissed = 0, statesStale = 0, statesUndecoded = 0, inputs = 0, bytesIn = 0, snapshotBytes = 0, rejected = 0;
+
+    double startTime = GetWallTime();
+    double reportTime = startTime;
+
+    while ((GetWallTime() - startTime) < runSeconds)
+    {
+        double time = GetWallTime();
+
+        // Join requests in bursts, bots not answered in time are retried
+        // NOTE: Paired bots join in order, retried ones can end up paired with other bots
+        int sent = 0;
+
+        for (int checked = 0; (checked < botsCount) && (sent < JOIN_BURST) && (joined < botsCount); checked++)
+        {
+            Bot *bot = &bots[joinCursor];
+
+            if ((bot->match == -1) && ((bot->joinTime == 0.0) || ((time - bot->joinTime) > JOIN_RETRY_TIME)))
+            {
+                PongNetMessage join = { 0 };
+                join.type = PONG_NET_JOIN;
+                join.token = joinCursor;
+                join.players = players;
+
+                SendUdp(socket, server, packet, WritePongNetMessage(&join, packet));
+
+                bot->joinTime = time;
+                sent++;
+            }
+
+            joinCursor = (joinCursor + 1)%botsCount;
+        }
+
+        if (WaitNetPoller(&poller, 0.005) > 0)
+        {
+            NetAddress from = { 0 };
+            int size = 0;
+
+            for (int i = 0; (i < RECEIVE_BATCH) && ((size = ReceiveUdp(socket, &from, packet, PONG_NET_MAX_PACKET)) >= 0); i++)
+            {
+                PongNetMessage message = { 0 };
+
+                bytesIn += size;
+
+                if (!IsNetAddressEqual(from, server) || !ReadPongNetMessage(packet, size, &message) ||
+                    (message.token >= (unsigned int)botsCount)) continue;
+
+                Bot *bot = &bots[message.token];
+
+                if (message.type == PONG_NET_JOINED)
+                {
+                    if (message.match == -1) rejected++;
+                    else if (bot->match == -1)
+                    {
+                        bot->match = message.match;
+                        bot->side = message.side;
+                        joined++;
+                    }
+                }
+                else if ((message.type == PONG_NET_STATE) && (bot->match != -1))
+                {
+                    PongSnapshot snapshot = { 0 };
+                    unsigned int lastTick = bot->history.latestTick;
+
+                    if (!DecodePongSnapshot(message.payload, message.payloadSize, &bot->history, &snapshot))
+                    {
+                        statesUndecoded++;
+                        continue;
+                    }
+
+                    if ((lastTick > 0) && ((int)(snapshot.tick - lastTick) <= 0))
+                    {
+                        statesStale++;
+                        continue;
+                    }
+
+                    if (lastTick > 0) statesMissed += snapshot.tick - lastTick - 1;
+                    StoreSnapshotHistory(&bot->history, &snapshot);
+                    snapshotBytes += message.payloadSize;
+                    states++;
+
+                    PongNetMessage input = { 0 };
+                    input.type = PONG_NET_INPUT;
+                    input.match = bot->match;
+                    input.side = bot->side;
+                    input.sequence = ++bot->sequence;
+                    input.buttons = GetBotButtons(&snapshot, bot->side);
+                    input.ack = snapshot.tick;
+
+                    if (SendUdp(socket, server, packet, WritePongNetMessage(&input, packet)) > 0) inputs++;
+                }
+            }
+        }
+
+        time = GetWallTime();
+
+        if ((time - reportTime) >= 1.0)
+        {
+            double elapsed = time - reportTime;
+
+            printf("[%5.0fs] joined %5i/%i (rejected %u) | states %7.0f/s (missed %u, stale %u, undecoded %u) | inputs %7.0f/s | in %7.1f KB/s | snapshot %4.2f B/state\n",
+                time - startTime, joined, botsCount, rejected, states/elapsed, statesMissed, statesStale, statesUndecoded,
+                inputs/elapsed, bytesIn/elapsed/1024.0, (states > 0)? (double)snapshotBytes/states : 0.0);
+            fflush(stdout);
+
+            states = statesMissed = statesStale = statesUndecoded = inputs = bytesIn = snapshotBytes = rejected = 0;
+            reportTime = time;
+        }
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < botsCount; i++)
+    {
+        if (bots[i].match == -1) continue;
+
+        PongNetMessage leave = { 0 };
+        leave.type = PONG_NET_LEAVE;
+        leave.match = bots[i].match;
+        leave.side = bots[i].side;
+
+        SendUdp(socket, server, packet, WritePongNetMessage(&leave, packet));
+    }
+
+    free(bots);
+
+    UnloadNetPoller(&poller);
+    CloseUdpSocket(socket);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get paddle buttons following the ball
+static unsigned int GetBotButtons(const PongSnapshot *snapshot, int side)
+{
+    float paddleY = (side == PONG_SIDE_PLAYER)? snapshot->playerY : snapshot->enemyY;
+    float offset = snapshot->ballY - (paddleY + PADDLE_HEIGHT/2);
+
+    if (offset < -PADDLE_DEAD_ZONE) return PONG_NET_BUTTON_UP;
+    else if (offset > PADDLE_DEAD_ZONE) return PONG_NET_BUTTON_DOWN;
+
+    return 0;
+}
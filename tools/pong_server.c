@@ -0,0 +1,144 @@
+/*******************************************************************************************
+*
+*   pong_server - Headless PONG match server, thousands of concurrent matches over UDP
+*
+*   No window: matches are simulated by tick workers at a fixed tick rate and streamed to
+*   clients (check src/match_server.h and src/pong_net.h). Every second, reports:
+*     - Active/waiting matches
+*     - Ticks per second per worker and ticks dropped (workers late)
+*     - Tick latency (deadline to done) average/maximum and tick work time
+*     - Packets and bytes in/out per second, send errors
+*     - Encoded snapshot bytes per state (STATE payload, check src/snapshot_codec.h), keyframes
+*     - Memory per match: arena bytes per match slot, process resident memory per active match
+*
+*   Use pong_bots to connect thousands of bot clients on loopback:
+*       pong_server --matches 4096 --workers 2 &
+*       pong_bots --bots 4000 --seconds 20
+*
+*   USAGE:
+*       pong_server [--port <port>] [--matches <count>] [--workers <count>] [--tick-rate <ticks>]
+*                   [--timeout <seconds>] [--seconds <time>]
+*
+*         --port <port>       UDP port, default: 7777
+*         --matches <count>   Match slots preallocated, default: 4096
+*         --workers <count>   Tick worker threads, default: 2
+*         --tick-rate <ticks> Ticks per second, default: 60
+*         --timeout <sec>     Close matches without inputs for <sec>, default: 5
+*         --seconds <time>    Exit after <time> seconds, default: 0 (run until killed)
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o pong_server pong_server.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "match_server.h"           // Match server: MatchServer, StartMatchServer(), UpdateMatchServer()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf(), fopen(), fscanf()
+#include <stdlib.h>                 // Required for: atoi(), atof()
+#include <unistd.h>                 // Required for: sysconf()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static MatchServer server = { 0 };
+static double runSeconds = 0.0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static long GetResidentMemory(void);                        // Get process resident memory in bytes (Linux), 0 if not available
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    MatchServerConfig config = GetMatchServerConfigDefault();
+
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--port")) config.port = (unsigned short)atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--matches")) config.maxMatches = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--workers")) config.workers = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--tick-rate")) config.tickRate = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--timeout")) config.timeout = atof(argv[++i]);
+        else if (TextIsEqual(argv[i], "--seconds")) runSeconds = atof(argv[++i]);
+    }
+
+    long baseMemory = GetResidentMemory();
+
+    if (!StartMatchServer(&server, config))
+    {
+        printf("match server could not be started (port %i)\n", config.port);
+        return 1;
+    }
+
+    long arenaMemory = GetResidentMemory() - baseMemory;   // Arena pages committed on start
+
+    printf("pong server: port %i, %i match slots, %i workers, %i ticks/sec\n", server.config.port,
+        server.config.maxMatches, server.config.workers, server.config.tickRate);
+    printf("memory: arena %.1f MB (%i bytes/match slot), resident +%.1f MB after start\n",
+        server.arenaSize/(1024.0*1024.0), server.matchStride, arenaMemory/(1024.0*1024.0));
+    //--------------------------------------------------------------------------------------
+
+    // Network loop, stats every second
+    //--------------------------------------------------------------------------------------
+    double startTime = GetWallTime();
+    double reportTime = startTime;
+
+    while ((runSeconds <= 0.0) || ((GetWallTime() - startTime) < runSeconds))
+    {
+        UpdateMatchServer(&server, 0.01);
+
+        if ((GetWallTime() - reportTime) < 1.0) continue;
+
+        reportTime = GetWallTime();
+
+        MatchServerStats stats = GetMatchServerStats(&server, true);
+        long memory = GetResidentMemory();
+
+        printf("[%5.0fs] matches %5i (+%i waiting) | ticks/sec %5.1f per worker (dropped %u) | tick latency avg %6.3f ms, max %6.3f ms, work %6.3f ms | "
+            "in %6.0f pkt/s, out %6.0f pkt/s %6.1f KB/s (errors %u) | snapshot %4.2f B/state (keyframes %u) | resident %5.0f B/match\n",
+            reportTime - startTime, stats.activeMatches, stats.waitingMatches, stats.workerTicksPerSecond, stats.ticksDropped,
+            stats.latencyAvg*1000.0, stats.latencyMax*1000.0, stats.workAvg*1000.0,
+            stats.packetsIn/stats.elapsed, stats.packetsOut/stats.elapsed, stats.bytesOut/stats.elapsed/1024.0, stats.sendErrors,
+            (stats.packetsOut > 0)? (double)stats.snapshotBytes/stats.packetsOut : 0.0, stats.keyframes,
+            (stats.activeMatches > 0)? (double)memory/stats.activeMatches : 0.0);
+        fflush(stdout);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    StopMatchServer(&server);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get process resident memory in bytes
+static long GetResidentMemory(void)
+{
+    long pages = 0, resident = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+
+    if (file == NULL) return 0;
+    if (fscanf(file, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(file);
+
+    return resident*sysconf(_SC_PAGESIZE);
+}
@@ -0,0 +1,416 @@
+/*******************************************************************************************
+*
+*   replay_player - PONG/BLOCKS session replays player, seeking and fast-forward
+*
+*   Plays replays recorded by pong and blocks games (check src/replay.h) running the games
+*   simulation steps on recorded inputs. Seeking anywhere loads the nearest keyframe and
+*   re-simulates the gap only (at most one keyframe interval), whatever the session length.
+*   A replay still being recorded is followed live, new segments are picked up every second.
+*
+*   Headless mode draws nothing: seeks to --seek position, measures random seeks, then runs
+*   the simulation to the end as fast as possible and reports speed (times real time).
+*   With --verify, every keyframe is compared with the state re-simulated from the previous
+*   one (determinism check, i.e. game core or enemy policy weights changed since recording).
+*
+*   USAGE:
+*       replay_player <file> [--seek <seconds>] [--speed <factor>] [--headless] [--verify] [--policy <file>]
+*
+*         <file>              Replay file, i.e. pong_session.rpl, blocks_session.rpl
+*         --seek <seconds>    Playback start position (gameplay seconds), default: 0
+*         --speed <factor>    Window playback speed (1-64), default: 1
+*         --headless          No window, seek and fast-forward timings only
+*         --verify            Headless: check keyframes against re-simulated states
+*         --policy <file>     Pong enemy MLP weights, must be the recording game ones, default: ../pong/resources/enemy_policy.mlp
+*
+*   WINDOW CONTROLS:
+*       SPACE pause, LEFT/RIGHT seek -/+10 seconds, UP/DOWN playback speed, HOME/END replay start/end
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o replay_player replay_player.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"               // Game simulation: PongGame, UpdatePongGame()
+#include "blocks_sim.h"             // Game simulation: BlocksGame, UpdateBlocksGame()
+#include "enemy_policy.h"           // Enemy policies: LoadEnemyPolicy(), ApplyEnemyPolicy()
+#include "replay.h"                 // Replays: LoadReplay(), SeekReplay(), StepReplay()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atof(), rand(), srand()
+#include <string.h>                 // Required for: memcmp(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SEEK_JUMP_TIME          10.0        // Window seek jump (seconds)
+#define RANDOM_SEEKS            1000        // Headless random seeks measured
+#define INDEX_UPDATE_TIME       1.0         // Time between new segments checks, replay still being recorded (seconds)
+#define MAX_WINDOW_WIDTH        1280        // Larger playfields (blocks board mode) are scaled down to fit
+#define MAX_WINDOW_HEIGHT       720
+
+// Simulation buttons, same bitmasks as recording games (pong/pong.c, lessons/07_blocks_game_audio.c)
+#define PONG_BUTTON_UP              0x01
+#define PONG_BUTTON_DOWN            0x02
+#define PONG_BUTTON_VISION_INCREASE 0x04
+#define PONG_BUTTON_VISION_DECREASE 0x08
+#define PONG_BUTTON_ENEMY_POLICY    0x10
+
+#define BLOCKS_BUTTON_LEFT          0x01
+#define BLOCKS_BUTTON_RIGHT         0x02
+#define BLOCKS_BUTTON_LAUNCH        0x04
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const char *fileName = NULL;
+static double seekSeconds = 0.0;
+static float speed = 1.0f;
+static bool headless = false;
+static bool verify = false;
+static const char *policyFileName = "../pong/resources/enemy_policy.mlp";
+static float viewScale = 1.0f;              // Playfield to window scale
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int StepPong(void *state, SimInput input, void *userData);     // Pong simulation step (pong/pong.c step, no events queue)
+static unsigned int StepBlocks(void *state, SimInput input, void *userData);   // Blocks simulation step (lessons/07_blocks_game_audio.c step, no events queue)
+static int VerifyKeyframes(const char *fileName, SimStepFunc step, void *userData);     // Compare keyframes with re-simulated states, returns mismatches
+static void DrawPong(const PongGame *pong);                 // Draw pong match (pong/pong.c gameplay screen)
+static void DrawBlocks(const BlocksGame *blocks);           // Draw blocks game (lessons/07_blocks_game_audio.c shapes backend)
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < argc; i++)
+    {
+        if (TextIsEqual(argv[i], "--headless")) headless = true;
+        else if (TextIsEqual(argv[i], "--verify")) verify = headless = true;
+        else if (argv[i][0] != '-') fileName = argv[i];
+        else if (i == (argc - 1)) break;
+        else if (TextIsEqual(argv[i], "--seek")) seekSeconds = atof(argv[++i]);
+        else if (TextIsEqual(argv[i], "--speed")) speed = (float)atof(argv[++i]);
+        else if (TextIsEqual(argv[i], "--policy")) policyFileName = argv[++i];
+    }
+
+    if (fileName == NULL)
+    {
+        printf("usage: replay_player <file> [--seek <seconds>] [--speed <factor>] [--headless] [--verify] [--policy <file>]\n");
+        return 1;
+    }
+
+    if (speed < 1.0f) speed = 1.0f;
+    if (speed > 64.0f) speed = 64.0f;
+
+    Replay replay = LoadReplay(fileName);
+
+    if (replay.file == NULL) return 1;
+
+    // NOTE: Pong replays need same enemy policy as recording game, chase steps if not available
+    EnemyPolicy policy = { 0 };
+    SimStepFunc step = StepBlocks;
+    void *userData = NULL;
+
+    if (replay.header.game == REPLAY_GAME_PONG)
+    {
+        policy = LoadEnemyPolicy(policyFileName);
+        step = StepPong;
+        userData = &policy;
+    }
+
+    if (((replay.header.game == REPLAY_GAME_PONG) && (replay.header.stateSize != (int)sizeof(PongGame))) ||
+        ((replay.header.game == REPLAY_GAME_BLOCKS) && (replay.header.stateSize != (int)sizeof(BlocksGame))) ||
+        ((replay.header.game != REPLAY_GAME_PONG) && (replay.header.game != REPLAY_GAME_BLOCKS)))
+    {
+        printf("replay game state does not match this game core build\n");
+        UnloadReplay(&replay);
+        return 1;
+    }
+
+    int stepRate = replay.header.stepRate;
+    unsigned int seekStep = (unsigned int)(seekSeconds*stepRate);
+
+    printf("replay: %s (%s), %u steps (%.1f seconds), %i keyframes%s\n", fileName, (replay.header.game == REPLAY_GAME_PONG)? "pong" : "blocks",
+        replay.steps, (double)replay.steps/stepRate, replay.keyframesCount, replay.finished? "" : ", recording not finished");
+    //--------------------------------------------------------------------------------------
+
+    // Headless: seek, random seeks and fast-forward timings
+    //--------------------------------------------------------------------------------------
+    if (headless)
+    {
+        int result = 0;
+
+        if (!IsReplayReady(&replay)) result = 1;
+        else if (verify)
+        {
+            int mismatches = VerifyKeyframes(fileName, step, userData);
+
+            printf("verify: %i keyframes checked, %i mismatches\n", replay.keyframesCount - 1, mismatches);
+            result = (mismatches == 0)? 0 : 1;
+        }
+        else
+        {
+            double time = GetWallTime();
+            SeekReplay(&replay, seekStep, step, userData);
+            double seekTime = GetWallTime() - time;
+
+            int keyframe = replay.step/replay.header.keyframeInterval;
+            if (keyframe >= replay.keyframesCount) keyframe = replay.keyframesCount - 1;
+
+            printf("seek: step %u (%.1f s) in %.3f ms, %u steps re-simulated from keyframe\n", replay.step, (double)replay.step/stepRate,
+                seekTime*1000.0, replay.step - replay.keyframes[keyframe].step);
+
+            // NOTE: Random seeks run from any position, backwards seeks included
+            Replay seeker = LoadReplay(fileName);
+            double seekMax = 0.0;
+            srand(1);
+
+            time = GetWallTime();
+            for (int i = 0; i < RANDOM_SEEKS; i++)
+            {
+                double start = GetWallTime();
+                SeekReplay(&seeker, (unsigned int)(((double)rand()/RAND_MAX)*seeker.steps), step, userData);
+                double elapsed = GetWallTime() - start;
+
+                if (elapsed > seekMax) seekMax = elapsed;
+            }
+            printf("random seeks: %i, average %.3f ms, max %.3f ms\n", RANDOM_SEEKS, (GetWallTime() - time)*1000.0/RANDOM_SEEKS, seekMax*1000.0);
+
+            UnloadReplay(&seeker);
+
+            // Fast-forward: remaining steps as fast as possible
+            unsigned int first = replay.step;
+
+            time = GetWallTime();
+            while (replay.step < replay.steps) StepReplay(&replay, replay.header.keyframeInterval, step, userData);
+            double elapsed = GetWallTime() - time;
+
+            unsigned int steps = replay.step - first;
+            printf("fast-forward: %u steps in %.3f s, %.0f steps/s, %.0fx real time\n", steps, elapsed,
+                (elapsed > 0.0)? steps/elapsed : 0.0, (elapsed > 0.0)? steps/(elapsed*stepRate) : 0.0);
+        }
+
+        UnloadReplay(&replay);
+
+        return result;
+    }
+    //--------------------------------------------------------------------------------------
+
+    // Window playback
+    //--------------------------------------------------------------------------------------
+    SeekReplay(&replay, seekStep, step, userData);
+
+    const int *playfield = (const int *)replay.state;     // NOTE: PongGame and BlocksGame start with screenWidth, screenHeight
+
+    // NOTE: Playfields larger than maximum window size are shown whole, scaled down
+    if (playfield[0]*viewScale > MAX_WINDOW_WIDTH) viewScale = (float)MAX_WINDOW_WIDTH/playfield[0];
+    if (playfield[1]*viewScale > MAX_WINDOW_HEIGHT) viewScale = (float)MAX_WINDOW_HEIGHT/playfield[1];
+
+    InitWindow(playfield[0]*viewScale, playfield[1]*viewScale, TextFormat("replay player - %s", fileName));
+    SetTargetFPS(60);
+
+    bool paused = false;
+    double stepsDue = 0.0;
+    double seekTime = 0.0;
+    double indexTime = GetTime();
+
+    while (!WindowShouldClose())
+    {
+        // Replay still being recorded: segments appended since last check
+        if (!replay.finished && ((GetTime() - indexTime) >= INDEX_UPDATE_TIME))
+        {
+            UpdateReplayIndex(&replay);
+            indexTime = GetTime();
+        }
+
+        unsigned int target = replay.step;
+        unsigned int jump = (unsigned int)(SEEK_JUMP_TIME*stepRate);
+
+        if (IsKeyPressed(KEY_SPACE)) paused = !paused;
+        if (IsKeyPressed(KEY_UP) && (speed < 64.0f)) speed *= 2.0f;
+        if (IsKeyPressed(KEY_DOWN) && (speed > 1.0f)) speed /= 2.0f;
+        if (IsKeyPressed(KEY_RIGHT)) target = replay.step + jump;
+        if (IsKeyPressed(KEY_LEFT)) target = (replay.step > jump)? replay.step - jump : 0;
+        if (IsKeyPressed(KEY_HOME)) target = 0;
+        if (IsKeyPressed(KEY_END)) target = replay.steps;
+
+        if (target != replay.step)
+        {
+            double time = GetWallTime();
+            SeekReplay(&replay, target, step, userData);
+            seekTime = GetWallTime() - time;
+        }
+        else if (!paused)
+        {
+            // Steps due at playback speed, fast-forward runs several steps per frame
+            stepsDue += speed*stepRate*GetFrameTime();
+            StepReplay(&replay, (int)stepsDue, step, userData);
+            stepsDue -= (int)stepsDue;
+        }
+
+        BeginDrawing();
+
+            ClearBackground(RAYWHITE);
+
+            BeginMode2D((Camera2D){ { 0, 0 }, { 0, 0 }, 0.0f, viewScale });
+
+                if (replay.header.game == REPLAY_GAME_BLOCKS) DrawBlocks((const BlocksGame *)replay.state);
+                else DrawPong((const PongGame *)replay.state);
+
+            EndMode2D();
+
+            int seconds = replay.step/stepRate;
+            int totalSeconds = replay.steps/stepRate;
+
+            DrawText(TextFormat("REPLAY %02i:%02i / %02i:%02i | x%i%s | last seek %.2f ms%s", seconds/60, seconds%60, totalSeconds/60, totalSeconds%60,
+                (int)speed, paused? " (paused)" : "", seekTime*1000.0, replay.finished? "" : " | LIVE"), 10, GetScreenHeight() - 20, 10, GRAY);
+
+        EndDrawing();
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    CloseWindow();
+
+    UnloadReplay(&replay);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Pong simulation step
+static unsigned int StepPong(void *state, SimInput input, void *userData)
+{
+    const EnemyPolicy *policy = (const EnemyPolicy *)userData;
+
+    PongInput pongInput = { 0 };
+    pongInput.up = (input.down & PONG_BUTTON_UP) != 0;
+    pongInput.down = (input.down & PONG_BUTTON_DOWN) != 0;
+    pongInput.visionIncrease = (input.down & PONG_BUTTON_VISION_INCREASE) != 0;
+    pongInput.visionDecrease = (input.down & PONG_BUTTON_VISION_DECREASE) != 0;
+
+    PongGame *pong = (PongGame *)state;
+    if (input.down & PONG_BUTTON_ENEMY_POLICY) ApplyEnemyPolicy(policy, pong, &pongInput);
+
+    return UpdatePongGame(pong, pongInput);
+}
+
+// Blocks simulation step
+static unsigned int StepBlocks(void *state, SimInput input, void *userData)
+{
+    (void)userData;
+
+    BlocksInput blocksInput = { 0 };
+    blocksInput.left = (input.down & BLOCKS_BUTTON_LEFT) != 0;
+    blocksInput.right = (input.down & BLOCKS_BUTTON_RIGHT) != 0;
+    blocksInput.launch = (input.pressed & BLOCKS_BUTTON_LAUNCH) != 0;
+
+    return UpdateBlocksGame((BlocksGame *)state, blocksInput);
+}
+
+// Compare keyframes with re-simulated states
+// NOTE: One replay plays from start, the other one seeks to every keyframe (keyframe state loaded, no steps run)
+static int VerifyKeyframes(const char *fileName, SimStepFunc step, void *userData)
+{
+    Replay played = LoadReplay(fileName);
+    Replay keyframes = LoadReplay(fileName);
+    int mismatches = 0;
+
+    for (int i = 1; i < keyframes.keyframesCount; i++)
+    {
+        unsigned int keyframeStep = keyframes.keyframes[i].step;
+
+        StepReplay(&played, keyframeStep - played.step, step, userData);
+        SeekReplay(&keyframes, keyframeStep, step, userData);
+
+        if ((played.step != keyframeStep) || (memcmp(played.state, keyframes.state, played.header.stateSize) != 0))
+        {
+            if (mismatches == 0) printf("verify: keyframe %i (step %u) does not match re-simulated state\n", i, keyframeStep);
+            mismatches++;
+
+            memcpy(played.state, keyframes.state, played.header.stateSize);     // Next keyframe checked from this one
+        }
+    }
+
+    UnloadReplay(&played);
+    UnloadReplay(&keyframes);
+
+    return mismatches;
+}
+
+// Draw pong match
+static void DrawPong(const PongGame *pong)
+{
+    DrawCircleV(pong->ballPosition, pong->ballRadius, RED);
+    DrawRectangleRec(pong->player, BLUE);
+    DrawRectangleRec(pong->enemy, DARKGREEN);
+    DrawLine(pong->enemyVisionRange, 0, pong->enemyVisionRange, pong->screenHeight, GRAY);
+
+    DrawText(TextFormat("%04i", pong->playerScore), 100, 10, 30, BLUE);
+    DrawText(TextFormat("%04i", pong->enemyScore), pong->screenWidth - 200, 10, 30, DARKGREEN);
+}
+
+// Draw blocks game
+static void DrawBlocks(const BlocksGame *blocks)
+{
+    DrawRectangle(blocks->player.position.x, blocks->player.position.y, blocks->player.size.x, blocks->player.size.y, BLACK);
+    DrawCircleV(blocks->ball.position, blocks->ball.radius, MAROON);
+
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++)
+        {
+            const Brick *brick = &blocks->bricks[j][i];
+
+            if (brick->active) DrawRectangle(brick->position.x, brick->position.y, brick->size.x, brick->size.y, ((i + j)%2 == 0)? GRAY : DARKGRAY);
+        }
+    }
+
+    // Endless mode: resident field rows, from lowest one up to screen top
+    if (blocks->mode == BLOCKS_MODE_ENDLESS)
+    {
+        const BrickField *field = &blocks->field;
+
+        for (const BrickRow *row = GetBrickFieldRow(field, field->landedRows); row != NULL; row = GetBrickFieldRow(field, row->index + 1))
+        {
+            float y = GetBrickFieldRowY(field, row->index);
+            if ((y + field->cellSize.y) < 0) break;
+
+            for (int i = 0; i < BRICK_FIELD_COLUMNS; i++)
+            {
+                if (row->cells[i] > 0) DrawRectangle(i*field->cellSize.x, y, field->cellSize.x, field->cellSize.y, ((i + row->index)%2 == 0)? GRAY : DARKGRAY);
+            }
+        }
+    }
+
+    // Board mode: whole board cells, bricks requiring more hits tinted red
+    if (blocks->mode == BLOCKS_MODE_BOARD)
+    {
+        const BrickBoard *board = &blocks->board;
+        const Color tints[4] = { GRAY, DARKGRAY, MAROON, { 120, 30, 40, 255 } };
+
+        for (int cell = 0; cell < board->rows*board->columns; cell++)
+        {
+            if (board->cells[cell] > 0) DrawRectangleRec(GetBrickBoardCellRec(board, cell), tints[((board->cells[cell] > 1)? 2 : 0) + (cell/board->columns + cell%board->columns)%2]);
+        }
+    }
+
+    for (int i = 0; i < blocks->player.lifes; i++) DrawRectangle(20 + 40*i, blocks->screenHeight - 30, 35, 10, LIGHTGRAY);
+}
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+#**********************************************************************************************
+#
+#   serve_web - Throttled static file server to test web builds streaming assets locally
+#
+#   Serves a web build directory (i.e. pong/ after 'make web') like a slow remote host:
+#   every request waits some latency, file bodies are sent at limited bandwidth and selected
+#   files can be answered with an error status, so the background fetch error path
+#   (emscripten_async_wget2() onerror, check src/assets.h) can be exercised.
+#
+#   Requests are served on separate threads: a slow music download does not block other files,
+#   game must reach TITLE screen once .html/.js/.wasm/.data arrive, whatever music size is.
+#
+#   USAGE:
+#       python3 tools/serve_web.py --dir pong --latency 0.3 --bandwidth 65536
+#       python3 tools/serve_web.py --dir pong --fail "*.xm"                 # Music fetch fails (404)
+#       python3 tools/serve_web.py --dir lessons --fail "*.mod" --fail-status 503
+#
+#       Open http://localhost:8080/pong.html, served files are logged with elapsed times
+#
+#   LICENSE: zlib/libpng
+#
+#   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+#
+#**********************************************************************************************
+
+import argparse
+import fnmatch
+import functools
+import http.server
+import os
+import time
+
+CHUNK_SIZE = 4096       # Bytes sent per write while throttling
+
+
+class ThrottledHandler(http.server.SimpleHTTPRequestHandler):
+    """Static files handler with latency, bandwidth limit and failing files"""
+
+    extensions_map = dict(http.server.SimpleHTTPRequestHandler.extensions_map, **{
+        '.wasm': 'application/wasm',
+        '.data': 'application/octet-stream',
+        '.xm': 'application/octet-stream',
+        '.mod': 'application/octet-stream',
+    })
+
+    def __init__(self, *args, options=None, **kwargs):
+        self.options = options
+        self.started = time.monotonic()     # Reset per request by send_head(), set for malformed requests
+        super().__init__(*args, **kwargs)
+
+    def send_head(self):
+        self.started = time.monotonic()
+
+        if self.options.latency > 0: time.sleep(self.options.latency)
+
+        # Failing files are matched on url path without query (i.e. "*.xm", "resources/*")
+        path = self.path.split('?', 1)[0].split('#', 1)[0].lstrip('/')
+
+        for pattern in self.options.fail:
+            if fnmatch.fnmatch(path, pattern):
+                self.send_error(self.options.fail_status, 'Failing file (serve_web --fail %s)' % pattern)
+                return None
+
+        return super().send_head()
+
+    def end_headers(self):
+        # Browser must fetch again on reload, cached files would skip throttling
+        self.send_header('Cache-Control', 'no-store')
+        super().end_headers()
+
+    def copyfile(self, source, outputfile):
+        bandwidth = self.options.bandwidth
+        sent = 0
+        start = time.monotonic()
+
+        while True:
+            chunk = source.read(CHUNK_SIZE)
+            if not chunk: break
+
+            outputfile.write(chunk)
+            sent += len(chunk)
+
+            # Wait until sent bytes match bandwidth
+            if bandwidth > 0:
+                delay = sent/bandwidth - (time.monotonic() - start)
+                if delay > 0: time.sleep(delay)
+
+        self.log_message('"%s" %i bytes sent in %.2f s', self.requestline, sent, time.monotonic() - self.started)
+
+    def log_request(self, code='-', size='-'):
+        self.log_message('"%s" %s after %.2f s', self.requestline, str(code), time.monotonic() - self.started)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Throttled static file server for web builds')
+    parser.add_argument('--dir', default='.', help='directory to serve (default: current)')
+    parser.add_argument('--port', type=int, default=8080, help='port to listen on (default: 8080)')
+    parser.add_argument('--latency', type=float, default=0.0, help='seconds before every response')
+    parser.add_argument('--bandwidth', type=float, default=0.0, help='bytes per second per file (0: unlimited)')
+    parser.add_argument('--fail', action='append', default=[], metavar='PATTERN', help='answer files matching pattern with error status (can be repeated)')
+    parser.add_argument('--fail-status', type=int, default=404, help='status for failing files (default: 404)')
+    options = parser.parse_args()
+
+    handler = functools.partial(ThrottledHandler, directory=os.path.abspath(options.dir), options=options)
+    server = http.server.ThreadingHTTPServer(('', options.port), handler)
+
+    print('serve_web: %s on http://localhost:%i (latency: %.2f s, bandwidth: %.0f bytes/s, failing: %s)' %
+          (os.path.abspath(options.dir), options.port, options.latency, options.bandwidth, ', '.join(options.fail) or 'none'))
+
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+    server.server_close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,295 @@
+/*******************************************************************************************
+*
+*   snapshot_codec_bench - PONG network snapshots codec: size per tick and encode/decode cost
+*
+*   Thousands of matches are played with random player inputs (server enemy), every tick
+*   match state is encoded like the match server does (against last state acknowledged by
+*   the client) and decoded like clients do (against received states history), then:
+*     - Decoded snapshots are compared with quantized ones, exit code 1 on any difference
+*     - Extreme values keyframes are checked to fit SNAPSHOT_MAX_SIZE and decode back
+*     - Encode/decode cost per snapshot (nanoseconds) and throughput (MB/s encoded)
+*     - Bytes per tick: delta snapshots and keyframes vs previous fixed layout (28 bytes)
+*
+*   USAGE:
+*       snapshot_codec_bench [--matches <count>] [--steps <count>] [--seed <value>] [--ack-lag <ticks>] [--loss <percent>]
+*
+*         --matches <count>   Matches simulated, default: 4096
+*         --steps <count>     Simulation ticks, default: 1000
+*         --seed <value>      Inputs and losses seed, default: 1
+*         --ack-lag <ticks>   Ticks until server receives client ack (round trip), default: 2
+*         --loss <percent>    States lost on the way to clients, default: 0
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o snapshot_codec_bench snapshot_codec_bench.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"               // Game simulation: PongGame, UpdatePongGame()...
+#include "pong_net.h"               // Protocol: PongSnapshot, GetPongSnapshot()
+#include "snapshot_codec.h"         // Snapshots: EncodePongSnapshot(), DecodePongSnapshot()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), calloc(), free()
+#include <string.h>                 // Required for: memcmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define RAW_SNAPSHOT_SIZE       28          // Previous fixed layout: u32 tick, 4 x f32 positions, 2 x i16 speeds, 2 x u16 scores
+#define ACK_LAG_MAX             (SNAPSHOT_HISTORY*2)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Match simulated, server and client sides
+typedef struct BenchMatch {
+    PongGame game;
+    PongInput input;                    // Player input, held for a few ticks
+    SnapshotHistory serverHistory;      // Snapshots sent, encoder baselines
+    SnapshotHistory clientHistory;      // Snapshots received, decoder baselines
+    unsigned int acks[ACK_LAG_MAX + 1]; // Client acks on their way to server, by tick
+} BenchMatch;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int matchesCount = 4096;
+static int stepsCount = 1000;
+static unsigned int seed = 1;
+static int ackLag = 2;
+static int lossPercent = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);         // Get pseudo-random value (xorshift32)
+static bool IsSnapshotEqual(const PongSnapshot *a, const PongSnapshot *b);     // Check snapshots fields are equal
+static int CheckExtremeKeyframes(unsigned int *state);      // Check extreme values keyframes, returns failures
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--matches")) matchesCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--steps")) stepsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--seed")) seed = (unsigned int)atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--ack-lag")) ackLag = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--loss")) lossPercent = atoi(argv[++i]);
+    }
+
+    if (matchesCount < 1) matchesCount = 1;
+    if (stepsCount < 1) stepsCount = 1;
+    if (seed == 0) seed = 1;        // NOTE: xorshift state can not be 0
+    if (ackLag < 1) ackLag = 1;
+    if (ackLag > ACK_LAG_MAX) ackLag = ACK_LAG_MAX;
+
+    unsigned int state = seed;
+
+    BenchMatch *matches = (BenchMatch *)calloc(matchesCount, sizeof(BenchMatch));
+    unsigned char (*packets)[SNAPSHOT_MAX_SIZE] = calloc(matchesCount, SNAPSHOT_MAX_SIZE);
+    int *sizes = (int *)calloc(matchesCount, sizeof(int));
+    PongSnapshot *snapshots = (PongSnapshot *)calloc(matchesCount, sizeof(PongSnapshot));
+
+    for (int i = 0; i < matchesCount; i++) InitPongGame(&matches[i].game, 800, 600);
+
+    printf("snapshot codec: %i matches, %i ticks, ack lag %i ticks, %i%% loss\n", matchesCount, stepsCount, ackLag, lossPercent);
+    //--------------------------------------------------------------------------------------
+
+    // Check extreme values keyframes
+    //--------------------------------------------------------------------------------------
+    int mismatches = CheckExtremeKeyframes(&state);
+    //--------------------------------------------------------------------------------------
+
+    // Matches ticks: encode (server), lose some states, decode (client), compare
+    // NOTE: Encode and decode loops are timed alone, simulation and checks are not
+    //--------------------------------------------------------------------------------------
+    double encodeTime = 0.0, decodeTime = 0.0;
+    unsigned long long deltaCount = 0, deltaBytes = 0, keyframeCount = 0, keyframeBytes = 0, lost = 0, undecoded = 0;
+    int maxSize = 0;
+
+    for (int step = 0; (step < stepsCount) && (mismatches == 0); step++)
+    {
+        unsigned int tick = (unsigned int)step + 1;
+
+        for (int i = 0; i < matchesCount; i++)
+        {
+            BenchMatch *match = &matches[i];
+
+            if ((GetRandom(&state)%8) == 0)
+            {
+                unsigned int move = GetRandom(&state)%3;
+                match->input.up = (move == 1);
+                match->input.down = (move == 2);
+            }
+
+            UpdatePongGame(&match->game, match->input);
+
+            snapshots[i] = GetPongSnapshot(&match->game, tick);
+            QuantizePongSnapshot(&snapshots[i]);
+            StoreSnapshotHistory(&match->serverHistory, &snapshots[i]);
+        }
+
+        double start = GetWallTime();
+        for (int i = 0; i < matchesCount; i++)
+        {
+            BenchMatch *match = &matches[i];
+            const PongSnapshot *baseline = GetSnapshotHistory(&match->serverHistory, match->acks[tick%(ACK_LAG_MAX + 1)]);
+
+            sizes[i] = EncodePongSnapshot(&snapshots[i], baseline, packets[i]);
+        }
+        encodeTime += GetWallTime() - start;
+
+        for (int i = 0; i < matchesCount; i++)
+        {
+            if (IsSnapshotKeyframe(packets[i], sizes[i])) { keyframeCount++; keyframeBytes += sizes[i]; }
+            else { deltaCount++; deltaBytes += sizes[i]; }
+
+            if (sizes[i] > maxSize) maxSize = sizes[i];
+            if ((int)(GetRandom(&state)%100) < lossPercent) { sizes[i] = -1; lost++; }
+        }
+
+        start = GetWallTime();
+        for (int i = 0; i < matchesCount; i++)
+        {
+            PongSnapshot decoded = { 0 };
+
+            if (sizes[i] < 0) continue;
+            if (DecodePongSnapshot(packets[i], sizes[i], &matches[i].clientHistory, &decoded)) StoreSnapshotHistory(&matches[i].clientHistory, &decoded);
+            else sizes[i] = -2;
+        }
+        decodeTime += GetWallTime() - start;
+
+        for (int i = 0; i < matchesCount; i++)
+        {
+            BenchMatch *match = &matches[i];
+
+            if (sizes[i] == -2) undecoded++;
+            else if ((sizes[i] >= 0) && !IsSnapshotEqual(GetSnapshotHistory(&match->clientHistory, tick), &snapshots[i]))
+            {
+                if (mismatches == 0) printf("MISMATCH: match %i, tick %u: decoded snapshot differs\n", i, tick);
+                mismatches++;
+            }
+
+            // Client acks latest state received, server gets it after lag
+            match->acks[(tick + ackLag)%(ACK_LAG_MAX + 1)] = match->clientHistory.latestTick;
+        }
+    }
+
+    // NOTE: Baselines are always in client history (acked), no state can fail to decode
+    if (undecoded > 0)
+    {
+        printf("MISMATCH: %llu states could not be decoded\n", undecoded);
+        mismatches++;
+    }
+
+    if (mismatches == 0)
+    {
+        unsigned long long count = deltaCount + keyframeCount;
+        unsigned long long bytes = deltaBytes + keyframeBytes;
+
+        printf("check: %llu snapshots (%llu lost) decoded equal to quantized ones\n", count, lost);
+        printf("delta snapshots:    %10llu, %5.2f bytes avg\n", deltaCount, (deltaCount > 0)? (double)deltaBytes/deltaCount : 0.0);
+        printf("keyframes:          %10llu, %5.2f bytes avg\n", keyframeCount, (keyframeCount > 0)? (double)keyframeBytes/keyframeCount : 0.0);
+        printf("bytes per tick:     %5.2f avg, %i max (raw %i, %.1fx smaller)\n", (double)bytes/count, maxSize,
+            RAW_SNAPSHOT_SIZE, (double)RAW_SNAPSHOT_SIZE*count/bytes);
+        printf("encode:             %7.1f ns/snapshot, %6.1f MB/s\n", encodeTime*1e9/count, bytes/encodeTime/(1024.0*1024.0));
+        printf("decode:             %7.1f ns/snapshot, %6.1f MB/s\n", decodeTime*1e9/(count - lost), bytes/decodeTime/(1024.0*1024.0));
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    free(matches);
+    free(packets);
+    free(sizes);
+    free(snapshots);
+    //--------------------------------------------------------------------------------------
+
+    return (mismatches == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Get pseudo-random value (xorshift32)
+static unsigned int GetRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    *state = x;
+
+    return x;
+}
+
+// Check snapshots fields are equal
+static bool IsSnapshotEqual(const PongSnapshot *a, const PongSnapshot *b)
+{
+    if ((a == NULL) || (b == NULL)) return false;
+
+    return (a->tick == b->tick) && (a->ballX == b->ballX) && (a->ballY == b->ballY) &&
+        (a->ballSpeedX == b->ballSpeedX) && (a->ballSpeedY == b->ballSpeedY) &&
+        (a->playerY == b->playerY) && (a->enemyY == b->enemyY) &&
+        (a->playerScore == b->playerScore) && (a->enemyScore == b->enemyScore);
+}
+
+// Check extreme values keyframes
+// NOTE: Values beyond quantized limits are clamped by QuantizePongSnapshot()
+static int CheckExtremeKeyframes(unsigned int *state)
+{
+    int failures = 0;
+    int maxSize = 0;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        PongSnapshot snapshot = { 0 };
+        bool extreme = (i < 16);    // Every field at limits, signs from index bits
+
+        snapshot.tick = extreme? 0xFFFFFFFF : GetRandom(state);
+        snapshot.ballX = extreme? ((i & 1)? -1e9f : 1e9f) : (float)(int)GetRandom(state)/1024.0f;
+        snapshot.ballY = extreme? ((i & 2)? -1e9f : 1e9f) : (float)(int)GetRandom(state)/1024.0f;
+        snapshot.ballSpeedX = extreme? ((i & 4)? -2147483647 : 2147483647) : (int)GetRandom(state);
+        snapshot.ballSpeedY = extreme? ((i & 8)? -2147483647 : 2147483647) : (int)GetRandom(state);
+        snapshot.playerY = extreme? -1e9f : (float)(int)GetRandom(state)/1024.0f;
+        snapshot.enemyY = extreme? 1e9f : (float)(int)GetRandom(state)/1024.0f;
+        snapshot.playerScore = extreme? -2147483647 : (int)GetRandom(state);
+        snapshot.enemyScore = extreme? 2147483647 : (int)GetRandom(state);
+
+        QuantizePongSnapshot(&snapshot);
+
+        unsigned char data[SNAPSHOT_MAX_SIZE] = { 0 };
+        SnapshotHistory history = { 0 };
+        PongSnapshot decoded = { 0 };
+
+        int size = EncodePongSnapshot(&snapshot, NULL, data);
+        if (size > maxSize) maxSize = size;
+
+        if (!IsSnapshotKeyframe(data, size) || !DecodePongSnapshot(data, size, &history, &decoded) || !IsSnapshotEqual(&decoded, &snapshot))
+        {
+            if (failures == 0) printf("MISMATCH: extreme keyframe %i (%i bytes) differs\n", i, size);
+            failures++;
+        }
+    }
+
+    if (failures == 0) printf("check: extreme values keyframes decoded, %i bytes max (limit %i)\n", maxSize, SNAPSHOT_MAX_SIZE);
+
+    return failures;
+}
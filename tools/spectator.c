@@ -0,0 +1,281 @@
+/*******************************************************************************************
+*
+*   spectator - Live PONG/BLOCKS matches viewer, attached read-only to a running game
+*
+*   Running games publish their state every frame into shared memory (check src/spectator_shm.h),
+*   any number of spectator processes follow it at their own frame rate, host game cost does
+*   not change with viewers count. Viewer waits for the game to start and reattaches when the
+*   game is restarted.
+*
+*   Headless mode draws nothing, it reports every second: frames applied per second, frames
+*   behind host, resyncs (viewer fell behind ring) and events received, i.e. to check many
+*   viewers on one machine.
+*
+*   USAGE:
+*       spectator [--game pong|blocks] [--name <region>] [--fps <rate>] [--headless] [--seconds <time>]
+*
+*         --game <game>       Game watched, default region name: raylib_pong or raylib_blocks, default: pong
+*         --name <region>     Shared memory region name, overrides game default
+*         --fps <rate>        Viewer frame rate, default: 30
+*         --headless          No window, stats only
+*         --seconds <time>    Exit after <time> seconds, default: 0 (run until closed)
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o spectator spectator.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "pong_sim.h"               // Game simulation: PongGame
+#include "blocks_sim.h"             // Game simulation: BlocksGame
+#include "spectator_shm.h"          // Spectators: OpenSpectatorView(), UpdateSpectatorView()...
+#include "threads.h"                // Threads: GetWallTime()
+
+#include <stdio.h>                  // Required for: printf()
+#include <stdlib.h>                 // Required for: atoi(), atof()
+#include <time.h>                   // Required for: nanosleep()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ATTACH_RETRY_TIME       0.5         // Time between attach attempts while game is not running (seconds)
+#define MAX_WINDOW_WIDTH        1280        // Larger playfields (blocks board mode) are scaled down to fit
+#define MAX_WINDOW_HEIGHT       720
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int game = SPECTATOR_GAME_PONG;
+static const char *regionName = NULL;
+static int frameRate = 30;
+static bool headless = false;
+static double runSeconds = 0.0;
+static float viewScale = 1.0f;              // Playfield to window scale
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static bool AttachView(SpectatorView *view);                // Open game region and sync first state, returns false if not available
+static void DrawPong(const PongGame *pong);                 // Draw pong match (pong/pong.c gameplay screen)
+static void DrawBlocks(const BlocksGame *blocks);           // Draw blocks game (lessons/07_blocks_game_audio.c shapes backend)
+static void SleepTime(double seconds);                      // Sleep current thread
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < argc; i++)
+    {
+        if (TextIsEqual(argv[i], "--headless")) headless = true;
+        else if (i == (argc - 1)) break;
+        else if (TextIsEqual(argv[i], "--game")) game = TextIsEqual(argv[++i], "blocks")? SPECTATOR_GAME_BLOCKS : SPECTATOR_GAME_PONG;
+        else if (TextIsEqual(argv[i], "--name")) regionName = argv[++i];
+        else if (TextIsEqual(argv[i], "--fps")) frameRate = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--seconds")) runSeconds = atof(argv[++i]);
+    }
+
+    if (regionName == NULL) regionName = (game == SPECTATOR_GAME_BLOCKS)? "raylib_blocks" : "raylib_pong";
+    if (frameRate < 1) frameRate = 1;
+
+    SpectatorView view = { 0 };
+    double startTime = GetWallTime();
+
+    printf("spectator: watching %s (%s), %i fps%s\n", regionName, (game == SPECTATOR_GAME_BLOCKS)? "blocks" : "pong",
+        frameRate, headless? ", headless" : "");
+
+    // NOTE: Window size is taken from game playfield, game must be running before window is created
+    while (!AttachView(&view))
+    {
+        if ((runSeconds > 0.0) && ((GetWallTime() - startTime) >= runSeconds)) return 1;
+        SleepTime(ATTACH_RETRY_TIME);
+    }
+
+    if (!headless)
+    {
+        const int *playfield = (const int *)view.state;     // NOTE: PongGame and BlocksGame start with screenWidth, screenHeight
+
+        // NOTE: Playfields larger than maximum window size are shown whole, scaled down
+        if (playfield[0]*viewScale > MAX_WINDOW_WIDTH) viewScale = (float)MAX_WINDOW_WIDTH/playfield[0];
+        if (playfield[1]*viewScale > MAX_WINDOW_HEIGHT) viewScale = (float)MAX_WINDOW_HEIGHT/playfield[1];
+
+        InitWindow(playfield[0]*viewScale, playfield[1]*viewScale, TextFormat("spectator - %s", regionName));
+        SetTargetFPS(frameRate);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // Viewer loop: apply frames published since previous frame, draw latest state
+    //--------------------------------------------------------------------------------------
+    double reportTime = GetWallTime();
+    double attachTime = 0.0;
+    unsigned int framesReported = 0, resyncsReported = 0, events = 0;
+
+    while ((headless || !WindowShouldClose()) && ((runSeconds <= 0.0) || ((GetWallTime() - startTime) < runSeconds)))
+    {
+        // Game closed (or restarted): reattach once available, latest state kept on screen meanwhile
+        if (!IsSpectatorHostClosed(&view))
+        {
+            UpdateSpectatorView(&view);
+            events |= view.events;
+        }
+        else if ((GetWallTime() - attachTime) >= ATTACH_RETRY_TIME)
+        {
+            SpectatorView next = { 0 };
+            attachTime = GetWallTime();
+
+            if (AttachView(&next))
+            {
+                CloseSpectatorView(&view);
+                view = next;
+                framesReported = resyncsReported = 0;
+            }
+        }
+
+        if (headless)
+        {
+            double time = GetWallTime();
+
+            if ((time - reportTime) >= 1.0)
+            {
+                printf("[%5.0fs] frame %8u | applied %6.1f frames/s | behind %3u frames | resyncs %u | events 0x%02x%s\n",
+                    time - startTime, view.frame, (view.frames - framesReported)/(time - reportTime),
+                    view.header->frame - view.frame, view.resyncs - resyncsReported, events,
+                    IsSpectatorHostClosed(&view)? " | game closed" : "");
+                fflush(stdout);
+
+                framesReported = view.frames;
+                resyncsReported = view.resyncs;
+                events = 0;
+                reportTime = time;
+            }
+
+            SleepTime(1.0/frameRate);
+            continue;
+        }
+
+        BeginDrawing();
+
+            ClearBackground(RAYWHITE);
+
+            BeginMode2D((Camera2D){ { 0, 0 }, { 0, 0 }, 0.0f, viewScale });
+
+                if (view.header->game == SPECTATOR_GAME_BLOCKS) DrawBlocks((const BlocksGame *)view.state);
+                else DrawPong((const PongGame *)view.state);
+
+            EndMode2D();
+
+            DrawText(TextFormat("SPECTATING: frame %u%s", view.frame, IsSpectatorHostClosed(&view)? " (game closed)" : ""), 10, GetScreenHeight() - 20, 10, GRAY);
+
+        EndDrawing();
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    if (!headless) CloseWindow();
+
+    CloseSpectatorView(&view);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Open game region and sync first state
+// NOTE: Region state size must match viewer game state (same game core build)
+static bool AttachView(SpectatorView *view)
+{
+    SpectatorView opened = OpenSpectatorView(regionName);
+
+    int stateSize = (game == SPECTATOR_GAME_BLOCKS)? (int)sizeof(BlocksGame) : (int)sizeof(PongGame);
+
+    if (!IsSpectatorViewReady(&opened) || (opened.header->game != game) || (opened.header->stateSize != stateSize) ||
+        IsSpectatorHostClosed(&opened) || (UpdateSpectatorView(&opened) == 0))
+    {
+        CloseSpectatorView(&opened);
+        return false;
+    }
+
+    *view = opened;
+
+    return true;
+}
+
+// Draw pong match
+static void DrawPong(const PongGame *pong)
+{
+    DrawCircleV(pong->ballPosition, pong->ballRadius, RED);
+    DrawRectangleRec(pong->player, BLUE);
+    DrawRectangleRec(pong->enemy, DARKGREEN);
+    DrawLine(pong->enemyVisionRange, 0, pong->enemyVisionRange, pong->screenHeight, GRAY);
+
+    DrawText(TextFormat("%04i", pong->playerScore), 100, 10, 30, BLUE);
+    DrawText(TextFormat("%04i", pong->enemyScore), pong->screenWidth - 200, 10, 30, DARKGREEN);
+}
+
+// Draw blocks game
+static void DrawBlocks(const BlocksGame *blocks)
+{
+    DrawRectangle(blocks->player.position.x, blocks->player.position.y, blocks->player.size.x, blocks->player.size.y, BLACK);
+    DrawCircleV(blocks->ball.position, blocks->ball.radius, MAROON);
+
+    for (int j = 0; j < BRICKS_LINES; j++)
+    {
+        for (int i = 0; i < BRICKS_PER_LINE; i++)
+        {
+            const Brick *brick = &blocks->bricks[j][i];
+
+            if (brick->active) DrawRectangle(brick->position.x, brick->position.y, brick->size.x, brick->size.y, ((i + j)%2 == 0)? GRAY : DARKGRAY);
+        }
+    }
+
+    // Endless mode: resident field rows, from lowest one up to screen top
+    if (blocks->mode == BLOCKS_MODE_ENDLESS)
+    {
+        const BrickField *field = &blocks->field;
+
+        for (const BrickRow *row = GetBrickFieldRow(field, field->landedRows); row != NULL; row = GetBrickFieldRow(field, row->index + 1))
+        {
+            float y = GetBrickFieldRowY(field, row->index);
+            if ((y + field->cellSize.y) < 0) break;
+
+            for (int i = 0; i < BRICK_FIELD_COLUMNS; i++)
+            {
+                if (row->cells[i] > 0) DrawRectangle(i*field->cellSize.x, y, field->cellSize.x, field->cellSize.y, ((i + row->index)%2 == 0)? GRAY : DARKGRAY);
+            }
+        }
+    }
+
+    // Board mode: whole board cells, bricks requiring more hits tinted red
+    if (blocks->mode == BLOCKS_MODE_BOARD)
+    {
+        const BrickBoard *board = &blocks->board;
+        const Color tints[4] = { GRAY, DARKGRAY, MAROON, { 120, 30, 40, 255 } };
+
+        for (int cell = 0; cell < board->rows*board->columns; cell++)
+        {
+            if (board->cells[cell] > 0) DrawRectangleRec(GetBrickBoardCellRec(board, cell), tints[((board->cells[cell] > 1)? 2 : 0) + (cell/board->columns + cell%board->columns)%2]);
+        }
+    }
+
+    for (int i = 0; i < blocks->player.lifes; i++) DrawRectangle(20 + 40*i, blocks->screenHeight - 30, 35, 10, LIGHTGRAY);
+}
+
+// Sleep current thread
+// NOTE: raylib WaitTime() can use window timer, not available in headless mode
+static void SleepTime(double seconds)
+{
+    struct timespec duration = { (time_t)seconds, (long)((seconds - (double)(time_t)seconds)*1e9) };
+    nanosleep(&duration, NULL);
+}
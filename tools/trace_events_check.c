@@ -0,0 +1,207 @@
+/*******************************************************************************************
+*
+*   trace_events_check - Trace buffers reuse: many worker threads started and stopped
+*
+*   Worker threads are started and stopped again and again (i.e. clip recorder worker on
+*   every recording), many more than TRACE_MAX_THREADS, their events must be kept:
+*     - Named workers, rounds of TRACE_MAX_THREADS - 1 running at the same time (main thread
+*       owns one buffer), same names every round: all rounds events are in saved trace
+*     - Unnamed workers one after another: every worker events are in trace saved after it
+*   Exit code 1 on any missing event
+*
+*   USAGE:
+*       trace_events_check [--rounds <count>] [--events <count>]
+*
+*         --rounds <count>    Named workers rounds and unnamed workers, default: 4
+*         --events <count>    Spans recorded per worker, default: 100
+*
+*   COMPILATION (Linux - GCC):
+*       gcc -o trace_events_check trace_events_check.c -I../src -L../lessons/build/PLATFORM_DESKTOP -lgamecore -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+// Shared game core library (libgamecore)
+#include "trace_events.h"           // Trace: InitTraceEvents(), SaveTraceEvents(), ReleaseTraceThread()...
+#include "threads.h"                // Threads: StartThread(), JoinThread()
+
+#include <stdio.h>                  // Required for: printf(), snprintf()
+#include <stdlib.h>                 // Required for: atoi()
+#include <string.h>                 // Required for: strstr()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define TRACE_FILE_NAME         "trace_events_check.json"
+#define WORKERS_PER_ROUND       (TRACE_MAX_THREADS - 1)     // Main thread owns one buffer
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Worker thread parameters
+typedef struct Worker {
+    Thread thread;
+    char name[32];                  // Thread name, "" for unnamed worker
+    char detail[32];                // Spans detail, identifies worker run in trace
+} Worker;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int roundsCount = 4;
+static int eventsCount = 100;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void WorkerThread(void *arg);                    // Record spans, release trace buffer
+static int CountTraceDetail(const char *detail);        // Count saved trace events with detail
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 1; i < (argc - 1); i++)
+    {
+        if (TextIsEqual(argv[i], "--rounds")) roundsCount = atoi(argv[++i]);
+        else if (TextIsEqual(argv[i], "--events")) eventsCount = atoi(argv[++i]);
+    }
+
+    if (roundsCount < 1) roundsCount = 1;
+    if (eventsCount < 1) eventsCount = 1;
+    if (eventsCount*roundsCount > TRACE_EVENTS_PER_THREAD) eventsCount = TRACE_EVENTS_PER_THREAD/roundsCount;
+
+    SetTraceLogLevel(LOG_WARNING);
+    InitTraceEvents(TRACE_FILE_NAME);
+
+    printf("trace events: %i threads max, %i rounds of %i named workers, %i unnamed workers, %i events each\n",
+        TRACE_MAX_THREADS, roundsCount, WORKERS_PER_ROUND, roundsCount, eventsCount);
+
+    int failures = 0;
+    Worker workers[WORKERS_PER_ROUND] = { 0 };
+    //--------------------------------------------------------------------------------------
+
+    // Named workers: all running at the same time, same names every round
+    //--------------------------------------------------------------------------------------
+    for (int round = 0; round < roundsCount; round++)
+    {
+        for (int w = 0; w < WORKERS_PER_ROUND; w++)
+        {
+            snprintf(workers[w].name, sizeof(workers[w].name), "worker_%i", w);
+            snprintf(workers[w].detail, sizeof(workers[w].detail), "named_%i_%i", round, w);
+
+            if (!StartThread(&workers[w].thread, WorkerThread, &workers[w]))
+            {
+                printf("FAILED: thread could not be started\n");
+                return 1;
+            }
+        }
+
+        for (int w = 0; w < WORKERS_PER_ROUND; w++) JoinThread(&workers[w].thread);
+    }
+
+    SaveTraceEvents();
+
+    for (int round = 0; round < roundsCount; round++)
+    {
+        for (int w = 0; w < WORKERS_PER_ROUND; w++)
+        {
+            int count = CountTraceDetail(TextFormat("named_%i_%i", round, w));
+
+            if (count != eventsCount)
+            {
+                if (failures == 0) printf("MISSING: round %i worker %i, %i of %i events\n", round, w, count, eventsCount);
+                failures++;
+            }
+        }
+    }
+
+    if (failures == 0) printf("check: %i named workers runs, all events kept\n", roundsCount*WORKERS_PER_ROUND);
+    //--------------------------------------------------------------------------------------
+
+    // Unnamed workers: one after another, every one reuses a released buffer
+    //--------------------------------------------------------------------------------------
+    int unnamedFailures = 0;
+
+    for (int run = 0; run < roundsCount; run++)
+    {
+        Worker *worker = &workers[0];
+        worker->name[0] = '\0';
+        snprintf(worker->detail, sizeof(worker->detail), "unnamed_%i", run);
+
+        if (!StartThread(&worker->thread, WorkerThread, worker))
+        {
+            printf("FAILED: thread could not be started\n");
+            return 1;
+        }
+
+        JoinThread(&worker->thread);
+        SaveTraceEvents();
+
+        int count = CountTraceDetail(worker->detail);
+
+        if (count != eventsCount)
+        {
+            if (unnamedFailures == 0) printf("MISSING: unnamed worker %i, %i of %i events\n", run, count, eventsCount);
+            unnamedFailures++;
+        }
+    }
+
+    if (unnamedFailures == 0) printf("check: %i unnamed workers runs, all events kept\n", roundsCount);
+    failures += unnamedFailures;
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    CloseTraceEvents();
+    remove(TRACE_FILE_NAME);
+    //--------------------------------------------------------------------------------------
+
+    return (failures == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Record spans, release trace buffer
+static void WorkerThread(void *arg)
+{
+    Worker *worker = (Worker *)arg;
+
+    if (worker->name[0] != '\0') SetTraceThreadName(worker->name);
+
+    for (int i = 0; i < eventsCount; i++)
+    {
+        BeginTraceSpan("WorkerSpan", worker->detail);
+        EndTraceSpan();
+    }
+
+    ReleaseTraceThread();
+}
+
+// Count saved trace events with detail
+static int CountTraceDetail(const char *detail)
+{
+    char *text = LoadFileText(TRACE_FILE_NAME);
+    if (text == NULL) return 0;
+
+    char pattern[64] = { 0 };
+    snprintf(pattern, sizeof(pattern), "\"detail\":\"%s\"", detail);
+
+    int count = 0;
+    for (const char *found = strstr(text, pattern); found != NULL; found = strstr(found + 1, pattern)) count++;
+
+    UnloadFileText(text);
+
+    return count;
+}